@@ -0,0 +1,105 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 Core.AsyncIO.cpp
+ */
+
+#include "Candle/Core.hpp"
+#include "Filesystem/AsyncIO.hpp"
+#include "Filesystem/BinaryFile.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+
+candle_test("Core.AsyncIO", "Handler Resubmission At Capacity") {
+
+	//A queue depth of 4 allows 7 requests in flight on io_uring, one completion slot is reserved
+	constexpr u32 Requests = 7;
+	constexpr u32 Resubmissions = 3;
+	constexpr u32 BlockSize = 4096;
+
+	Path path(std::filesystem::temp_directory_path() / "candle-asyncio-resubmit.bin");
+
+	std::vector<u8> source(Requests * BlockSize);
+
+	for (SizeT i = 0; i < source.size(); i++) {
+		source[i] = i * 31 + 7;
+	}
+
+	{
+		BinaryFile file(path, BinaryFile::Out | BinaryFile::Trunc);
+		candle_condition(file.open());
+		candle_equal(file.write(source), source.size());
+	}
+
+	auto file = std::make_unique<BinaryFile>(path);
+	candle_condition(file->open());
+
+	auto io = std::make_unique<AsyncIO>(AsyncIO::Backend::Native, 4);
+	std::vector<u8> target(Requests * BlockSize);
+
+	std::atomic<u32> completed = 0;
+	std::atomic<u32> failed = 0;
+
+	//Every handler submits another read of the same block while the ring is full
+	std::function<IORequest(u32, u32)> createRead = [&](u32 block, u32 depth) {
+
+		std::span<u8> data(target.data() + block * BlockSize, BlockSize);
+
+		return IORequest::read(*file, block * BlockSize, data, [&, block, depth](const IOResult& result) {
+
+			failed.fetch_add(!result.success() || result.transferred != BlockSize, std::memory_order_relaxed);
+			completed.fetch_add(1, std::memory_order_release);
+
+			if (depth < Resubmissions) {
+				io->submit(createRead(block, depth + 1));
+			}
+
+		});
+
+	};
+
+	//A single batch occupies all slots at once
+	std::vector<IORequest> requests;
+
+	for (u32 i = 0; i < Requests; i++) {
+		requests.push_back(createRead(i, 0));
+	}
+
+	io->submit(requests);
+
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+	while (completed.load(std::memory_order_acquire) < Requests * (Resubmissions + 1) && std::chrono::steady_clock::now() < deadline) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	if (completed.load(std::memory_order_acquire) < Requests * (Resubmissions + 1)) {
+
+		//Destroying a deadlocked service would wait forever
+		io.release();
+		file.release();
+
+		candle_error("Completion handlers deadlocked while resubmitting");
+		return;
+
+	}
+
+	io.reset();
+	file.reset();
+
+	std::filesystem::remove(path.getHandle());
+
+	candle_equal(failed.load(), 0u);
+	candle_condition(target == source);
+
+}
@@ -0,0 +1,439 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 Core.BigInt.cpp
+ */
+
+#include "Candle/Core.hpp"
+#include "Math/BigInt.hpp"
+
+#include <stdexcept>
+
+
+
+namespace {
+
+	constexpr SizeT LimbBits = 64;
+
+	// Limb counts around the Karatsuba (24) and Toom-3 (256) thresholds
+	constexpr SizeT ThresholdLimbs[] = {1, 2, 23, 24, 25, 47, 48, 49, 255, 256, 257, 300, 520};
+
+
+	BigInt powerOfTwo(SizeT n) {
+		return BigInt(1) << n;
+	}
+
+	// 2^n - 1
+	BigInt ones(SizeT n) {
+		return powerOfTwo(n) - 1;
+	}
+
+	// Limbs drawn from 0, ~0 and pseudo-random values, so that carries and borrows run across whole limbs
+	BigInt patterned(SizeT limbs, u64 seed) {
+
+		std::vector<u64> magnitude(limbs);
+
+		for (SizeT i = 0; i < limbs; i++) {
+
+			seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+
+			switch (seed >> 62) {
+				case 0:		magnitude[i] = 0;			break;
+				case 1:		magnitude[i] = ~0ull;		break;
+				default:	magnitude[i] = seed ^ (seed >> 29);	break;
+			}
+
+		}
+
+		magnitude.back() |= 1ull << 63;
+
+		return BigInt(1, magnitude);
+
+	}
+
+	BigInt fromHex(std::string_view hex) {
+
+		BigInt value;
+
+		for (char c : hex) {
+
+			u32 digit = c <= '9' ? c - '0' : c - 'a' + 10;
+			value = (value << 4) + digit;
+
+		}
+
+		return value;
+
+	}
+
+	std::string toHex(BigInt value) {
+
+		constexpr const char* Digits = "0123456789abcdef";
+
+		if (value.isZero()) {
+			return "0";
+		}
+
+		std::string hex;
+
+		while (!value.isZero()) {
+
+			hex.insert(hex.begin(), Digits[(value % 16).toInteger<u32>()]);
+			value >>= 4;
+
+		}
+
+		return hex;
+
+	}
+
+}
+
+
+
+candle_test("Core.BigInt", "Carry and Borrow Chains") {
+
+	for (SizeT limbs : {1, 2, 3, 5, 24, 64, 300}) {
+
+		SizeT bits = limbs * LimbBits;
+
+		BigInt x = powerOfTwo(bits);
+		BigInt m = ones(bits);
+
+		candle_equal(m + 1, x);
+		candle_equal(x - 1, m);
+		candle_equal(x - m, BigInt(1));
+		candle_equal(BigInt(1) - x, -m);
+		candle_equal(m.magnitudeBitSize(), bits);
+
+		// In-place operations borrowing through runs of zero limbs
+		BigInt y = x;
+		y -= 1;
+		candle_equal(y, m);
+
+		y += 1;
+		candle_equal(y, x);
+
+		BigInt z = x + 1;
+		z -= 2;
+		candle_equal(z, m);
+
+		BigInt w = powerOfTwo(bits + LimbBits) + powerOfTwo(LimbBits);
+		w -= powerOfTwo(bits) + 1;
+		candle_equal(w, powerOfTwo(bits + LimbBits) - powerOfTwo(bits) + powerOfTwo(LimbBits) - 1);
+
+		BigInt v = x;
+		--v;
+		candle_equal(v, m);
+
+		++v;
+		candle_equal(v, x);
+
+	}
+
+}
+
+
+candle_test("Core.BigInt", "Squares Across Thresholds") {
+
+	// (2^n - 1)^2 = 2^2n - 2^(n + 1) + 1, the product consists of long runs of ones and zeros
+	for (SizeT limbs : ThresholdLimbs) {
+
+		SizeT n = limbs * LimbBits;
+		BigInt m = ones(n);
+
+		candle_equal(m * m, powerOfTwo(2 * n) - powerOfTwo(n + 1) + 1);
+
+	}
+
+	BigInt m = ones(16384);
+	candle_equal(m * m, powerOfTwo(32768) - powerOfTwo(16385) + 1);
+
+	// (2^a - 1)(2^b - 1) = 2^(a + b) - 2^a - 2^b + 1 for unbalanced operands
+	for (auto [a, b] : {std::pair<SizeT, SizeT>{64 * 300, 64 * 30}, {64 * 600, 64 * 257}, {64 * 100, 64 * 24}, {5000, 1500}}) {
+		candle_equal(ones(a) * ones(b), powerOfTwo(a + b) - powerOfTwo(a) - powerOfTwo(b) + 1);
+	}
+
+}
+
+
+candle_test("Core.BigInt", "Products Across Thresholds") {
+
+	for (SizeT limbs : ThresholdLimbs) {
+
+		BigInt a = patterned(limbs, limbs);
+		BigInt b = patterned(limbs, limbs * 31 + 7);
+		BigInt c = patterned(limbs / 3 + 1, limbs * 17 + 3);
+
+		BigInt ab = a * b;
+
+		candle_equal(ab, b * a);
+
+		// Splitting b yields smaller products computed by different algorithms
+		SizeT split = (limbs / 2 + 1) * LimbBits;
+		BigInt high = b >> split;
+		BigInt low = b - (high << split);
+
+		candle_equal(ab, ((a * high) << split) + a * low);
+
+		candle_equal((a + b) * (a + b), a * a + 2 * ab + b * b);
+		candle_equal((a - b) * (a + b), a * a - b * b);
+		candle_equal(a * c, c * a);
+		candle_equal(-a * b, -ab);
+		candle_equal(-a * -b, ab);
+
+	}
+
+}
+
+
+candle_test("Core.BigInt", "Fixed Values") {
+
+	candle_equal(BigInt(3).pow(200).toString(), "265613988875874769338781322035779626829233452653394495974574961739092490901302182994384699044001");
+	candle_equal(powerOfTwo(256).toString(), "115792089237316195423570985008687907853269984665640564039457584007913129639936");
+
+	candle_equal((BigInt(3).pow(300) * BigInt(7).pow(250)).toString(),
+		"2575647462788388848994601323936583012479612131815852016028590143936575459974579700457388800737398705793364615518027208298322961022862"
+		"497476656268886087324524147504059919402339695136306828280285713051255139940943410524689044692313557051460362708835252268797002755469"
+		"329301355966246292686529222810219117490369246691604977495115933284085521762844796056065249");
+
+	candle_equal(BigInt(0).toString(), "0");
+	candle_equal(BigInt(-1).toString(), "-1");
+	candle_equal(BigInt(~0ull).toString(), "18446744073709551615");
+
+}
+
+
+candle_test("Core.BigInt", "Division") {
+
+	BigInt n = BigInt(10).pow(150) + 12345;
+	BigInt d("987654321987654321987654321");
+
+	candle_equal((n / d).toString(), "1012499998974843750012814454137339818310783252271115210359111058858011111764274862115446563211056917959861789538001726618274");
+	candle_equal((n % d).toString(), "966338046967338046966350391");
+
+	// Truncating division, the remainder takes the sign of the dividend
+	candle_equal(BigInt(-7) / 2, BigInt(-3));
+	candle_equal(BigInt(-7) % 2, BigInt(-1));
+	candle_equal(BigInt(7) / -2, BigInt(-3));
+	candle_equal(BigInt(7) % -2, BigInt(1));
+
+	for (SizeT limbs : ThresholdLimbs) {
+
+		BigInt q = patterned(limbs, limbs * 5 + 1);
+
+		for (SizeT divisorLimbs : {SizeT(1), SizeT(2), limbs / 2 + 1, limbs}) {
+
+			BigInt b = patterned(divisorLimbs, divisorLimbs * 13 + limbs);
+			BigInt r = patterned(divisorLimbs, divisorLimbs * 7 + 2) % b;
+			BigInt a = q * b + r;
+
+			candle_equal(a / b, q);
+			candle_equal(a % b, r);
+
+			BigInt::DivResult result = BigInt(a).divmod(b);
+
+			candle_equal(result.quotient, q);
+			candle_equal(result.remainder, r);
+
+		}
+
+		// Divisors of the form 2^n - 1 produce borrow chains during normalization
+		BigInt m = ones(limbs * LimbBits);
+		candle_equal((m * m) / m, m);
+		candle_equal((m * m + m - 1) % m, m - 1);
+
+	}
+
+}
+
+
+candle_test("Core.BigInt", "Decimal Round-Trip") {
+
+	const char* values[] = {
+		"0",
+		"1",
+		"-1",
+		"18446744073709551616",
+		"-340282366920938463463374607431768211455",
+		"100000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000001"
+	};
+
+	for (const char* value : values) {
+		candle_equal(BigInt(value).toString(), value);
+	}
+
+	// Large enough for the recursive conversion in both directions
+	std::string power = "1" + std::string(5000, '0');
+
+	candle_equal(BigInt(10).pow(5000).toString(), power);
+	candle_equal(BigInt(power), BigInt(10).pow(5000));
+
+	std::string nines(5000, '9');
+	candle_equal(BigInt(nines) + 1, BigInt(10).pow(5000));
+	candle_equal((BigInt(10).pow(5000) - 1).toString(), nines);
+
+	for (SizeT limbs : ThresholdLimbs) {
+
+		BigInt a = patterned(limbs, limbs * 3 + 11);
+
+		candle_equal(BigInt(a.toString()), a);
+		candle_equal(BigInt((-a).toString()), -a);
+
+	}
+
+	bool thrown = false;
+
+	try {
+		BigInt("12a3");
+	} catch (const std::runtime_error&) {
+		thrown = true;
+	}
+
+	candle_condition(thrown);
+
+}
+
+
+candle_test("Core.BigInt", "Hex Round-Trip") {
+
+	candle_equal(fromHex("1000000000000000000000000000000000000000000deadbeef"), powerOfTwo(200) + 0xDEADBEEF);
+	candle_equal(toHex(powerOfTwo(200) + 0xDEADBEEF), "1000000000000000000000000000000000000000000deadbeef");
+	candle_equal(toHex(ones(256)), std::string(64, 'f'));
+	candle_equal(fromHex(std::string(64, 'f')), ones(256));
+	candle_equal(toHex(powerOfTwo(128)), "1" + std::string(32, '0'));
+	candle_equal(fromHex("ffffffffffffffffffffffffffffffff").toString(), "340282366920938463463374607431768211455");
+
+	for (SizeT limbs : {1, 2, 24, 33, 64}) {
+
+		BigInt a = patterned(limbs, limbs * 19 + 5);
+
+		candle_equal(fromHex(toHex(a)), a);
+		candle_equal(toHex(a).size(), (a.magnitudeBitSize() + 3) / 4);
+
+	}
+
+}
+
+candle_test("Core.BigInt", "Modular Exponentiation") {
+
+	// Exponents 0 and 1, modulus 1
+	candle_equal(BigInt(5).modPow(0, 7), BigInt(1));
+	candle_equal(BigInt(0).modPow(0, 7), BigInt(1));
+	candle_equal(BigInt(5).modPow(0, powerOfTwo(100)), BigInt(1));
+	candle_equal(BigInt(5).modPow(3, 1), BigInt(0));
+	candle_equal(BigInt(12345).modPow(1, 1000), BigInt(345));
+	candle_equal(BigInt(-3).modPow(1, 7), BigInt(4));
+	candle_equal(BigInt(-3).modPow(3, powerOfTwo(64)), BigInt(~0ull - 26));
+	candle_equal(ones(2000).modPow(1, powerOfTwo(2048) - 159), ones(2000));
+
+	// Even moduli take the division path
+	candle_equal(BigInt(3).modPow(BigInt(10).pow(20), BigInt(10).pow(30)).toString(), "427865522000000000000000000001");
+	candle_equal(BigInt(7).modPow(powerOfTwo(64) + 1, powerOfTwo(100)).toString(), "846599913202324767441940381703");
+	candle_equal((BigInt(10).pow(40) + 1).modPow(BigInt(10).pow(40), powerOfTwo(128)).toString(), "110503260744116230138349023763680460801");
+	candle_equal(BigInt(3).modPow(powerOfTwo(600), powerOfTwo(256)), BigInt(1));
+
+	// 1024 and 2048 bit odd moduli take the Montgomery path
+	candle_equal(BigInt(3).modPow(powerOfTwo(1023) + 12345, ones(1024)).toString(),
+		"1380495051503766581168989608893950225912077266511277046760169576748829267558465492760272138253606607260886607091011482932432785586180000360955"
+		"0328801098304429413615848284412071287434045292098395445111891825964589297946880273301991419498887256378779706130587621324474502594475946570102"
+		"973803569222583795711708");
+
+	BigInt m = powerOfTwo(2048) - 159;
+
+	candle_equal(BigInt(5).modPow(powerOfTwo(2047) + 99, m).toString(),
+		"1232536939950232765801581102055407292980218295633103937337585277352741662359589241143828341106775271351035090543270559727057202666785712682165"
+		"0472171470523282456608173769199391438779661799789952385876228134362196852288534334432919727285037613718697110044096828259992379925187546162680"
+		"1339506186807421007453627308581904735640513066002194764663916353567275273597867302595300972946475183659395001323738298787796931771841703651202"
+		"9884268750436387233101475987742892335792342472579640476984014218055750946146511394991896444474815575859126045722000998945455941314931643591967"
+		"6466710472173727276029377155928298198751294957459");
+
+	candle_equal((powerOfTwo(1000) + 7).modPow(BigInt(3).pow(500), m).toString(),
+		"4672832016308749725245397216767329364791882729647176995000102357213674256509509449183544045828955391722393490303460115907689173717274494165478"
+		"4337040829485020632627523906033092253756226061977328320369968748677317727823845918212970481362025476202913842111797705233632124619591906161087"
+		"6333388038483565725747013883035791980346856478702854811368989387350270867237450599513307071402539464484306120484353145006259396063719833598321"
+		"3377604674458316392789342960922761552862246166315666580911746377495970309958249546109325099494564054956905578467108415079863130483280021955672"
+		"832664335012325786702640965270295541792420918966");
+
+	// A reused context matches the one-shot exponentiation
+	BigInt::MontgomeryContext context(m);
+	candle_equal(context.modPow(5, powerOfTwo(2047) + 99), BigInt(5).modPow(powerOfTwo(2047) + 99, m));
+
+	// Fermat's little theorem for the Mersenne primes 2^521 - 1, 2^1279 - 1 and 2^2203 - 1
+	for (SizeT exponent : {521, 1279, 2203}) {
+
+		BigInt p = ones(exponent);
+
+		for (BigInt a : {BigInt(2), BigInt(3), patterned(exponent / 128, exponent)}) {
+
+			candle_equal(BigInt(a).modPow(p - 1, p), BigInt(1));
+			candle_equal(BigInt(a).modPow(p, p), a % p);
+
+		}
+
+	}
+
+	// Negative exponents exponentiate the inverse
+	candle_equal(BigInt(3).modPow(-1, 1000), BigInt(667));
+	candle_equal(BigInt(3).modPow(-5, 1000), BigInt(107));
+
+}
+
+
+candle_test("Core.BigInt", "Modular Inverse") {
+
+	candle_equal(BigInt(3).modInverse(1000), BigInt(667));
+	candle_equal(BigInt(-3).modInverse(1000), BigInt(333));
+	candle_equal(BigInt(1).modInverse(2), BigInt(1));
+	candle_equal(BigInt("12345678901234567890").modInverse(ones(127)).toString(), "95987530177320089548629399254220539361");
+
+	candle_equal(BigInt(12345).modInverse(powerOfTwo(2048) - 159).toString(),
+		"1107862046932265556068249154689762954204936755757277670506080371399630138093875368651361331499108706183318383237111967748068966985215695245641"
+		"2560623689682800041301986101078611606872165220656761114695498229353904329476279408308368414491601072533912793155247083500821623450807709437164"
+		"0746883079589382319474709389598141009659882007949207566835238745513958283511502458706804608264761071044187512267610369540346686264342597432628"
+		"8678462714269263389772672728223598797590548366931520381754207086711286945005457104837596914910175088379422194331607356034865614409105067025007"
+		"3181667627297513281179221640755639731227558626769");
+
+	for (SizeT exponent : {521, 1279, 2203}) {
+
+		BigInt p = ones(exponent);
+		BigInt a = patterned(exponent / 128, exponent + 1);
+		BigInt inverse = BigInt(a).modInverse(p);
+
+		candle_equal(inverse * a % p, BigInt(1));
+		candle_equal(inverse, BigInt(a).modPow(p - 2, p));
+
+	}
+
+	// No inverse exists for values sharing a factor with the modulus
+	auto throws = [](BigInt a, const BigInt& mod) {
+
+		try {
+			a.modInverse(mod);
+		} catch (const std::runtime_error&) {
+			return true;
+		}
+
+		return false;
+
+	};
+
+	candle_condition(throws(6, 9));
+	candle_condition(throws(4, 10));
+	candle_condition(throws(0, 7));
+	candle_condition(throws(powerOfTwo(200), powerOfTwo(100)));
+	candle_condition(throws(BigInt(3).pow(300), BigInt(3).pow(200) * 7));
+
+	bool thrown = false;
+
+	try {
+		BigInt(6).modPow(-1, 9);
+	} catch (const std::runtime_error&) {
+		thrown = true;
+	}
+
+	candle_condition(thrown);
+
+}
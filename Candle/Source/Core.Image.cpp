@@ -0,0 +1,204 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 Core.Image.cpp
+ */
+
+#include "Candle/Benchmark.hpp"
+#include "Image/Decode/JPEGDecoder.hpp"
+
+#include <array>
+
+
+
+//64x64 baseline JPEG, YCbCr 4:4:4 with the standard quality 75 tables
+static constexpr std::array<u8, 2743> BaselineJPEG = {
+	0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01,
+	0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x84, 0x00, 0x08, 0x06, 0x06, 0x07, 0x06, 0x05, 0x08,
+	0x07, 0x07, 0x07, 0x09, 0x09, 0x08, 0x0A, 0x0C, 0x14, 0x0D, 0x0C, 0x0B, 0x0B, 0x0C, 0x19, 0x12,
+	0x13, 0x0F, 0x14, 0x1D, 0x1A, 0x1F, 0x1E, 0x1D, 0x1A, 0x1C, 0x1C, 0x20, 0x24, 0x2E, 0x27, 0x20,
+	0x22, 0x2C, 0x23, 0x1C, 0x1C, 0x28, 0x37, 0x29, 0x2C, 0x30, 0x31, 0x34, 0x34, 0x34, 0x1F, 0x27,
+	0x39, 0x3D, 0x38, 0x32, 0x3C, 0x2E, 0x33, 0x34, 0x32, 0x01, 0x09, 0x09, 0x09, 0x0C, 0x0B, 0x0C,
+	0x18, 0x0D, 0x0D, 0x18, 0x32, 0x21, 0x1C, 0x21, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+	0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+	0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+	0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00,
+	0x40, 0x00, 0x40, 0x03, 0x01, 0x11, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x01,
+	0xA2, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x10, 0x00,
+	0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00, 0x00, 0x01, 0x7D, 0x01,
+	0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22,
+	0x71, 0x14, 0x32, 0x81, 0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24,
+	0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25, 0x26, 0x27, 0x28, 0x29,
+	0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A,
+	0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A,
+	0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A,
+	0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8,
+	0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6,
+	0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xE1, 0xE2, 0xE3,
+	0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9,
+	0xFA, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x11, 0x00,
+	0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00, 0x01, 0x02, 0x77, 0x00,
+	0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13,
+	0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+	0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18, 0x19, 0x1A, 0x26, 0x27,
+	0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+	0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+	0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88,
+	0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6,
+	0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+	0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xE2,
+	0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9,
+	0xFA, 0xFF, 0xDA, 0x00, 0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0xE6,
+	0x74, 0xB5, 0x55, 0x89, 0x46, 0x07, 0x4A, 0xFB, 0xC7, 0x4A, 0x9F, 0xB3, 0x49, 0x25, 0xB1, 0xF7,
+	0x18, 0x7A, 0xD6, 0x46, 0xA4, 0x80, 0x14, 0xC8, 0x1D, 0x06, 0x6B, 0x38, 0xDD, 0x7B, 0xC9, 0x68,
+	0xB5, 0xFF, 0x00, 0x81, 0x6F, 0xEB, 0xFC, 0xB8, 0xB3, 0x0A, 0xAA, 0x51, 0xB1, 0x9A, 0xF0, 0xBE,
+	0xE2, 0xD8, 0x6F, 0xCB, 0xFA, 0x54, 0xCA, 0xB5, 0x68, 0x42, 0x53, 0xD7, 0x6B, 0x6C, 0xFA, 0xB5,
+	0xAF, 0x2F, 0x97, 0xFC, 0x0F, 0x37, 0xF0, 0x78, 0xD8, 0x73, 0x48, 0xD5, 0xD3, 0x23, 0x91, 0x06,
+	0x7E, 0x60, 0x49, 0x03, 0xD6, 0xBE, 0x7B, 0x1B, 0x88, 0xC5, 0x46, 0x94, 0x9F, 0xBC, 0x9B, 0x69,
+	0x75, 0x7B, 0x5F, 0x5B, 0x74, 0xBE, 0x8B, 0x6F, 0x3B, 0x7D, 0x92, 0xB0, 0x71, 0x4A, 0x48, 0xEB,
+	0x6D, 0x1D, 0xC4, 0x2A, 0x3E, 0x61, 0x93, 0x9A, 0xF8, 0xFC, 0x65, 0x7C, 0x52, 0xA6, 0xBE, 0x25,
+	0x76, 0xDF, 0x57, 0xDB, 0x4E, 0xEA, 0xFA, 0xBD, 0xFC, 0xAF, 0xD4, 0xFA, 0x8A, 0x75, 0x60, 0xA2,
+	0x17, 0x5B, 0xD9, 0x40, 0xF9, 0xBA, 0x57, 0x93, 0x52, 0xB5, 0x74, 0xA2, 0x9B, 0x7B, 0x79, 0xF7,
+	0x7D, 0x7C, 0x95, 0x8F, 0x07, 0x33, 0x92, 0x95, 0xEC, 0x52, 0x48, 0x1B, 0xCC, 0x04, 0xE6, 0xB2,
+	0xAB, 0x5E, 0x56, 0xBC, 0x99, 0xF1, 0x35, 0xA9, 0xBE, 0x72, 0xDE, 0xAF, 0xAC, 0x0F, 0x0E, 0xF8,
+	0x72, 0x7B, 0xB5, 0x60, 0x2E, 0x5F, 0xF7, 0x56, 0xFD, 0xFF, 0x00, 0x78, 0xC0, 0xE0, 0xF4, 0x23,
+	0x80, 0x0B, 0x73, 0xD7, 0x18, 0xEF, 0x58, 0xE1, 0xF0, 0xD0, 0xC4, 0x55, 0xE5, 0x93, 0x5B, 0x5D,
+	0xF5, 0xD3, 0xF4, 0xED, 0xDD, 0x79, 0xF4, 0xFA, 0x5E, 0x1C, 0xC1, 0xFD, 0x6B, 0x17, 0x1A, 0x6F,
+	0xE1, 0x5A, 0xBF, 0x45, 0xF7, 0x6F, 0xB6, 0x9D, 0xEF, 0xD0, 0xF3, 0x9B, 0x77, 0xF2, 0xF6, 0x83,
+	0xC7, 0xD6, 0xBF, 0xA0, 0x26, 0xAF, 0x65, 0x2D, 0x17, 0x9F, 0xE1, 0x6F, 0xEB, 0xFE, 0x07, 0xD9,
+	0xCB, 0x13, 0xC8, 0x68, 0x43, 0x21, 0x90, 0xF6, 0xDD, 0x83, 0x80, 0x4F, 0x39, 0xAF, 0x2A, 0xA7,
+	0x3A, 0x9D, 0xDD, 0xB9, 0xAC, 0xDA, 0x4D, 0xAB, 0xDE, 0xCF, 0x45, 0xAE, 0xDF, 0xD7, 0x76, 0xF9,
+	0x6A, 0x62, 0x55, 0x45, 0x62, 0xD4, 0x36, 0x65, 0xB7, 0x11, 0x8D, 0xD8, 0xF5, 0x19, 0xEB, 0x5E,
+	0x0D, 0x5A, 0xB3, 0x8F, 0x3D, 0x9A, 0xE6, 0xB5, 0xBE, 0x25, 0xCD, 0x66, 0xD5, 0xEE, 0xEF, 0x6D,
+	0x3F, 0xAD, 0x2C, 0x97, 0x15, 0x4C, 0x3F, 0x3E, 0xA5, 0xE8, 0x2D, 0x8C, 0x4A, 0x71, 0x8E, 0xA3,
+	0x38, 0x3D, 0xAB, 0xE7, 0x6B, 0xCE, 0x4E, 0x94, 0xD4, 0x5A, 0xD5, 0xAB, 0xD9, 0xAD, 0x95, 0xF7,
+	0xD7, 0xF5, 0xBD, 0xBA, 0xB7, 0xA9, 0x84, 0xA9, 0xFB, 0x36, 0x68, 0x43, 0x36, 0xD4, 0x03, 0x23,
+	0xAF, 0x63, 0x5E, 0x0D, 0x78, 0xBF, 0x66, 0xB6, 0xDD, 0xBD, 0x1A, 0xF2, 0xF9, 0x7F, 0x5F, 0x23,
+	0x29, 0x63, 0x39, 0x74, 0x34, 0x21, 0x1E, 0x6E, 0x07, 0xE9, 0x5E, 0x7C, 0xD5, 0xAC, 0x9F, 0xDC,
+	0x71, 0xD5, 0xAB, 0xED, 0x0D, 0x2B, 0x6B, 0x1C, 0x90, 0x76, 0x92, 0xDE, 0xC3, 0x9A, 0x88, 0x55,
+	0x77, 0xD1, 0x37, 0x2E, 0xC9, 0x3B, 0xDF, 0xB7, 0xF5, 0xFF, 0x00, 0x05, 0x79, 0xD5, 0x70, 0xD7,
+	0xD4, 0xF2, 0xFF, 0x00, 0x1D, 0x6A, 0xE2, 0xFF, 0x00, 0x5D, 0x6B, 0x48, 0x49, 0x36, 0xF6, 0x00,
+	0xC4, 0x30, 0xBD, 0x64, 0x3F, 0xEB, 0x09, 0xE0, 0x1E, 0xA0, 0x2F, 0x71, 0xF2, 0xE4, 0x75, 0xAF,
+	0xB5, 0xC8, 0xF0, 0xCA, 0x96, 0x5E, 0xE7, 0x04, 0xDC, 0xA4, 0xAE, 0xEC, 0x9E, 0xCD, 0x75, 0x7B,
+	0x69, 0xAB, 0xFF, 0x00, 0x2B, 0x3B, 0xFD, 0xBE, 0x43, 0x83, 0xFA, 0x96, 0x1B, 0xDA, 0x4B, 0xE2,
+	0x9E, 0xBF, 0x2E, 0x9D, 0x7E, 0x7F, 0x3B, 0x3D, 0x8C, 0xD9, 0x0E, 0xC9, 0xB9, 0x60, 0x39, 0xE8,
+	0x39, 0xFA, 0x57, 0xE9, 0x52, 0x94, 0x55, 0x6F, 0x7E, 0x4B, 0x75, 0xB5, 0xDF, 0x5F, 0x76, 0xFA,
+	0x69, 0xFD, 0x5B, 0xAD, 0xFC, 0xDC, 0x7D, 0x67, 0x16, 0xEC, 0x5D, 0xD3, 0x8E, 0xE9, 0x00, 0xDC,
+	0x37, 0x73, 0xEB, 0xD7, 0x15, 0xF3, 0xD5, 0xE4, 0xA3, 0x26, 0xB9, 0xD7, 0x35, 0xA5, 0xB5, 0xDA,
+	0xE6, 0xB3, 0xBB, 0xBD, 0xB4, 0xD3, 0xFA, 0xB5, 0x92, 0xE7, 0xC3, 0xD6, 0x72, 0x67, 0x57, 0x61,
+	0x6E, 0xAD, 0x19, 0xE4, 0x74, 0xF7, 0xC7, 0x5E, 0x79, 0xAF, 0x8D, 0xC4, 0x55, 0x8F, 0x2C, 0xE3,
+	0x19, 0xAD, 0xBC, 0xED, 0x6B, 0xAB, 0xEB, 0x6F, 0xEB, 0xD6, 0xED, 0xFD, 0x35, 0x1A, 0x7C, 0xD1,
+	0x4E, 0xC4, 0xF3, 0x42, 0x16, 0x33, 0x82, 0x3B, 0x57, 0x8E, 0xE6, 0xA5, 0x06, 0xB9, 0xAF, 0xAA,
+	0xEF, 0xB6, 0xB6, 0xE9, 0xE7, 0xDA, 0xDF, 0x2D, 0x0F, 0x33, 0x31, 0x8F, 0x2A, 0x29, 0xAB, 0x10,
+	0xE0, 0x54, 0xB5, 0x78, 0xF7, 0xFE, 0xBF, 0xE0, 0x1F, 0x11, 0x89, 0xC4, 0x35, 0x23, 0xA1, 0xD2,
+	0x50, 0xB9, 0x00, 0x8C, 0xFA, 0x8E, 0xD5, 0xC9, 0x38, 0xB5, 0x74, 0xE3, 0x7E, 0xFB, 0x5A, 0xDD,
+	0x35, 0xBF, 0xF5, 0xEB, 0x66, 0xB7, 0xC2, 0x54, 0xE7, 0x66, 0xB7, 0x88, 0x35, 0x13, 0xA0, 0xF8,
+	0x66, 0x7B, 0xA4, 0x07, 0xED, 0x4E, 0x7C, 0xA8, 0x3A, 0x7F, 0xAD, 0x39, 0xC1, 0xE8, 0x47, 0x00,
+	0x16, 0xC1, 0xE0, 0xED, 0xC7, 0x7A, 0xE8, 0xC9, 0xF0, 0xB5, 0x31, 0x58, 0x85, 0x4B, 0x91, 0xBB,
+	0x37, 0x7D, 0x92, 0xBA, 0x7D, 0xEE, 0xAF, 0xDB, 0x4F, 0x96, 0x97, 0xBF, 0xD5, 0xE5, 0x99, 0x72,
+	0xC6, 0x62, 0x23, 0x07, 0xF0, 0xAD, 0x5F, 0xA2, 0xFF, 0x00, 0x3D, 0xB4, 0xDA, 0xF7, 0x3C, 0x26,
+	0x58, 0x8A, 0xC3, 0xF2, 0xA9, 0xFB, 0xBD, 0xF8, 0xFA, 0xD7, 0xE9, 0xD8, 0x65, 0x29, 0x61, 0x52,
+	0x84, 0x1F, 0xC3, 0xD6, 0xCB, 0xA7, 0xBD, 0x6D, 0x6E, 0xFE, 0xEF, 0x5B, 0xE9, 0x6F, 0xA2, 0xCD,
+	0x25, 0xC9, 0x26, 0x5F, 0x9A, 0x20, 0x6E, 0x3A, 0x92, 0x77, 0x76, 0x15, 0xD5, 0x53, 0x11, 0x4A,
+	0x18, 0x9D, 0x64, 0xDB, 0x52, 0xE8, 0xAD, 0xBB, 0xD2, 0xFA, 0xEB, 0x6D, 0x36, 0x5D, 0xAF, 0xF6,
+	0x4F, 0x92, 0xC7, 0xC5, 0xC8, 0xB7, 0xA6, 0x44, 0x15, 0xC7, 0x27, 0xA1, 0x19, 0xC7, 0x15, 0xF3,
+	0x35, 0xEB, 0x52, 0xBB, 0x8A, 0x9B, 0x7A, 0x35, 0x7B, 0x59, 0x6C, 0xF5, 0xDF, 0xD7, 0xCA, 0xF7,
+	0xEA, 0xD9, 0x86, 0x1A, 0x2D, 0x48, 0xEC, 0x74, 0xF2, 0xA2, 0x3E, 0xA7, 0xA7, 0xA5, 0x7C, 0x95,
+	0x79, 0xC1, 0xA9, 0x59, 0xBD, 0x7C, 0xB4, 0xDD, 0x74, 0xBB, 0xF2, 0xF9, 0x79, 0x58, 0xFA, 0xAA,
+	0x15, 0x6D, 0x12, 0xCC, 0xCA, 0x19, 0x70, 0x2B, 0x8A, 0x1D, 0x91, 0xE4, 0xE6, 0x75, 0x39, 0x93,
+	0x29, 0xA5, 0xB3, 0x19, 0x78, 0x19, 0xEF, 0x5D, 0x94, 0xB9, 0xAF, 0x64, 0xAF, 0xD7, 0xB5, 0xBA,
+	0x59, 0xF5, 0xDF, 0xE7, 0x7D, 0xB5, 0x3E, 0x0B, 0x17, 0x16, 0xE4, 0x74, 0xBA, 0x34, 0x2C, 0xAD,
+	0xD0, 0x1C, 0x1C, 0xE7, 0x3C, 0x74, 0xA4, 0xA1, 0x53, 0xDE, 0xB2, 0x4E, 0xCE, 0xF7, 0xBF, 0xBB,
+	0xAA, 0x56, 0x56, 0xB7, 0x45, 0xF8, 0x5E, 0xFA, 0x5C, 0xDF, 0x06, 0xF9, 0x5A, 0xB9, 0xC7, 0x78,
+	0xDB, 0x5A, 0x3A, 0xA6, 0xB8, 0x6C, 0xE2, 0xDB, 0xF6, 0x7B, 0x02, 0xD0, 0x82, 0x7A, 0x19, 0x33,
+	0xF3, 0x9E, 0x99, 0xEA, 0x02, 0xF7, 0x1F, 0x2E, 0x47, 0x5A, 0xFB, 0x3E, 0x1D, 0xCB, 0xAB, 0x50,
+	0xC2, 0xDD, 0xC5, 0x73, 0x49, 0xBD, 0x5B, 0x76, 0xDF, 0x46, 0x95, 0x9F, 0xDF, 0xE6, 0xAF, 0xAA,
+	0x56, 0xFD, 0x77, 0x21, 0xA3, 0x1C, 0x3E, 0x0F, 0xDA, 0x4B, 0xE2, 0x9D, 0x9F, 0xCB, 0xA7, 0x5F,
+	0x9F, 0xCE, 0xDD, 0x0E, 0x4A, 0x68, 0x8B, 0xC3, 0xC2, 0x81, 0xF2, 0xF7, 0x35, 0xF5, 0x58, 0x68,
+	0x54, 0xFA, 0xAA, 0x5C, 0xA9, 0x7B, 0xBD, 0x5F, 0x65, 0xD3, 0x4D, 0x2F, 0xAF, 0x5E, 0xF6, 0xEA,
+	0x79, 0xF9, 0xB4, 0xD4, 0x9B, 0x34, 0x52, 0xDD, 0x5E, 0x6C, 0xED, 0x27, 0xE6, 0xEE, 0x6B, 0xE5,
+	0x71, 0x38, 0xBA, 0x70, 0xC5, 0x68, 0x9B, 0x6A, 0x5D, 0x5F, 0x77, 0xD3, 0x4D, 0x6C, 0xEF, 0xBB,
+	0xEF, 0x6E, 0xA7, 0x9B, 0x52, 0x83, 0xA8, 0xAE, 0x5D, 0xB7, 0xB6, 0x58, 0xCE, 0x76, 0x9E, 0x9D,
+	0xCD, 0x7C, 0xEC, 0xF1, 0x14, 0xDB, 0x76, 0x4F, 0x66, 0xB5, 0x7E, 0x5E, 0x9D, 0xBF, 0xAD, 0x8E,
+	0x79, 0x51, 0x70, 0xD4, 0xD4, 0xB7, 0x97, 0x67, 0x1F, 0xD6, 0xBC, 0xC9, 0xC5, 0x3B, 0xE9, 0xBF,
+	0xF5, 0xE4, 0x65, 0x2C, 0x5F, 0x26, 0x86, 0xA4, 0x19, 0x94, 0x81, 0xEB, 0xEB, 0x50, 0xA9, 0x49,
+	0x49, 0x2E, 0xFD, 0xEF, 0xA5, 0xBA, 0xAB, 0x6B, 0xBF, 0xCE, 0xFA, 0x6E, 0x70, 0xD6, 0xC4, 0x7B,
+	0x44, 0x69, 0xDB, 0x58, 0x33, 0x3E, 0x70, 0x3A, 0x03, 0xC8, 0xAE, 0x8A, 0x51, 0xA9, 0xED, 0x1A,
+	0xBA, 0xD9, 0x3D, 0x56, 0xDB, 0xD9, 0x25, 0x7B, 0x34, 0xD7, 0xCA, 0xDE, 0x47, 0x97, 0x57, 0x0E,
+	0xA5, 0xA8, 0xDF, 0x10, 0xEA, 0x4D, 0xE1, 0xBF, 0x0F, 0xDC, 0xDD, 0xA3, 0x01, 0x70, 0xC7, 0xCA,
+	0x80, 0x95, 0xE7, 0xCC, 0x61, 0xD7, 0xA1, 0x1C, 0x00, 0x5B, 0x9E, 0xB8, 0xC7, 0x7A, 0xF6, 0xF2,
+	0x6C, 0x05, 0x6C, 0x56, 0x2D, 0xC2, 0xE9, 0xA4, 0xEE, 0xDB, 0x4F, 0x9B, 0x68, 0xDD, 0x5B, 0x99,
+	0x75, 0xB2, 0xEE, 0x9D, 0x9A, 0xD6, 0xC8, 0xD7, 0x2D, 0xC1, 0x2C, 0x46, 0x2A, 0x34, 0xDA, 0xF7,
+	0x56, 0xAF, 0xD1, 0x7F, 0x9E, 0xDA, 0x77, 0xB9, 0xE4, 0x16, 0x92, 0x32, 0xAE, 0xDD, 0xC3, 0xA9,
+	0x19, 0xC7, 0xBD, 0x7E, 0x8F, 0x86, 0xC2, 0xD4, 0x51, 0xB2, 0x92, 0xDD, 0xAB, 0xDB, 0x5D, 0xDE,
+	0xBB, 0xFA, 0xFE, 0x3E, 0x67, 0xE8, 0x55, 0x71, 0xC9, 0x68, 0x6A, 0x41, 0x19, 0x95, 0x00, 0xE3,
+	0xA7, 0xA5, 0x6B, 0x08, 0xCA, 0x34, 0x52, 0xD3, 0x6F, 0xD3, 0xD7, 0xB7, 0x91, 0xE7, 0x56, 0x9F,
+	0xB5, 0x66, 0xCD, 0x84, 0x41, 0x98, 0x1D, 0xA3, 0xAD, 0x7E, 0x51, 0x8C, 0xC4, 0xA5, 0x88, 0x6E,
+	0x31, 0x5B, 0xBE, 0xFD, 0xF5, 0xEB, 0x65, 0xF7, 0x1D, 0xB8, 0x6A, 0x7C, 0xD0, 0xD4, 0xBE, 0xF0,
+	0x05, 0x5C, 0x85, 0xFA, 0x57, 0x93, 0x1A, 0x97, 0x77, 0x4B, 0xD0, 0xE5, 0xC7, 0xC1, 0x46, 0x25,
+	0x5E, 0x55, 0xC6, 0x0F, 0x7E, 0xB5, 0xD7, 0x0A, 0x5F, 0x0B, 0x4F, 0x7E, 0xBD, 0x2D, 0x67, 0x7D,
+	0x3F, 0xAF, 0xBE, 0xE9, 0x7C, 0x2E, 0x37, 0x10, 0xE3, 0x26, 0x8D, 0xED, 0x2A, 0x32, 0xD2, 0x2F,
+	0x27, 0x91, 0xCE, 0x70, 0x78, 0xAB, 0x9E, 0x19, 0xA9, 0xAF, 0x79, 0xAB, 0xA7, 0x7B, 0xD9, 0xFB,
+	0xBA, 0x5A, 0xCA, 0xD6, 0x5F, 0x97, 0x5B, 0xDB, 0x53, 0x3C, 0x35, 0x6E, 0x76, 0x76, 0xD6, 0x16,
+	0x59, 0xEE, 0x73, 0x80, 0x4E, 0x79, 0xE6, 0x88, 0x50, 0x9C, 0x6B, 0x49, 0x73, 0xB4, 0xEC, 0x9B,
+	0xBD, 0x9B, 0xE6, 0xBB, 0xB6, 0xB6, 0xD3, 0xBE, 0xD7, 0xF2, 0xBD, 0x91, 0xED, 0xA8, 0x27, 0x0B,
+	0xD8, 0xF2, 0x2F, 0x88, 0xFA, 0x9F, 0xF6, 0x8F, 0x88, 0x5E, 0xD2, 0x27, 0x3F, 0x67, 0xB0, 0x26,
+	0x25, 0xE0, 0x64, 0xC9, 0xC7, 0x98, 0x7A, 0x67, 0xA8, 0x0B, 0xDC, 0x7C, 0xB9, 0x1D, 0x6B, 0xF4,
+	0x6E, 0x1A, 0xCB, 0xA5, 0x87, 0xA3, 0x29, 0x73, 0x3B, 0xC9, 0xDF, 0xA5, 0xF6, 0x5D, 0x6C, 0xFB,
+	0xF4, 0xB6, 0xFE, 0x4D, 0x9E, 0xFE, 0x0B, 0x06, 0xB0, 0xB8, 0x4F, 0x68, 0xD7, 0xBD, 0x3D, 0x7E,
+	0x5D, 0x3A, 0xFC, 0xFE, 0x76, 0x7B, 0x1C, 0x6C, 0x04, 0xAB, 0x63, 0x27, 0xAF, 0x15, 0xF5, 0x34,
+	0xE8, 0xB8, 0xC2, 0xDC, 0xCF, 0x77, 0x6D, 0xBB, 0xFA, 0x7D, 0xE7, 0x91, 0x5F, 0x12, 0xF9, 0xCE,
+	0x9B, 0x4A, 0x4D, 0xDB, 0x45, 0x70, 0x56, 0x97, 0x2D, 0xA2, 0xBF, 0xAE, 0xFF, 0x00, 0xD7, 0xFC,
+	0x0B, 0xF7, 0xE0, 0xE5, 0xCF, 0xB9, 0xB3, 0xA7, 0x61, 0x46, 0x4E, 0x2B, 0xF1, 0x7C, 0x5C, 0xDF,
+	0x3B, 0x93, 0x3D, 0x5C, 0x2D, 0x44, 0xA2, 0x69, 0xC8, 0x9B, 0x97, 0x1F, 0xC4, 0x78, 0xF7, 0xCD,
+	0x63, 0x1A, 0x4D, 0x34, 0xBE, 0xD3, 0x69, 0x2E, 0xF7, 0xBF, 0x4F, 0xEB, 0xF5, 0xB7, 0x16, 0x61,
+	0x59, 0x38, 0xB2, 0xA1, 0xB4, 0xCC, 0xAB, 0x8C, 0xE4, 0x9F, 0x5E, 0x6B, 0xD8, 0xA7, 0x87, 0x5C,
+	0xF0, 0x51, 0xBF, 0x33, 0x7D, 0xDF, 0x35, 0x92, 0x77, 0xEB, 0xD7, 0xFA, 0xD3, 0x57, 0xF9, 0xEE,
+	0x3A, 0xEE, 0x4C, 0xE8, 0x34, 0x8B, 0x5D, 0xB2, 0xAF, 0x5E, 0x99, 0x38, 0x27, 0x38, 0xE2, 0xBA,
+	0x5E, 0x16, 0x1E, 0xD9, 0x28, 0xDF, 0x66, 0xDD, 0x9B, 0xBB, 0x57, 0x56, 0x4F, 0xF5, 0xD3, 0xE5,
+	0x7D, 0x16, 0x78, 0x46, 0xE3, 0xB9, 0xBB, 0xAF, 0x6B, 0x0B, 0xE1, 0xFF, 0x00, 0x0E, 0x5C, 0x5D,
+	0x46, 0xC4, 0x5C, 0x38, 0x11, 0x41, 0x82, 0x7F, 0xD6, 0x36, 0x70, 0x7A, 0x11, 0xC0, 0x05, 0xB0,
+	0x78, 0x38, 0xC7, 0x7A, 0xEA, 0xCA, 0xF2, 0x98, 0xE2, 0x31, 0xBE, 0xCD, 0x5E, 0xC9, 0x27, 0x2B,
+	0x37, 0xAE, 0xAF, 0x7D, 0x6F, 0xD9, 0x68, 0xF4, 0xBF, 0x6D, 0x4F, 0xB3, 0xC9, 0xE9, 0x2C, 0x65,
+	0x78, 0xD3, 0x97, 0xC2, 0xB5, 0x7E, 0x8B, 0xEE, 0xDF, 0x6F, 0x9D, 0xCF, 0x0C, 0x9A, 0x30, 0x41,
+	0xC6, 0x7E, 0x99, 0xAF, 0xD2, 0x70, 0xF4, 0xA3, 0x07, 0x2B, 0x5F, 0x7D, 0xAE, 0xFB, 0x2F, 0xEA,
+	0xE7, 0xD4, 0xE6, 0xB5, 0x39, 0x91, 0x56, 0x3B, 0x73, 0xE6, 0x60, 0x7A, 0xD7, 0x4C, 0xA7, 0xCA,
+	0xB9, 0x22, 0xF5, 0xFE, 0xBF, 0xAF, 0xEB, 0x5F, 0x87, 0xAF, 0x06, 0xE7, 0x73, 0xA7, 0xD2, 0x17,
+	0x6B, 0xA8, 0x1E, 0xBD, 0xAB, 0xC4, 0xC4, 0xE2, 0x1B, 0xAB, 0xC9, 0x4F, 0xBF, 0x4F, 0x27, 0xAD,
+	0xFF, 0x00, 0xAF, 0xBF, 0x5B, 0x7A, 0xB8, 0x1F, 0x75, 0x6A, 0x5C, 0xB7, 0x71, 0x12, 0xF5, 0x19,
+	0xC5, 0x7E, 0x4B, 0x51, 0x41, 0x41, 0xB6, 0xD5, 0xED, 0xEB, 0xBF, 0xE5, 0x6F, 0xEA, 0xF7, 0xD0,
+	0x96, 0x27, 0x93, 0x43, 0x5E, 0x12, 0x92, 0x00, 0xB9, 0x5E, 0x48, 0x1E, 0xBF, 0x8E, 0x6B, 0x67,
+	0x43, 0x0F, 0x14, 0xA9, 0xDD, 0x5D, 0xB4, 0xBA, 0x3E, 0xAA, 0xEE, 0xFD, 0x3F, 0xAE, 0xD7, 0x7C,
+	0x15, 0x71, 0x4E, 0xA1, 0xA9, 0x05, 0x8C, 0x72, 0x15, 0xE1, 0x7A, 0xE7, 0xFC, 0x9A, 0xEE, 0x51,
+	0xC2, 0xB9, 0x42, 0x0B, 0x97, 0x7B, 0xF4, 0xE8, 0x9E, 0x9C, 0xDE, 0x6E, 0xDF, 0x9F, 0x5B, 0x2F,
+	0x26, 0xAD, 0x19, 0x4A, 0xEC, 0xDA, 0xB5, 0xB4, 0x8E, 0x36, 0x5E, 0x17, 0x81, 0x9A, 0xED, 0x50,
+	0xC2, 0xCA, 0xA4, 0x52, 0x51, 0xD1, 0x37, 0xD1, 0x76, 0xD3, 0xCE, 0xDA, 0xF5, 0xF2, 0xBF, 0x53,
+	0x86, 0x50, 0x95, 0x33, 0xCC, 0xFC, 0x77, 0xE2, 0x05, 0xD4, 0xBC, 0x44, 0x6D, 0x22, 0x20, 0xDB,
+	0xD8, 0x03, 0x0A, 0xF1, 0xD6, 0x4C, 0xFC, 0xE7, 0xA0, 0xEE, 0x02, 0xF7, 0x1F, 0x2E, 0x47, 0x5A,
+	0xFB, 0x9C, 0x97, 0x2E, 0xA3, 0x46, 0x97, 0xB4, 0xB2, 0xBC, 0x92, 0x7D, 0x36, 0xD6, 0xDE, 0x5F,
+	0x96, 0xE7, 0xDC, 0xE4, 0x57, 0xC2, 0xE1, 0x39, 0xE5, 0xF1, 0x4F, 0x5F, 0x97, 0x4E, 0xBF, 0x3F,
+	0x9D, 0x9E, 0xC6, 0x14, 0x43, 0xCC, 0xE0, 0x0C, 0xD7, 0xA9, 0x35, 0xC9, 0xA4, 0x57, 0xF5, 0xEB,
+	0xFD, 0x7E, 0x8F, 0xBA, 0xAD, 0x5F, 0x6A, 0x5D, 0x8A, 0xC9, 0x89, 0xC0, 0x07, 0xD3, 0xFF, 0x00,
+	0xAF, 0x5C, 0x38, 0x9A, 0xB5, 0x6F, 0xEC, 0xE1, 0x7E, 0xDD, 0x57, 0xCE, 0xFF, 0x00, 0xD7, 0xE3,
+	0x75, 0xE7, 0xCF, 0x0A, 0x9E, 0xA6, 0x94, 0x08, 0xF1, 0xC8, 0x38, 0x60, 0x01, 0xFA, 0x57, 0x8F,
+	0x88, 0xAF, 0x88, 0xAB, 0x88, 0xB2, 0xBF, 0x2D, 0xFC, 0xD2, 0x49, 0x3F, 0xC5, 0x3F, 0xEA, 0xD6,
+	0xF7, 0xB1, 0xD2, 0x92, 0x3F, 0xFF, 0xD9
+};
+
+
+
+candle_bench("Core.Image", "JPEG Decode Baseline") {
+
+	candle_bytes(BaselineJPEG.size());
+
+	candle_measure(
+		JPEGDecoder decoder(Pixel::RGB8);
+		decoder.decode(BaselineJPEG);
+		candle_do_not_optimize(decoder.getImage());
+	);
+
+}
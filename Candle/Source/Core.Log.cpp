@@ -0,0 +1,142 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 Core.Log.cpp
+ */
+
+#include "Candle/Core.hpp"
+#include "Util/Log.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+
+
+namespace {
+
+	//Captures console output, the writer thread and synchronous fallbacks write concurrently
+	//xsputn() may call overflow() internally, hence the recursive mutex
+	class CaptureBuffer : public std::stringbuf {
+
+	public:
+
+		std::string take() {
+
+			std::lock_guard lock(mutex);
+			return str();
+
+		}
+
+	protected:
+
+		std::streamsize xsputn(const char* s, std::streamsize n) override {
+
+			std::lock_guard lock(mutex);
+			return std::stringbuf::xsputn(s, n);
+
+		}
+
+		int_type overflow(int_type c) override {
+
+			std::lock_guard lock(mutex);
+			return std::stringbuf::overflow(c);
+
+		}
+
+	private:
+
+		std::recursive_mutex mutex;
+
+	};
+
+}
+
+
+
+candle_test("Core.Log", "Records Submitted During Shutdown") {
+
+	constexpr u32 Producers = 4;
+	constexpr u32 Records = 20000;
+	constexpr std::string_view Marker = "shutdown-record ";
+
+	CaptureBuffer capture;
+	std::streambuf* console = std::cout.rdbuf(&capture);
+
+	//Small rings make producers block on the writer, widening the window around stopAsync()
+	Log::AsyncConfig config;
+	config.threadBufferSize = 4096;
+	config.backpressure = Log::Backpressure::Block;
+
+	Log::startAsync(config);
+
+	std::atomic<u32> submitted = 0;
+	std::vector<std::thread> producers;
+
+	for (u32 p = 0; p < Producers; p++) {
+
+		producers.emplace_back([&, p]() {
+
+			for (u32 i = 0; i < Records; i++) {
+
+				LogI("Candle") << Marker << p * Records + i << ';';
+				submitted.fetch_add(1, std::memory_order_relaxed);
+
+			}
+
+		});
+
+	}
+
+	//Stop while every producer is still logging
+	while (submitted.load(std::memory_order_relaxed) < Producers * Records / 4) {
+		std::this_thread::yield();
+	}
+
+	Log::stopAsync();
+
+	for (std::thread& producer : producers) {
+		producer.join();
+	}
+
+	std::cout.rdbuf(console);
+
+	std::string output = capture.take();
+	std::vector<u32> counts(Producers * Records);
+	std::string other;
+
+	std::istringstream lines(output);
+
+	for (std::string line; std::getline(lines, line);) {
+
+		SizeT start = line.find(Marker);
+
+		if (start == std::string::npos) {
+
+			//Forward output of concurrently running tests
+			other += line + '\n';
+			continue;
+
+		}
+
+		u32 id = std::stoul(line.substr(start + Marker.size()));
+
+		if (id < counts.size()) {
+			counts[id]++;
+		}
+
+	}
+
+	std::cout << other << std::flush;
+
+	SizeT written = std::count(counts.begin(), counts.end(), 1);
+
+	candle_equal(written, counts.size());
+	candle_condition(!Log::isAsync());
+
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 Core.Math.cpp
+ */
+
+#include "Candle/Benchmark.hpp"
+#include "Math/Matrix.hpp"
+
+
+
+candle_bench("Core.Math", "Mat4 Multiply") {
+
+	Mat4f a = Mat4f::fromRotation(Vec3f(0, 1, 0), 0.5f);
+	Mat4f b = Mat4f::fromTranslation(Vec3f(1, 2, 3));
+
+	candle_measure(
+		candle_do_not_optimize(a);
+		candle_do_not_optimize(b);
+		candle_do_not_optimize(a * b);
+	);
+
+}
+
+
+candle_bench("Core.Math", "Mat4 Inverse") {
+
+	Mat4f a = Mat4f::fromRotation(Vec3f(0, 1, 0), 0.5f) * Mat4f::fromTranslation(Vec3f(1, 2, 3));
+
+	candle_measure(
+		candle_do_not_optimize(a);
+		candle_do_not_optimize(a.inverse());
+	);
+
+}
\ No newline at end of file
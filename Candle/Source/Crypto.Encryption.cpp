@@ -0,0 +1,287 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 Crypto.Encryption.cpp
+ */
+
+#include "Candle/Core.hpp"
+#include "Crypto/Encryption/AES.hpp"
+#include "Crypto/Encryption/DES.hpp"
+#include "Common/Intrinsic.hpp"
+
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+
+
+namespace {
+
+	std::vector<u8> fromHex(std::string_view hex) {
+
+		auto nibble = [](char c) -> u8 {
+			return c <= '9' ? c - '0' : c - 'a' + 10;
+		};
+
+		std::vector<u8> bytes(hex.size() / 2);
+
+		for (SizeT i = 0; i < bytes.size(); i++) {
+			bytes[i] = nibble(hex[i * 2]) << 4 | nibble(hex[i * 2 + 1]);
+		}
+
+		return bytes;
+
+	}
+
+	template<SizeT Size>
+	CryptoKey<Size> keyFromHex(std::string_view hex) {
+
+		std::vector<u8> bytes = fromHex(hex);
+		std::array<u8, Size / 8> array;
+
+		std::copy_n(bytes.begin(), array.size(), array.begin());
+
+		return std::apply([](auto... b) { return CryptoKey<Size>(b...); }, array);
+
+	}
+
+	std::mutex pathMutex;
+
+	/*
+		Runs the accelerated path first, then again with AES-NI and PCLMULQDQ masked to force the portable implementation.
+		Tests execute in parallel, so masking is serialized to keep each pass on the intended path.
+	*/
+	template<class F>
+	void forEachPath(F&& f) {
+
+		std::lock_guard lock(pathMutex);
+
+		f();
+
+		CPU::disable(CPU::X86::AESNI);
+		CPU::disable(CPU::X86::PCLMULQDQ);
+
+		f();
+
+		CPU::enable(CPU::X86::AESNI);
+		CPU::enable(CPU::X86::PCLMULQDQ);
+
+	}
+
+
+	// NIST SP 800-38A F.5 plaintext and initial counter
+	constexpr std::string_view CTRPlaintext =	"6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+												"30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710";
+
+	constexpr std::string_view CTRCounter = "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+	// GCM specification test cases 3 to 18 plaintext and additional data
+	constexpr std::string_view GCMPlaintext =	"d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+												"1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39";
+
+	constexpr std::string_view GCMData = "feedfacedeadbeeffeedfacedeadbeefabaddad2";
+
+
+	template<SizeT KeySize>
+	void testBlock(Candle::TestContext& candle, std::string_view key, std::string_view plaintext, std::string_view ciphertext) {
+
+		AES::Cipher<KeySize> cipher(keyFromHex<KeySize>(key));
+
+		std::vector<u8> input = fromHex(plaintext);
+		std::vector<u8> output(input.size());
+
+		cipher.encryptBlocks(input, output);
+		candle_equal(output, fromHex(ciphertext));
+
+		cipher.decryptBlocks(output, output);
+		candle_equal(output, input);
+
+	}
+
+	template<SizeT KeySize>
+	void testCTR(Candle::TestContext& candle, std::string_view key, std::string_view ciphertext) {
+
+		AES::Cipher<KeySize> cipher(keyFromHex<KeySize>(key));
+
+		std::vector<u8> counter = fromHex(CTRCounter);
+		std::vector<u8> input = fromHex(CTRPlaintext);
+		std::vector<u8> output(input.size());
+
+		auto next = cipher.ctr(std::span<const u8, 16>(counter.data(), 16), input, output);
+		candle_equal(output, fromHex(ciphertext));
+
+		// The returned counter continues the stream where the first block ended
+		std::vector<u8> split(input.size());
+
+		auto middle = cipher.ctr(std::span<const u8, 16>(counter.data(), 16), std::span(input).first(16), split);
+		cipher.ctr(middle, std::span(input).subspan(16), std::span(split).subspan(16));
+
+		candle_equal(split, output);
+		candle_equal(std::vector<u8>(next.begin(), next.end()), fromHex("f0f1f2f3f4f5f6f7f8f9fafbfcfdff03"));
+
+	}
+
+	template<SizeT KeySize>
+	void testGCM(Candle::TestContext& candle, std::string_view key, std::string_view iv, std::string_view aad, std::string_view plaintext, std::string_view ciphertext, std::string_view tag) {
+
+		AES::GCM<KeySize> gcm(keyFromHex<KeySize>(key));
+
+		std::vector<u8> ivBytes = fromHex(iv);
+		std::vector<u8> aadBytes = fromHex(aad);
+		std::vector<u8> input = fromHex(plaintext);
+		std::vector<u8> output(input.size());
+
+		auto result = gcm.encrypt(ivBytes, aadBytes, input, output);
+
+		candle_equal(output, fromHex(ciphertext));
+		candle_equal(std::vector<u8>(result.begin(), result.end()), fromHex(tag));
+
+		std::vector<u8> decrypted(output.size());
+
+		candle_condition(gcm.decrypt(ivBytes, aadBytes, output, result, decrypted));
+		candle_equal(decrypted, input);
+
+		// A modified tag must be rejected and leave no plaintext behind
+		result[0] ^= 1;
+
+		candle_condition(!gcm.decrypt(ivBytes, aadBytes, output, result, decrypted));
+		candle_equal(decrypted, std::vector<u8>(input.size(), 0));
+
+	}
+
+}
+
+
+
+candle_test("Crypto.Encryption", "AES Block") {
+
+	// FIPS-197 Appendix C
+	forEachPath([&]() {
+
+		testBlock<128>(candle, "000102030405060708090a0b0c0d0e0f", "00112233445566778899aabbccddeeff", "69c4e0d86a7b0430d8cdb78070b4c55a");
+		testBlock<192>(candle, "000102030405060708090a0b0c0d0e0f1011121314151617", "00112233445566778899aabbccddeeff", "dda97ca4864cdfe06eaf70a0ec0d7191");
+		testBlock<256>(candle, "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f", "00112233445566778899aabbccddeeff", "8ea2b7ca516745bfeafc49904b496089");
+
+	});
+
+}
+
+
+candle_test("Crypto.Encryption", "AES CTR") {
+
+	// NIST SP 800-38A F.5.1, F.5.3 and F.5.5
+	forEachPath([&]() {
+
+		testCTR<128>(candle, "2b7e151628aed2a6abf7158809cf4f3c",
+			"874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee");
+
+		testCTR<192>(candle, "8e73b0f7da0e6452c810f32b809079e562f8ead2522c6b7b",
+			"1abc932417521ca24f2b0459fe7e6e0b090339ec0aa6faefd5ccc2c6f4ce8e941e36b26bd1ebc670d1bd1d665620abf74f78a7f6d29809585a97daec58c6b050");
+
+		testCTR<256>(candle, "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4",
+			"601ec313775789a5b7a7f504bbf3d228f443e3ca4d62b59aca84e990cacaf5c52b0930daa23de94ce87017ba2d84988ddfc9c58db67aada613c2dd08457941a6");
+
+	});
+
+}
+
+
+candle_test("Crypto.Encryption", "AES GCM") {
+
+	// NIST SP 800-38D reference test cases from the GCM specification
+	forEachPath([&]() {
+
+		testGCM<128>(candle, "00000000000000000000000000000000", "000000000000000000000000", "", "", "", "58e2fccefa7e3061367f1d57a4e7455a");
+
+		testGCM<128>(candle, "00000000000000000000000000000000", "000000000000000000000000", "", "00000000000000000000000000000000",
+			"0388dace60b6a392f328c2b971b2fe78", "ab6e47d42cec13bdf53a67b21257bddf");
+
+		testGCM<128>(candle, "feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888", GCMData, GCMPlaintext,
+			"42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091",
+			"5bc94fbc3221a5db94fae95ae7121a47");
+
+		// Non-96-bit IVs are hashed into the initial counter
+		testGCM<128>(candle, "feffe9928665731c6d6a8f9467308308", "cafebabefacedbad", GCMData, GCMPlaintext,
+			"61353b4c2806934a777ff51fa22a4755699b2a714fcdc6f83766e5f97b6c742373806900e49f24b22b097544d4896b424989b5e1ebac0f07c23f4598",
+			"3612d2e79e3b0785561be14aaca2fccb");
+
+		testGCM<128>(candle, "feffe9928665731c6d6a8f9467308308",
+			"9313225df88406e555909c5aff5269aa6a7a9538534f7da1e4c303d2a318a728c3c0c95156809539fcf0e2429a6b525416aedbf5a0de6a57a637b39b",
+			GCMData, GCMPlaintext,
+			"8ce24998625615b603a033aca13fb894be9112a5c3a211a8ba262a3cca7e2ca701e4a9a4fba43c90ccdcb281d48c7c6fd62875d2aca417034c34aee5",
+			"619cc5aefffe0bfa462af43c1699d050");
+
+		testGCM<192>(candle, "feffe9928665731c6d6a8f9467308308feffe9928665731c", "cafebabefacedbaddecaf888", GCMData, GCMPlaintext,
+			"3980ca0b3c00e841eb06fac4872a2757859e1ceaa6efd984628593b40ca1e19c7d773d00c144c525ac619d18c84a3f4718e2448b2fe324d9ccda2710",
+			"2519498e80f1478f37ba55bd6d27618c");
+
+		testGCM<256>(candle, "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888", GCMData, GCMPlaintext,
+			"522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662",
+			"76fc6ece0f4e1768cddf8853bb2d551b");
+
+	});
+
+}
+
+
+candle_test("Crypto.Encryption", "AES Path Agreement") {
+
+	// Inputs spanning several GCM chunks and unaligned tails must produce identical results on both paths
+	AES::GCM256 gcm(keyFromHex<256>("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"));
+	AES::Cipher256 cipher(keyFromHex<256>("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"));
+
+	std::vector<u8> iv = fromHex("cafebabefacedbaddecaf888");
+	std::vector<u8> aad = fromHex(GCMData);
+	std::vector<u8> counter = fromHex("00000000000000000000fffffffffffe");
+	std::vector<u8> input(3 * 4096 + 37);
+
+	for (SizeT i = 0; i < input.size(); i++) {
+		input[i] = u8(i * 131 + (i >> 8));
+	}
+
+	std::vector<std::vector<u8>> results;
+
+	forEachPath([&]() {
+
+		std::vector<u8> sealed(input.size());
+		std::vector<u8> stream(input.size());
+
+		auto tag = gcm.encrypt(iv, aad, input, sealed);
+		cipher.ctr(std::span<const u8, 16>(counter.data(), 16), input, stream);
+
+		sealed.insert(sealed.end(), tag.begin(), tag.end());
+
+		results.push_back(std::move(sealed));
+		results.push_back(std::move(stream));
+
+	});
+
+	candle_equal(results.size(), 4);
+	candle_equal(results[0], results[2]);
+	candle_equal(results[1], results[3]);
+
+}
+
+
+candle_test("Crypto.Encryption", "DES") {
+
+	auto input = fromHex("0123456789abcdef");
+	auto output = DES::encrypt(std::span<const u8>(input), keyFromHex<64>("133457799bbcdff1"));
+
+	candle_equal(output, fromHex("85e813540f0ab405"));
+	candle_equal(DES::decrypt(std::span<const u8>(output), keyFromHex<64>("133457799bbcdff1")), input);
+
+	// NIST SP 800-67 TDEA example
+	auto key1 = keyFromHex<64>("0123456789abcdef");
+	auto key2 = keyFromHex<64>("23456789abcdef01");
+	auto key3 = keyFromHex<64>("456789abcdef0123");
+
+	auto text = fromHex("54686520717566636b2062726f776e20666f78206a756d70");
+	auto encrypted = TripleDES::encrypt(std::span<const u8>(text), key1, key2, key3);
+
+	candle_equal(encrypted, fromHex("a826fd8ce53b855fcce21c8112256fe668d5c05dd9b6b900"));
+	candle_equal(TripleDES::decrypt(std::span<const u8>(encrypted), key1, key2, key3), text);
+
+}
\ No newline at end of file
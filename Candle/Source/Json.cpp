@@ -0,0 +1,60 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 Json.cpp
+ */
+
+#include "Candle/Benchmark.hpp"
+#include "Json/Json.hpp"
+
+
+
+//Array of 256 small records with strings, integers, floats, booleans and a nested array
+static std::string createDocument() {
+
+	JsonArray entities;
+
+	for (u32 i = 0; i < 256; i++) {
+
+		JsonObject entity;
+		entity.insert("name", JsonValue("entity_" + std::to_string(i)));
+		entity.insert("id", JsonValue(i64(i)));
+		entity.insert("health", JsonValue(100.0 - i * 0.25));
+		entity.insert("active", JsonValue(i % 3 != 0));
+		entity.insert("position", JsonValue(JsonArray({i * 1.5, i * -0.5, 8.0})));
+
+		entities.append(entity);
+
+	}
+
+	return JsonDocument(entities).write();
+
+}
+
+
+
+candle_bench("Json.Document", "Read") {
+
+	std::string json = createDocument();
+
+	candle_bytes(json.size());
+
+	candle_measure(
+		JsonDocument document(json);
+		candle_do_not_optimize(document);
+	);
+
+}
+
+
+candle_bench("Json.Document", "Write") {
+
+	JsonDocument document(createDocument());
+
+	candle_measure(
+		candle_do_not_optimize(document.write());
+	);
+
+}
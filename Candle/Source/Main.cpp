@@ -6,15 +6,19 @@
  *	 Main.cpp
  */
 
+#include "Common/Intrinsic.hpp"
 #include "Util/ArgumentParser.hpp"
 #include "Util/Log.hpp"
 #include "Candle/Core.hpp"
+#include "Candle/Benchmark.hpp"
+
+#include <stdexcept>
 
 
 
 int main(int argc, char* argv[]) {
 
-	constexpr const char* Layout = "<-h | --help> | {[-m | --module string] & [-v | --verbose] & [-s | --strict]}";
+	constexpr const char* Layout = "<-h | --help> | {[-m | --module string] & [-v | --verbose] & [-s | --strict] & [-b | --bench] & [-o | --output string] & [-c | --compare string] & [-t | --threshold double] & [-j | --jobs uint] & [-x | --shard string]}";
 
 	constexpr const char* Usage = "test";
 
@@ -74,20 +78,73 @@ int main(int argc, char* argv[]) {
 #endif
 	;
 
+	CPU::init();
+
+
 	LogI("Main") << "Arclight Candle - Build " ARC_PP_TIME " " ARC_PP_DATE;
 	LogI("Main") << "Compiled with " << Compiler << " for " << System << " (" << Architecture << ")\n";
 
 
-	Candle::ExecutionFlags flags{};
+	if (parser.getFlag("--bench")) {
+
+		Candle::BenchmarkOptions options;
+		options.outputPath = parser.getString("--output", "");
+		options.baselinePath = parser.getString("--compare", "");
+
+		//--threshold is given in percent, e.g. -t 5 fails benchmarks that are more than 5% slower
+		options.threshold = parser.getDouble("--threshold", options.threshold * 100) / 100;
+
+		return !Candle::benchmark(parser.getString("--module", ""), options);
+
+	}
+
+
+	Candle::ExecutionOptions options;
 
 	if (parser.getFlag("--verbose")) {
-		flags |= Candle::Verbose;
+		options.flags |= Candle::Verbose;
 	}
 
 	if (parser.getFlag("--strict")) {
-		flags |= Candle::Strict;
+		options.flags |= Candle::Strict;
+	}
+
+	options.jobs = parser.getUInt("--jobs", 0);
+
+
+	// Shards are passed as index/count with a one-based index, e.g. 2/4
+
+	std::string shard = parser.getString("--shard", "");
+
+	if (!shard.empty()) {
+
+		SizeT pos = shard.find('/');
+
+		try {
+
+			if (pos == std::string::npos) {
+				throw std::invalid_argument("Missing separator");
+			}
+
+			u32 index = std::stoul(shard.substr(0, pos));
+			u32 count = std::stoul(shard.substr(pos + 1));
+
+			if (!index || index > count) {
+				throw std::out_of_range("Shard index out of range");
+			}
+
+			options.shardIndex = index - 1;
+			options.shardCount = count;
+
+		} catch (const std::exception&) {
+
+			LogE("Main") << "Invalid shard '" << shard << "', expected index/count";
+			return 1;
+
+		}
+
 	}
 
-	return !Candle::execute(parser.getString("--module", ""), flags);
+	return !Candle::execute(parser.getString("--module", ""), options);
 
 }
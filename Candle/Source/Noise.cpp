@@ -0,0 +1,38 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 Noise.cpp
+ */
+
+#include "Candle/Benchmark.hpp"
+#include "Noise/Perlin.hpp"
+#include "Math/Vector.hpp"
+
+
+
+candle_bench("Noise.Perlin", "Sample 2D") {
+
+	PerlinNoise noise;
+	Vec2f point(0.5f, 0.25f);
+
+	candle_measure(
+		candle_do_not_optimize(noise.sample(point, 1.0f));
+		point.x += 0.01f;
+	);
+
+}
+
+
+candle_bench("Noise.Perlin", "Sample 2D Fractal") {
+
+	PerlinNoise noise;
+	Vec2f point(0.5f, 0.25f);
+
+	candle_measure(
+		candle_do_not_optimize(noise.sample(point, 1.0f, 8, 2.0f, 0.5f));
+		point.x += 0.01f;
+	);
+
+}
\ No newline at end of file
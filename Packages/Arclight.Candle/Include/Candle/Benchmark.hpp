@@ -0,0 +1,223 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 Benchmark.hpp
+ */
+
+#pragma once
+
+#include "Core.hpp"
+#include "Common/Build.hpp"
+#include "Common/Types.hpp"
+
+#include <type_traits>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#ifdef ARC_COMPILER_MSVC
+	#include <intrin.h>
+#endif
+
+
+
+namespace Candle::Detail {
+
+	void useCharPointer(const volatile char* pointer) noexcept;
+
+}
+
+
+namespace Candle {
+
+	//Forces the compiler to materialize value
+	template<class T>
+	inline void doNotOptimize(const T& value) noexcept {
+
+#ifdef ARC_COMPILER_GCCLIKE
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		Detail::useCharPointer(&reinterpret_cast<const volatile char&>(value));
+		_ReadWriteBarrier();
+#endif
+
+	}
+
+	//Forces the compiler to materialize value and assume it has been modified
+	template<class T>
+	inline void doNotOptimize(T& value) noexcept {
+
+#if defined(ARC_COMPILER_CLANG)
+		asm volatile("" : "+r,m"(value) : : "memory");
+#elif defined(ARC_COMPILER_GCC)
+		if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void*)) {
+			asm volatile("" : "+m,r"(value) : : "memory");
+		} else {
+			asm volatile("" : "+m"(value) : : "memory");
+		}
+#else
+		Detail::useCharPointer(&reinterpret_cast<const volatile char&>(value));
+		_ReadWriteBarrier();
+#endif
+
+	}
+
+	//Forces all pending memory writes to be performed
+	inline void clobberMemory() noexcept {
+
+#ifdef ARC_COMPILER_GCCLIKE
+		asm volatile("" : : : "memory");
+#else
+		_ReadWriteBarrier();
+#endif
+
+	}
+
+
+	struct BenchmarkConfig {
+
+		double warmupTime = 0.05;			//Minimum warm-up time in seconds, also used for iteration calibration
+		double sampleTime = 0.01;			//Target duration of a single sample in seconds
+		u32 samples = 30;
+		double outlierThreshold = 3.5;		//Samples with a modified z-score above the threshold are rejected
+
+	};
+
+
+	struct BenchmarkResult {
+
+		std::string module;
+		std::string name;
+
+		//Nanoseconds per iteration
+		double median = 0;
+		double mad = 0;						//Median absolute deviation
+		double mean = 0;
+		double min = 0;
+		double max = 0;
+
+		u64 iterations = 0;					//Iterations per sample
+		u32 samples = 0;
+		u32 rejected = 0;
+		u64 bytes = 0;						//Bytes processed per iteration
+
+		inline std::string fullName() const {
+			return module + '/' + name;
+		}
+
+	};
+
+
+	class BenchmarkContext {
+
+	public:
+
+		explicit BenchmarkContext(const BenchmarkConfig& config = BenchmarkConfig()) : config(config), measured(false), bytes(0) {}
+
+
+		/*
+			Measures function. After warm-up, the iteration count is calibrated so that a sample takes config.sampleTime.
+			Only the last call per benchmark is reported.
+		*/
+		template<CC::Invocable F>
+		void run(F&& function) {
+
+			auto batch = [](void* context, u64 iterations) -> u64 {
+
+				F& f = *static_cast<TT::RemoveRef<F>*>(context);
+
+				auto start = std::chrono::steady_clock::now();
+
+				for (u64 i = 0; i < iterations; i++) {
+					f();
+				}
+
+				auto end = std::chrono::steady_clock::now();
+
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+			};
+
+			measure(batch, const_cast<void*>(static_cast<const void*>(&function)));
+
+		}
+
+
+		//Sets the number of bytes processed per iteration to report throughput
+		constexpr void setBytesPerIteration(u64 bytes) noexcept {
+			this->bytes = bytes;
+		}
+
+
+		constexpr bool hasResult() const noexcept {
+			return measured;
+		}
+
+		constexpr const BenchmarkResult& getResult() const noexcept {
+			return result;
+		}
+
+	private:
+
+		using BatchFunction = u64(*)(void* context, u64 iterations);
+
+		void measure(BatchFunction batch, void* context);
+
+
+		BenchmarkConfig config;
+		BenchmarkResult result;
+		bool measured;
+		u64 bytes;
+
+	};
+
+
+	struct BenchmarkOptions {
+
+		BenchmarkConfig config;
+		std::string outputPath;				//JSON result file, empty to disable
+		std::string baselinePath;			//JSON result file to compare against, empty to disable
+		double threshold = 0.05;			//Relative slowdown above which a benchmark counts as regressed, 0.05 = 5%
+
+	};
+
+
+	/*
+		Runs all benchmarks of the module and its submodules.
+		Returns false if a benchmark failed or regressed against the baseline.
+	*/
+	extern bool benchmark(const std::string& module = "", const BenchmarkOptions& options = BenchmarkOptions()) noexcept;
+
+	extern std::string toJson(const std::vector<BenchmarkResult>& results);
+
+	//Parses results written by toJson, throws JsonException on malformed input
+	extern std::vector<BenchmarkResult> parseJson(const std::string& json);
+
+}
+
+
+#define __ARC_CANDLE_BENCH_IMPL(id, module, name)								\
+																				\
+static void ARC_PP_CAT(candleBench, id)(::Candle::BenchmarkContext&);			\
+																				\
+static ::Candle::Detail::StaticRegister ARC_PP_CAT(candleBenchRegister, id) = {	\
+	module, ::Candle::BenchmarkHandle{&ARC_PP_CAT(candleBench, id), name}		\
+};																				\
+																				\
+static void ARC_PP_CAT(candleBench, id)(::Candle::BenchmarkContext& bench) /* { ... } */
+
+
+#define candle_bench(module, name)			__ARC_CANDLE_BENCH_IMPL(__COUNTER__, module, name)
+
+#define candle_benchmark					::Candle::benchmark
+
+
+#define candle_measure(...)					bench.run([&]() { __VA_ARGS__; })
+
+#define candle_bytes(count)					bench.setBytesPerIteration(count)
+
+#define candle_do_not_optimize(value)		::Candle::doNotOptimize(value)
+
+#define candle_clobber()					::Candle::clobberMemory()
\ No newline at end of file
@@ -15,6 +15,7 @@
 
 #include <source_location>
 #include <unordered_map>
+#include <functional>
 #include <utility>
 #include <vector>
 #include <format>
@@ -216,6 +217,9 @@ namespace Candle {
 
 	};
 
+	class BenchmarkContext;
+
+
 	struct TestHandle {
 
 		using FunctionT = void(*)(TestContext& context);
@@ -235,10 +239,39 @@ namespace Candle {
 	};
 
 
+	struct BenchmarkHandle {
+
+		using FunctionT = void(*)(BenchmarkContext& context);
+
+
+		constexpr BenchmarkHandle(FunctionT function, std::string name) : name(std::move(name)), function(function) {}
+
+
+		std::string name;
+		FunctionT function;
+
+	};
+
+
+	struct ExecutionOptions {
+
+		ExecutionFlags flags = None;
+		u32 jobs = 0;				// Threads executing tests including the caller, 0 to use all hardware threads. Strict execution is always sequential.
+		u32 shardIndex = 0;			// Zero-based shard to execute, tests are distributed by a hash of their name
+		u32 shardCount = 1;
+		u32 slowestCount = 5;		// Number of slowest tests to report
+
+	};
+
+
+	extern bool execute(const std::string& module, const ExecutionOptions& options) noexcept;
+
 	extern bool execute(const std::string& module = "", ExecutionFlags flags = None) noexcept;
 
 	extern bool registerModule(const std::string& module, const TestHandle& test) noexcept;
 
+	extern bool registerModule(const std::string& module, const BenchmarkHandle& benchmark) noexcept;
+
 
 	inline bool execute(ExecutionFlags flags) {
 		return execute("", flags);
@@ -252,6 +285,7 @@ namespace Candle::Detail {
 	struct StaticRegister {
 
 		StaticRegister(const std::string& module, const TestHandle& test) noexcept;
+		StaticRegister(const std::string& module, const BenchmarkHandle& benchmark) noexcept;
 
 	};
 
@@ -269,9 +303,14 @@ namespace Candle::Detail {
 			return !tests.empty();
 		}
 
+		inline bool hasBenchmarks() const noexcept {
+			return !benchmarks.empty();
+		}
+
 
 		std::unordered_map<std::string, TreeNode> children;
 		std::vector<TestHandle> tests;
+		std::vector<BenchmarkHandle> benchmarks;
 
 	};
 
@@ -281,8 +320,6 @@ namespace Candle::Detail {
 			: node(node), module(std::move(module)), expanded(expanded) {}
 
 
-		std::vector<std::string> process(const std::string& spacing, bool& terminate, ExecutionFlags flags) const;
-
 		template<CC::Returns<bool, const ExecuteNode&, SizeT> F>
 		void traverse(bool expand, F&& callback) const {
 
@@ -355,6 +392,14 @@ namespace Candle::Detail {
 
 	extern TreeNode* root;
 
+
+	/*
+		Visits the module and all of its submodules, or every module if module is empty.
+		visitor(node, spacing, name) receives the last module name component and returns false to stop the traversal.
+		Returns false if the module does not exist.
+	*/
+	bool traverseModule(const std::string& module, const std::function<bool(const ExecuteNode&, const std::string&, const std::string&)>& visitor);
+
 }
 
 
@@ -0,0 +1,433 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 Benchmark.cpp
+ */
+
+#include "Candle/Benchmark.hpp"
+#include "Filesystem/File.hpp"
+#include "Math/Math.hpp"
+#include "Util/Log.hpp"
+#include "Json/Document.hpp"
+
+#include <unordered_map>
+#include <string_view>
+#include <algorithm>
+#include <cmath>
+
+
+
+static constexpr const char* LogName = "Candle";
+
+
+static volatile const char* optimizationSink = nullptr;
+
+
+
+void Candle::Detail::useCharPointer(const volatile char* pointer) noexcept {
+	optimizationSink = pointer;
+}
+
+
+
+static double median(std::vector<double> values) {
+
+	if (values.empty()) {
+		return 0;
+	}
+
+	SizeT half = values.size() / 2;
+	std::nth_element(values.begin(), values.begin() + half, values.end());
+
+	double upper = values[half];
+
+	if (values.size() % 2) {
+		return upper;
+	}
+
+	double lower = *std::max_element(values.begin(), values.begin() + half);
+
+	return (lower + upper) / 2;
+
+}
+
+
+static double medianAbsoluteDeviation(const std::vector<double>& values, double center) {
+
+	std::vector<double> deviations;
+	deviations.reserve(values.size());
+
+	for (double value : values) {
+		deviations.push_back(std::abs(value - center));
+	}
+
+	return median(std::move(deviations));
+
+}
+
+
+static std::string formatTime(double ns) {
+
+	if (ns < 1e3) {
+		return std::format("{:.2f} ns", ns);
+	} else if (ns < 1e6) {
+		return std::format("{:.2f} us", ns / 1e3);
+	} else if (ns < 1e9) {
+		return std::format("{:.2f} ms", ns / 1e6);
+	} else {
+		return std::format("{:.2f} s", ns / 1e9);
+	}
+
+}
+
+
+static std::string formatThroughput(u64 bytes, double ns) {
+
+	double perSecond = bytes / ns * 1e9;
+
+	if (perSecond < 1024.0 * 1024.0) {
+		return std::format("{:.2f} KiB/s", perSecond / 1024.0);
+	} else if (perSecond < 1024.0 * 1024.0 * 1024.0) {
+		return std::format("{:.2f} MiB/s", perSecond / (1024.0 * 1024.0));
+	} else {
+		return std::format("{:.2f} GiB/s", perSecond / (1024.0 * 1024.0 * 1024.0));
+	}
+
+}
+
+
+
+void Candle::BenchmarkContext::measure(BatchFunction batch, void* context) {
+
+	constexpr u64 MaxIterations = u64(1) << 40;
+
+	const u64 sampleTarget = Math::max(u64(config.sampleTime * 1e9), u64(1));
+	const u64 warmupTarget = u64(config.warmupTime * 1e9);
+
+	// Warm up while calibrating the iteration count per sample
+
+	u64 iterations = 1;
+	u64 elapsed = 0;
+
+	while (true) {
+
+		u64 time = batch(context, iterations);
+		elapsed += time;
+
+		bool calibrated = time >= sampleTarget || iterations >= MaxIterations;
+
+		if (calibrated && elapsed >= warmupTarget) {
+			break;
+		}
+
+		if (!calibrated) {
+
+			// Aim slightly above the target, but grow at most by a factor of 10 per step
+
+			u64 estimate = time ? u64(double(iterations) * sampleTarget / time * 1.1) : iterations * 10;
+			iterations = Math::clamp(estimate, iterations + 1, Math::min(iterations * 10, MaxIterations));
+
+		}
+
+	}
+
+
+	// Sample
+
+	std::vector<double> samples;
+	samples.reserve(config.samples);
+
+	for (u32 i = 0; i < Math::max(config.samples, 1u); i++) {
+		samples.push_back(double(batch(context, iterations)) / iterations);
+	}
+
+
+	// Reject outliers by modified z-score (0.6745 scales the MAD to the standard deviation of normally distributed data)
+
+	double center = median(samples);
+	double mad = medianAbsoluteDeviation(samples, center);
+
+	std::vector<double> kept;
+	kept.reserve(samples.size());
+
+	for (double sample : samples) {
+
+		if (mad == 0 || 0.6745 * std::abs(sample - center) / mad <= config.outlierThreshold) {
+			kept.push_back(sample);
+		}
+
+	}
+
+
+	result.median = median(kept);
+	result.mad = medianAbsoluteDeviation(kept, result.median);
+	result.min = *std::min_element(kept.begin(), kept.end());
+	result.max = *std::max_element(kept.begin(), kept.end());
+
+	result.mean = 0;
+
+	for (double sample : kept) {
+		result.mean += sample;
+	}
+
+	result.mean /= kept.size();
+
+	result.iterations = iterations;
+	result.samples = kept.size();
+	result.rejected = samples.size() - kept.size();
+	result.bytes = bytes;
+
+	measured = true;
+
+}
+
+
+
+bool Candle::benchmark(const std::string& module, const BenchmarkOptions& options) noexcept {
+
+	try {
+
+		std::vector<BenchmarkResult> results;
+		std::vector<std::string> report;
+
+
+		bool found = Detail::traverseModule(module, [&](const Detail::ExecuteNode& current, const std::string& spacing, const std::string& name) {
+
+			LogI(LogName) << spacing << "> " << name;
+
+
+			const auto& benchmarks = current.node.benchmarks;
+
+			for (SizeT i = 1; const auto& benchmark : benchmarks) {
+
+				BenchmarkContext context(options.config);
+				std::string error;
+
+				try {
+					benchmark.function(context);
+				} catch (const std::exception& ex) {
+					error = "(Uncaught) " + Exception::getMessage(ex);
+				} catch (...) {
+					error = "(Uncaught) Unknown exception";
+				}
+
+				if (error.empty() && !context.hasResult()) {
+					error = "Benchmark did not measure anything";
+				}
+
+				if (!error.empty()) {
+
+					LogI(LogName) << std::format("{}| [{}/{} Fail] {}", spacing, i++, benchmarks.size(), benchmark.name);
+					report.emplace_back(std::format("+ In '{}/{}': {}", current.module, benchmark.name, error));
+
+					continue;
+
+				}
+
+
+				BenchmarkResult result = context.getResult();
+				result.module = current.module;
+				result.name = benchmark.name;
+
+				std::string throughput = result.bytes ? ", " + formatThroughput(result.bytes, result.median) : "";
+
+				LogI(LogName) << std::format("{}| [{}/{}] {:<32} {:>12} +- {:<12} ({} samples, {} rejected, {} iterations{})",
+											 spacing, i++, benchmarks.size(), result.name, formatTime(result.median), formatTime(result.mad),
+											 result.samples, result.rejected, result.iterations, throughput);
+
+				results.emplace_back(std::move(result));
+
+			}
+
+			return true;
+
+		});
+
+		if (!found) {
+			return false;
+		}
+
+
+		if (!options.outputPath.empty()) {
+
+			File file;
+
+			if (file.open(Path(options.outputPath), File::Out | File::Trunc)) {
+				file.write(toJson(results));
+			} else {
+				report.emplace_back("Failed to write results to '" + options.outputPath + "'");
+			}
+
+		}
+
+
+		if (!options.baselinePath.empty()) {
+
+			File file;
+
+			if (!file.open(Path(options.baselinePath), File::In | File::Text)) {
+
+				report.emplace_back("Failed to read baseline '" + options.baselinePath + "'");
+
+			} else {
+
+				std::unordered_map<std::string, BenchmarkResult> baseline;
+
+				try {
+
+					for (auto& result : parseJson(file.readAllText())) {
+						baseline.emplace(result.fullName(), std::move(result));
+					}
+
+				} catch (const JsonException& ex) {
+
+					report.emplace_back("Malformed baseline '" + options.baselinePath + "': " + Exception::getMessage(ex));
+
+				}
+
+				LogI(LogName) << "";
+				LogI(LogName) << "Comparison against '" << options.baselinePath << "'";
+
+				for (const auto& result : results) {
+
+					auto it = baseline.find(result.fullName());
+
+					if (it == baseline.end()) {
+
+						LogI(LogName) << std::format("| {:<48} {:>12} (new)", result.fullName(), formatTime(result.median));
+						continue;
+
+					}
+
+					const BenchmarkResult& base = it->second;
+
+					// Changes within the combined noise of both measurements are never reported
+
+					double change = base.median > 0 ? result.median / base.median - 1 : 0;
+					double noise = 3 * (result.mad + base.mad);
+					double difference = result.median - base.median;
+
+					const char* status = "";
+
+					if (difference > noise && change > options.threshold) {
+
+						status = " Regressed";
+						report.emplace_back(std::format("+ '{}' regressed by {:.1f}% ({} -> {})", result.fullName(), change * 100, formatTime(base.median), formatTime(result.median)));
+
+					} else if (-difference > noise && -change > options.threshold) {
+
+						status = " Improved";
+
+					}
+
+					LogI(LogName) << std::format("| {:<48} {:>12} -> {:>12} ({:+.1f}%){}", result.fullName(), formatTime(base.median), formatTime(result.median), change * 100, status);
+
+				}
+
+			}
+
+		}
+
+
+		const bool success = report.empty();
+
+		LogI(LogName) << "";
+
+		if (success) {
+			LogI(LogName) << "Benchmarks succeded!";
+		} else {
+			LogE(LogName) << "Benchmarks failed!";
+		}
+
+		for (const auto& line : report) {
+			LogE(LogName) << line;
+		}
+
+		return success;
+
+	} catch (const std::exception& ex) {
+
+		LogE(LogName) << "Benchmark execution failed: " << Exception::getMessage(ex);
+		return false;
+
+	}
+
+}
+
+
+
+static void appendEscaped(std::string& out, std::string_view string) {
+
+	for (char c : string) {
+
+		if (c == '"' || c == '\\') {
+			out += '\\';
+		}
+
+		out += c;
+
+	}
+
+}
+
+
+std::string Candle::toJson(const std::vector<BenchmarkResult>& results) {
+
+	std::string json = "{\n\t\"benchmarks\": [";
+
+	for (SizeT i = 0; i < results.size(); i++) {
+
+		const BenchmarkResult& result = results[i];
+
+		json += i ? ",\n\t\t{" : "\n\t\t{";
+
+		json += "\"module\": \"";
+		appendEscaped(json, result.module);
+		json += "\", \"name\": \"";
+		appendEscaped(json, result.name);
+		json += '"';
+
+		json += std::format(", \"median\": {}, \"mad\": {}, \"mean\": {}, \"min\": {}, \"max\": {}, \"iterations\": {}, \"samples\": {}, \"rejected\": {}, \"bytes\": {}}}",
+							result.median, result.mad, result.mean, result.min, result.max, result.iterations, result.samples, result.rejected, result.bytes);
+
+	}
+
+	json += "\n\t]\n}\n";
+
+	return json;
+
+}
+
+
+std::vector<Candle::BenchmarkResult> Candle::parseJson(const std::string& json) {
+
+	std::vector<BenchmarkResult> results;
+
+	JsonDocument document(json);
+
+	for (const JsonValue& value : document.getRoot().toObject()["benchmarks"].toArray()) {
+
+		const JsonObject& object = value.toObject();
+
+		BenchmarkResult result;
+		result.module = object["module"].toString();
+		result.name = object["name"].toString();
+		result.median = object["median"].toNumber<double>();
+		result.mad = object["mad"].toNumber<double>();
+		result.mean = object["mean"].toNumber<double>();
+		result.min = object["min"].toNumber<double>();
+		result.max = object["max"].toNumber<double>();
+		result.iterations = object["iterations"].toNumber<u64>();
+		result.samples = object["samples"].toNumber<u32>();
+		result.rejected = object["rejected"].toNumber<u32>();
+		result.bytes = object["bytes"].toNumber<u64>();
+
+		results.emplace_back(std::move(result));
+
+	}
+
+	return results;
+
+}
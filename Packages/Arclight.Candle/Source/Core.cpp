@@ -8,9 +8,13 @@
 
 #include "Candle/Core.hpp"
 #include "Util/DestructionGuard.hpp"
+#include "Concurrent/JobSystem.hpp"
+#include "Math/Math.hpp"
 
 #include <stack>
+#include <chrono>
 #include <ranges>
+#include <algorithm>
 
 
 
@@ -20,178 +24,367 @@ static constexpr const char* LogName = "Candle";
 Candle::Detail::TreeNode* Candle::Detail::root = nullptr;
 
 
-std::vector<std::string> Candle::Detail::ExecuteNode::process(const std::string& spacing, bool& terminate, Candle::ExecutionFlags flags) const {
+bool Candle::Detail::traverseModule(const std::string& module, const std::function<bool(const ExecuteNode&, const std::string&, const std::string&)>& visitor) {
 
-	terminate = false;
+	if (module.starts_with('.') || module.ends_with('.')) {
+		LogE(LogName) << "Cannot execute illegal module '" << module << "'";
+		return false;
+	}
+
+	if (!root) {
+		LogE(LogName) << "No modules registered";
+		return false;
+	}
+
+
+	const bool rootTarget = module.empty();
+
+	SizeT targetDepth = rootTarget ? 0 : -1;
+
+	if (rootTarget) {
+		LogI(LogName) << "Executing all modules";
+		LogI(LogName) << "";
+	}
 
 
-	bool prefix = false;
+	ExecuteNode(*root, "").traverse(rootTarget, [&](const ExecuteNode& current, SizeT depth) {
 
-	std::vector<std::string> report;
+		if (targetDepth == -1) {
 
-	for (SizeT i = 1; const auto& test : node.tests) {
+			if (current.module != module) {
+				return true;
+			}
 
-		Candle::TestContext context;
+			targetDepth = depth;
+
+			LogI(LogName) << "Executing module '" << module << "'";
+			LogI(LogName) << "";
+
+		} else if (depth - 1 < targetDepth) {
+
+			// Leave traverse once processing is finished
 
+			return false;
 
-		try {
-			test.function(context);
-		} catch (const std::exception& ex) {
-			context.error("(Uncaught) " + Exception::getMessage(ex));
-		} catch (...) {
-			context.error("(Uncaught) Unknown exception");
 		}
 
 
-		std::string name = test.unnamed() ? std::format("Test #{}", i) : test.name;
+		const std::string spacing(depth - targetDepth, '\t');
 
+		// Isolate last module name (e.g. Core.Math -> Math)
 
-		constexpr const char* Status[] = {"Fail", "Pass"};
+		SizeT pos = current.module.rfind('.');
+		pos = (pos == std::string::npos) ? 0 : pos + 1;
 
-		const bool success = context.success();
+		return visitor(current, spacing, current.module.substr(pos));
 
-		LogI(LogName) << std::format("{}| [{}/{} {}] {}", spacing, i++, node.tests.size(), Status[success], name);
+	});
 
-		if (success) {
-			continue;
+	if (targetDepth == -1) {
+		LogE(LogName) << "Module '" << module << "' does not exist";
+		return false;
+	}
+
+
+	return true;
+
+}
+
+
+
+static u32 shardOf(const std::string& name, u32 shardCount) {
+
+	// FNV-1a keeps the distribution stable across platforms and builds
+
+	u64 hash = 0xCBF29CE484222325;
+
+	for (char c : name) {
+		hash = (hash ^ static_cast<u8>(c)) * 0x100000001B3;
+	}
+
+	return hash % shardCount;
+
+}
+
+
+
+bool Candle::execute(const std::string& module, const ExecutionOptions& options) noexcept {
+
+	using Clock = std::chrono::steady_clock;
+
+	struct TestCase {
+
+		const TestHandle* test;
+
+		std::string module;
+		std::string name;
+		std::string spacing;
+
+		SizeT index;
+		SizeT count;
+		SizeT line;
+
+	};
+
+	struct TestOutcome {
+
+		TestContext context;
+		double time = 0;
+		bool executed = false;
+
+	};
+
+
+	try {
+
+		if (!options.shardCount || options.shardIndex >= options.shardCount) {
+			LogE(LogName) << "Invalid shard " << options.shardIndex + 1 << "/" << options.shardCount;
+			return false;
 		}
 
 
-		if (!prefix) {
+		// Collect all tests first so that they can run concurrently while the output keeps the traversal order
+
+		std::vector<std::string> lines;
+		std::vector<TestCase> cases;
+
+		bool found = Detail::traverseModule(module, [&](const Detail::ExecuteNode& current, const std::string& spacing, const std::string& name) {
 
-			report.emplace_back("");
-			report.emplace_back("> " + module);
+			lines.emplace_back(spacing + "> " + name);
 
-			prefix = true;
+			for (SizeT i = 1; const auto& test : current.node.tests) {
 
+				std::string testName = test.unnamed() ? std::format("Test #{}", i) : test.name;
+
+				if (shardOf(current.module + '/' + testName, options.shardCount) == options.shardIndex) {
+
+					cases.push_back({&test, current.module, testName, spacing, i, current.node.tests.size(), lines.size()});
+					lines.emplace_back();
+
+				}
+
+				i++;
+
+			}
+
+			return true;
+
+		});
+
+		if (!found) {
+			return false;
 		}
 
-		report.emplace_back(std::format("+ In '{}'", name));
 
-		for (const auto& failure : context.data()) {
-			report.emplace_back("| \t" + failure.toString(bool(flags & Verbose)));
+		const bool strict = bool(options.flags & Strict);
+
+		std::vector<TestOutcome> outcomes(cases.size());
+
+		auto run = [&](SizeT i) {
+
+			TestOutcome& outcome = outcomes[i];
+
+			Clock::time_point start = Clock::now();
+
+			try {
+				cases[i].test->function(outcome.context);
+			} catch (const std::exception& ex) {
+				outcome.context.error("(Uncaught) " + Exception::getMessage(ex));
+			} catch (...) {
+				outcome.context.error("(Uncaught) Unknown exception");
+			}
+
+			outcome.time = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+			outcome.executed = true;
+
+		};
+
+
+		Clock::time_point start = Clock::now();
+
+		SizeT jobs = options.jobs ? options.jobs : JobSystem::getDefaultWorkerCount() + 1;
+
+		if (strict || jobs <= 1 || cases.size() <= 1) {
+
+			// Strict execution stops at the first failure and therefore runs in order
+
+			for (SizeT i = 0; i < cases.size(); i++) {
+
+				run(i);
+
+				if (strict && !outcomes[i].context.success()) {
+					break;
+				}
+
+			}
+
+		} else {
+
+			JobSystem system(Math::min(jobs, cases.size()) - 1);
+			system.parallelFor(SizeT(0), cases.size(), run, 1);
+
 		}
 
+		double wallTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+
+		// Print results in traversal order
+
+		constexpr const char* Status[] = {"Fail", "Pass"};
+
+		SizeT printedLines = lines.size();
+
+		for (SizeT i = 0; i < cases.size(); i++) {
+
+			const TestCase& test = cases[i];
+			const TestOutcome& outcome = outcomes[i];
+
+			if (!outcome.executed) {
+				printedLines = test.line;
+				break;
+			}
+
+			lines[test.line] = std::format("{}| [{}/{} {}] {} ({:.2f} ms)", test.spacing, test.index, test.count, Status[outcome.context.success()], test.name, outcome.time);
 
-		if (bool(flags & Strict)) {
-			terminate = true;
-			break;
 		}
 
-	}
+		for (SizeT i = 0; i < printedLines; i++) {
+			LogI(LogName) << lines[i];
+		}
 
 
-	return report;
+		// Failures are grouped by module, the report lists the last module first
 
-}
+		std::vector<std::string> report;
+		std::vector<std::string> moduleReport;
 
+		SizeT passed = 0;
+		SizeT executed = 0;
 
+		for (SizeT i = 0; i < cases.size(); i++) {
 
-bool Candle::execute(const std::string& module, ExecutionFlags flags) noexcept {
+			const TestCase& test = cases[i];
+			const TestOutcome& outcome = outcomes[i];
 
-	if (module.starts_with('.') || module.ends_with('.')) {
-		LogE(LogName) << "Cannot execute illegal module '" << module << "'";
-		return false;
-	}
+			if (!outcome.executed) {
+				break;
+			}
 
+			executed++;
 
-	const bool rootTarget = module.empty();
+			if (i && test.module != cases[i - 1].module) {
 
-	SizeT targetDepth = rootTarget ? 0 : -1;
+				report.insert(report.begin(), moduleReport.begin(), moduleReport.end());
+				moduleReport.clear();
 
-	if (rootTarget) {
-		LogI(LogName) << "Executing all modules";
-		LogI(LogName) << "";
-	}
+			}
 
+			if (outcome.context.success()) {
+				passed++;
+				continue;
+			}
 
-	std::vector<std::string> report;
+			if (moduleReport.empty()) {
 
+				moduleReport.emplace_back("");
+				moduleReport.emplace_back("> " + test.module);
 
-	Detail::ExecuteNode(*Detail::root, "").traverse(rootTarget, [&](const Detail::ExecuteNode& current, SizeT depth) {
+			}
 
-		if (targetDepth == -1) {
+			moduleReport.emplace_back(std::format("+ In '{}'", test.name));
 
-			if (current.module != module) {
-				return true;
+			for (const auto& failure : outcome.context.data()) {
+				moduleReport.emplace_back("| \t" + failure.toString(bool(options.flags & Verbose)));
 			}
 
-			targetDepth = depth;
+		}
 
-			LogI(LogName) << "Executing module '" << module << "'";
-			LogI(LogName) << "";
+		report.insert(report.begin(), moduleReport.begin(), moduleReport.end());
 
-		} else if (depth - 1 < targetDepth) {
 
-			// Leave traverse once processing is finished
+		const bool success = report.empty();
 
-			return false;
 
+		LogI(LogName) << "";
+		LogI(LogName) << std::format("{}/{} tests passed in {:.2f} ms", passed, executed, wallTime);
+
+		if (options.shardCount > 1) {
+			LogI(LogName) << std::format("Executed shard {}/{} ({} of the selected tests)", options.shardIndex + 1, options.shardCount, cases.size());
 		}
 
 
-		const std::string spacing(depth - targetDepth, '\t');
+		if (options.slowestCount && executed > 1) {
 
-		// Isolate last module name (e.g. Core.Math -> Math)
+			std::vector<SizeT> order;
 
-		SizeT pos = current.module.rfind('.');
-		pos = (pos == std::string::npos) ? 0 : pos + 1;
+			for (SizeT i = 0; i < executed; i++) {
+				order.push_back(i);
+			}
 
-		LogI(LogName) << spacing << "> " << current.module.substr(pos);
+			SizeT count = Math::min<SizeT>(options.slowestCount, order.size());
 
+			std::partial_sort(order.begin(), order.begin() + count, order.end(), [&](SizeT a, SizeT b) {
+				return outcomes[a].time > outcomes[b].time;
+			});
 
-		bool terminate = false;
+			LogI(LogName) << "";
+			LogI(LogName) << "Slowest tests:";
 
-		std::vector<std::string> output = current.process(spacing, terminate, flags);
+			for (SizeT i = 0; i < count; i++) {
+				LogI(LogName) << std::format("| {:>10.2f} ms  {}/{}", outcomes[order[i]].time, cases[order[i]].module, cases[order[i]].name);
+			}
 
-		report.insert(report.begin(), output.begin(), output.end());
+		}
 
-		return !terminate;
 
-	});
+		LogI(LogName) << "";
 
-	if (targetDepth == -1) {
-		LogE(LogName) << "Module '" << module << "' does not exist";
-		return false;
-	}
+		if (success) {
+			LogI(LogName) << "Tests succeded!";
+		} else {
+			LogE(LogName) << "Tests failed!";
+		}
 
+		for (const auto& line : report) {
+			LogE(LogName) << line;
+		}
 
-	const bool success = report.empty();
 
+		if constexpr (__TIME__[7] & 3) {
+			LogI(LogName) << "";
+			LogI(LogName) << "~ The wax has melted";
+		}
 
-	LogI(LogName) << "";
 
-	if (success) {
-		LogI(LogName) << "Tests succeded!";
-	} else {
-		LogE(LogName) << "Tests failed!";
-	}
+		return success;
 
-	for (const auto& line : report) {
-		LogE(LogName) << line;
-	}
+	} catch (const std::exception& ex) {
 
+		LogE(LogName) << "Test execution failed: " << Exception::getMessage(ex);
+		return false;
 
-	if constexpr (__TIME__[7] & 3) {
-		LogI(LogName) << "";
-		LogI(LogName) << "~ The wax has melted";
 	}
 
+}
+
+
+
+bool Candle::execute(const std::string& module, ExecutionFlags flags) noexcept {
 
-	return success;
+	ExecutionOptions options;
+	options.flags = flags;
+
+	return execute(module, options);
 
 }
 
-bool Candle::registerModule(const std::string& module, const TestHandle& test) noexcept {
 
-	if (module.starts_with('.') || module.ends_with('.') || module.empty()) {
-		LogE(LogName) << "Cannot register test at illegal module '" << module << "'";
-		return false;
-	}
 
-	if (!test.function) {
-		LogE(LogName) << "Cannot register nullptr as test function";
-		return false;
+static Candle::Detail::TreeNode* findModuleNode(const std::string& module) {
+
+	if (module.starts_with('.') || module.ends_with('.') || module.empty()) {
+		LogE(LogName) << "Cannot register at illegal module '" << module << "'";
+		return nullptr;
 	}
 
 
@@ -216,23 +409,43 @@ bool Candle::registerModule(const std::string& module, const TestHandle& test) n
 	}
 
 
-	Detail::TreeNode* node = Detail::root;
+	Candle::Detail::TreeNode* node = Candle::Detail::root;
 
 	for (SizeT i = 0; const auto& name : names) {
 
 		if (!node->children.contains(name)) {
-			node->children.emplace(name, Detail::TreeNode{});
+			node->children.emplace(name, Candle::Detail::TreeNode{});
 		}
 
 		node = &node->children.at(name);
 
 		if (++i == names.size() && node->isParent()) {
-			LogE(LogName) << "Cannot register test at '" << module << "', conflicts found at '" << name << "'";
-			return false;
+			LogE(LogName) << "Cannot register at '" << module << "', conflicts found at '" << name << "'";
+			return nullptr;
 		}
 
 	}
 
+
+	return node;
+
+}
+
+
+
+bool Candle::registerModule(const std::string& module, const TestHandle& test) noexcept {
+
+	if (!test.function) {
+		LogE(LogName) << "Cannot register nullptr as test function";
+		return false;
+	}
+
+	Detail::TreeNode* node = findModuleNode(module);
+
+	if (!node) {
+		return false;
+	}
+
 	node->tests.emplace_back(test);
 
 
@@ -241,16 +454,45 @@ bool Candle::registerModule(const std::string& module, const TestHandle& test) n
 }
 
 
-Candle::Detail::StaticRegister::StaticRegister(const std::string& module, const TestHandle& test) noexcept {
+
+bool Candle::registerModule(const std::string& module, const BenchmarkHandle& benchmark) noexcept {
+
+	if (!benchmark.function) {
+		LogE(LogName) << "Cannot register nullptr as benchmark function";
+		return false;
+	}
+
+	Detail::TreeNode* node = findModuleNode(module);
+
+	if (!node) {
+		return false;
+	}
+
+	node->benchmarks.emplace_back(benchmark);
+
+
+	return true;
+
+}
+
+
+static void prepareStaticRegistration() {
 
 	static DestructionGuard guard([]() {
-		delete root;
+		delete Candle::Detail::root;
 	});
 
-	if (!root) {
-		root = new TreeNode;
+	if (!Candle::Detail::root) {
+		Candle::Detail::root = new Candle::Detail::TreeNode;
 	}
 
+}
+
+
+Candle::Detail::StaticRegister::StaticRegister(const std::string& module, const TestHandle& test) noexcept {
+
+	prepareStaticRegistration();
+
 	std::ios_base::Init ios; // Guarantees Log availability at dynamic initialization
 
 	if (!registerModule(module, test)) {
@@ -259,3 +501,17 @@ Candle::Detail::StaticRegister::StaticRegister(const std::string& module, const
 	}
 
 }
+
+
+Candle::Detail::StaticRegister::StaticRegister(const std::string& module, const BenchmarkHandle& benchmark) noexcept {
+
+	prepareStaticRegistration();
+
+	std::ios_base::Init ios;
+
+	if (!registerModule(module, benchmark)) {
+		LogE(LogName) << "Static registration failed, exiting";
+		arc_exit(1);
+	}
+
+}
@@ -21,6 +21,9 @@
 #define ARC_CFG_INTRINSIC_ENABLE_X86_SSE42
 #define ARC_CFG_INTRINSIC_ENABLE_X86_AVX
 #define ARC_CFG_INTRINSIC_ENABLE_X86_AVX2
+#define ARC_CFG_INTRINSIC_ENABLE_X86_SHA
+#define ARC_CFG_INTRINSIC_ENABLE_X86_AESNI
+#define ARC_CFG_INTRINSIC_ENABLE_X86_PCLMULQDQ
 
 // `ARC_CFG_INTRINSIC_STATIC_{Arch}_{Feature}` Disables runtime checking of {Feature} for {Arch} targets
 #define ARC_CFG_INTRINSIC_STATIC_X86_SSE
@@ -40,10 +43,20 @@
 // Unsyncs stdio from cout in Log::init (accelerated logging but data races become possible)
 #define ARC_CFG_LOG_STDIO_UNSYNC
 
+// Starts the asynchronous log backend in Log::init (records are written by a background thread)
+//#define ARC_CFG_LOG_ASYNC
+
 // Aborts when Log throws (disabled in final build mode)
 #define ARC_CFG_LOG_EXCEPTION_ABORT
 
 
+// Compiles instrumentation zones, counters and frame markers into the program
+#define ARC_CFG_INSTRUMENTATION
+
+// Takes instrumentation timestamps from steady_clock instead of the TSC
+//#define ARC_CFG_INSTRUMENTATION_STEADY_CLOCK
+
+
 // Logs all allocations performed with Arclight allocators
 #define ARC_CFG_ALLOCATOR_DEBUG
 
@@ -50,7 +50,7 @@ namespace CPU::X86 {
 			arc_assert(extended || (reg != Register::EAX) || (reg != Register::EBX), "At leaf 0x1 EAX and EBX do not contain features");
 
 			packed |= std::to_underlying(reg) & 0x7;
-			packed |= (bit & 0x1F) << 5;
+			packed |= (bit & 0x1F) << 3;
 			packed |= (subLeaf & 0x7F) << 8;
 			packed |= extended << 15;
 
@@ -142,6 +142,13 @@ namespace CPU {
 	extern bool supports(X86::Feature feature) noexcept;
 	extern bool supports(ARM::Feature feature) noexcept;
 
+	/*
+		Masks a detected feature so that runtime dispatch takes the fallback path, enable restores it if the hardware supports it.
+		Intended for testing fallback implementations. Updates are atomic, but dispatch decisions already taken on other threads are unaffected.
+	*/
+	extern void disable(X86::Feature feature) noexcept;
+	extern void enable(X86::Feature feature) noexcept;
+
 
 	extern std::string manufacturerID() noexcept;
 	extern Manufacturer manufacturer() noexcept;
@@ -183,6 +190,18 @@ namespace CPU {
 		return supports(X86::AVX2);
 	}
 
+	inline bool hasSHA() noexcept {
+		return supports(X86::SHA);
+	}
+
+	inline bool hasAESNI() noexcept {
+		return supports(X86::AESNI);
+	}
+
+	inline bool hasPCLMULQDQ() noexcept {
+		return supports(X86::PCLMULQDQ);
+	}
+
 
 	inline bool hasNEON() noexcept {
 		return supports(ARM::NEON);
@@ -221,3 +240,6 @@ ARC_PP_IF_ELSE(ARC_INTRINSIC_ENABLED(arch, id), \
 #define arc_intrinsic_sse42(...)	arc_intrinsic(X86, SSE42)	(__VA_ARGS__)
 #define arc_intrinsic_avx(...)		arc_intrinsic(X86, AVX)		(__VA_ARGS__)
 #define arc_intrinsic_avx2(...)		arc_intrinsic(X86, AVX2)	(__VA_ARGS__)
+#define arc_intrinsic_sha(...)		arc_intrinsic(X86, SHA)		(__VA_ARGS__)
+#define arc_intrinsic_aesni(...)	arc_intrinsic(X86, AESNI)	(__VA_ARGS__)
+#define arc_intrinsic_pclmulqdq(...)	arc_intrinsic(X86, PCLMULQDQ)	(__VA_ARGS__)
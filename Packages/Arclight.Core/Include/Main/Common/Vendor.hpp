@@ -52,3 +52,12 @@
 	#endif
 
 #endif
+
+
+// Compiles a function for the given instruction set extension (e.g. "avx2") regardless of global target flags
+
+#ifdef ARC_COMPILER_GCCLIKE
+	#define ARC_TARGET(isa) [[gnu::target(isa)]]
+#else
+	#define ARC_TARGET(isa)
+#endif
@@ -0,0 +1,154 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 AtomicWait.hpp
+ */
+
+#pragma once
+
+#include "Common/Types.hpp"
+
+#include <atomic>
+#include <chrono>
+
+
+
+/*
+	Address-based waiting (futex on Linux, WaitOnAddress on Windows).
+	Unlike std::atomic::wait, a timeout may be specified. Wakeups may be spurious.
+*/
+namespace AtomicWait {
+
+	//Blocks while value equals expected
+	void wait(std::atomic<u32>& value, u32 expected) noexcept;
+
+	//Blocks while value equals expected for at most us microseconds. Returns false if the wait timed out.
+	bool waitFor(std::atomic<u32>& value, u32 expected, u64 us) noexcept;
+
+	void notifyOne(std::atomic<u32>& value) noexcept;
+	void notifyAll(std::atomic<u32>& value) noexcept;
+
+}
+
+
+
+/*
+	Wakes consumers blocked until a condition becomes true, typically a queue becoming non-empty.
+	Notifying is a fence and a load as long as nobody waits.
+*/
+class AtomicSignal {
+
+public:
+
+	constexpr AtomicSignal() noexcept : epoch(0), waiters(0) {}
+
+	AtomicSignal(const AtomicSignal& signal) = delete;
+	AtomicSignal& operator=(const AtomicSignal& signal) = delete;
+
+
+	//Must be called after the state change the waiters are interested in
+	void notifyOne() noexcept {
+
+		if (prepareNotify()) {
+			AtomicWait::notifyOne(epoch);
+		}
+
+	}
+
+	void notifyAll() noexcept {
+
+		if (prepareNotify()) {
+			AtomicWait::notifyAll(epoch);
+		}
+
+	}
+
+
+	//Blocks until predicate returns true
+	template<class Predicate>
+	void wait(Predicate&& predicate) {
+
+		while (!predicate()) {
+
+			waiters.fetch_add(1, std::memory_order_seq_cst);
+			u32 current = epoch.load(std::memory_order_seq_cst);
+
+			if (!predicate()) {
+				AtomicWait::wait(epoch, current);
+			} else {
+				waiters.fetch_sub(1, std::memory_order_relaxed);
+				return;
+			}
+
+			waiters.fetch_sub(1, std::memory_order_relaxed);
+
+		}
+
+	}
+
+
+	//Blocks until predicate returns true or us microseconds passed. Returns the last result of predicate.
+	template<class Predicate>
+	bool waitFor(Predicate&& predicate, u64 us) {
+
+		if (predicate()) {
+			return true;
+		}
+
+		using Clock = std::chrono::steady_clock;
+		Clock::time_point deadline = Clock::now() + std::chrono::microseconds(us);
+
+		while (true) {
+
+			waiters.fetch_add(1, std::memory_order_seq_cst);
+			u32 current = epoch.load(std::memory_order_seq_cst);
+
+			if (predicate()) {
+
+				waiters.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+
+			}
+
+			Clock::time_point now = Clock::now();
+
+			if (now < deadline) {
+				AtomicWait::waitFor(epoch, current, std::chrono::duration_cast<std::chrono::microseconds>(deadline - now).count() + 1);
+			}
+
+			waiters.fetch_sub(1, std::memory_order_relaxed);
+
+			if (predicate()) {
+				return true;
+			}
+
+			if (Clock::now() >= deadline) {
+				return false;
+			}
+
+		}
+
+	}
+
+private:
+
+	bool prepareNotify() noexcept {
+
+		//Orders the producer's state change before the waiter check (pairs with the increment in wait)
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if (!waiters.load(std::memory_order_relaxed)) {
+			return false;
+		}
+
+		epoch.fetch_add(1, std::memory_order_seq_cst);
+		return true;
+
+	}
+
+	std::atomic<u32> epoch;
+	std::atomic<u32> waiters;
+
+};
\ No newline at end of file
@@ -0,0 +1,528 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 JobSystem.hpp
+ */
+
+#pragma once
+
+#include "Concurrent/Thread.hpp"
+#include "Concurrent/WorkStealingDeque.hpp"
+#include "Memory/SmallObjectAllocator.hpp"
+#include "Meta/Concepts.hpp"
+#include "Meta/TypeTraits.hpp"
+#include "Math/Math.hpp"
+#include "Common/Types.hpp"
+
+#include <new>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+
+
+
+class JobSystem;
+
+template<class R>
+class JobHandle;
+
+
+
+/*
+	Reference counted unit of work.
+	A job becomes runnable once all of its dependencies have finished.
+	Jobs are allocated from the SmallObjectHeap since they are typically created and destroyed on different threads.
+*/
+class Job {
+
+public:
+
+	Job() noexcept = default;
+	virtual ~Job() noexcept = default;
+
+	Job(const Job& job) = delete;
+	Job& operator=(const Job& job) = delete;
+
+	static void* operator new(SizeT size) {
+		return SmallObjectHeap::allocate(size);
+	}
+
+	static void operator delete(void* ptr, SizeT size) noexcept {
+		SmallObjectHeap::deallocate(ptr, size);
+	}
+
+	bool finished() const noexcept {
+		return done.load(std::memory_order_acquire);
+	}
+
+protected:
+
+	std::exception_ptr exception;
+
+private:
+
+	friend class JobSystem;
+	friend class JobHandleBase;
+
+	template<class>
+	friend class JobHandle;
+
+	//Dependent job to be notified on completion
+	struct Continuation {
+
+		static void* operator new(SizeT size) {
+			return SmallObjectHeap::allocate(size);
+		}
+
+		static void operator delete(void* ptr, SizeT size) noexcept {
+			SmallObjectHeap::deallocate(ptr, size);
+		}
+
+		Job* job;
+		Continuation* next;
+
+	};
+
+	//Marks the continuation list as closed after the job finished
+	inline static Continuation sealed {nullptr, nullptr};
+
+
+	//Invokes the job's function. Exceptions are captured and rethrown by JobHandle::get().
+	virtual void execute() noexcept = 0;
+
+	void acquire() noexcept {
+		references.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void release() noexcept {
+
+		if (references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			delete this;
+		}
+
+	}
+
+
+	//One reference for the scheduler, one for the initial handle
+	std::atomic<u32> references {2};
+
+	//Unfinished dependencies plus one held until submission completed
+	std::atomic<u32> dependencies {1};
+
+	std::atomic<Continuation*> continuations {nullptr};
+	std::atomic<bool> done {false};
+
+};
+
+
+
+template<class R>
+class JobResult : public Job {
+
+protected:
+
+	template<class>
+	friend class JobHandle;
+
+	std::optional<R> result;
+
+};
+
+template<>
+class JobResult<void> : public Job {};
+
+
+
+template<class R, class F>
+class FunctionJob final : public JobResult<R> {
+
+public:
+
+	template<class G>
+	explicit FunctionJob(G&& function) : function(std::forward<G>(function)) {}
+
+private:
+
+	void execute() noexcept override {
+
+		try {
+
+			if constexpr (CC::Equal<R, void>) {
+				std::invoke(function);
+			} else {
+				this->result.emplace(std::invoke(function));
+			}
+
+		} catch (...) {
+
+			this->exception = std::current_exception();
+
+		}
+
+	}
+
+	F function;
+
+};
+
+
+
+//Type-erased shared reference to a job
+class JobHandleBase {
+
+public:
+
+	constexpr JobHandleBase() noexcept : job(nullptr), system(nullptr) {}
+
+	JobHandleBase(const JobHandleBase& handle) noexcept : job(handle.job), system(handle.system) {
+
+		if (job) {
+			job->acquire();
+		}
+
+	}
+
+	JobHandleBase(JobHandleBase&& handle) noexcept : job(std::exchange(handle.job, nullptr)), system(std::exchange(handle.system, nullptr)) {}
+
+	JobHandleBase& operator=(const JobHandleBase& handle) noexcept {
+
+		JobHandleBase(handle).swap(*this);
+		return *this;
+
+	}
+
+	JobHandleBase& operator=(JobHandleBase&& handle) noexcept {
+
+		JobHandleBase(std::move(handle)).swap(*this);
+		return *this;
+
+	}
+
+	~JobHandleBase() noexcept {
+
+		if (job) {
+			job->release();
+		}
+
+	}
+
+
+	bool valid() const noexcept {
+		return job;
+	}
+
+	bool finished() const noexcept {
+		return !job || job->finished();
+	}
+
+	//Blocks until the job finished. The calling thread executes pending jobs in the meantime.
+	void wait() const;
+
+protected:
+
+	friend class JobSystem;
+
+	//Takes over the handle reference held by a newly created job
+	JobHandleBase(Job* job, JobSystem* system) noexcept : job(job), system(system) {}
+
+	void swap(JobHandleBase& handle) noexcept {
+
+		std::swap(job, handle.job);
+		std::swap(system, handle.system);
+
+	}
+
+	Job* job;
+	JobSystem* system;
+
+};
+
+
+
+template<class R>
+class JobHandle : public JobHandleBase {
+
+public:
+
+	using ResultType = R;
+
+	constexpr JobHandle() noexcept = default;
+
+
+	/*
+		Waits for the job and returns its result.
+		Rethrows the exception the job exited with, if any.
+	*/
+	decltype(auto) get() const {
+
+		arc_assert(valid(), "Attempted to get the result of an empty job handle");
+
+		wait();
+
+		if (job->exception) {
+			std::rethrow_exception(job->exception);
+		}
+
+		if constexpr (!CC::Equal<R, void>) {
+			return *static_cast<JobResult<R>*>(job)->result;
+		}
+
+	}
+
+
+	/*
+		Schedules function to run after this job finished.
+		function receives this job's result if it accepts it. If this job failed, the continuation fails with the same exception.
+	*/
+	template<class F>
+	auto then(F&& function) const;
+
+private:
+
+	friend class JobSystem;
+
+	JobHandle(Job* job, JobSystem* system) noexcept : JobHandleBase(job, system) {}
+
+};
+
+
+
+/*
+	Work-stealing job system.
+
+	Every worker owns a Chase-Lev deque. Jobs submitted from a worker are pushed onto its own deque,
+	jobs submitted from other threads go to a shared injection queue. Idle workers steal from each other and sleep when no work is left.
+	Waiting on a handle executes other jobs instead of blocking, so jobs may wait on jobs they submitted.
+
+	All jobs must be finished before the JobSystem is destroyed.
+*/
+class JobSystem {
+
+public:
+
+	explicit JobSystem(SizeT workerCount = getDefaultWorkerCount());
+	~JobSystem();
+
+	JobSystem(const JobSystem& system) = delete;
+	JobSystem& operator=(const JobSystem& system) = delete;
+
+
+	//Submits function for execution
+	template<class F> requires CC::Invocable<TT::Decay<F>&>
+	auto submit(F&& function) {
+		return submitAfter({}, std::forward<F>(function));
+	}
+
+
+	//Submits function for execution once all dependencies have finished
+	template<class F> requires CC::Invocable<TT::Decay<F>&>
+	auto submitAfter(std::initializer_list<JobHandleBase> dependencies, F&& function) {
+
+		using R = TT::RemoveCVRef<std::invoke_result_t<TT::Decay<F>&>>;
+
+		Job* job = new FunctionJob<R, TT::Decay<F>>(std::forward<F>(function));
+		JobHandle<R> handle(job, this);
+
+		for (const JobHandleBase& dependency : dependencies) {
+			addDependency(job, dependency.job);
+		}
+
+		submitJob(job);
+
+		return handle;
+
+	}
+
+
+	//Blocks until the job finished. The calling thread executes pending jobs in the meantime.
+	void wait(const JobHandleBase& handle);
+
+
+	/*
+		Invokes function for every index in [begin; end) in parallel and returns once all invocations finished.
+		function is either invoked as function(index) or, if it accepts two indices, as function(first, last) for every chunk.
+		grainSize specifies the number of indices per chunk. If 0, it is chosen such that every thread receives several chunks.
+		The first exception thrown is rethrown after all chunks finished.
+	*/
+	template<CC::Integer I, class F>
+	void parallelFor(I begin, I end, F&& function, SizeT grainSize = 0) {
+
+		if (end <= begin) {
+			return;
+		}
+
+		SizeT count = end - begin;
+		SizeT threads = getWorkerCount() + 1;
+
+		if (!grainSize) {
+			grainSize = Math::max(count / (threads * 8), SizeT(1));
+		}
+
+		SizeT chunks = (count + grainSize - 1) / grainSize;
+
+		auto invokeChunk = [&](SizeT chunk) {
+
+			I first = begin + static_cast<I>(chunk * grainSize);
+			I last = begin + static_cast<I>(Math::min(chunk * grainSize + grainSize, count));
+
+			if constexpr (CC::Invocable<F&, I, I>) {
+
+				std::invoke(function, first, last);
+
+			} else {
+
+				for (I i = first; i != last; i++) {
+					std::invoke(function, i);
+				}
+
+			}
+
+		};
+
+		if (chunks == 1) {
+
+			invokeChunk(0);
+			return;
+
+		}
+
+		std::atomic<SizeT> nextChunk = 0;
+
+		auto body = [&]() {
+
+			for (SizeT chunk = nextChunk.fetch_add(1, std::memory_order_relaxed); chunk < chunks; chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) {
+				invokeChunk(chunk);
+			}
+
+		};
+
+		SizeT helpers = Math::min(chunks - 1, getWorkerCount());
+		std::vector<JobHandle<void>> handles;
+		handles.reserve(helpers);
+
+		for (SizeT i = 0; i < helpers; i++) {
+			handles.emplace_back(submit(body));
+		}
+
+		std::exception_ptr exception;
+
+		try {
+			body();
+		} catch (...) {
+			exception = std::current_exception();
+		}
+
+		for (const JobHandle<void>& handle : handles) {
+
+			try {
+				handle.get();
+			} catch (...) {
+
+				if (!exception) {
+					exception = std::current_exception();
+				}
+
+			}
+
+		}
+
+		if (exception) {
+			std::rethrow_exception(exception);
+		}
+
+	}
+
+
+	SizeT getWorkerCount() const noexcept;
+
+	//Returns the hardware thread count minus the calling thread, at least 1
+	static SizeT getDefaultWorkerCount() noexcept;
+
+	//Returns the process-wide job system, created on first use
+	static JobSystem& getGlobal();
+
+private:
+
+	struct alignas(std::hardware_destructive_interference_size) Worker {
+
+		WorkStealingDeque<Job*> deque;
+		Thread thread;
+
+	};
+
+	constexpr static SizeT invalidWorker = -1;
+
+
+	void addDependency(Job* job, Job* dependency);
+	void submitJob(Job* job);
+	void schedule(Job* job);
+
+	void run(Job* job) noexcept;
+	void finish(Job* job) noexcept;
+
+	Job* findJob(SizeT self) noexcept;
+	SizeT getCurrentWorker() const noexcept;
+
+	void workerMain(SizeT index);
+
+
+	std::vector<std::unique_ptr<Worker>> workers;
+
+	std::mutex injectionMutex;
+	std::deque<Job*> injectionQueue;
+	std::atomic<SizeT> injectionCount;
+
+	alignas(std::hardware_destructive_interference_size) std::atomic<u32> wakeEpoch;
+	std::atomic<u32> sleepers;
+	std::atomic<bool> stopping;
+
+};
+
+
+
+inline void JobHandleBase::wait() const {
+
+	if (job) {
+		system->wait(*this);
+	}
+
+}
+
+
+
+template<class R>
+template<class F>
+auto JobHandle<R>::then(F&& function) const {
+
+	arc_assert(valid(), "Attempted to attach a continuation to an empty job handle");
+
+	return system->submitAfter({*this}, [parent = *this, f = std::forward<F>(function)]() mutable {
+
+		if constexpr (CC::Equal<R, void>) {
+
+			parent.get();
+			return std::invoke(f);
+
+		} else if constexpr (CC::Invocable<decltype(f)&, R&>) {
+
+			return std::invoke(f, parent.get());
+
+		} else {
+
+			parent.get();
+			return std::invoke(f);
+
+		}
+
+	});
+
+}
\ No newline at end of file
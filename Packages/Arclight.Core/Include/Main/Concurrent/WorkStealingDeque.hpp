@@ -0,0 +1,172 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 WorkStealingDeque.hpp
+ */
+
+#pragma once
+
+#include "Meta/TypeTraits.hpp"
+#include "Common/Types.hpp"
+
+#include <new>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+
+
+/*
+	Chase-Lev work-stealing deque (Lê, Pop, Cohen, Zappa Nardelli: Correct and Efficient Work-Stealing for Weak Memory Models).
+
+	The owning thread pushes and pops at the bottom without contention, any other thread may steal from the top.
+	The ring buffer grows on demand. Retired buffers are kept alive until destruction since thieves may still read from them.
+	T is restricted to trivially copyable types, typically pointers.
+*/
+template<class T> requires std::is_trivially_copyable_v<T>
+class WorkStealingDeque {
+
+	class Buffer {
+
+	public:
+
+		explicit Buffer(SizeT capacity) : capacity(capacity), mask(capacity - 1), data(std::make_unique<std::atomic<T>[]>(capacity)) {}
+
+		SizeT size() const noexcept {
+			return capacity;
+		}
+
+		T load(i64 index) const noexcept {
+			return data[index & mask].load(std::memory_order_relaxed);
+		}
+
+		void store(i64 index, T value) noexcept {
+			data[index & mask].store(value, std::memory_order_relaxed);
+		}
+
+		std::unique_ptr<Buffer> grow(i64 bottom, i64 top) const {
+
+			auto buffer = std::make_unique<Buffer>(capacity * 2);
+
+			for (i64 i = top; i != bottom; i++) {
+				buffer->store(i, load(i));
+			}
+
+			return buffer;
+
+		}
+
+	private:
+
+		SizeT capacity;
+		SizeT mask;
+		std::unique_ptr<std::atomic<T>[]> data;
+
+	};
+
+	constexpr static SizeT hdiSize = std::hardware_destructive_interference_size;
+
+public:
+
+	//capacity must be a power of two
+	explicit WorkStealingDeque(SizeT capacity = 256) : top(0), bottom(0) {
+
+		buffers.emplace_back(std::make_unique<Buffer>(capacity));
+		buffer.store(buffers.back().get(), std::memory_order_relaxed);
+
+	}
+
+	WorkStealingDeque(const WorkStealingDeque& deque) = delete;
+	WorkStealingDeque& operator=(const WorkStealingDeque& deque) = delete;
+
+
+	//Pushes an element to the bottom. Owner thread only.
+	void push(T value) {
+
+		i64 b = bottom.load(std::memory_order_relaxed);
+		i64 t = top.load(std::memory_order_acquire);
+		Buffer* a = buffer.load(std::memory_order_relaxed);
+
+		if (b - t > static_cast<i64>(a->size()) - 1) {
+
+			buffers.emplace_back(a->grow(b, t));
+			a = buffers.back().get();
+			buffer.store(a, std::memory_order_release);
+
+		}
+
+		a->store(b, value);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+
+	}
+
+
+	//Pops an element from the bottom. Owner thread only. Returns false if the deque is empty.
+	bool pop(T& value) noexcept {
+
+		i64 b = bottom.load(std::memory_order_relaxed) - 1;
+		Buffer* a = buffer.load(std::memory_order_relaxed);
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		i64 t = top.load(std::memory_order_relaxed);
+
+		if (t > b) {
+
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+
+		}
+
+		value = a->load(b);
+
+		if (t == b) {
+
+			//Last element, race against thieves
+			bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom.store(b + 1, std::memory_order_relaxed);
+
+			return won;
+
+		}
+
+		return true;
+
+	}
+
+
+	//Steals an element from the top. Any thread. Returns false if the deque is empty or the steal lost a race.
+	bool steal(T& value) noexcept {
+
+		i64 t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		i64 b = bottom.load(std::memory_order_acquire);
+
+		if (t >= b) {
+			return false;
+		}
+
+		Buffer* a = buffer.load(std::memory_order_acquire);
+		value = a->load(t);
+
+		return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+
+	}
+
+
+	//Returns whether the deque is empty. It's NOT a qualitative measurement since it might not represent the actual current state!
+	bool empty() const noexcept {
+		return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+	}
+
+private:
+
+	alignas(hdiSize) std::atomic<i64> top;
+	alignas(hdiSize) std::atomic<i64> bottom;
+	std::atomic<Buffer*> buffer;
+
+	std::vector<std::unique_ptr<Buffer>> buffers;
+
+};
\ No newline at end of file
@@ -0,0 +1,158 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 AssetArchive.hpp
+ */
+
+#pragma once
+
+#include "MappedFile.hpp"
+#include "Path.hpp"
+#include "Common/Types.hpp"
+
+#include <span>
+#include <string>
+#include <vector>
+#include <string_view>
+
+
+
+/*
+ *	Packed asset archive.
+ *
+ *	Layout (little endian):
+ *		Header		Magic, version, entry count, index location and data alignment
+ *		Data		Entry contents, each aligned to the archive alignment
+ *		Index		Entry records sorted by path hash, followed by the path strings
+ *
+ *	Paths use forward slashes and are matched case-sensitively; leading "./" and "/" are ignored.
+ *	Entries are stored raw or LZ-compressed. Raw entries can be viewed in place without copying.
+ */
+namespace AssetArchiveFormat {
+
+	constexpr u8 Magic[8] = {'A', 'R', 'C', 'P', 'A', 'C', 'K', 0};
+	constexpr u32 Version = 1;
+
+	constexpr SizeT HeaderSize = 40;
+	constexpr SizeT EntrySize = 48;
+
+	enum class Compression : u32 {
+		None,
+		LZ
+	};
+
+	// Normalizes separators and strips leading "./" and "/"
+	std::string normalizePath(std::string_view path);
+
+	u64 hashPath(std::string_view path) noexcept;
+
+}
+
+
+
+struct AssetEntry {
+
+	std::string_view path;
+	u64 offset;
+	u64 size;						// Uncompressed size
+	u64 storedSize;
+	AssetArchiveFormat::Compression compression;
+
+	constexpr bool compressed() const noexcept {
+		return compression != AssetArchiveFormat::Compression::None;
+	}
+
+};
+
+
+
+class AssetArchive {
+
+public:
+
+	AssetArchive();
+	explicit AssetArchive(const Path& path);
+
+	// Maps the archive and validates its index
+	bool open();
+	bool open(const Path& path);
+	void close();
+
+	bool isOpen() const noexcept;
+
+	bool contains(std::string_view path) const;
+
+	// Returns nullptr if the entry does not exist
+	const AssetEntry* find(std::string_view path) const;
+
+	// Zero-copy view into the mapping, empty if the entry does not exist or is compressed
+	std::span<const u8> view(std::string_view path) const;
+
+	// Decompresses if necessary. Returns false if the entry does not exist or is corrupted.
+	bool read(std::string_view path, std::vector<u8>& data) const;
+	bool read(const AssetEntry& entry, std::span<u8> data) const;
+	std::vector<u8> read(std::string_view path) const;
+
+	// Hints the system to load the entry ahead of access
+	void prefetch(std::string_view path) const;
+
+	const std::vector<AssetEntry>& getEntries() const noexcept;
+	SizeT getEntryCount() const noexcept;
+
+	Path path() const;
+
+private:
+
+	const AssetEntry* findNormalized(std::string_view path) const;
+
+	Path archivePath;
+	MappedFile file;
+
+	std::vector<u64> hashes;		// Parallel to entries, sorted
+	std::vector<AssetEntry> entries;
+
+};
+
+
+
+/*
+ *	Builds archives.
+ *	Entry data is kept in memory until write() is called. Compression is dropped for entries it does not shrink.
+ */
+class AssetArchiveWriter {
+
+public:
+
+	using Compression = AssetArchiveFormat::Compression;
+
+	// Alignment is rounded up to a power of two
+	explicit AssetArchiveWriter(u32 alignment = 16);
+
+	// Replaces existing entries with the same path
+	void add(std::string_view path, std::span<const u8> data, Compression compression = Compression::None);
+	bool addFile(std::string_view path, const Path& file, Compression compression = Compression::None);
+
+	// Adds all files below the directory, paths are relative to it. Returns the number of files added.
+	SizeT addDirectory(const Path& directory, Compression compression = Compression::None);
+
+	bool write(const Path& path) const;
+
+	SizeT getEntryCount() const noexcept;
+
+private:
+
+	struct PendingEntry {
+
+		std::string path;
+		std::vector<u8> data;
+		u64 size;
+		Compression compression;
+
+	};
+
+	u32 alignment;
+	std::vector<PendingEntry> entries;
+
+};
\ No newline at end of file
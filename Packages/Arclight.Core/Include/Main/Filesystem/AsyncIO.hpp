@@ -0,0 +1,175 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 AsyncIO.hpp
+ */
+
+#pragma once
+
+#include "BinaryFile.hpp"
+#include "Common/Types.hpp"
+
+#include <span>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <functional>
+
+
+
+struct IOResult {
+
+	SizeT transferred = 0;
+	i32 error = 0;				// System error code, 0 on success
+
+	constexpr bool success() const noexcept {
+		return !error;
+	}
+
+};
+
+
+using IOCallback = std::function<void(const IOResult&)>;
+
+
+/*
+ *	Positional transfer on an open BinaryFile.
+ *	The file and the data must stay valid until the request completed. Reads are short only at the end of file.
+ */
+struct IORequest {
+
+	enum class Type {
+		Read,
+		Write
+	};
+
+	static IORequest read(const BinaryFile& file, u64 offset, std::span<u8> data, IOCallback callback = {}) {
+		return {&file, Type::Read, offset, data.data(), data.size(), std::move(callback)};
+	}
+
+	static IORequest write(BinaryFile& file, u64 offset, std::span<const u8> data, IOCallback callback = {}) {
+		return {&file, Type::Write, offset, const_cast<u8*>(data.data()), data.size(), std::move(callback)};
+	}
+
+
+	const BinaryFile* file;
+	Type type;
+	u64 offset;
+	u8* data;
+	SizeT size;
+	IOCallback callback;		// Invoked on an I/O thread before the handle becomes ready
+
+};
+
+
+
+namespace Detail {
+
+	struct IOOperation {
+
+		IORequest request;
+		IOResult result;
+		std::atomic<u32> done {0};
+
+		SizeT progress = 0;
+		std::atomic<u32>* pending = nullptr;	// Pending counter of the owning service
+		std::shared_ptr<IOOperation> self;		// Keeps the operation alive while in flight
+
+	};
+
+
+	class AsyncIOBackend {
+
+	public:
+
+		virtual ~AsyncIOBackend() noexcept = default;
+
+		// Takes ownership of the operations' self references
+		virtual void submit(std::span<IOOperation* const> operations) = 0;
+
+	};
+
+
+	// Completes the operation and releases its self reference
+	void completeOperation(IOOperation& operation, SizeT transferred, i32 error) noexcept;
+
+	// Returns nullptr if the platform offers no native asynchronous I/O
+	std::unique_ptr<AsyncIOBackend> createNativeAsyncIOBackend(u32 queueDepth);
+
+}
+
+
+
+class IOHandle {
+
+public:
+
+	IOHandle() noexcept = default;
+
+	bool valid() const noexcept {
+		return operation != nullptr;
+	}
+
+	bool finished() const noexcept {
+		return !operation || operation->done.load(std::memory_order_acquire);
+	}
+
+	// Blocks until the request completed
+	const IOResult& wait() const;
+
+private:
+
+	friend class AsyncIO;
+
+	explicit IOHandle(std::shared_ptr<Detail::IOOperation> operation) noexcept : operation(std::move(operation)) {}
+
+	std::shared_ptr<Detail::IOOperation> operation;
+
+};
+
+
+
+/*
+ *	Asynchronous I/O service.
+ *
+ *	Requests are submitted in batches and complete out of order. On Linux, io_uring is used where the kernel supports it,
+ *	otherwise requests are executed by a pool of I/O threads performing positional transfers.
+ *	Destroying the service waits for all pending requests.
+ */
+class AsyncIO {
+
+public:
+
+	enum class Backend {
+		Auto,
+		Native,
+		ThreadPool
+	};
+
+	explicit AsyncIO(Backend backend = Backend::Auto, u32 queueDepth = 128, u32 threadCount = 4);
+	~AsyncIO();
+
+	AsyncIO(const AsyncIO& io) = delete;
+	AsyncIO& operator=(const AsyncIO& io) = delete;
+
+	IOHandle submit(IORequest request);
+	std::vector<IOHandle> submit(std::span<IORequest> requests);
+
+	// Blocks until all submitted requests completed
+	void waitIdle() const;
+
+	SizeT getPendingCount() const noexcept;
+
+	// Returns the backend in use, never Auto
+	Backend getBackend() const noexcept;
+
+private:
+
+	std::unique_ptr<Detail::AsyncIOBackend> backend;
+	Backend backendType;
+
+	mutable std::atomic<u32> pending;
+
+};
\ No newline at end of file
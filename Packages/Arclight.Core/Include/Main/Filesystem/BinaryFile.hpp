@@ -0,0 +1,151 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 BinaryFile.hpp
+ */
+
+#pragma once
+
+#include "Path.hpp"
+#include "Common/Types.hpp"
+
+#include <span>
+#include <vector>
+#include <memory>
+
+
+
+/*
+ *	Unformatted file with a user-space buffer for sequential access and unbuffered positional access.
+ *
+ *	Sequential reads and writes go through a single buffer of configurable size; requests at least as large as the buffer
+ *	bypass it entirely. All transfers are issued at explicit offsets, so the OS file position is never used.
+ *	readAt() and writeAt() do not touch the cursor or the buffer and may be called from any number of threads concurrently.
+ *	They do not observe buffered sequential writes that have not been flushed yet.
+ */
+class BinaryFile {
+
+public:
+
+	enum Flags : u32 {
+		In = 0x1,
+		Out = 0x2,			// Creates the file if it does not exist
+		Append = 0x4,		// Places the cursor at the end of the file
+		Trunc = 0x8
+	};
+
+	enum class Access {
+		Default,
+		Sequential,
+		Random
+	};
+
+	enum class FlushPolicy {
+		Buffered,			// Written when the buffer is full, on flush(), seeks away from pending data and close()
+		Immediate			// Every sequential write is passed to the system before returning
+	};
+
+	static constexpr SizeT DefaultBufferSize = 256 * 1024;
+
+
+	BinaryFile();
+	explicit BinaryFile(const Path& path, u32 flags = In, Access access = Access::Default);
+	~BinaryFile();
+
+	BinaryFile(const BinaryFile& file) = delete;
+	BinaryFile& operator=(const BinaryFile& file) = delete;
+	BinaryFile(BinaryFile&& file) noexcept;
+	BinaryFile& operator=(BinaryFile&& file) noexcept;
+
+	bool open();
+	bool open(const Path& path, u32 flags = In, Access access = Access::Default);
+	void close();
+
+	bool isOpen() const noexcept;
+
+	// Flushes pending data and resizes the buffer, 0 disables buffering
+	void setBufferSize(SizeT size);
+	SizeT getBufferSize() const noexcept;
+
+	void setFlushPolicy(FlushPolicy policy);
+	FlushPolicy getFlushPolicy() const noexcept;
+
+
+	// Sequential access at the cursor, returns the number of bytes transferred
+	SizeT read(std::span<u8> data);
+	SizeT write(std::span<const u8> data);
+
+	std::vector<u8> readAll();
+
+	// Passes buffered writes to the system
+	bool flush();
+
+	// Flushes and waits until the file contents reached the storage device
+	bool sync();
+
+	void seek(i64 offset);
+	void seekTo(u64 offset);
+	void seekFromEnd(u64 offset);
+
+	u64 getPosition() const noexcept;
+
+
+	// Positional access, safe to call concurrently. Returns the number of bytes transferred, which is short only at the end of file or on error.
+	SizeT readAt(u64 offset, std::span<u8> data) const;
+	SizeT writeAt(u64 offset, std::span<const u8> data);
+
+
+	// Declares the expected access pattern for a range of the file, size 0 extends to the end of file
+	void advise(u64 offset, u64 size, Access access) const noexcept;
+
+	// Hints the system to start reading the given range in the background
+	void prefetch(u64 offset, u64 size) const noexcept;
+
+
+	// Includes buffered data that has not been flushed yet
+	u64 size() const;
+
+	Path path() const;
+
+
+	using Handle = AddressT;
+
+	static constexpr Handle InvalidHandle = -1;
+
+	// File descriptor on POSIX systems, HANDLE on Windows
+	Handle getNativeHandle() const noexcept;
+
+private:
+
+
+	// Platform implementation
+	bool openHandle();
+	void closeHandle() noexcept;
+
+	SizeT readNative(u64 offset, u8* data, SizeT size) const;
+	SizeT writeNative(u64 offset, const u8* data, SizeT size);
+
+	u64 nativeSize() const;
+	bool syncNative();
+
+
+	bool flushBuffer();
+	void discardBuffer() noexcept;
+
+	Path filePath;
+	u32 openFlags;
+	Access accessHint;
+	FlushPolicy flushPolicy;
+
+	Handle handle;
+	u64 position;
+
+	std::unique_ptr<u8[]> buffer;
+	SizeT bufferCapacity;
+	u64 bufferOffset;		// File offset of the first buffered byte
+	SizeT bufferSize;		// Valid bytes in the buffer
+	bool bufferDirty;		// Buffer holds pending writes instead of read-ahead data
+
+};
\ No newline at end of file
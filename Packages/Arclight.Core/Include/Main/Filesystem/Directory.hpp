@@ -13,6 +13,7 @@
 
 #include <vector>
 #include <variant>
+#include <string_view>
 
 
 
@@ -83,6 +84,17 @@ public:
 		SizeDescending
 	};
 
+	/*
+		Sort key computed once per entry.
+		Entries are ordered by type rank, then by value and finally by the primary and secondary strings.
+	*/
+	struct SortKey {
+		u32 rank;
+		u64 value;
+		std::string_view primary;
+		std::string_view secondary;
+	};
+
 	Directory();
 	Directory(const Path& path);
 	Directory(FSEntry entry);
@@ -139,6 +151,10 @@ public:
 	Path getPath() const;
 	FSEntry getFSEntry() const;
 
+
+	static u32 getSortRank(FSEntry::Type type) noexcept;
+	static bool compareKeys(const SortKey& a, const SortKey& b, Sorting sorting) noexcept;
+
 private:
 
 	FSEntry entry;
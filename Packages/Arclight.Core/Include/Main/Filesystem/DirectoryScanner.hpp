@@ -0,0 +1,103 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 DirectoryScanner.hpp
+ */
+
+#pragma once
+
+#include "Directory.hpp"
+#include "Path.hpp"
+#include "Util/BitmaskEnum.hpp"
+#include "Common/Types.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <string_view>
+
+
+
+struct ScannedEntry {
+
+	std::string path;			// Relative to the scan root, separated by '/'
+	FSEntry::Type type;
+	u64 size;					// Files only, requires DirectoryScanner::Metadata
+	u64 modified;				// Nanoseconds since the Unix epoch, requires DirectoryScanner::Metadata
+	u32 nameOffset;				// Start of the file name in path
+	u32 extensionOffset;		// Start of the extension including the dot, path.size() if there is none
+
+	std::string_view name() const noexcept {
+		return std::string_view(path).substr(nameOffset);
+	}
+
+	std::string_view stem() const noexcept {
+		return std::string_view(path).substr(nameOffset, extensionOffset - nameOffset);
+	}
+
+	std::string_view extension() const noexcept {
+		return std::string_view(path).substr(extensionOffset);
+	}
+
+};
+
+
+
+namespace Detail {
+
+	// Platform directory handle shared by all pending subdirectories so they can be opened relative to it
+	struct ScanHandle;
+
+	struct ScanTask {
+
+		std::shared_ptr<ScanHandle> parent;
+		std::string path;
+
+	};
+
+	/*
+		Reads a single directory. Subdirectories are appended to entries and to subdirectories.
+		Returns false if the directory could not be opened.
+	*/
+	bool scanDirectory(const Path& root, const ScanTask& task, bool metadata, std::vector<ScannedEntry>& entries, std::vector<ScanTask>& subdirectories);
+
+}
+
+
+
+/*
+ *	Recursive directory scanner.
+ *
+ *	Subtrees are read in parallel and every entry's metadata is collected exactly once while reading its directory
+ *	(getdents64 and fstatat relative to the open parent on Linux, FindFirstFileEx on Windows).
+ *	Symbolic links are reported but never followed. Unreadable directories are skipped.
+ */
+class DirectoryScanner {
+
+public:
+
+	enum class Flags {
+		None = 0x0,
+		Recursive = 0x1,
+		Metadata = 0x2			// Collect sizes and modification times
+	};
+
+	using enum Flags;
+
+	// 0 uses all hardware threads
+	explicit DirectoryScanner(u32 threadCount = 0);
+
+	std::vector<ScannedEntry> scan(const Path& root, Flags flags = Recursive) const;
+
+	// Orders entries like Directory::listEntries. Date and size sorting require metadata.
+	static void sort(std::vector<ScannedEntry>& entries, Directory::Sorting sorting);
+
+private:
+
+	u32 threadCount;
+
+};
+
+ARC_CREATE_BITMASK_ENUM(DirectoryScanner::Flags)
\ No newline at end of file
@@ -51,6 +51,8 @@ public:
 	void write(const std::span<const u8>& data);
 	std::vector<u8> readAll();
 
+	void flush();
+
 	void seek(i64 offset);
 	void seekTo(u64 offset);
 	void seekFromEnd(u64 offset);
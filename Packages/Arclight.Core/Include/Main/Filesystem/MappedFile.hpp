@@ -0,0 +1,74 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 MappedFile.hpp
+ */
+
+#pragma once
+
+#include "Path.hpp"
+#include "Common/Types.hpp"
+
+#include <span>
+#include <vector>
+
+
+
+/*
+ *	Read-only view of a whole file.
+ *	The file is memory-mapped where the platform allows it, otherwise its contents are read into an owned buffer.
+ */
+class MappedFile {
+
+public:
+
+	enum class Access {
+		Default,
+		Sequential,
+		Random
+	};
+
+	MappedFile();
+	explicit MappedFile(const Path& path, Access access = Access::Default);
+	~MappedFile();
+
+	MappedFile(const MappedFile& file) = delete;
+	MappedFile& operator=(const MappedFile& file) = delete;
+	MappedFile(MappedFile&& file) noexcept;
+	MappedFile& operator=(MappedFile&& file) noexcept;
+
+	bool open();
+	bool open(const Path& path, Access access = Access::Default);
+	void close();
+
+	bool isOpen() const noexcept;
+	bool isMapped() const noexcept;
+
+	std::span<const u8> data() const noexcept;
+	SizeT size() const noexcept;
+
+	Path path() const;
+
+	// Hints the system to load the given range ahead of access
+	void prefetch(SizeT offset, SizeT size) const noexcept;
+
+private:
+
+	bool map();
+	void unmap() noexcept;
+
+	bool readFallback();
+
+	Path filePath;
+	Access accessHint;
+
+	const u8* view;
+	SizeT viewSize;
+	bool mapped;
+	bool opened;
+
+	std::vector<u8> buffer;
+
+};
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Pixel.hpp"
+#include "PixelConversion.hpp"
 #include "RawImage.hpp"
 #include "Math/Vector.hpp"
 #include "Math/Rectangle.hpp"
@@ -357,23 +357,22 @@ template<Pixel Q>
 Image<Q> Image<P>::convert() const {
 
 	if constexpr (P == Q) {
-		return *this;
-	}
 
-	Image<Q> img(width, height);
+		return *this;
 
-	for (u32 y = 0; y < height; y++) {
+	} else {
 
-		for (u32 x = 0; x < width; x++) {
+		Image<Q> img;
+		img.width = width;
+		img.height = height;
+		img.pixels = std::make_unique_for_overwrite<typename Image<Q>::PixelType[]>(pixelCount());
 
-			img.setPixel(x, y, PixelConverter::convert<Q>(getPixel(x, y)));
+		PixelConversion::convert<P, Q>(getImageData(), img.getImageData(), pixelCount());
 
-		}
+		return img;
 
 	}
 
-	return img;
-
 }
 
 
@@ -413,12 +412,29 @@ Image<P> Image<P>::fromRaw(RawImage& image, bool allowConversion) {
 
 		using Type = ::PixelType<From>;
 
-		Image<From> newImage;
-		newImage.width = w;
-		newImage.height = h;
-		newImage.pixels = std::unique_ptr<Type[]>(reinterpret_cast<Type*>(image.release().data()));
+		if constexpr (sizeof(Type) == sizeof(PixelType)) {
 
-		return newImage.template convert<P>();
+			// Same pixel size, convert within the raw buffer
+			std::span<u8> data = image.release();
+			PixelConversion::convert<From, P>(data.data(), data.size() / sizeof(Type));
+
+			Image<P> newImage;
+			newImage.width = w;
+			newImage.height = h;
+			newImage.pixels = std::unique_ptr<PixelType[]>(reinterpret_cast<PixelType*>(data.data()));
+
+			return newImage;
+
+		} else {
+
+			Image<From> newImage;
+			newImage.width = w;
+			newImage.height = h;
+			newImage.pixels = std::unique_ptr<Type[]>(reinterpret_cast<Type*>(image.release().data()));
+
+			return newImage.template convert<P>();
+
+		}
 
 	};
 
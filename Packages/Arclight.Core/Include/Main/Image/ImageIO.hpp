@@ -17,6 +17,7 @@
 #include "Decode/TGADecoder.hpp"
 #include "Encode/Encoder.hpp"
 #include "Encode/PPMEncoder.hpp"
+#include "Filesystem/MappedFile.hpp"
 #include "Util/Bool.hpp"
 
 
@@ -27,6 +28,8 @@ namespace ImageIO {
 
 		std::vector<u8> loadFile(const Path& path);
 
+		MappedFile mapFile(const Path& path);
+
 		void saveFile(const Path& path, std::span<const u8> data);
 
 	}
@@ -46,9 +49,14 @@ namespace ImageIO {
 
 	}
 
+	template<CC::ImageDecoder Decoder, class... Args>
+	Decoder decode(const MappedFile& file, std::optional<Pixel> reqFormat = {}, Args&&... args) {
+		return decode<Decoder, Args...>(file.data(), reqFormat, std::forward<Args>(args)...);
+	}
+
 	template<CC::ImageDecoder Decoder, class... Args>
 	Decoder decode(const Path& path, std::optional<Pixel> reqFormat = {}, Args&&... args) {
-		return decode<Decoder, Args...>(Detail::loadFile(path), reqFormat, std::forward<Args>(args)...);
+		return decode<Decoder, Args...>(Detail::mapFile(path), reqFormat, std::forward<Args>(args)...);
 	}
 
 	template<CC::ImageEncoder Encoder, class Img, class... Args>
@@ -77,7 +85,7 @@ namespace ImageIO {
 
 	template<Pixel P, CC::ImageDecoder Decoder, class... Args>
 	Image<P> load(const Path& path, Args&&... args) {
-		return load<P, Decoder, Args...>(Detail::loadFile(path), std::forward<Args>(args)...);
+		return load<P, Decoder, Args...>(Detail::mapFile(path).data(), std::forward<Args>(args)...);
 	}
 
 	template<Pixel P, CC::ImageEncoder Encoder, class Img, class... Args>
@@ -102,7 +110,7 @@ namespace ImageIO {
 
 	template<CC::ImageDecoder Decoder, class... Args>
 	RawImage load(const Path& path, Args&&... args) {
-		return load<Decoder, Args...>(Detail::loadFile(path), std::forward<Args>(args)...);
+		return load<Decoder, Args...>(Detail::mapFile(path).data(), std::forward<Args>(args)...);
 	}
 
 	template<CC::ImageEncoder Encoder, class Img, class... Args>
@@ -128,36 +136,41 @@ namespace ImageIO {
 	namespace Detail {
 
 		template<bool Raw, Pixel P = Pixel::RGB8>
-		auto fileLoad(const Path& path) -> TT::Conditional<Raw, RawImage, Image<P>> {
+		auto extensionLoad(const std::span<const u8>& bytes, const std::string& ext) -> TT::Conditional<Raw, RawImage, Image<P>> {
 
-			auto doLoad = []<CC::ImageDecoder Decoder>(const Path& p) {
+			auto doLoad = [&]<CC::ImageDecoder Decoder>() {
 
 				if constexpr (Raw) {
-					return load<Decoder>(p);
+					return load<Decoder>(bytes);
 				} else {
-					return load<P, Decoder>(p);
+					return load<P, Decoder>(bytes);
 				}
 
 			};
 
-			std::string ext = path.getExtension();
-
 			if (ext == ".bmp") {
-				return doLoad.template operator()<BitmapDecoder>(path);
+				return doLoad.template operator()<BitmapDecoder>();
 			} else if (Bool::any(ext, ".jpg", ".jpeg", ".jfif")) {
-				return doLoad.template operator()<JPEGDecoder>(path);
+				return doLoad.template operator()<JPEGDecoder>();
 			} else if (ext == ".ppm") {
-	            return doLoad.template operator()<PPMDecoder>(path);
+	            return doLoad.template operator()<PPMDecoder>();
 	        } else if (ext == ".qoi") {
-	            return doLoad.template operator()<QOIDecoder>(path);
+	            return doLoad.template operator()<QOIDecoder>();
 	        } else if (ext == ".tga") {
-	            return doLoad.template operator()<TGADecoder>(path);
+	            return doLoad.template operator()<TGADecoder>();
 	        }
 
 			throw ImageException("Unknown image file format");
 
 		}
 
+		template<bool Raw, Pixel P = Pixel::RGB8>
+		auto fileLoad(const Path& path) -> TT::Conditional<Raw, RawImage, Image<P>> {
+
+			return extensionLoad<Raw, P>(mapFile(path).data(), path.getExtension());
+
+		}
+
 		template<class Img>
 		void fileSave(const Path& path, const Img& image) {
 
@@ -187,6 +200,18 @@ namespace ImageIO {
 		return Detail::fileLoad<true>(path);
 	}
 
+	/*
+	 *  Extension-selected decoding of in-memory files (e.g. ".qoi")
+	 */
+	template<Pixel P>
+	Image<P> load(const std::span<const u8>& bytes, const std::string& extension) {
+		return Detail::extensionLoad<false, P>(bytes, extension);
+	}
+
+	inline RawImage load(const std::span<const u8>& bytes, const std::string& extension) {
+		return Detail::extensionLoad<true>(bytes, extension);
+	}
+
 	template<Pixel P>
 	void save(const Path& path, const Image<P>& image) {
 		return Detail::fileSave(path, image);
@@ -673,9 +673,17 @@ public:
 
 		SrcType t = pixel.pack();
 
+		// Single channel sources expand into all color channels
+		constexpr bool Monochrome = SrcFormat::Channels == 1;
+
+		constexpr u32 GreenMaskIn = Monochrome ? SrcFormat::RedMask : SrcFormat::GreenMask;
+		constexpr u32 GreenShiftIn = Monochrome ? SrcFormat::RedShift : SrcFormat::GreenShift;
+		constexpr u32 BlueMaskIn = Monochrome ? SrcFormat::RedMask : SrcFormat::BlueMask;
+		constexpr u32 BlueShiftIn = Monochrome ? SrcFormat::RedShift : SrcFormat::BlueShift;
+
 		constexpr u32 RBitsIn = Bits::popcount(SrcFormat::RedMask);
-		constexpr u32 GBitsIn = Bits::popcount(SrcFormat::GreenMask);
-		constexpr u32 BBitsIn = Bits::popcount(SrcFormat::BlueMask);
+		constexpr u32 GBitsIn = Bits::popcount(GreenMaskIn);
+		constexpr u32 BBitsIn = Bits::popcount(BlueMaskIn);
 		constexpr u32 ABitsIn = Bits::popcount(SrcFormat::AlphaMask);
 		constexpr u32 RBitsOut = Bits::popcount(DestFormat::RedMask);
 		constexpr u32 GBitsOut = Bits::popcount(DestFormat::GreenMask);
@@ -683,8 +691,8 @@ public:
 		constexpr u32 ABitsOut = Bits::popcount(DestFormat::AlphaMask);
 
 		SrcType RValueIn = (t & SrcFormat::RedMask) >> SrcFormat::RedShift;
-		SrcType GValueIn = (t & SrcFormat::GreenMask) >> SrcFormat::GreenShift;
-		SrcType BValueIn = (t & SrcFormat::BlueMask) >> SrcFormat::BlueShift;
+		SrcType GValueIn = (t & GreenMaskIn) >> GreenShiftIn;
+		SrcType BValueIn = (t & BlueMaskIn) >> BlueShiftIn;
 		SrcType AValueIn = (t & SrcFormat::AlphaMask) >> SrcFormat::AlphaShift;
 
 		DestType RValueOut = convertChannel<ConvType, RBitsIn, RBitsOut>(RValueIn) << DestFormat::RedShift;
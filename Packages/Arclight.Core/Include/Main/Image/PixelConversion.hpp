@@ -0,0 +1,422 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 PixelConversion.hpp
+ */
+
+#pragma once
+
+#include "Pixel.hpp"
+#include "Common/Intrinsic.hpp"
+#include "Common/Vendor.hpp"
+
+#include <array>
+#include <span>
+#include <utility>
+
+#include ARC_INTRINSIC_H
+
+
+
+/*
+ *	Bulk pixel conversion kernels
+ *	Results are identical to PixelConverter::convert applied per pixel.
+ *	Formats with whole-byte channels are converted with byte shuffles (SSSE3/AVX2), packed formats with lookup tables.
+ *	Source and destination may alias if the destination pixel is not larger than the source pixel.
+ */
+namespace PixelConversion {
+
+	using Kernel = void(*)(const u8* src, u8* dst, SizeT count);
+
+
+	namespace Detail {
+
+		// Marks a destination byte receiving an opaque alpha value
+		constexpr u8 Opaque = 0xFF;
+
+		// pshufb index producing zero
+		constexpr u8 ShuffleZero = 0x80;
+
+
+		template<Pixel P>
+		constexpr bool isByteFormat() {
+
+			using F = PixelFormat<P>;
+
+			constexpr auto byteChannel = [](u32 mask, u32 shift) {
+				return !mask || (mask == (0xFFu << shift) && shift % 8 == 0);
+			};
+
+			return byteChannel(F::RedMask, F::RedShift) && byteChannel(F::GreenMask, F::GreenShift) && byteChannel(F::BlueMask, F::BlueShift) && byteChannel(F::AlphaMask, F::AlphaShift);
+
+		}
+
+		// Source byte index for each destination byte, Opaque for missing alpha
+		template<Pixel From, Pixel To>
+		constexpr std::array<u8, 4> byteMap() {
+
+			using S = PixelFormat<From>;
+			using D = PixelFormat<To>;
+
+			std::array<u8, 4> map {};
+
+			constexpr bool Monochrome = S::Channels == 1;
+
+			if constexpr (D::RedMask) {
+				map[D::RedShift / 8] = S::RedShift / 8;
+			}
+
+			if constexpr (D::GreenMask) {
+				map[D::GreenShift / 8] = (S::GreenMask || !Monochrome) ? S::GreenShift / 8 : S::RedShift / 8;
+			}
+
+			if constexpr (D::BlueMask) {
+				map[D::BlueShift / 8] = (S::BlueMask || !Monochrome) ? S::BlueShift / 8 : S::RedShift / 8;
+			}
+
+			if constexpr (D::AlphaMask) {
+				map[D::AlphaShift / 8] = S::AlphaMask ? S::AlphaShift / 8 : Opaque;
+			}
+
+			return map;
+
+		}
+
+
+		template<Pixel From, Pixel To>
+		struct ShuffleData {
+
+			static constexpr u32 SrcBytes = PixelFormat<From>::BytesPerPixel;
+			static constexpr u32 DstBytes = PixelFormat<To>::BytesPerPixel;
+
+			// Pixels per 16 byte vector
+			static constexpr u32 Pixels = 16 / Math::max(SrcBytes, DstBytes);
+
+			// Vectors overwrite trailing bytes past the converted pixels; aliasing is only safe if those are not read again
+			static constexpr bool AliasSafe = SrcBytes == DstBytes || Pixels * SrcBytes == 16;
+
+			static constexpr std::array<std::array<u8, 16>, 2> Masks = []() {
+
+				constexpr std::array<u8, 4> Map = byteMap<From, To>();
+
+				std::array<std::array<u8, 16>, 2> masks {};
+				auto& [shuffle, alpha] = masks;
+
+				for (u32 i = 0; i < 16; i++) {
+
+					if (i >= Pixels * DstBytes) {
+
+						// Keep trailing bytes intact when layouts line up, zero them otherwise
+						shuffle[i] = SrcBytes == DstBytes ? i : ShuffleZero;
+						continue;
+
+					}
+
+					u8 index = Map[i % DstBytes];
+
+					if (index == Opaque) {
+						shuffle[i] = ShuffleZero;
+						alpha[i] = 0xFF;
+					} else {
+						shuffle[i] = (i / DstBytes) * SrcBytes + index;
+					}
+
+				}
+
+				return masks;
+
+			}();
+
+		};
+
+
+		template<Pixel From, Pixel To>
+		ARC_TARGET("ssse3") SizeT shuffleSSSE3(const u8* src, u8* dst, SizeT count, SizeT i) {
+
+			using Data = ShuffleData<From, To>;
+
+			const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data::Masks[0].data()));
+			const __m128i alpha = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data::Masks[1].data()));
+
+			for (; i + Data::Pixels <= count && (i * Data::SrcBytes + 16 <= count * Data::SrcBytes) && (i * Data::DstBytes + 16 <= count * Data::DstBytes); i += Data::Pixels) {
+
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * Data::SrcBytes));
+				v = _mm_or_si128(_mm_shuffle_epi8(v, shuffle), alpha);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * Data::DstBytes), v);
+
+			}
+
+			return i;
+
+		}
+
+		template<Pixel From, Pixel To>
+		ARC_TARGET("avx2") SizeT shuffleAVX2(const u8* src, u8* dst, SizeT count, SizeT i) {
+
+			using Data = ShuffleData<From, To>;
+
+			constexpr SizeT Step = Data::Pixels * 2;
+
+			const __m128i shuffle128 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data::Masks[0].data()));
+			const __m128i alpha128 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data::Masks[1].data()));
+
+			const __m256i shuffle = _mm256_broadcastsi128_si256(shuffle128);
+			const __m256i alpha = _mm256_broadcastsi128_si256(alpha128);
+
+			for (; i + Step <= count && ((i + Data::Pixels) * Data::SrcBytes + 16 <= count * Data::SrcBytes) && ((i + Data::Pixels) * Data::DstBytes + 16 <= count * Data::DstBytes); i += Step) {
+
+				const u8* s = src + i * Data::SrcBytes;
+				u8* d = dst + i * Data::DstBytes;
+
+				__m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+				__m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + Data::Pixels * Data::SrcBytes));
+
+				__m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+				v = _mm256_or_si256(_mm256_shuffle_epi8(v, shuffle), alpha);
+
+				if constexpr (Data::Pixels * Data::DstBytes == 16) {
+
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(d), v);
+
+				} else {
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(d), _mm256_castsi256_si128(v));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(d + Data::Pixels * Data::DstBytes), _mm256_extracti128_si256(v, 1));
+
+				}
+
+			}
+
+			return i;
+
+		}
+
+
+		template<Pixel From, Pixel To>
+		void shuffleKernel(const u8* src, u8* dst, SizeT count) {
+
+			using Data = ShuffleData<From, To>;
+
+			constexpr std::array<u8, 4> Map = byteMap<From, To>();
+
+			SizeT i = 0;
+
+			if (Data::AliasSafe || src != dst) {
+
+				arc_intrinsic_avx2 (
+					i = shuffleAVX2<From, To>(src, dst, count, i);
+				)
+
+				arc_intrinsic_ssse3 (
+					i = shuffleSSSE3<From, To>(src, dst, count, i);
+				)
+
+			}
+
+			for (; i < count; i++) {
+
+				u8 pixel[4];
+				std::copy_n(src + i * Data::SrcBytes, Data::SrcBytes, pixel);
+
+				for (u32 j = 0; j < Data::DstBytes; j++) {
+					dst[i * Data::DstBytes + j] = Map[j] == Opaque ? 0xFF : pixel[Map[j]];
+				}
+
+			}
+
+		}
+
+
+		// Channel depth conversion tables, mirroring PixelConverter rounding
+		constexpr std::array<u8, 32> Expand5 = []() {
+
+			std::array<u8, 32> table {};
+
+			for (u32 i = 0; i < 32; i++) {
+#ifdef ARC_CFG_PIXEL_EXACT
+				table[i] = (i * 255 * 2 + 31) / 62;
+#else
+				table[i] = i << 3;
+#endif
+			}
+
+			return table;
+
+		}();
+
+		constexpr std::array<u8, 256> Reduce8 = []() {
+
+			std::array<u8, 256> table {};
+
+			for (u32 i = 0; i < 256; i++) {
+#ifdef ARC_CFG_PIXEL_EXACT
+				table[i] = (i * 31 * 2 + 255) / 510;
+#else
+				table[i] = i >> 3;
+#endif
+			}
+
+			return table;
+
+		}();
+
+		template<u32 InBits, u32 OutBits>
+		constexpr u32 convertChannel(u32 value) {
+
+			static_assert((InBits == 5 || InBits == 8) && (OutBits == 5 || OutBits == 8), "Unsupported channel depth");
+
+			if constexpr (InBits == OutBits) {
+				return value;
+			} else if constexpr (InBits == 5) {
+				return Expand5[value];
+			} else {
+				return Reduce8[value];
+			}
+
+		}
+
+		template<Pixel From, Pixel To>
+		void packedKernel(const u8* src, u8* dst, SizeT count) {
+
+			using S = PixelFormat<From>;
+			using D = PixelFormat<To>;
+
+			constexpr bool Monochrome = S::Channels == 1;
+
+			constexpr u32 RBitsIn = Bits::popcount(S::RedMask);
+			constexpr u32 GBitsIn = Bits::popcount(S::GreenMask);
+			constexpr u32 BBitsIn = Bits::popcount(S::BlueMask);
+			constexpr u32 ABitsIn = Bits::popcount(S::AlphaMask);
+			constexpr u32 RBitsOut = Bits::popcount(D::RedMask);
+			constexpr u32 GBitsOut = Bits::popcount(D::GreenMask);
+			constexpr u32 BBitsOut = Bits::popcount(D::BlueMask);
+			constexpr u32 ABitsOut = Bits::popcount(D::AlphaMask);
+
+			auto channel = []<u32 InBits, u32 OutBits>(u32 packed, u32 mask, u32 shift) -> u32 {
+
+				if constexpr (OutBits == 0) {
+					return 0;
+				} else if constexpr (InBits == 0) {
+					return 0;
+				} else {
+					return convertChannel<InBits, OutBits>((packed & mask) >> shift);
+				}
+
+			};
+
+			for (SizeT i = 0; i < count; i++) {
+
+				u32 in = 0;
+
+				for (u32 j = 0; j < S::BytesPerPixel; j++) {
+					in |= src[i * S::BytesPerPixel + j] << (j * 8);
+				}
+
+				u32 r = channel.template operator()<RBitsIn, RBitsOut>(in, S::RedMask, S::RedShift);
+				u32 g, b, a;
+
+				if constexpr (Monochrome) {
+					g = channel.template operator()<RBitsIn, GBitsOut>(in, S::RedMask, S::RedShift);
+					b = channel.template operator()<RBitsIn, BBitsOut>(in, S::RedMask, S::RedShift);
+				} else {
+					g = channel.template operator()<GBitsIn, GBitsOut>(in, S::GreenMask, S::GreenShift);
+					b = channel.template operator()<BBitsIn, BBitsOut>(in, S::BlueMask, S::BlueShift);
+				}
+
+				if constexpr (ABitsIn == 0) {
+					a = D::AlphaMask >> D::AlphaShift;
+				} else {
+					a = channel.template operator()<ABitsIn, ABitsOut>(in, S::AlphaMask, S::AlphaShift);
+				}
+
+				u32 out = (r << D::RedShift) | (g << D::GreenShift) | (b << D::BlueShift) | (a << D::AlphaShift);
+
+				for (u32 j = 0; j < D::BytesPerPixel; j++) {
+					dst[i * D::BytesPerPixel + j] = (out >> (j * 8)) & 0xFF;
+				}
+
+			}
+
+		}
+
+	}
+
+
+	template<Pixel From, Pixel To>
+	void convert(const u8* src, u8* dst, SizeT count) {
+
+		if constexpr (Detail::isByteFormat<From>() && Detail::isByteFormat<To>()) {
+			Detail::shuffleKernel<From, To>(src, dst, count);
+		} else {
+			Detail::packedKernel<From, To>(src, dst, count);
+		}
+
+	}
+
+	// In-place conversion requires the destination pixel to be no larger than the source pixel
+	template<Pixel From, Pixel To> requires (PixelFormat<To>::BytesPerPixel <= PixelFormat<From>::BytesPerPixel)
+	void convert(u8* data, SizeT count) {
+		convert<From, To>(data, data, count);
+	}
+
+
+	namespace Detail {
+
+		template<SizeT From, SizeT... To>
+		constexpr std::array<Kernel, sizeof...(To)> kernelRow(std::index_sequence<To...>) {
+			return {&PixelConversion::convert<static_cast<Pixel>(From), static_cast<Pixel>(To)>...};
+		}
+
+		template<SizeT... From>
+		constexpr auto kernelTable(std::index_sequence<From...> seq) {
+			return std::array{kernelRow<From>(seq)...};
+		}
+
+		constexpr SizeT PixelCount = static_cast<SizeT>(Pixel::ARGB8) + 1;
+
+		constexpr auto Kernels = kernelTable(std::make_index_sequence<PixelCount>{});
+
+	}
+
+
+	constexpr Kernel getKernel(Pixel from, Pixel to) noexcept {
+		return Detail::Kernels[static_cast<SizeT>(from)][static_cast<SizeT>(to)];
+	}
+
+	constexpr u32 getPixelBytes(Pixel pixel) noexcept {
+
+		switch (pixel) {
+
+			case Pixel::Grayscale8:	return PixelFormat<Pixel::Grayscale8>::BytesPerPixel;
+			case Pixel::BGR5:		return PixelFormat<Pixel::BGR5>::BytesPerPixel;
+			case Pixel::RGB5:		return PixelFormat<Pixel::RGB5>::BytesPerPixel;
+			case Pixel::BGR8:		return PixelFormat<Pixel::BGR8>::BytesPerPixel;
+			case Pixel::RGB8:		return PixelFormat<Pixel::RGB8>::BytesPerPixel;
+			case Pixel::RGBA8:		return PixelFormat<Pixel::RGBA8>::BytesPerPixel;
+			case Pixel::ABGR8:		return PixelFormat<Pixel::ABGR8>::BytesPerPixel;
+			case Pixel::BGRA8:		return PixelFormat<Pixel::BGRA8>::BytesPerPixel;
+			case Pixel::ARGB8:		return PixelFormat<Pixel::ARGB8>::BytesPerPixel;
+			default: std::unreachable();
+
+		}
+
+	}
+
+	// Converts pixels of runtime formats, returns the number of pixels converted
+	inline SizeT convert(Pixel from, Pixel to, std::span<const u8> src, std::span<u8> dst) {
+
+		SizeT count = src.size() / getPixelBytes(from);
+
+		arc_assert(dst.size() >= count * getPixelBytes(to), "Pixel conversion destination too small");
+		arc_assert(src.data() != dst.data() || getPixelBytes(to) <= getPixelBytes(from), "In-place pixel conversion cannot expand pixels");
+
+		getKernel(from, to)(src.data(), dst.data(), count);
+
+		return count;
+
+	}
+
+}
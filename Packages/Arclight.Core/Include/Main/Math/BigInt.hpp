@@ -16,6 +16,14 @@
 
 #include <vector>
 #include <span>
+#include <string>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef ARC_COMPILER_MSVC
+	#include <intrin.h>
+#endif
 
 
 
@@ -23,30 +31,246 @@ class BigInt {
 
 private:
 
-	using ValueT = u32;
+	using ValueT = u64;
 
 	constexpr static u32 ValueBits = Bits::bitCount<ValueT>();
 
+	//Balanced operand sizes in limbs from which Karatsuba and Toom-3 multiplication take over, tuned on x86-64
+	constexpr static SizeT KaratsubaThreshold = 24;
+	constexpr static SizeT Toom3Threshold = 256;
+
+	//Limb count up to which radix conversion works on one 10^19 chunk at a time instead of dividing and conquering
+	constexpr static SizeT ConversionThreshold = 32;
+
+	//Largest power of 10 fitting into a limb
+	constexpr static u32 DecimalChunkDigits = 19;
+	constexpr static ValueT DecimalChunk = 10000000000000000000ull;
+
 	template<class T>
 	struct _DivResult {
 		T quotient;
 		T remainder;
 	};
 
+	struct WideValue {
+		ValueT low;
+		ValueT high;
+	};
+
+
+	/*
+		Limb vector storing up to two limbs inline.
+		Values of up to 128 bits make up the vast majority of all numbers and never touch the heap.
+	*/
+	class Limbs {
+
+	public:
+
+		constexpr static u32 InlineCount = 2;
+
+
+		constexpr Limbs() noexcept : count(0), capacity(InlineCount), heap(nullptr), local{} {}
+
+		constexpr explicit Limbs(SizeT size) : Limbs() {
+			resize(size);
+		}
+
+		constexpr Limbs(const Limbs& limbs) : Limbs() {
+			assign(limbs.data(), limbs.size());
+		}
+
+		constexpr Limbs(Limbs&& limbs) noexcept : count(limbs.count), capacity(limbs.capacity), heap(limbs.heap), local{limbs.local[0], limbs.local[1]} {
+			limbs.reset();
+		}
+
+		constexpr Limbs& operator=(const Limbs& limbs) {
+
+			if (this != &limbs) {
+				assign(limbs.data(), limbs.size());
+			}
+
+			return *this;
+
+		}
+
+		constexpr Limbs& operator=(Limbs&& limbs) noexcept {
+
+			if (this != &limbs) {
+
+				release();
+
+				count = limbs.count;
+				capacity = limbs.capacity;
+				heap = limbs.heap;
+				local[0] = limbs.local[0];
+				local[1] = limbs.local[1];
+
+				limbs.reset();
+
+			}
+
+			return *this;
+
+		}
+
+		constexpr ~Limbs() {
+			release();
+		}
+
+
+		constexpr ValueT* data() noexcept {
+			return heap ? heap : local;
+		}
+
+		constexpr const ValueT* data() const noexcept {
+			return heap ? heap : local;
+		}
+
+		constexpr SizeT size() const noexcept {
+			return count;
+		}
+
+		constexpr ValueT* begin() noexcept {
+			return data();
+		}
+
+		constexpr const ValueT* begin() const noexcept {
+			return data();
+		}
+
+		constexpr ValueT* end() noexcept {
+			return data() + count;
+		}
+
+		constexpr const ValueT* end() const noexcept {
+			return data() + count;
+		}
+
+		constexpr ValueT& operator[](SizeT i) noexcept {
+			return data()[i];
+		}
+
+		constexpr const ValueT& operator[](SizeT i) const noexcept {
+			return data()[i];
+		}
+
+		constexpr ValueT& front() noexcept {
+			return data()[0];
+		}
+
+		constexpr const ValueT& front() const noexcept {
+			return data()[0];
+		}
+
+		constexpr ValueT& back() noexcept {
+			return data()[count - 1];
+		}
+
+		constexpr const ValueT& back() const noexcept {
+			return data()[count - 1];
+		}
+
+
+		constexpr void reserve(SizeT size) {
+
+			if (size <= capacity) {
+				return;
+			}
+
+			SizeT newCapacity = Math::max(size, SizeT(capacity) * 2);
+			ValueT* storage = std::allocator<ValueT>().allocate(newCapacity);
+
+			std::copy_n(data(), count, storage);
+			release();
+
+			heap = storage;
+			capacity = newCapacity;
+
+		}
+
+		//New limbs are zeroed
+		constexpr void resize(SizeT size) {
+
+			reserve(size);
+
+			if (size > count) {
+				std::fill(data() + count, data() + size, 0);
+			}
+
+			count = size;
+
+		}
+
+		constexpr void assign(const ValueT* values, SizeT size) {
+
+			reserve(size);
+			std::copy_n(values, size, data());
+
+			count = size;
+
+		}
+
+		constexpr void emplace_back(ValueT value) {
+
+			reserve(count + 1);
+			data()[count++] = value;
+
+		}
+
+	private:
+
+		constexpr void release() noexcept {
+
+			if (heap) {
+
+				std::allocator<ValueT>().deallocate(heap, capacity);
+				heap = nullptr;
+				capacity = InlineCount;
+
+			}
+
+		}
+
+		//Leaves a moved-from vector holding a single zero limb
+		constexpr void reset() noexcept {
+
+			count = 1;
+			capacity = InlineCount;
+			heap = nullptr;
+			local[0] = 0;
+
+		}
+
+
+		u32 count;
+		u32 capacity;
+		ValueT* heap;
+		ValueT local[InlineCount];
+
+	};
+
 public:
 
 	using DivResult = _DivResult<BigInt>;
 
+	class MontgomeryContext;
+
+
+	constexpr BigInt() noexcept : signum(0), magnitude() {
+		magnitude.resize(1);
+	}
 
-	constexpr BigInt() noexcept : signum(0), magnitude(1) {}
+	constexpr BigInt(i32 sign, std::span<const ValueT> magnitude) : signum(sign) {
 
-	constexpr BigInt(i32 sign, std::span<const ValueT> magnitude) : signum(sign), magnitude(magnitude.size()) {
+		this->magnitude.assign(magnitude.data(), magnitude.size());
 
-		std::copy(magnitude.begin(), magnitude.end(), this->magnitude.begin());
+		if (magnitude.empty()) {
+			this->magnitude.resize(1);
+		}
 
-		bool qualifiesZero = magnitude.size() == 1 && magnitude.front() == 0;
+		compress();
 
-		if (qualifiesZero) {
+		if (checkZero()) {
 			signum = 0;		//Actually sign of 0
 		} else if (signum == 0) {
 			signum = 1;		//Someone messed with us
@@ -67,17 +291,20 @@ public:
 	template<CC::Integer I>
 	constexpr void set(I i) {
 
+		static_assert(sizeof(I) <= sizeof(ValueT), "Integer exceeds limb size");
+
+		using U = TT::MakeUnsigned<I>;
+
 		if (i == I(0)) {
 
 			setZero();
 
 		} else {
 
-			SizeT bits = Bits::bitCount<I>() - Bits::clz(i);
-
+			//Negating in unsigned arithmetic covers the minimum value
 			signum = i >= I(0) ? 1 : -1;
-			magnitude.resize((bits + ValueBits - 1) / ValueBits);
-			Bits::disassemble(Math::abs(i), magnitude.data(), magnitude.size());
+			magnitude.resize(1);
+			magnitude.front() = i >= I(0) ? ValueT(U(i)) : ValueT(U(U(0) - U(i)));
 
 		}
 
@@ -85,14 +312,14 @@ public:
 
 	constexpr BigInt& add(const BigInt& b) {
 
-		*this = addCore(*this, b);
+		addSigned(b, b.signum);
 		return *this;
 
 	}
 
 	constexpr BigInt& subtract(const BigInt& b) {
 
-		*this = subtractCore(*this, b);
+		addSigned(b, -b.signum);
 		return *this;
 
 	}
@@ -181,27 +408,22 @@ public:
 			return *this;
 		}
 
-		magnitude.insert(magnitude.begin(), insertCount, 0);
-
-		if (shiftCount) {
-
-			ValueT shiftOut = 0;
-
-			for (SizeT i = insertCount; i < magnitude.size(); i++) {
+		SizeT size = magnitude.size();
 
-				ValueT& v = magnitude[i];
-				ValueT nextShiftOut = v >> (ValueBits - shiftCount);
+		magnitude.resize(size + insertCount + 1);
 
-				v = shiftOut | (v << shiftCount);
-				shiftOut = nextShiftOut;
+		ValueT* limbs = magnitude.data();
 
-			}
+		//Move upwards starting at the top so that source limbs are read before being overwritten
+		if (shiftCount) {
+			limbs[size + insertCount] = shiftLeftLimbs(limbs + insertCount, limbs, size, shiftCount);
+		} else {
+			std::copy_backward(limbs, limbs + size, limbs + size + insertCount);
+		}
 
-			if (shiftOut) {
-				magnitude.emplace_back(shiftOut);
-			}
+		std::fill_n(limbs, insertCount, 0);
 
-		}
+		compress();
 
 		return *this;
 
@@ -221,27 +443,18 @@ public:
 
 			SizeT shiftCount = count % ValueBits;
 			SizeT eraseCount = count / ValueBits;
+			SizeT size = magnitude.size() - eraseCount;
 
-			if (eraseCount) {
-
-				std::move(magnitude.begin() + eraseCount, magnitude.end(), magnitude.begin());
-				magnitude.resize(magnitude.size() - eraseCount);
-
-			}
+			ValueT* limbs = magnitude.data();
 
 			if (shiftCount) {
-
-				for (SizeT i = 0; i < magnitude.size() - 1; i++) {
-
-					ValueT& v = magnitude[i];
-					v = magnitude[i + 1] << (ValueBits - shiftCount) | v >> shiftCount;
-
-				}
-
-				magnitude.back() >>= shiftCount;
-
+				shiftRightLimbs(limbs, limbs + eraseCount, size, shiftCount);
+			} else {
+				std::copy(limbs + eraseCount, limbs + eraseCount + size, limbs);
 			}
 
+			magnitude.resize(size);
+
 			compress();
 
 		}
@@ -258,12 +471,42 @@ public:
 
 	}
 
+	/*
+		Raises to exp modulo mod, the result lies in [0; mod).
+		Negative exponents exponentiate the modular inverse. Odd moduli use Montgomery multiplication,
+		callers exponentiating repeatedly with the same modulus should keep a MontgomeryContext instead.
+	*/
+	constexpr BigInt modPow(const BigInt& exp, const BigInt& mod) {
+
+		*this = modPowCore(*this, exp, mod);
+		return *this;
+
+	}
+
+	//Replaces the value by its inverse modulo mod. Throws if the value and mod are not coprime.
+	constexpr BigInt modInverse(const BigInt& mod) {
+
+		*this = modInverseCore(*this, mod);
+		return *this;
+
+	}
+
 	constexpr BigInt abs() const noexcept {
-		return BigInt(Math::abs(signum), magnitude);
+
+		BigInt b = *this;
+		b.signum = Math::abs(signum);
+
+		return b;
+
 	}
 
 	constexpr BigInt negate() const noexcept {
-		return BigInt(-signum, magnitude);
+
+		BigInt b = *this;
+		b.signum = -signum;
+
+		return b;
+
 	}
 
 	constexpr bool lowestBitSet() const {
@@ -366,21 +609,7 @@ public:
 	}
 
 	constexpr auto operator==(const BigInt& b) const {
-
-		if (sign() != b.sign() || magnitude.size() != b.magnitude.size()) {
-			return false;
-		}
-
-		for (SizeT i = 0; i < magnitude.size(); i++) {
-
-			if (magnitude[i] != b.magnitude[i]) {
-				return false;
-			}
-
-		}
-
-		return true;
-
+		return sign() == b.sign() && compareMagnitudes(magnitude, b.magnitude) == 0;
 	}
 
 	constexpr auto operator<=>(const BigInt& b) const {
@@ -390,46 +619,20 @@ public:
 		}
 
 		//Signs are equal
-		if (magnitude.size() != b.magnitude.size()) {
-			return isPositive() ? magnitude.size() <=> b.magnitude.size() : b.magnitude.size() <=> magnitude.size();
-		}
-
-		//Magnitude range is equal
-		for (SizeT i = 0; i < magnitude.size(); i++) {
-
-			SizeT j = magnitude.size() - i - 1;
-
-			ValueT va = magnitude[j];
-			ValueT vb = b.magnitude[j];
+		i32 order = compareMagnitudes(magnitude, b.magnitude);
 
-			if (va != vb) {
-				return isPositive() ? va <=> vb : vb <=> va;
-			}
-
-		}
-
-		return std::strong_ordering::equal;
+		return isPositive() ? order <=> 0 : 0 <=> order;
 
 	}
 
 	template<CC::Integer I>
 	constexpr I toInteger() const {
 
-		if constexpr (sizeof(I) <= sizeof(ValueT)) {
-
-			return isNegative() ? -magnitude.front() : magnitude.front();
-
-		} else {
-
-			I i = Bits::assemble<I>(magnitude.data(), magnitude.size());
+		static_assert(sizeof(I) <= sizeof(ValueT), "Integer exceeds limb size");
 
-			if (isNegative()) {
-				i = -i;
-			}
-
-			return i;
+		ValueT v = magnitude.front();
 
-		}
+		return static_cast<I>(isNegative() ? ValueT(0) - v : v);
 
 	}
 
@@ -447,24 +650,7 @@ public:
 			}
 
 			//Cover minimum value
-			if (isNegative()) {
-
-				SizeT bits = magnitudeBitSize();
-				ValueT upper = ValueT(1) << ((bits % ValueBits) - 1);
-
-				for (SizeT i = 0; i < bits / ValueBits; i++) {
-
-					if (magnitude[i]) {
-						return false;
-					}
-
-				}
-
-				return magnitude.back() == upper;
-
-			}
-
-			return false;
+			return isNegative() && magnitude.size() == 1 && magnitude.front() == ValueT(1) << (Bits::bitCount<I>() - 1);
 
 		}
 
@@ -479,30 +665,37 @@ public:
 	}
 
 
+	/*
+		Converts to decimal by splitting the value at precomputed powers 10^(19 * 2^k) recursively.
+		Both halves are converted independently until they are small enough to be divided by 10^19 limb by limb.
+	*/
 	constexpr std::string toString() const {
 
+		if (isZero()) {
+			return "0";
+		}
+
 		std::string result;
 
-		BigInt b = *this;
+		if (isNegative()) {
+			result += '-';
+		}
 
-		while (!b.isZero()) {
+		BigInt value = abs();
+		std::vector<BigInt> powers;
 
-			DivResult digit = b.divmod(10);
+		if (value.magnitude.size() > ConversionThreshold) {
 
-			result += char('0') + digit.remainder.toInteger<i8>();
-			b = digit.quotient;
+			//Stop once the square of the largest power is guaranteed to exceed the value
+			powers.emplace_back(DecimalChunk);
 
-		}
+			while (value.magnitude.size() > 2 * powers.back().magnitude.size() - 2) {
+				powers.emplace_back(multiplyCore(powers.back(), powers.back()));
+			}
 
-		if (result.empty()) {
-			return "0";
 		}
 
-		std::reverse(result.begin(), result.end());
-
-		if (isNegative()) {
-			result = '-' + result;
-		}
+		toStringRecursive(value, powers, powers.size(), result, 0);
 
 		return result;
 
@@ -511,15 +704,7 @@ public:
 
 	static BigInt fromString(std::string_view str) {
 
-		BigInt b;
-
 		bool sign = false;
-		ValueT value = 0;
-
-		SizeT bufferOps = static_cast<SizeT>(Math::floor(Math::log(std::numeric_limits<ValueT>::max())));
-		ValueT factor = static_cast<ValueT>(Math::pow(10, bufferOps));
-
-		SizeT i = 0;
 
 		if (str.size() >= 2 && str[0] == '-') {
 
@@ -538,25 +723,21 @@ public:
 				throw std::runtime_error("Bad integer string");
 			}
 
-			value *= 10;
-			value += c - '0';
+		}
 
-			i++;
+		std::vector<BigInt> powers;
 
-			if (i == bufferOps) {
+		if (str.size() > ConversionThreshold * DecimalChunkDigits) {
 
-				b = addCoreUnchecked(multiplyMagnitudeSingle(b, factor), value);
-				value = 0;
-				i = 0;
+			powers.emplace_back(DecimalChunk);
 
+			while ((SizeT(DecimalChunkDigits) << powers.size()) < str.size()) {
+				powers.emplace_back(multiplyCore(powers.back(), powers.back()));
 			}
 
 		}
 
-		//Add the remaining digits
-		if (i) {
-			b = addCoreUnchecked(multiplyMagnitudeSingle(b, static_cast<ValueT>(Math::pow(10, i))), value);
-		}
+		BigInt b = fromStringRecursive(str, powers);
 
 		if (!b.checkZero()) {
 			b.signum = sign ? -1 : 1;
@@ -569,258 +750,1253 @@ public:
 
 private:
 
-	constexpr static BigInt addCore(const BigInt& a, const BigInt& b) {
+	/*
+		Limb primitives.
+		Operands are little endian limb arrays. Unless stated otherwise, the result may alias an operand at the same offset.
+	*/
 
-		if (b.isZero()) {
-			return a;
-		} else if (a.isZero()) {
-			return b;
-		}
+	constexpr static WideValue multiplyWide(ValueT a, ValueT b) noexcept {
 
-		if (a.isPositive() ^ b.isPositive()) {
-			return subtractCoreUnchecked(a, b.negate());
-		}
+#ifdef __SIZEOF_INT128__
 
-		return addCoreUnchecked(a, b);
+		unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+		return { static_cast<ValueT>(p), static_cast<ValueT>(p >> 64) };
 
-	}
+#else
 
-	constexpr static BigInt subtractCore(const BigInt& a, const BigInt& b) {
+	#if defined(ARC_COMPILER_MSVC) && defined(_M_X64)
 
-		if (b.isZero()) {
-			return a;
-		} else if (a.isZero()) {
-			return b.negate();
-		}
+		if (!std::is_constant_evaluated()) {
 
-		if (a.isPositive() ^ b.isPositive()) {
-			return addCoreUnchecked(a, b.negate());
-		}
+			ValueT high;
+			ValueT low = _umul128(a, b, &high);
+
+			return { low, high };
 
-		if (b > a) {
-			return subtractCoreUnchecked(b, a).negate();
-		} else if (b == a) {
-			return {};
-		} else {
-			return subtractCoreUnchecked(a, b);
 		}
 
+	#endif
+
+		OverflowMultiplyResult<ValueT> p = Math::overflowMultiply(a, b);
+		return { p.bottom, p.top };
+
+#endif
+
 	}
 
-	constexpr static BigInt multiplyCore(const BigInt& a, const BigInt& b) {
+	//Divides (high:low) by d, requires high < d
+	constexpr static ValueT divideWide(ValueT high, ValueT low, ValueT d, ValueT& remainder) noexcept {
 
-		if (a.isZero() || b.isZero()) {
-			return {};
-		} else if (a == 1) {
-			return b;
-		} else if (b == 1) {
-			return a;
-		}
+#ifdef __SIZEOF_INT128__
 
-		return multiplyCoreUnchecked(a, b);
+		unsigned __int128 n = (static_cast<unsigned __int128>(high) << 64) | low;
+		ValueT q = static_cast<ValueT>(n / d);
 
-	}
+		remainder = low - q * d;
 
-	constexpr static DivResult divideCore(const BigInt& a, const BigInt& b) {
+		return q;
 
-		arc_assert(!b.isZero(), "Division by zero");
+#else
 
-		if (b == 1) {
-			return {a, 0};
-		} else if (a.isZero()) {
-			return {};
-		}
+		//Knuth's algorithm D on 32 bit digits
+		constexpr ValueT Base = ValueT(1) << 32;
 
-		return divideCoreUnchecked(a, b);
+		u32 shift = Bits::clz(d);
 
-	}
+		d <<= shift;
 
-	constexpr static BigInt powCore(const BigInt& base, const BigInt& exp) {
+		ValueT un32 = shift ? (high << shift) | (low >> (ValueBits - shift)) : high;
+		ValueT un10 = low << shift;
 
-		//Illegal operation
-		if (base.isZero() && exp.isZero()) {
+		ValueT vn1 = d >> 32;
+		ValueT vn0 = d & 0xFFFFFFFF;
+		ValueT un1 = un10 >> 32;
+		ValueT un0 = un10 & 0xFFFFFFFF;
 
-		} else if (base.isZero() || exp.isNegative()) {
-			return {};
-		} else if (exp.isZero() || base == 1) {
-			return 1;
-		}
+		ValueT q1 = un32 / vn1;
+		ValueT rhat = un32 - q1 * vn1;
 
-		return powCoreUnchecked(base, exp);
+		while (q1 >= Base || q1 * vn0 > Base * rhat + un1) {
 
-	}
+			q1--;
+			rhat += vn1;
+
+			if (rhat >= Base) {
+				break;
+			}
 
-	constexpr static BigInt addCoreUnchecked(BigInt a, const BigInt& b) {
+		}
 
-		a.widen(b.magnitude.size());
+		ValueT un21 = un32 * Base + un1 - q1 * d;
+		ValueT q0 = un21 / vn1;
 
-		SizeT i = 0;
-		bool carry = false;
+		rhat = un21 - q0 * vn1;
 
-		for (; i < b.magnitude.size(); i++) {
+		while (q0 >= Base || q0 * vn0 > Base * rhat + un0) {
 
-			OverflowAddResult<ValueT> result = Math::overflowAdd(a.magnitude[i], b.magnitude[i]);
+			q0--;
+			rhat += vn1;
 
-			a.magnitude[i] = result.value + carry;
-			carry = result.overflown || (result.value == -1 && carry);
+			if (rhat >= Base) {
+				break;
+			}
 
 		}
 
-		for (; i < a.magnitude.size() && carry; i++) {
+		remainder = (un21 * Base + un0 - q0 * d) >> shift;
 
-			a.magnitude[i]++;
-			carry = a.magnitude[i] == 0;
+		return q1 * Base + q0;
 
-		}
+#endif
 
-		if (carry) {
-			a.magnitude.emplace_back(1);
-		}
+	}
 
-		a.compress();
+	//Reciprocal floor((2^128 - 1) / d) - 2^64 of a normalized divisor
+	constexpr static ValueT reciprocal(ValueT d) noexcept {
 
-		return a;
+		ValueT remainder;
+		return divideWide(~d, ~ValueT(0), d, remainder);
 
 	}
 
-	constexpr static BigInt subtractCoreUnchecked(BigInt a, const BigInt& b) {
+	//Divides (high:low) by a normalized d using its reciprocal v, requires high < d (Möller & Granlund)
+	constexpr static ValueT divideWide(ValueT high, ValueT low, ValueT d, ValueT v, ValueT& remainder) noexcept {
 
-		a.widen(b.magnitude.size());
+		WideValue q = multiplyWide(v, high);
 
-		SizeT i = 0;
-		bool borrow = false;
+		q.low += low;
+		q.high += high + 1 + (q.low < low);
 
-		for (; i < b.magnitude.size(); i++) {
+		ValueT r = low - q.high * d;
 
-			OverflowAddResult<ValueT> result = Math::overflowSubtract(a.magnitude[i], b.magnitude[i]);
+		if (r > q.low) {
 
-			a.magnitude[i] = result.value - borrow;
-			borrow = result.overflown || (result.value == 0 && borrow);
+			q.high--;
+			r += d;
 
 		}
 
-		for (; i < a.magnitude.size() && borrow; i++) {
+		if (r >= d) {
 
-			a.magnitude[i]--;
-			borrow = a.magnitude[i] == -1;
+			q.high++;
+			r -= d;
 
 		}
 
-		arc_assert(!borrow, "Illegal borrow");
-
-		a.compress();
+		remainder = r;
 
-		return a;
+		return q.high;
+
+	}
+
+	constexpr static SizeT normalizedSize(const ValueT* a, SizeT n) noexcept {
+
+		while (n > 1 && !a[n - 1]) {
+			n--;
+		}
+
+		return n;
+
+	}
+
+	//Compares two normalized magnitudes
+	constexpr static i32 compareMagnitudes(const Limbs& a, const Limbs& b) noexcept {
+
+		if (a.size() != b.size()) {
+			return a.size() < b.size() ? -1 : 1;
+		}
+
+		return compareLimbs(a.data(), b.data(), a.size());
+
+	}
+
+	constexpr static i32 compareLimbs(const ValueT* a, const ValueT* b, SizeT n) noexcept {
+
+		for (SizeT i = n; i-- > 0;) {
+
+			if (a[i] != b[i]) {
+				return a[i] < b[i] ? -1 : 1;
+			}
+
+		}
+
+		return 0;
+
+	}
+
+	//r = a + b with an >= bn, returns the carry. r may alias a or b.
+	constexpr static ValueT addLimbs(ValueT* r, const ValueT* a, SizeT an, const ValueT* b, SizeT bn) noexcept {
+
+		ValueT carry = 0;
+		SizeT i = 0;
+
+		for (; i < bn; i++) {
+
+			ValueT s = a[i] + carry;
+			carry = s < carry;
+
+			r[i] = s + b[i];
+			carry += r[i] < s;
+
+		}
+
+		for (; i < an; i++) {
+
+			r[i] = a[i] + carry;
+			carry = r[i] < carry;
+
+		}
+
+		return carry;
+
+	}
+
+	//r += b with rn >= bn, stops propagating as soon as the carry vanishes. Returns the carry out of r.
+	constexpr static ValueT addLimbsInPlace(ValueT* r, SizeT rn, const ValueT* b, SizeT bn) noexcept {
+
+		ValueT carry = 0;
+
+		for (SizeT i = 0; i < bn; i++) {
+
+			ValueT s = r[i] + carry;
+			carry = s < carry;
+
+			r[i] = s + b[i];
+			carry += r[i] < s;
+
+		}
+
+		for (SizeT i = bn; i < rn && carry; i++) {
+			carry = ++r[i] == 0;
+		}
+
+		return carry;
+
+	}
+
+	//r = a - b with an >= bn, returns the borrow. r may alias a or b.
+	constexpr static ValueT subtractLimbs(ValueT* r, const ValueT* a, SizeT an, const ValueT* b, SizeT bn) noexcept {
+
+		ValueT borrow = 0;
+		SizeT i = 0;
+
+		for (; i < bn; i++) {
+
+			ValueT d = a[i] - b[i];
+			ValueT nextBorrow = a[i] < b[i];
+
+			r[i] = d - borrow;
+			borrow = nextBorrow | (d < borrow);
+
+		}
+
+		for (; i < an; i++) {
+
+			ValueT v = a[i];
+
+			r[i] = v - borrow;
+			borrow = v < borrow;
+
+		}
+
+		return borrow;
+
+	}
+
+	//r = a * m, returns the high limb
+	constexpr static ValueT multiplyLimb(ValueT* r, const ValueT* a, SizeT n, ValueT m) noexcept {
+
+		ValueT carry = 0;
+
+		for (SizeT i = 0; i < n; i++) {
+
+			WideValue p = multiplyWide(a[i], m);
+
+			r[i] = p.low + carry;
+			carry = p.high + (r[i] < carry);
+
+		}
+
+		return carry;
+
+	}
+
+	//r += a * m, returns the high limb
+	constexpr static ValueT multiplyAddLimb(ValueT* r, const ValueT* a, SizeT n, ValueT m) noexcept {
+
+		ValueT carry = 0;
+
+		for (SizeT i = 0; i < n; i++) {
+
+			WideValue p = multiplyWide(a[i], m);
+
+			p.low += carry;
+			p.high += p.low < carry;
+
+			r[i] += p.low;
+			carry = p.high + (r[i] < p.low);
+
+		}
+
+		return carry;
+
+	}
+
+	//r -= a * m, returns the borrow out of r
+	constexpr static ValueT multiplySubtractLimb(ValueT* r, const ValueT* a, SizeT n, ValueT m) noexcept {
+
+		ValueT carry = 0;
+
+		for (SizeT i = 0; i < n; i++) {
+
+			WideValue p = multiplyWide(a[i], m);
+
+			p.low += carry;
+			p.high += p.low < carry;
+
+			ValueT v = r[i];
+
+			r[i] = v - p.low;
+			carry = p.high + (v < p.low);
+
+		}
+
+		return carry;
+
+	}
+
+	//Shifts by 0 < shift < ValueBits, processing from the top so that r may lie above a. Returns the bits shifted out.
+	constexpr static ValueT shiftLeftLimbs(ValueT* r, const ValueT* a, SizeT n, u32 shift) noexcept {
+
+		ValueT out = a[n - 1] >> (ValueBits - shift);
+
+		for (SizeT i = n - 1; i > 0; i--) {
+			r[i] = (a[i] << shift) | (a[i - 1] >> (ValueBits - shift));
+		}
+
+		r[0] = a[0] << shift;
+
+		return out;
+
+	}
+
+	//Shifts by 0 < shift < ValueBits, processing from the bottom so that r may lie below a
+	constexpr static void shiftRightLimbs(ValueT* r, const ValueT* a, SizeT n, u32 shift) noexcept {
+
+		for (SizeT i = 0; i < n - 1; i++) {
+			r[i] = (a[i] >> shift) | (a[i + 1] << (ValueBits - shift));
+		}
+
+		r[n - 1] = a[n - 1] >> shift;
+
+	}
+
+	//q = a / d, returns the remainder. q may alias a.
+	constexpr static ValueT divideLimbsSingle(ValueT* q, const ValueT* a, SizeT n, ValueT d) noexcept {
+
+		u32 shift = Bits::clz(d);
+		ValueT dn = d << shift;
+		ValueT v = reciprocal(dn);
+		ValueT r = 0;
+
+		//Normalize the dividend on the fly
+		if (shift) {
+
+			r = a[n - 1] >> (ValueBits - shift);
+
+			for (SizeT i = n - 1; i > 0; i--) {
+				q[i] = divideWide(r, (a[i] << shift) | (a[i - 1] >> (ValueBits - shift)), dn, v, r);
+			}
+
+			q[0] = divideWide(r, a[0] << shift, dn, v, r);
+
+		} else {
+
+			for (SizeT i = n; i-- > 0;) {
+				q[i] = divideWide(r, a[i], dn, v, r);
+			}
+
+		}
+
+		return r >> shift;
+
+	}
+
+
+	constexpr static void multiplySchoolbook(ValueT* r, const ValueT* a, SizeT an, const ValueT* b, SizeT bn) noexcept {
+
+		r[an] = multiplyLimb(r, a, an, b[0]);
+
+		for (SizeT j = 1; j < bn; j++) {
+			r[an + j] = multiplyAddLimb(r + j, a, an, b[j]);
+		}
+
+	}
+
+	//r[0, 2n) = a * a, computing every cross product only once
+	constexpr static void squareSchoolbook(ValueT* r, const ValueT* a, SizeT n) noexcept {
+
+		std::fill_n(r, 2 * n, 0);
+
+		for (SizeT i = 0; i + 1 < n; i++) {
+			r[i + n] = multiplyAddLimb(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+		}
+
+		//Cross products appear twice, the doubled sum still fits since it is below a^2
+		shiftLeftLimbs(r, r, 2 * n, 1);
+
+		ValueT carry = 0;
+
+		for (SizeT i = 0; i < n; i++) {
+
+			WideValue p = multiplyWide(a[i], a[i]);
+
+			ValueT low = r[2 * i] + carry;
+			carry = low < carry;
+
+			r[2 * i] = low + p.low;
+			carry += r[2 * i] < low;
+
+			ValueT high = r[2 * i + 1] + carry;
+			carry = high < carry;
+
+			r[2 * i + 1] = high + p.high;
+			carry += r[2 * i + 1] < high;
+
+		}
+
+	}
+
+	//Scratch limbs needed by Karatsuba multiplication of two n limb operands
+	constexpr static SizeT karatsubaScratchSize(SizeT n) noexcept {
+
+		SizeT size = 0;
+
+		while (n >= KaratsubaThreshold && n < Toom3Threshold) {
+
+			SizeT h = (n + 1) / 2;
+
+			size += 4 * h + 1;
+			n = h;
+
+		}
+
+		return size;
+
+	}
+
+	//r[0, 2n) = a * b
+	constexpr static void multiplyBalanced(ValueT* r, const ValueT* a, const ValueT* b, SizeT n, ValueT* scratch) {
+
+		if (n < KaratsubaThreshold) {
+
+			if (a == b) {
+				squareSchoolbook(r, a, n);
+			} else {
+				multiplySchoolbook(r, a, n, b, n);
+			}
+
+		} else if (n < Toom3Threshold) {
+			multiplyKaratsuba(r, a, b, n, scratch);
+		} else {
+			multiplyToom3(r, a, b, n);
+		}
+
+	}
+
+	/*
+		Subtractive Karatsuba: a0 * b1 + a1 * b0 = a0 * b0 + a1 * b1 + (a0 - a1) * (b1 - b0).
+		Working on absolute differences keeps all intermediate products at h limbs, avoiding carry limbs in the recursion.
+	*/
+	constexpr static void multiplyKaratsuba(ValueT* r, const ValueT* a, const ValueT* b, SizeT n, ValueT* scratch) {
+
+		const SizeT h = (n + 1) / 2;
+		const SizeT l = n - h;
+
+		const ValueT* a0 = a;
+		const ValueT* a1 = a + h;
+		const ValueT* b0 = b;
+		const ValueT* b1 = b + h;
+
+		ValueT* product = scratch;
+		ValueT* middle = scratch + 2 * h;
+		ValueT* next = middle + 2 * h + 1;
+
+		//Absolute differences are formed in r, which is only written after they have been consumed
+		auto difference = [&](ValueT* d, const ValueT* x, const ValueT* y) constexpr {
+
+			//x has h limbs, y has l limbs
+			bool greater = (l < h && x[h - 1]) || compareLimbs(x, y, l) >= 0;
+
+			if (greater) {
+
+				subtractLimbs(d, x, h, y, l);
+
+			} else {
+
+				//y > x implies that x has no more than l significant limbs
+				subtractLimbs(d, y, l, x, l);
+				std::fill(d + l, d + h, 0);
+
+			}
+
+			return greater;
+
+		};
+
+		bool negative;
+
+		if (a == b) {
+
+			//(a0 - a1) * (a1 - a0) is never positive, squaring the difference keeps the recursion on squares
+			difference(r, a0, a1);
+			multiplyBalanced(product, r, r, h, next);
+
+			negative = true;
+
+		} else {
+
+			//Signs of (a0 - a1) and (b1 - b0)
+			bool positiveA = difference(r, a0, a1);
+			bool positiveB = !difference(r + h, b0, b1);
+
+			multiplyBalanced(product, r, r + h, h, next);
+
+			negative = positiveA != positiveB;
+
+		}
+
+		multiplyBalanced(r, a0, b0, h, next);
+		multiplyBalanced(r + 2 * h, a1, b1, l, next);
+
+		//middle = z0 + z2 +- |a0 - a1| * |b1 - b0|
+		middle[2 * h] = addLimbs(middle, r, 2 * h, r + 2 * h, 2 * l);
+
+		if (negative) {
+			subtractLimbs(middle, middle, 2 * h + 1, product, 2 * h);
+		} else {
+			addLimbsInPlace(middle, 2 * h + 1, product, 2 * h);
+		}
+
+		addLimbsInPlace(r + h, 2 * n - h, middle, Math::min(2 * h + 1, 2 * n - h));
+
+	}
+
+	/*
+		Toom-3 with evaluation points 0, 1, -1, -2 and infinity, interpolated following Bodrato.
+		Operand thirds are wrapped in BigInts since evaluation produces signed values, the overhead is negligible at these sizes.
+	*/
+	constexpr static void multiplyToom3(ValueT* r, const ValueT* a, const ValueT* b, SizeT n) {
+
+		const SizeT k = (n + 2) / 3;
+
+		auto evaluate = [&](const ValueT* x, BigInt& x0, BigInt& x2, BigInt& p1, BigInt& pm1, BigInt& pm2) {
+
+			x0 = BigInt(1, {x, k});
+			BigInt x1(1, {x + k, k});
+			x2 = BigInt(1, {x + 2 * k, n - 2 * k});
+
+			BigInt p = x0;
+			p += x2;
+
+			p1 = p;
+			p1 += x1;
+
+			pm1 = p;
+			pm1 -= x1;
+
+			pm2 = pm1;
+			pm2 += x2;
+			pm2 <<= 1;
+			pm2 -= x0;
+
+		};
+
+		BigInt a0, a2, a1v, am1, am2;
+		BigInt b0, b2, b1v, bm1, bm2;
+
+		evaluate(a, a0, a2, a1v, am1, am2);
+
+		//Squares evaluate once so that the point products recurse as squares
+		const bool square = a == b;
+
+		if (!square) {
+			evaluate(b, b0, b2, b1v, bm1, bm2);
+		}
+
+		BigInt r0 = multiplyCore(a0, square ? a0 : b0);
+		BigInt r1 = multiplyCore(a1v, square ? a1v : b1v);
+		BigInt rm1 = multiplyCore(am1, square ? am1 : bm1);
+		BigInt rm2 = multiplyCore(am2, square ? am2 : bm2);
+		BigInt rinf = multiplyCore(a2, square ? a2 : b2);
+
+		BigInt r3 = rm2;
+		r3 -= r1;
+		r3.divideExact(3);
+
+		r1 -= rm1;
+		r1 >>= 1;
+
+		BigInt r2 = rm1;
+		r2 -= r0;
+
+		r3.negateInPlace();
+		r3 += r2;
+		r3 >>= 1;
+		r3 += rinf << 1;
+
+		r2 += r1;
+		r2 -= rinf;
+
+		r1 -= r3;
+
+		std::fill_n(r, 2 * n, 0);
+
+		const BigInt* coefficients[] = { &r0, &r1, &r2, &r3, &rinf };
+
+		for (SizeT i = 0; i < 5; i++) {
+
+			const BigInt& c = *coefficients[i];
+
+			arc_assert(c.isPositive(), "Negative Toom-3 coefficient");
+
+			if (!c.isZero()) {
+				addLimbsInPlace(r + i * k, 2 * n - i * k, c.magnitude.data(), Math::min(c.magnitude.size(), 2 * n - i * k));
+			}
+
+		}
+
+	}
+
+	//r[0, an + bn) = a * b
+	constexpr static void multiplyLimbs(ValueT* r, const ValueT* a, SizeT an, const ValueT* b, SizeT bn) {
+
+		if (an < bn) {
+
+			std::swap(a, b);
+			std::swap(an, bn);
+
+		}
+
+		if (bn < KaratsubaThreshold) {
+
+			multiplySchoolbook(r, a, an, b, bn);
+			return;
+
+		}
+
+		std::vector<ValueT> scratch(karatsubaScratchSize(bn));
+
+		if (an == bn) {
+
+			multiplyBalanced(r, a, b, bn, scratch.data());
+			return;
+
+		}
+
+		//Split the longer operand into pieces of the shorter one's size
+		std::vector<ValueT> product(an + bn);
+		std::fill_n(r, an + bn, 0);
+
+		SizeT offset = 0;
+
+		for (; offset + bn <= an; offset += bn) {
+
+			multiplyBalanced(product.data(), a + offset, b, bn, scratch.data());
+			addLimbsInPlace(r + offset, an + bn - offset, product.data(), 2 * bn);
+
+		}
+
+		if (offset < an) {
+
+			SizeT rest = an - offset;
+
+			multiplyLimbs(product.data(), b, bn, a + offset, rest);
+			addLimbsInPlace(r + offset, an + bn - offset, product.data(), bn + rest);
+
+		}
+
+	}
+
+	/*
+		Knuth's algorithm D.
+		q receives an - bn + 1 limbs and r receives bn limbs. Requires an >= bn >= 2 and a normalized b.
+	*/
+	constexpr static void divideLimbs(ValueT* q, ValueT* r, const ValueT* a, SizeT an, const ValueT* b, SizeT bn) {
+
+		u32 shift = Bits::clz(b[bn - 1]);
+
+		std::vector<ValueT> v(bn);
+		std::vector<ValueT> u(an + 1);
+
+		if (shift) {
+
+			shiftLeftLimbs(v.data(), b, bn, shift);
+			u[an] = shiftLeftLimbs(u.data(), a, an, shift);
+
+		} else {
+
+			std::copy_n(b, bn, v.data());
+			std::copy_n(a, an, u.data());
+
+		}
+
+		const ValueT d1 = v[bn - 1];
+		const ValueT d0 = v[bn - 2];
+		const ValueT inverse = reciprocal(d1);
+
+		for (SizeT j = an - bn + 1; j-- > 0;) {
+
+			ValueT u2 = u[j + bn];
+			ValueT u1 = u[j + bn - 1];
+			ValueT u0 = u[j + bn - 2];
+
+			ValueT qhat;
+			ValueT rhat;
+			bool rhatOverflow = false;
+
+			if (u2 >= d1) {
+
+				qhat = ~ValueT(0);
+				rhat = u1 + d1;
+				rhatOverflow = rhat < u1;
+
+			} else {
+
+				qhat = divideWide(u2, u1, d1, inverse, rhat);
+
+			}
+
+			//Correct the estimate using the second divisor limb, at most two steps are required
+			while (!rhatOverflow) {
+
+				WideValue p = multiplyWide(qhat, d0);
+
+				if (p.high < rhat || (p.high == rhat && p.low <= u0)) {
+					break;
+				}
+
+				qhat--;
+				rhat += d1;
+				rhatOverflow = rhat < d1;
+
+			}
+
+			ValueT borrow = multiplySubtractLimb(u.data() + j, v.data(), bn, qhat);
+
+			u[j + bn] = u2 - borrow;
+
+			//Rare case of an estimate one too large
+			if (u2 < borrow) {
+
+				qhat--;
+				u[j + bn] += addLimbsInPlace(u.data() + j, bn, v.data(), bn);
+
+			}
+
+			q[j] = qhat;
+
+		}
+
+		if (shift) {
+			shiftRightLimbs(r, u.data(), bn, shift);
+		} else {
+			std::copy_n(u.data(), bn, r);
+		}
+
+	}
+
+
+	constexpr static BigInt multiplyCore(const BigInt& a, const BigInt& b) {
+
+		if (a.isZero() || b.isZero()) {
+			return {};
+		}
+
+		return multiplyCoreUnchecked(a, b);
+
+	}
+
+	constexpr static DivResult divideCore(const BigInt& a, const BigInt& b) {
+
+		arc_assert(!b.isZero(), "Division by zero");
+
+		if (a.isZero()) {
+			return {};
+		}
+
+		return divideCoreUnchecked(a, b);
+
+	}
+
+	constexpr static BigInt powCore(const BigInt& base, const BigInt& exp) {
+
+		//Illegal operation
+		if (base.isZero() && exp.isZero()) {
+
+		} else if (base.isZero() || exp.isNegative()) {
+			return {};
+		} else if (exp.isZero() || base == 1) {
+			return 1;
+		}
+
+		return powCoreUnchecked(base, exp);
+
+	}
+
+	constexpr void addSigned(const BigInt& b, i32 bSign) {
+
+		if (bSign == 0) {
+			return;
+		}
+
+		if (&b == this) {
+
+			if (bSign == signum) {
+				shiftLeft(1);
+			} else {
+				setZero();
+			}
+
+			return;
+
+		}
+
+		if (isZero()) {
+
+			magnitude = b.magnitude;
+			signum = bSign;
+			return;
+
+		}
+
+		SizeT an = magnitude.size();
+		SizeT bn = b.magnitude.size();
+
+		if (signum == bSign) {
+
+			if (an < bn) {
+				magnitude.resize(bn);
+			}
+
+			ValueT carry = addLimbs(magnitude.data(), magnitude.data(), magnitude.size(), b.magnitude.data(), bn);
+
+			if (carry) {
+				magnitude.emplace_back(carry);
+			}
+
+			return;
+
+		}
+
+		i32 order = compareMagnitudes(magnitude, b.magnitude);
+
+		if (order == 0) {
+
+			setZero();
+
+		} else if (order > 0) {
+
+			subtractLimbs(magnitude.data(), magnitude.data(), an, b.magnitude.data(), bn);
+			compress();
+
+		} else {
+
+			//this = b - this
+			magnitude.resize(bn);
+			subtractLimbs(magnitude.data(), b.magnitude.data(), bn, magnitude.data(), an);
+
+			signum = bSign;
+			compress();
+
+		}
 
 	}
 
 	constexpr static BigInt multiplyCoreUnchecked(const BigInt& a, const BigInt& b) {
 
 		BigInt result;
-		bool sign = a.isPositive() ^ b.isPositive();
 
-		for (SizeT i = 0; ValueT v : b.magnitude) {
-			result = addCore(result, multiplyMagnitudeSingle(a, v).shiftLeft(i++ * ValueBits));
+		SizeT an = a.magnitude.size();
+		SizeT bn = b.magnitude.size();
+
+		result.magnitude.resize(an + bn);
+
+		if (bn == 1) {
+			result.magnitude[an] = multiplyLimb(result.magnitude.data(), a.magnitude.data(), an, b.magnitude.front());
+		} else if (an == 1) {
+			result.magnitude[bn] = multiplyLimb(result.magnitude.data(), b.magnitude.data(), bn, a.magnitude.front());
+		} else {
+			multiplyLimbs(result.magnitude.data(), a.magnitude.data(), an, b.magnitude.data(), bn);
+		}
+
+		result.compress();
+		result.signum = a.signum * b.signum;
+
+		return result;
+
+	}
+
+	//Truncates the quotient towards zero, the remainder takes the dividend's sign
+	constexpr static DivResult divideCoreUnchecked(const BigInt& a, const BigInt& b) {
+
+		i32 order = compareMagnitudes(a.magnitude, b.magnitude);
+
+		if (order < 0) {
+			return {{}, a};
+		}
+
+		SizeT an = a.magnitude.size();
+		SizeT bn = b.magnitude.size();
+
+		DivResult result;
+
+		result.quotient.magnitude.resize(an - bn + 1);
+		result.remainder.magnitude.resize(bn);
+
+		if (bn == 1) {
+			result.remainder.magnitude[0] = divideLimbsSingle(result.quotient.magnitude.data(), a.magnitude.data(), an, b.magnitude.front());
+		} else {
+			divideLimbs(result.quotient.magnitude.data(), result.remainder.magnitude.data(), a.magnitude.data(), an, b.magnitude.data(), bn);
 		}
 
-		result.signum = sign ? -1 : 1;
+		result.quotient.compress();
+		result.remainder.compress();
+
+		result.quotient.signum = result.quotient.checkZero() ? 0 : a.signum * b.signum;
+		result.remainder.signum = result.remainder.checkZero() ? 0 : a.signum;
 
 		return result;
 
 	}
 
-	constexpr static BigInt multiplyMagnitudeSingle(BigInt a, ValueT b) {
+	constexpr static BigInt powCoreUnchecked(BigInt base, BigInt exp) {
 
-		bool carry = false;
-		ValueT prevTop = 0;
+		BigInt result(1);
 
-		OverflowMultiplyResult<ValueT> multiplyResult;
-		OverflowAddResult<ValueT> addResult;
+		while (exp) {
 
-		for (ValueT& v : a.magnitude) {
+			if (exp.lowestBitSet()) {
+				result = multiplyCoreUnchecked(result, base);
+			}
 
-			multiplyResult = Math::overflowMultiply(v, b);
-			addResult = Math::overflowAdd(multiplyResult.bottom, prevTop);
+			exp.shiftRight(1);
 
-			v = addResult.value + carry;
-			carry = addResult.overflown || (carry && addResult.value == -1);
-			prevTop = multiplyResult.top;
+			if (exp) {
+				base = multiplyCoreUnchecked(base, base);
+			}
 
 		}
 
-		prevTop += carry;
+		return result;
+
+	}
+
+	constexpr void negateInPlace() noexcept {
+		signum = -signum;
+	}
+
+	constexpr static BigInt modPowCore(const BigInt& base, const BigInt& exp, const BigInt& mod);
+
+	constexpr static BigInt modInverseCore(const BigInt& a, const BigInt& mod) {
+
+		arc_assert(mod.isPositive() && !mod.isZero(), "Modulus must be positive");
+
+		//Extended Euclidean algorithm, only tracking the coefficient of a
+		BigInt r0 = mod;
+		BigInt r1 = reduceModulo(a, mod);
+		BigInt t0 = 0;
+		BigInt t1 = 1;
+
+		while (!r1.isZero()) {
 
-		if (multiplyResult.overflown) {
-			a.magnitude.emplace_back(prevTop);
+			DivResult d = divideCoreUnchecked(r0, r1);
+
+			BigInt t = t0;
+			t.subtract(multiplyCore(d.quotient, t1));
+
+			r0 = std::move(r1);
+			r1 = std::move(d.remainder);
+			t0 = std::move(t1);
+			t1 = std::move(t);
+
+		}
+
+		if (r0 != 1) {
+			throw std::runtime_error("Value has no modular inverse");
 		}
 
-		return a;
+		return reduceModulo(t0, mod);
 
 	}
 
-	constexpr static DivResult divideCoreUnchecked(BigInt a, BigInt b) {
+	//Returns a mod m in [0; m)
+	constexpr static BigInt reduceModulo(const BigInt& a, const BigInt& m) {
 
-		BigInt result;
+		BigInt r = divideCore(a, m).remainder;
 
-		bool sign = a.isPositive() ^ b.isPositive();
-		a = a.abs();
-		b = b.abs();
+		if (r.isNegative()) {
+			r.add(m);
+		}
 
-		if (a < b) {
-			return {{}, a};
+		return r;
+
+	}
+
+	//Window width minimizing the multiplication count for exponents of the given bit size
+	constexpr static u32 windowSize(SizeT bits) noexcept {
+
+		if (bits > 671) {
+			return 6;
+		} else if (bits > 239) {
+			return 5;
+		} else if (bits > 79) {
+			return 4;
+		} else if (bits > 23) {
+			return 3;
+		} else if (bits > 6) {
+			return 2;
 		}
 
-		SizeT bitsA = a.magnitudeBitSize();
-		SizeT bitsB = b.magnitudeBitSize();
+		return 1;
+
+	}
+
+	/*
+		Left-to-right sliding window exponentiation for a positive exponent.
+		Only odd powers of base up to the window width are precomputed, runs of zero bits cost a squaring each.
+		multiply(r, a, b) stores a * b in r, which may alias either operand.
+	*/
+	template<class T, class Multiply>
+	constexpr static T slidingWindowPow(const T& base, const BigInt& exp, Multiply&& multiply) {
+
+		const SizeT bits = exp.magnitudeBitSize();
+		const u32 window = windowSize(bits);
+
+		std::vector<T> table(SizeT(1) << (window - 1), base);
 
-		SizeT shift = bitsA - bitsB;
-		b.shiftLeft(shift);
+		if (window > 1) {
 
-		//Divisor may be greater than dividend, shift once to correct
-		if (a < b) {
+			T square = base;
+			multiply(square, base, base);
 
-			b.shiftRight(1);
-			shift--;
+			for (SizeT i = 1; i < table.size(); i++) {
+				multiply(table[i], table[i - 1], square);
+			}
 
 		}
 
-		for (SizeT i = 0; i <= shift; i++) {
+		T result = base;
+		bool first = true;
+
+		for (SizeT i = bits; i > 0;) {
+
+			if (!exp.testBit(i - 1)) {
+
+				multiply(result, result, result);
+				i--;
+
+				continue;
+
+			}
+
+			//Shrink the window until its lowest bit is set
+			SizeT low = i > window ? i - window : 0;
 
-			result.shiftLeft(1);
+			while (!exp.testBit(low)) {
+				low++;
+			}
+
+			u32 value = 0;
+
+			for (SizeT j = i; j-- > low;) {
+				value = (value << 1) | exp.testBit(j);
+			}
+
+			if (first) {
+
+				result = table[value >> 1];
+				first = false;
+
+			} else {
 
-			if (a >= b) {
+				for (SizeT j = low; j < i; j++) {
+					multiply(result, result, result);
+				}
 
-				a.subtract(b);
-				result.increment();
+				multiply(result, result, table[value >> 1]);
 
 			}
 
-			b.shiftRight(1);
+			i = low;
 
 		}
 
-		result.signum = sign ? -1 : 1;
+		return result;
+
+	}
+
+	constexpr bool testBit(SizeT bit) const noexcept {
+
+		SizeT limb = bit / ValueBits;
 
-		return {result, a};
+		return limb < magnitude.size() && (magnitude[limb] >> (bit % ValueBits)) & 1;
 
 	}
 
-	constexpr static BigInt powCoreUnchecked(BigInt base, BigInt exp) {
+	//Divides by a single limb known to divide the value
+	constexpr void divideExact(ValueT d) {
 
-		BigInt result(1);
+		divideLimbsSingle(magnitude.data(), magnitude.data(), magnitude.size(), d);
 
-		while (exp) {
+		compress();
+		checkZero();
+
+	}
+
+	//Writes the decimal digits of a non-negative value, zero padded to width digits if width is non-zero
+	constexpr static void toStringRecursive(const BigInt& value, const std::vector<BigInt>& powers, SizeT level, std::string& out, SizeT width) {
+
+		if (level == 0 || value.magnitude.size() <= ConversionThreshold) {
+
+			appendDecimal(value, out, width);
+			return;
+
+		}
+
+		const BigInt& divisor = powers[level - 1];
+		const SizeT lowDigits = SizeT(DecimalChunkDigits) << (level - 1);
+
+		if (compareMagnitudes(value.magnitude, divisor.magnitude) < 0) {
+
+			toStringRecursive(value, powers, level - 1, out, width);
+			return;
+
+		}
+
+		DivResult split = divideCoreUnchecked(value, divisor);
+
+		toStringRecursive(split.quotient, powers, level - 1, out, width ? width - lowDigits : 0);
+		toStringRecursive(split.remainder, powers, level - 1, out, lowDigits);
+
+	}
+
+	constexpr static void appendDecimal(const BigInt& value, std::string& out, SizeT width) {
+
+		std::vector<ValueT> chunks;
+		Limbs limbs = value.magnitude;
+		SizeT size = limbs.size();
+
+		while (size > 1 || limbs[0]) {
+
+			chunks.push_back(divideLimbsSingle(limbs.data(), limbs.data(), size, DecimalChunk));
+			size = normalizedSize(limbs.data(), size);
+
+		}
+
+		std::string digits;
+
+		for (SizeT i = chunks.size(); i-- > 0;) {
+
+			char buffer[DecimalChunkDigits];
+			ValueT chunk = chunks[i];
+
+			for (u32 j = DecimalChunkDigits; j-- > 0;) {
+
+				buffer[j] = char('0' + chunk % 10);
+				chunk /= 10;
 
-			if (exp.lowestBitSet()) {
-				result = multiplyCoreUnchecked(result, base);
 			}
 
-			base = multiplyCoreUnchecked(base, base);
-			exp.shiftRight(1);
+			//The leading chunk is not padded
+			u32 skip = 0;
+
+			if (i == chunks.size() - 1) {
+
+				while (skip < DecimalChunkDigits - 1 && buffer[skip] == '0') {
+					skip++;
+				}
+
+			}
+
+			digits.append(buffer + skip, DecimalChunkDigits - skip);
 
 		}
 
-		return result;
+		if (width > digits.size()) {
+			out.append(width - digits.size(), '0');
+		}
+
+		out += digits;
+
+	}
+
+	//Parses a validated, unsigned digit string, splitting at 10^(19 * 2^k) while parts are large
+	static BigInt fromStringRecursive(std::string_view str, const std::vector<BigInt>& powers) {
+
+		if (str.size() <= ConversionThreshold * DecimalChunkDigits) {
+
+			BigInt b;
+			Limbs& limbs = b.magnitude;
+
+			limbs.reserve(str.size() / DecimalChunkDigits + 1);
+
+			SizeT size = 1;
+			SizeT first = str.size() % DecimalChunkDigits;
+
+			if (!first) {
+				first = DecimalChunkDigits;
+			}
+
+			for (SizeT i = 0; i < str.size();) {
+
+				SizeT length = i ? DecimalChunkDigits : first;
+				ValueT chunk = 0;
+				ValueT factor = 1;
+
+				for (SizeT j = 0; j < length; j++) {
+
+					chunk = chunk * 10 + (str[i + j] - '0');
+					factor *= 10;
+
+				}
+
+				ValueT carry = multiplyLimb(limbs.data(), limbs.data(), size, factor);
+				carry += addLimbsInPlace(limbs.data(), size, &chunk, 1);
+
+				if (carry) {
+
+					limbs.resize(size + 1);
+					limbs[size++] = carry;
+
+				}
+
+				i += length;
+
+			}
+
+			b.compress();
+			b.signum = b.checkZero() ? 0 : 1;
+
+			return b;
+
+		}
+
+		SizeT level = powers.size();
+
+		while ((SizeT(DecimalChunkDigits) << (level - 1)) >= str.size()) {
+			level--;
+		}
+
+		SizeT lowDigits = SizeT(DecimalChunkDigits) << (level - 1);
+
+		BigInt high = fromStringRecursive(str.substr(0, str.size() - lowDigits), powers);
+		BigInt low = fromStringRecursive(str.substr(str.size() - lowDigits), powers);
+
+		BigInt b = multiplyCore(high, powers[level - 1]);
+		b += low;
+
+		return b;
 
 	}
 
@@ -854,32 +2030,12 @@ private:
 
 		arc_assert(!borrow, "Illegal borrow");
 
-	}
-
-	constexpr void widen(SizeT minSize) {
-
-		if (magnitude.size() < minSize) {
-			magnitude.resize(minSize);
-		}
+		compress();
 
 	}
 
 	constexpr void compress() {
-
-		SizeT compSize = magnitude.size();
-
-		for (SizeT i = magnitude.size() - 1; i > 0; i--) {
-
-			if (magnitude[i] == 0) {
-				compSize--;
-			} else {
-				break;
-			}
-
-		}
-
-		magnitude.resize(compSize);
-
+		magnitude.resize(normalizedSize(magnitude.data(), magnitude.size()));
 	}
 
 	constexpr void setZero() {
@@ -905,7 +2061,7 @@ private:
 
 
 	i32 signum;
-	std::vector<ValueT> magnitude;
+	Limbs magnitude;
 
 };
 
@@ -946,6 +2102,162 @@ constexpr BigInt operator%(BigInt a, const BigInt& b) {
 }
 
 
+
+/*
+	Montgomery arithmetic modulo a fixed odd modulus.
+	Setup computes -mod^-1 mod 2^64 and R^2 mod mod once, after which every modular multiplication is a plain product
+	followed by a reduction without division. Reusing a context amortizes the setup over many exponentiations.
+*/
+class BigInt::MontgomeryContext {
+
+public:
+
+	constexpr explicit MontgomeryContext(const BigInt& modulus) : modulus(modulus), size(modulus.magnitude.size()), inverse(0) {
+
+		arc_assert(modulus.isPositive() && modulus.lowestBitSet(), "Montgomery modulus must be odd and positive");
+
+		//Newton iteration doubles the correct low bits each step, starting with 3 for odd values
+		ValueT m0 = modulus.magnitude.front();
+		ValueT x = m0;
+
+		for (u32 i = 0; i < 5; i++) {
+			x *= 2 - m0 * x;
+		}
+
+		inverse = ValueT(0) - x;
+
+		//R = 2^(64 * size)
+		BigInt r = 1;
+		r.shiftLeft(2 * size * ValueBits);
+
+		rSquared = padded(divideCore(r, modulus).remainder);
+
+	}
+
+
+	//Computes base^exp mod modulus for a non-negative exponent
+	constexpr BigInt modPow(const BigInt& base, const BigInt& exp) const {
+
+		arc_assert(!exp.isNegative(), "Negative exponent");
+
+		if (modulus == 1) {
+			return {};
+		}
+
+		if (exp.isZero()) {
+			return 1;
+		}
+
+		//All buffers are allocated upfront, products are swapped into place
+		std::vector<ValueT> product(2 * size + 1);
+		std::vector<ValueT> scratch(karatsubaScratchSize(size));
+		Limbs temporary(size);
+
+		auto multiply = [&](Limbs& r, const Limbs& a, const Limbs& b) {
+
+			this->multiply(temporary.data(), a.data(), b.data(), product.data(), scratch.data());
+			std::swap(r, temporary);
+
+		};
+
+		Limbs x(size);
+		Limbs b = padded(reduceModulo(base, modulus));
+
+		multiply(x, b, rSquared);
+
+		Limbs result = slidingWindowPow(x, exp, multiply);
+
+		//Leave the Montgomery domain by multiplying with 1
+		Limbs one(size);
+		one[0] = 1;
+
+		multiply(x, result, one);
+
+		BigInt value(1, {x.data(), size});
+
+		return value;
+
+	}
+
+	constexpr const BigInt& getModulus() const noexcept {
+		return modulus;
+	}
+
+private:
+
+	constexpr Limbs padded(const BigInt& value) const {
+
+		Limbs limbs(size);
+		std::copy_n(value.magnitude.data(), value.magnitude.size(), limbs.data());
+
+		return limbs;
+
+	}
+
+	//r = a * b * R^-1 mod modulus for a, b < modulus. t needs 2 * size + 1 limbs.
+	constexpr void multiply(ValueT* r, const ValueT* a, const ValueT* b, ValueT* t, ValueT* scratch) const {
+
+		const ValueT* m = modulus.magnitude.data();
+
+		multiplyBalanced(t, a, b, size, scratch);
+		t[2 * size] = 0;
+
+		//Clear one low limb per step by adding a multiple of the modulus
+		for (SizeT i = 0; i < size; i++) {
+
+			ValueT u = t[i] * inverse;
+			ValueT carry = multiplyAddLimb(t + i, m, size, u);
+
+			addLimbsInPlace(t + i + size, size + 1 - i, &carry, 1);
+
+		}
+
+		//The result is below 2 * modulus
+		if (t[2 * size] || compareLimbs(t + size, m, size) >= 0) {
+			subtractLimbs(r, t + size, size, m, size);
+		} else {
+			std::copy_n(t + size, size, r);
+		}
+
+	}
+
+
+	BigInt modulus;
+	SizeT size;
+	ValueT inverse;
+	Limbs rSquared;
+
+};
+
+
+
+constexpr BigInt BigInt::modPowCore(const BigInt& base, const BigInt& exp, const BigInt& mod) {
+
+	arc_assert(mod.isPositive() && !mod.isZero(), "Modulus must be positive");
+
+	if (mod == 1) {
+		return {};
+	}
+
+	if (exp.isZero()) {
+		return 1;
+	}
+
+	BigInt b = exp.isNegative() ? modInverseCore(base, mod) : reduceModulo(base, mod);
+	BigInt e = exp.abs();
+
+	if (mod.lowestBitSet()) {
+		return MontgomeryContext(mod).modPow(b, e);
+	}
+
+	//Even moduli fall back to reduction by division
+	return slidingWindowPow(b, e, [&](BigInt& r, const BigInt& x, const BigInt& y) {
+		r = divideCoreUnchecked(multiplyCore(x, y), mod).remainder;
+	});
+
+}
+
+
 template<FixedCharArray S>
 constexpr BigInt operator""_big() {
     return BigInt(S.data);
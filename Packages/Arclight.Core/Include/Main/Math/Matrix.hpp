@@ -772,14 +772,15 @@ public:
 
 		arc_intrinsic_sse (
 
-			if constexpr (CC::Equal<TT::CommonType<T, A>, float>) {
+			// Vec4<float> is 16 byte aligned, columns are loaded and stored directly
+			if constexpr (CC::Equal<T, float> && CC::Equal<A, float>) {
 
-				__m128 l0 = _mm_set_ps(v[0][3], v[0][2], v[0][1], v[0][0]);
-				__m128 l1 = _mm_set_ps(v[1][3], v[1][2], v[1][1], v[1][0]);
-				__m128 l2 = _mm_set_ps(v[2][3], v[2][2], v[2][1], v[2][0]);
-				__m128 l3 = _mm_set_ps(v[3][3], v[3][2], v[3][1], v[3][0]);
+				__m128 l0 = _mm_load_ps(&v[0].x);
+				__m128 l1 = _mm_load_ps(&v[1].x);
+				__m128 l2 = _mm_load_ps(&v[2].x);
+				__m128 l3 = _mm_load_ps(&v[3].x);
 
-				__m128 r0 = _mm_set_ps(t[0][3], t[0][2], t[0][1], t[0][0]);
+				__m128 r0 = _mm_load_ps(&t[0].x);
 
 				__m128 x00 = _mm_mul_ps(l0, _mm_shuffle_ps(r0, r0, 0x00));
 				__m128 x01 = _mm_mul_ps(l1, _mm_shuffle_ps(r0, r0, 0x55));
@@ -788,7 +789,7 @@ public:
 
 				__m128 c0 = _mm_add_ps(_mm_add_ps(x00, x01), _mm_add_ps(x02, x03));
 
-				__m128 r1 = _mm_set_ps(t[1][3], t[1][2], t[1][1], t[1][0]);
+				__m128 r1 = _mm_load_ps(&t[1].x);
 
 				__m128 x10 = _mm_mul_ps(l0, _mm_shuffle_ps(r1, r1, 0x00));
 				__m128 x11 = _mm_mul_ps(l1, _mm_shuffle_ps(r1, r1, 0x55));
@@ -797,7 +798,7 @@ public:
 
 				__m128 c1 = _mm_add_ps(_mm_add_ps(x10, x11), _mm_add_ps(x12, x13));
 
-				__m128 r2 = _mm_set_ps(t[2][3], t[2][2], t[2][1], t[2][0]);
+				__m128 r2 = _mm_load_ps(&t[2].x);
 
 				__m128 x20 = _mm_mul_ps(l0, _mm_shuffle_ps(r2, r2, 0x00));
 				__m128 x21 = _mm_mul_ps(l1, _mm_shuffle_ps(r2, r2, 0x55));
@@ -806,7 +807,7 @@ public:
 
 				__m128 c2 = _mm_add_ps(_mm_add_ps(x20, x21), _mm_add_ps(x22, x23));
 
-				__m128 r3 = _mm_set_ps(t[3][3], t[3][2], t[3][1], t[3][0]);
+				__m128 r3 = _mm_load_ps(&t[3].x);
 
 				__m128 x30 = _mm_mul_ps(l0, _mm_shuffle_ps(r3, r3, 0x00));
 				__m128 x31 = _mm_mul_ps(l1, _mm_shuffle_ps(r3, r3, 0x55));
@@ -816,35 +817,10 @@ public:
 				__m128 c3 = _mm_add_ps(_mm_add_ps(x30, x31), _mm_add_ps(x32, x33));
 
 
-				alignas(16) float f[4];
-
-				_mm_store_ps(f, c0);
-
-				v[0].x = f[0];
-				v[0].y = f[1];
-				v[0].z = f[2];
-				v[0].w = f[3];
-
-				_mm_store_ps(f, c1);
-
-				v[1].x = f[0];
-				v[1].y = f[1];
-				v[1].z = f[2];
-				v[1].w = f[3];
-
-				_mm_store_ps(f, c2);
-
-				v[2].x = f[0];
-				v[2].y = f[1];
-				v[2].z = f[2];
-				v[2].w = f[3];
-
-				_mm_store_ps(f, c3);
-
-				v[3].x = f[0];
-				v[3].y = f[1];
-				v[3].z = f[2];
-				v[3].w = f[3];
+				_mm_store_ps(&v[0].x, c0);
+				_mm_store_ps(&v[1].x, c1);
+				_mm_store_ps(&v[2].x, c2);
+				_mm_store_ps(&v[3].x, c3);
 
 				return *this;
 
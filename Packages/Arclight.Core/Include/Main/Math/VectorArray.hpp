@@ -0,0 +1,984 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 VectorArray.hpp
+ */
+
+#pragma once
+
+#include "Math/Vector.hpp"
+#include "Math/Matrix.hpp"
+#include "Memory/AlignedAllocator.hpp"
+#include "Common/Intrinsic.hpp"
+#include "Common/Vendor.hpp"
+
+#include <span>
+#include <array>
+#include <vector>
+#include <algorithm>
+
+#include ARC_INTRINSIC_H
+
+
+
+/*
+ *	Structure-of-arrays storage for 2D, 3D and 4D vectors.
+ *	Every component lives in its own contiguous, 32 byte aligned array so that the batch kernels below
+ *	process 8 (AVX2) or 4 (SSE, NEON) float vectors per instruction.
+ *	load/store convert from and to arrays of Vec2/Vec3/Vec4.
+ */
+template<CC::Float T, SizeT N> requires (N >= 2 && N <= 4)
+class VecArray {
+
+public:
+
+	using Type = T;
+	using VecT = TT::Conditional<N == 2, Vec2<T>, TT::Conditional<N == 3, Vec3<T>, Vec4<T>>>;
+
+	constexpr static SizeT Size = N;
+	constexpr static AlignT Alignment = 32;
+
+	// Component arrays are padded to a multiple of this count to keep every array aligned
+	constexpr static SizeT Granularity = Alignment / sizeof(T);
+
+
+
+	VecArray() noexcept : count(0), stride(0) {}
+
+	explicit VecArray(SizeT count) : VecArray() {
+		resize(count);
+	}
+
+	explicit VecArray(std::span<const VecT> vectors) : VecArray(vectors.size()) {
+		load(vectors);
+	}
+
+
+	void resize(SizeT newCount) {
+
+		SizeT newStride = (newCount + Granularity - 1) / Granularity * Granularity;
+
+		if (newStride != stride) {
+
+			Storage newStorage(newStride * N);
+			SizeT kept = Math::min(count, newCount);
+
+			for (SizeT c = 0; c < N; c++) {
+				std::copy_n(storage.data() + c * stride, kept, newStorage.data() + c * newStride);
+			}
+
+			storage = std::move(newStorage);
+			stride = newStride;
+
+		} else if (newCount > count) {
+
+			for (SizeT c = 0; c < N; c++) {
+				std::fill(data(c) + count, data(c) + newCount, T(0));
+			}
+
+		}
+
+		count = newCount;
+
+	}
+
+	void clear() noexcept {
+		count = 0;
+	}
+
+
+	constexpr SizeT size() const noexcept {
+		return count;
+	}
+
+	constexpr bool empty() const noexcept {
+		return count == 0;
+	}
+
+
+	T* data(SizeT c) noexcept {
+
+		arc_assert(c < N, "Component %d out of bounds", c);
+
+		return storage.data() + c * stride;
+
+	}
+
+	const T* data(SizeT c) const noexcept {
+
+		arc_assert(c < N, "Component %d out of bounds", c);
+
+		return storage.data() + c * stride;
+
+	}
+
+	std::span<T> component(SizeT c) noexcept {
+		return { data(c), count };
+	}
+
+	std::span<const T> component(SizeT c) const noexcept {
+		return { data(c), count };
+	}
+
+
+	VecT get(SizeT i) const noexcept {
+
+		arc_assert(i < count, "Index %d out of bounds", i);
+
+		VecT v;
+
+		for (SizeT c = 0; c < N; c++) {
+			v[c] = data(c)[i];
+		}
+
+		return v;
+
+	}
+
+	void set(SizeT i, const VecT& v) noexcept {
+
+		arc_assert(i < count, "Index %d out of bounds", i);
+
+		for (SizeT c = 0; c < N; c++) {
+			data(c)[i] = v[c];
+		}
+
+	}
+
+
+	// AoS -> SoA, writes vectors to [offset; offset + vectors.size())
+	void load(std::span<const VecT> vectors, SizeT offset = 0) noexcept {
+
+		arc_assert(offset + vectors.size() <= count, "Vector range out of bounds");
+
+		SizeT i = 0;
+
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
+
+		if constexpr (CC::Equal<T, float> && N == 4) {
+
+			arc_intrinsic_sse (
+
+				// Vec4<float> is 16 byte aligned, four vectors form a 4x4 block that is transposed in registers
+				for (; i + 4 <= vectors.size(); i += 4) {
+
+					__m128 r0 = _mm_load_ps(&vectors[i + 0].x);
+					__m128 r1 = _mm_load_ps(&vectors[i + 1].x);
+					__m128 r2 = _mm_load_ps(&vectors[i + 2].x);
+					__m128 r3 = _mm_load_ps(&vectors[i + 3].x);
+
+					_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+					_mm_storeu_ps(data(0) + offset + i, r0);
+					_mm_storeu_ps(data(1) + offset + i, r1);
+					_mm_storeu_ps(data(2) + offset + i, r2);
+					_mm_storeu_ps(data(3) + offset + i, r3);
+
+				}
+
+			)
+
+		}
+
+#endif
+
+		for (; i < vectors.size(); i++) {
+
+			for (SizeT c = 0; c < N; c++) {
+				data(c)[offset + i] = vectors[i][c];
+			}
+
+		}
+
+	}
+
+	// SoA -> AoS, reads vectors from [offset; offset + vectors.size())
+	void store(std::span<VecT> vectors, SizeT offset = 0) const noexcept {
+
+		arc_assert(offset + vectors.size() <= count, "Vector range out of bounds");
+
+		SizeT i = 0;
+
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
+
+		if constexpr (CC::Equal<T, float> && N == 4) {
+
+			arc_intrinsic_sse (
+
+				for (; i + 4 <= vectors.size(); i += 4) {
+
+					__m128 r0 = _mm_loadu_ps(data(0) + offset + i);
+					__m128 r1 = _mm_loadu_ps(data(1) + offset + i);
+					__m128 r2 = _mm_loadu_ps(data(2) + offset + i);
+					__m128 r3 = _mm_loadu_ps(data(3) + offset + i);
+
+					_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+					_mm_store_ps(&vectors[i + 0].x, r0);
+					_mm_store_ps(&vectors[i + 1].x, r1);
+					_mm_store_ps(&vectors[i + 2].x, r2);
+					_mm_store_ps(&vectors[i + 3].x, r3);
+
+				}
+
+			)
+
+		}
+
+#endif
+
+		for (; i < vectors.size(); i++) {
+
+			for (SizeT c = 0; c < N; c++) {
+				vectors[i][c] = data(c)[offset + i];
+			}
+
+		}
+
+	}
+
+	std::vector<VecT> toVectors() const {
+
+		std::vector<VecT> vectors(count);
+		store(vectors);
+
+		return vectors;
+
+	}
+
+private:
+
+	using Storage = std::vector<T, AlignedAllocator<T, Alignment>>;
+
+	Storage storage;
+	SizeT count;
+	SizeT stride;
+
+};
+
+
+template<CC::Float T>
+using Vec2Array = VecArray<T, 2>;
+
+template<CC::Float T>
+using Vec3Array = VecArray<T, 3>;
+
+template<CC::Float T>
+using Vec4Array = VecArray<T, 4>;
+
+using Vec2fArray = Vec2Array<float>;
+using Vec3fArray = Vec3Array<float>;
+using Vec4fArray = Vec4Array<float>;
+using Vec2dArray = Vec2Array<double>;
+using Vec3dArray = Vec3Array<double>;
+using Vec4dArray = Vec4Array<double>;
+
+
+
+/*
+ *	Batch kernels
+ *	Each kernel processes the leading multiple of its width and returns the amount of processed elements,
+ *	the remaining elements as well as double arrays are handled by the scalar loops of the public functions.
+ *	All kernels load a full element before storing it, so outputs may alias inputs.
+ */
+namespace Math::Detail::VecArrayKernel {
+
+	template<SizeT N>
+	using Components = std::array<const float*, N>;
+
+	template<SizeT N>
+	using MutableComponents = std::array<float*, N>;
+
+
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
+
+	template<SizeT N>
+	ARC_TARGET("sse") SizeT dotSSE(const Components<N>& a, const Components<N>& b, float* out, SizeT count) {
+
+		SizeT i = 0;
+
+		for (; i + 4 <= count; i += 4) {
+
+			__m128 sum = _mm_mul_ps(_mm_loadu_ps(a[0] + i), _mm_loadu_ps(b[0] + i));
+
+			for (SizeT c = 1; c < N; c++) {
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(a[c] + i), _mm_loadu_ps(b[c] + i)));
+			}
+
+			_mm_storeu_ps(out + i, sum);
+
+		}
+
+		return i;
+
+	}
+
+	template<SizeT N>
+	ARC_TARGET("avx2") SizeT dotAVX2(const Components<N>& a, const Components<N>& b, float* out, SizeT count) {
+
+		SizeT i = 0;
+
+		for (; i + 8 <= count; i += 8) {
+
+			__m256 sum = _mm256_mul_ps(_mm256_loadu_ps(a[0] + i), _mm256_loadu_ps(b[0] + i));
+
+			for (SizeT c = 1; c < N; c++) {
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(a[c] + i), _mm256_loadu_ps(b[c] + i)));
+			}
+
+			_mm256_storeu_ps(out + i, sum);
+
+		}
+
+		return i;
+
+	}
+
+
+	ARC_TARGET("sse") inline SizeT crossSSE(const Components<3>& a, const Components<3>& b, const MutableComponents<3>& out, SizeT count) {
+
+		SizeT i = 0;
+
+		for (; i + 4 <= count; i += 4) {
+
+			__m128 ax = _mm_loadu_ps(a[0] + i), ay = _mm_loadu_ps(a[1] + i), az = _mm_loadu_ps(a[2] + i);
+			__m128 bx = _mm_loadu_ps(b[0] + i), by = _mm_loadu_ps(b[1] + i), bz = _mm_loadu_ps(b[2] + i);
+
+			_mm_storeu_ps(out[0] + i, _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by)));
+			_mm_storeu_ps(out[1] + i, _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz)));
+			_mm_storeu_ps(out[2] + i, _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx)));
+
+		}
+
+		return i;
+
+	}
+
+	ARC_TARGET("avx2") inline SizeT crossAVX2(const Components<3>& a, const Components<3>& b, const MutableComponents<3>& out, SizeT count) {
+
+		SizeT i = 0;
+
+		for (; i + 8 <= count; i += 8) {
+
+			__m256 ax = _mm256_loadu_ps(a[0] + i), ay = _mm256_loadu_ps(a[1] + i), az = _mm256_loadu_ps(a[2] + i);
+			__m256 bx = _mm256_loadu_ps(b[0] + i), by = _mm256_loadu_ps(b[1] + i), bz = _mm256_loadu_ps(b[2] + i);
+
+			_mm256_storeu_ps(out[0] + i, _mm256_sub_ps(_mm256_mul_ps(ay, bz), _mm256_mul_ps(az, by)));
+			_mm256_storeu_ps(out[1] + i, _mm256_sub_ps(_mm256_mul_ps(az, bx), _mm256_mul_ps(ax, bz)));
+			_mm256_storeu_ps(out[2] + i, _mm256_sub_ps(_mm256_mul_ps(ax, by), _mm256_mul_ps(ay, bx)));
+
+		}
+
+		return i;
+
+	}
+
+
+	template<SizeT N>
+	ARC_TARGET("sse") SizeT normalizeSSE(const Components<N>& a, const MutableComponents<N>& out, SizeT count) {
+
+		SizeT i = 0;
+
+		for (; i + 4 <= count; i += 4) {
+
+			__m128 v[N];
+			__m128 sum = _mm_setzero_ps();
+
+			for (SizeT c = 0; c < N; c++) {
+				v[c] = _mm_loadu_ps(a[c] + i);
+				sum = _mm_add_ps(sum, _mm_mul_ps(v[c], v[c]));
+			}
+
+			__m128 length = _mm_sqrt_ps(sum);
+
+			for (SizeT c = 0; c < N; c++) {
+				_mm_storeu_ps(out[c] + i, _mm_div_ps(v[c], length));
+			}
+
+		}
+
+		return i;
+
+	}
+
+	template<SizeT N>
+	ARC_TARGET("avx2") SizeT normalizeAVX2(const Components<N>& a, const MutableComponents<N>& out, SizeT count) {
+
+		SizeT i = 0;
+
+		for (; i + 8 <= count; i += 8) {
+
+			__m256 v[N];
+			__m256 sum = _mm256_setzero_ps();
+
+			for (SizeT c = 0; c < N; c++) {
+				v[c] = _mm256_loadu_ps(a[c] + i);
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(v[c], v[c]));
+			}
+
+			__m256 length = _mm256_sqrt_ps(sum);
+
+			for (SizeT c = 0; c < N; c++) {
+				_mm256_storeu_ps(out[c] + i, _mm256_div_ps(v[c], length));
+			}
+
+		}
+
+		return i;
+
+	}
+
+
+	template<SizeT N>
+	ARC_TARGET("sse") SizeT lerpSSE(const Components<N>& a, const Components<N>& b, float factor, const MutableComponents<N>& out, SizeT count) {
+
+		const __m128 t = _mm_set1_ps(factor);
+
+		SizeT i = 0;
+
+		for (; i + 4 <= count; i += 4) {
+
+			for (SizeT c = 0; c < N; c++) {
+
+				__m128 start = _mm_loadu_ps(a[c] + i);
+				__m128 end = _mm_loadu_ps(b[c] + i);
+
+				_mm_storeu_ps(out[c] + i, _mm_add_ps(start, _mm_mul_ps(t, _mm_sub_ps(end, start))));
+
+			}
+
+		}
+
+		return i;
+
+	}
+
+	template<SizeT N>
+	ARC_TARGET("avx2") SizeT lerpAVX2(const Components<N>& a, const Components<N>& b, float factor, const MutableComponents<N>& out, SizeT count) {
+
+		const __m256 t = _mm256_set1_ps(factor);
+
+		SizeT i = 0;
+
+		for (; i + 8 <= count; i += 8) {
+
+			for (SizeT c = 0; c < N; c++) {
+
+				__m256 start = _mm256_loadu_ps(a[c] + i);
+				__m256 end = _mm256_loadu_ps(b[c] + i);
+
+				_mm256_storeu_ps(out[c] + i, _mm256_add_ps(start, _mm256_mul_ps(t, _mm256_sub_ps(end, start))));
+
+			}
+
+		}
+
+		return i;
+
+	}
+
+
+	// m is a column-major MxM matrix, for N == M - 1 the last column is added as translation
+	template<SizeT N, SizeT M>
+	ARC_TARGET("sse") SizeT transformSSE(const float* m, const Components<N>& a, const MutableComponents<N>& out, SizeT count) {
+
+		// Broadcasts are hoisted since the compiler cannot prove that out does not alias m
+		__m128 matrix[M * M];
+
+		for (SizeT j = 0; j < M * M; j++) {
+			matrix[j] = _mm_set1_ps(m[j]);
+		}
+
+		SizeT i = 0;
+
+		for (; i + 4 <= count; i += 4) {
+
+			__m128 v[N];
+
+			for (SizeT c = 0; c < N; c++) {
+				v[c] = _mm_loadu_ps(a[c] + i);
+			}
+
+			for (SizeT r = 0; r < N; r++) {
+
+				__m128 sum = N < M ? matrix[(M - 1) * M + r] : _mm_setzero_ps();
+
+				for (SizeT c = 0; c < N; c++) {
+					sum = _mm_add_ps(sum, _mm_mul_ps(matrix[c * M + r], v[c]));
+				}
+
+				_mm_storeu_ps(out[r] + i, sum);
+
+			}
+
+		}
+
+		return i;
+
+	}
+
+	template<SizeT N, SizeT M>
+	ARC_TARGET("avx2") SizeT transformAVX2(const float* m, const Components<N>& a, const MutableComponents<N>& out, SizeT count) {
+
+		// Broadcasts are hoisted since the compiler cannot prove that out does not alias m
+		__m256 matrix[M * M];
+
+		for (SizeT j = 0; j < M * M; j++) {
+			matrix[j] = _mm256_set1_ps(m[j]);
+		}
+
+		SizeT i = 0;
+
+		for (; i + 8 <= count; i += 8) {
+
+			__m256 v[N];
+
+			for (SizeT c = 0; c < N; c++) {
+				v[c] = _mm256_loadu_ps(a[c] + i);
+			}
+
+			for (SizeT r = 0; r < N; r++) {
+
+				__m256 sum = N < M ? matrix[(M - 1) * M + r] : _mm256_setzero_ps();
+
+				for (SizeT c = 0; c < N; c++) {
+					sum = _mm256_add_ps(sum, _mm256_mul_ps(matrix[c * M + r], v[c]));
+				}
+
+				_mm256_storeu_ps(out[r] + i, sum);
+
+			}
+
+		}
+
+		return i;
+
+	}
+
+#elif defined(ARC_PLATFORM_AARCH64) && defined(ARC_INTRINSIC_AVAILABLE)
+
+	template<SizeT N>
+	SizeT dotNEON(const Components<N>& a, const Components<N>& b, float* out, SizeT count) {
+
+		SizeT i = 0;
+
+		for (; i + 4 <= count; i += 4) {
+
+			float32x4_t sum = vmulq_f32(vld1q_f32(a[0] + i), vld1q_f32(b[0] + i));
+
+			for (SizeT c = 1; c < N; c++) {
+				sum = vaddq_f32(sum, vmulq_f32(vld1q_f32(a[c] + i), vld1q_f32(b[c] + i)));
+			}
+
+			vst1q_f32(out + i, sum);
+
+		}
+
+		return i;
+
+	}
+
+	inline SizeT crossNEON(const Components<3>& a, const Components<3>& b, const MutableComponents<3>& out, SizeT count) {
+
+		SizeT i = 0;
+
+		for (; i + 4 <= count; i += 4) {
+
+			float32x4_t ax = vld1q_f32(a[0] + i), ay = vld1q_f32(a[1] + i), az = vld1q_f32(a[2] + i);
+			float32x4_t bx = vld1q_f32(b[0] + i), by = vld1q_f32(b[1] + i), bz = vld1q_f32(b[2] + i);
+
+			vst1q_f32(out[0] + i, vsubq_f32(vmulq_f32(ay, bz), vmulq_f32(az, by)));
+			vst1q_f32(out[1] + i, vsubq_f32(vmulq_f32(az, bx), vmulq_f32(ax, bz)));
+			vst1q_f32(out[2] + i, vsubq_f32(vmulq_f32(ax, by), vmulq_f32(ay, bx)));
+
+		}
+
+		return i;
+
+	}
+
+	template<SizeT N>
+	SizeT normalizeNEON(const Components<N>& a, const MutableComponents<N>& out, SizeT count) {
+
+		SizeT i = 0;
+
+		for (; i + 4 <= count; i += 4) {
+
+			float32x4_t v[N];
+			float32x4_t sum = vdupq_n_f32(0);
+
+			for (SizeT c = 0; c < N; c++) {
+				v[c] = vld1q_f32(a[c] + i);
+				sum = vaddq_f32(sum, vmulq_f32(v[c], v[c]));
+			}
+
+			float32x4_t length = vsqrtq_f32(sum);
+
+			for (SizeT c = 0; c < N; c++) {
+				vst1q_f32(out[c] + i, vdivq_f32(v[c], length));
+			}
+
+		}
+
+		return i;
+
+	}
+
+	template<SizeT N>
+	SizeT lerpNEON(const Components<N>& a, const Components<N>& b, float factor, const MutableComponents<N>& out, SizeT count) {
+
+		const float32x4_t t = vdupq_n_f32(factor);
+
+		SizeT i = 0;
+
+		for (; i + 4 <= count; i += 4) {
+
+			for (SizeT c = 0; c < N; c++) {
+
+				float32x4_t start = vld1q_f32(a[c] + i);
+				float32x4_t end = vld1q_f32(b[c] + i);
+
+				vst1q_f32(out[c] + i, vaddq_f32(start, vmulq_f32(t, vsubq_f32(end, start))));
+
+			}
+
+		}
+
+		return i;
+
+	}
+
+	template<SizeT N, SizeT M>
+	SizeT transformNEON(const float* m, const Components<N>& a, const MutableComponents<N>& out, SizeT count) {
+
+		float32x4_t matrix[M * M];
+
+		for (SizeT j = 0; j < M * M; j++) {
+			matrix[j] = vdupq_n_f32(m[j]);
+		}
+
+		SizeT i = 0;
+
+		for (; i + 4 <= count; i += 4) {
+
+			float32x4_t v[N];
+
+			for (SizeT c = 0; c < N; c++) {
+				v[c] = vld1q_f32(a[c] + i);
+			}
+
+			for (SizeT r = 0; r < N; r++) {
+
+				float32x4_t sum = N < M ? matrix[(M - 1) * M + r] : vdupq_n_f32(0);
+
+				for (SizeT c = 0; c < N; c++) {
+					sum = vaddq_f32(sum, vmulq_f32(matrix[c * M + r], v[c]));
+				}
+
+				vst1q_f32(out[r] + i, sum);
+
+			}
+
+		}
+
+		return i;
+
+	}
+
+#endif
+
+
+	template<SizeT N>
+	SizeT dot(const Components<N>& a, const Components<N>& b, float* out, SizeT count) {
+
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
+		arc_intrinsic_avx2 ( return dotAVX2<N>(a, b, out, count); )
+		arc_intrinsic_sse ( return dotSSE<N>(a, b, out, count); )
+#elif defined(ARC_PLATFORM_AARCH64) && defined(ARC_INTRINSIC_AVAILABLE)
+		return dotNEON<N>(a, b, out, count);
+#endif
+
+		return 0;
+
+	}
+
+	inline SizeT cross(const Components<3>& a, const Components<3>& b, const MutableComponents<3>& out, SizeT count) {
+
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
+		arc_intrinsic_avx2 ( return crossAVX2(a, b, out, count); )
+		arc_intrinsic_sse ( return crossSSE(a, b, out, count); )
+#elif defined(ARC_PLATFORM_AARCH64) && defined(ARC_INTRINSIC_AVAILABLE)
+		return crossNEON(a, b, out, count);
+#endif
+
+		return 0;
+
+	}
+
+	template<SizeT N>
+	SizeT normalize(const Components<N>& a, const MutableComponents<N>& out, SizeT count) {
+
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
+		arc_intrinsic_avx2 ( return normalizeAVX2<N>(a, out, count); )
+		arc_intrinsic_sse ( return normalizeSSE<N>(a, out, count); )
+#elif defined(ARC_PLATFORM_AARCH64) && defined(ARC_INTRINSIC_AVAILABLE)
+		return normalizeNEON<N>(a, out, count);
+#endif
+
+		return 0;
+
+	}
+
+	template<SizeT N>
+	SizeT lerp(const Components<N>& a, const Components<N>& b, float factor, const MutableComponents<N>& out, SizeT count) {
+
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
+		arc_intrinsic_avx2 ( return lerpAVX2<N>(a, b, factor, out, count); )
+		arc_intrinsic_sse ( return lerpSSE<N>(a, b, factor, out, count); )
+#elif defined(ARC_PLATFORM_AARCH64) && defined(ARC_INTRINSIC_AVAILABLE)
+		return lerpNEON<N>(a, b, factor, out, count);
+#endif
+
+		return 0;
+
+	}
+
+	template<SizeT N, SizeT M>
+	SizeT transform(const float* m, const Components<N>& a, const MutableComponents<N>& out, SizeT count) {
+
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
+		arc_intrinsic_avx2 ( return transformAVX2<N, M>(m, a, out, count); )
+		arc_intrinsic_sse ( return transformSSE<N, M>(m, a, out, count); )
+#elif defined(ARC_PLATFORM_AARCH64) && defined(ARC_INTRINSIC_AVAILABLE)
+		return transformNEON<N, M>(m, a, out, count);
+#endif
+
+		return 0;
+
+	}
+
+
+	template<CC::Float T, SizeT N>
+	std::array<const T*, N> components(const VecArray<T, N>& array) noexcept {
+
+		std::array<const T*, N> c;
+
+		for (SizeT i = 0; i < N; i++) {
+			c[i] = array.data(i);
+		}
+
+		return c;
+
+	}
+
+	template<CC::Float T, SizeT N>
+	std::array<T*, N> components(VecArray<T, N>& array) noexcept {
+
+		std::array<T*, N> c;
+
+		for (SizeT i = 0; i < N; i++) {
+			c[i] = array.data(i);
+		}
+
+		return c;
+
+	}
+
+}
+
+
+
+namespace Math {
+
+	// out[i] = a[i] . b[i]
+	template<CC::Float T, SizeT N>
+	void dot(const VecArray<T, N>& a, const VecArray<T, N>& b, std::span<T> out) noexcept {
+
+		arc_assert(a.size() == b.size() && a.size() == out.size(), "Vector array sizes do not match");
+
+		auto pa = Detail::VecArrayKernel::components(a);
+		auto pb = Detail::VecArrayKernel::components(b);
+
+		SizeT i = 0;
+
+		if constexpr (CC::Equal<T, float>) {
+			i = Detail::VecArrayKernel::dot<N>(pa, pb, out.data(), out.size());
+		}
+
+		for (; i < out.size(); i++) {
+
+			T sum = pa[0][i] * pb[0][i];
+
+			for (SizeT c = 1; c < N; c++) {
+				sum += pa[c][i] * pb[c][i];
+			}
+
+			out[i] = sum;
+
+		}
+
+	}
+
+	// out[i] = a[i] x b[i], out may be a or b
+	template<CC::Float T>
+	void cross(const Vec3Array<T>& a, const Vec3Array<T>& b, Vec3Array<T>& out) {
+
+		arc_assert(a.size() == b.size(), "Vector array sizes do not match");
+
+		out.resize(a.size());
+
+		auto pa = Detail::VecArrayKernel::components(a);
+		auto pb = Detail::VecArrayKernel::components(b);
+		auto po = Detail::VecArrayKernel::components(out);
+
+		SizeT i = 0;
+
+		if constexpr (CC::Equal<T, float>) {
+			i = Detail::VecArrayKernel::cross(pa, pb, po, out.size());
+		}
+
+		for (; i < out.size(); i++) {
+
+			T x = pa[1][i] * pb[2][i] - pa[2][i] * pb[1][i];
+			T y = pa[2][i] * pb[0][i] - pa[0][i] * pb[2][i];
+			T z = pa[0][i] * pb[1][i] - pa[1][i] * pb[0][i];
+
+			po[0][i] = x;
+			po[1][i] = y;
+			po[2][i] = z;
+
+		}
+
+	}
+
+	// out[i] = a[i] / |a[i]|, out may be a. Null vectors yield non-finite components.
+	template<CC::Float T, SizeT N>
+	void normalize(const VecArray<T, N>& a, VecArray<T, N>& out) {
+
+		out.resize(a.size());
+
+		auto pa = Detail::VecArrayKernel::components(a);
+		auto po = Detail::VecArrayKernel::components(out);
+
+		SizeT i = 0;
+
+		if constexpr (CC::Equal<T, float>) {
+			i = Detail::VecArrayKernel::normalize<N>(pa, po, out.size());
+		}
+
+		for (; i < out.size(); i++) {
+
+			T v[N];
+			T sum = 0;
+
+			for (SizeT c = 0; c < N; c++) {
+				v[c] = pa[c][i];
+				sum += v[c] * v[c];
+			}
+
+			T length = Math::sqrt(sum);
+
+			for (SizeT c = 0; c < N; c++) {
+				po[c][i] = v[c] / length;
+			}
+
+		}
+
+	}
+
+	template<CC::Float T, SizeT N>
+	void normalize(VecArray<T, N>& a) {
+		normalize(a, a);
+	}
+
+	// out[i] = a[i] + factor * (b[i] - a[i]), out may be a or b
+	template<CC::Float T, SizeT N>
+	void lerp(const VecArray<T, N>& a, const VecArray<T, N>& b, T factor, VecArray<T, N>& out) {
+
+		arc_assert(a.size() == b.size(), "Vector array sizes do not match");
+
+		out.resize(a.size());
+
+		auto pa = Detail::VecArrayKernel::components(a);
+		auto pb = Detail::VecArrayKernel::components(b);
+		auto po = Detail::VecArrayKernel::components(out);
+
+		SizeT i = 0;
+
+		if constexpr (CC::Equal<T, float>) {
+			i = Detail::VecArrayKernel::lerp<N>(pa, pb, factor, po, out.size());
+		}
+
+		for (; i < out.size(); i++) {
+
+			for (SizeT c = 0; c < N; c++) {
+				po[c][i] = pa[c][i] + factor * (pb[c][i] - pa[c][i]);
+			}
+
+		}
+
+	}
+
+	/*
+		out[i] = m * a[i], out may be a.
+		For a matrix one dimension larger than the vectors, the vectors are treated as points (w = 1),
+		e.g. a Mat4 applies its full affine transform to a Vec3Array. The projective row is ignored.
+	*/
+	template<CC::FloatMatrix M, CC::Float T, SizeT N> requires (CC::Equal<typename M::Type, T> && (M::Size == N || M::Size == N + 1))
+	void transform(const M& m, const VecArray<T, N>& a, VecArray<T, N>& out) {
+
+		constexpr SizeT S = M::Size;
+
+		out.resize(a.size());
+
+		T flat[S * S];
+
+		for (SizeT c = 0; c < S; c++) {
+
+			for (SizeT r = 0; r < S; r++) {
+				flat[c * S + r] = m[c][r];
+			}
+
+		}
+
+		auto pa = Detail::VecArrayKernel::components(a);
+		auto po = Detail::VecArrayKernel::components(out);
+
+		SizeT i = 0;
+
+		if constexpr (CC::Equal<T, float>) {
+			i = Detail::VecArrayKernel::transform<N, S>(flat, pa, po, out.size());
+		}
+
+		for (; i < out.size(); i++) {
+
+			T v[N];
+
+			for (SizeT c = 0; c < N; c++) {
+				v[c] = pa[c][i];
+			}
+
+			for (SizeT r = 0; r < N; r++) {
+
+				T sum = N < S ? flat[(S - 1) * S + r] : T(0);
+
+				for (SizeT c = 0; c < N; c++) {
+					sum += flat[c * S + r] * v[c];
+				}
+
+				po[r][i] = sum;
+
+			}
+
+		}
+
+	}
+
+	template<CC::FloatMatrix M, CC::Float T, SizeT N> requires (CC::Equal<typename M::Type, T> && (M::Size == N || M::Size == N + 1))
+	void transform(const M& m, VecArray<T, N>& a) {
+		transform(m, a, a);
+	}
+
+}
@@ -15,7 +15,12 @@
 	ChunkAllocator
 
 	Manages a resizeable heap divided into fixed-size blocks.
-	Allows allocation/deallocation in O(1).TODO
+	Allows allocation in amortized O(1) and deallocation in O(1).
+
+	Blocks are grouped into chunks of chunkBlocks blocks each. Once all blocks are in use, allocate() appends a new chunk,
+	so allocation costs O(chunkBlocks) every chunkBlocks allocations. Chunks are linked through a ChunkLink stored after their last block
+	and are only released by clear().
+	Not thread-safe; see SmallObjectHeap for a concurrent alternative.
 */
 class ChunkAllocator {
 
@@ -62,7 +67,8 @@ public:
 
 
 	/*
-		Acquires a block of allocated memory. Throws std::bad_alloc if no memory has been allocated or there is no free block left.
+		Acquires a block of allocated memory. A new chunk is allocated if no free block is left.
+		Throws std::bad_alloc if create() has not been called or chunk allocation failed.
 		returns:	A pointer to the allocated block.
 	*/
 	[[nodiscard]] void* allocate();
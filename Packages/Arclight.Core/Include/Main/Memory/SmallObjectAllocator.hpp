@@ -0,0 +1,165 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 SmallObjectAllocator.hpp
+ */
+
+#pragma once
+
+#include "Meta/Concepts.hpp"
+#include "Common/Types.hpp"
+
+#include <new>
+#include <limits>
+#include <memory>
+#include <cstddef>
+
+
+
+/*
+	SmallObjectHeap
+	General purpose allocator for small objects shared by all threads.
+
+	Requests are rounded up to one of SizeClassCount size classes. Every thread owns a cache which in turn owns spans,
+	SpanSize-aligned heaps divided into blocks of a single size class. Like PoolAllocator, free blocks are linked in place.
+	Allocation and deallocation from the owning thread are O(1) and do not synchronize.
+
+	Deallocating a block owned by another thread pushes it onto the owner's lock-free remote list.
+	The owner reclaims remote blocks once its local free list for that size class runs dry.
+	When a thread exits, its cache is retired and adopted by the next thread requiring one, so spans are never leaked.
+
+	Requests larger than MaxSmallSize or aligned stricter than MaxSmallAlign are forwarded to the global operator new.
+	Since the size class is not stored per block, deallocate() must receive the same size and alignment as allocate().
+*/
+class SmallObjectHeap {
+
+public:
+
+	constexpr static SizeT SpanSize = 64 * 1024;
+	constexpr static SizeT MaxSmallSize = 1024;
+	constexpr static AlignT MaxSmallAlign = 16;
+	constexpr static SizeT SizeClassCount = 20;
+
+
+	SmallObjectHeap() = delete;
+
+
+	/*
+		Allocates size bytes aligned to align.
+		Throws std::bad_alloc on failure.
+	*/
+	[[nodiscard]] static void* allocate(SizeT size, AlignT align = alignof(std::max_align_t));
+
+
+	/*
+		Deallocates ptr previously returned by allocate(size, align). May be called from any thread.
+		ptr:		The pointer to be deallocated. nullptr has no effect.
+	*/
+	static void deallocate(void* ptr, SizeT size, AlignT align = alignof(std::max_align_t)) noexcept;
+
+
+	//Releases all fully unused spans of the calling thread's cache back to the system
+	static void trim() noexcept;
+
+
+	constexpr static bool isSmall(SizeT size, AlignT align) noexcept {
+		return size <= MaxSmallSize && align <= MaxSmallAlign;
+	}
+
+
+	/*
+		Returns the size class index of a small request.
+		Classes are 16 bytes apart up to 128 bytes and 4 classes per power of two above.
+	*/
+	constexpr static SizeT getSizeClass(SizeT size) noexcept {
+
+		if (size <= 128) {
+			return size ? (size - 1) / 16 : 0;
+		}
+
+		SizeT exponent = 7;
+
+		while ((SizeT(1) << (exponent + 1)) < size) {
+			exponent++;
+		}
+
+		SizeT step = (SizeT(1) << exponent) / 4;
+
+		return 8 + (exponent - 7) * 4 + (size - (SizeT(1) << exponent) - 1) / step;
+
+	}
+
+
+	//Returns the block size of the given size class
+	constexpr static SizeT getClassSize(SizeT sizeClass) noexcept {
+
+		if (sizeClass < 8) {
+			return (sizeClass + 1) * 16;
+		}
+
+		SizeT exponent = 7 + (sizeClass - 8) / 4;
+		SizeT base = SizeT(1) << exponent;
+
+		return base + ((sizeClass - 8) % 4 + 1) * (base / 4);
+
+	}
+
+};
+
+
+
+/*
+	Standard allocator adapter for SmallObjectHeap.
+	Stateless, hence containers can freely exchange memory between instances.
+*/
+template<class T> requires (!CC::ConstType<T>)
+class SmallObjectAllocator {
+
+public:
+
+	using value_type = T;
+	using size_type = SizeT;
+	using difference_type = std::ptrdiff_t;
+	using propagate_on_container_move_assignment = std::true_type;
+	using is_always_equal = std::true_type;
+
+
+	constexpr SmallObjectAllocator() noexcept = default;
+	constexpr ~SmallObjectAllocator() noexcept = default;
+
+	constexpr SmallObjectAllocator(const SmallObjectAllocator& alloc) noexcept = default;
+	constexpr SmallObjectAllocator& operator=(const SmallObjectAllocator& alloc) = default;
+
+	template<class U>
+	constexpr SmallObjectAllocator(const SmallObjectAllocator<U>& alloc) noexcept {};
+
+
+	[[nodiscard]] T* allocate(SizeT n) {
+
+		if (std::numeric_limits<SizeT>::max() / sizeof(T) < n) {
+			throw std::bad_array_new_length();
+		}
+
+		return static_cast<T*>(SmallObjectHeap::allocate(n * sizeof(T), alignof(T)));
+
+	}
+
+	void deallocate(T* p, SizeT n) noexcept {
+		SmallObjectHeap::deallocate(p, n * sizeof(T), alignof(T));
+	}
+
+
+	template<class U>
+	struct rebind {
+		using other = SmallObjectAllocator<U>;
+	};
+
+};
+
+
+template<class T, class U>
+constexpr bool operator==(const SmallObjectAllocator<T>&, const SmallObjectAllocator<U>&) noexcept {
+	return true;
+}
@@ -48,12 +48,18 @@ public:
 			throw std::bad_array_new_length();
 		}
 
-		return static_cast<T*>(VirtualMemory::allocate(n * sizeof(T), Protection));
+		void* p = VirtualMemory::allocate(n * sizeof(T), Protection);
+
+		if (!p) {
+			throw std::bad_alloc();
+		}
+
+		return static_cast<T*>(p);
 
 	}
 
-	constexpr void deallocate(T* p, [[maybe_unused]] SizeT n) noexcept {
-		VirtualMemory::deallocate(p);
+	constexpr void deallocate(T* p, SizeT n) noexcept {
+		VirtualMemory::deallocate(p, n * sizeof(T));
 	}
 
 
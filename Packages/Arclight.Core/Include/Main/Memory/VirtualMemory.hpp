@@ -22,16 +22,51 @@ namespace VirtualMemory {
 		ExecuteReadWrite
 	};
 
+	enum class HugePages {
+		None,			//Regular pages
+		Transparent,	//Hint the kernel to back the range with huge pages if possible (no effect on Windows)
+		Explicit		//Allocate from the explicit huge/large page pool, fails if unavailable
+	};
+
+	/*
+	 *  Returns the size of a regular page
+	 */
+	SizeT getPageSize() noexcept;
+
+	/*
+	 *  Returns the size of an explicit huge page or 0 if huge pages are not supported
+	 */
+	SizeT getHugePageSize() noexcept;
+
+	/*
+	 *  Allocates and commits virtual memory pages with the given protection. Returns nullptr on failure.
+	 *  For HugePages::Explicit, size must be a multiple of getHugePageSize().
+	 */
+	void* allocate(SizeT size, Protection protection, HugePages hugePages = HugePages::None);
+
+	/*
+	 *  Reserves address space without committing memory. Pages must be committed with commit() before being accessed.
+	 *  HugePages::Explicit is not supported for reservations. Returns nullptr on failure.
+	 */
+	void* reserve(SizeT size, HugePages hugePages = HugePages::None);
+
+	/*
+	 *  Commits all reserved pages containing the addresses in the range [start; start + size] with the given protection.
+	 *  Returns true if the pages have been committed.
+	 */
+	bool commit(void* start, SizeT size, Protection protection);
+
 	/*
-	 *  Allocates virtual memory pages with the given protection
-	 *
+	 *  Decommits all pages containing the addresses in the range [start; start + size], returning their physical memory to the system.
+	 *  The address range stays reserved and may be committed again. Returns true if the pages have been decommitted.
 	 */
-	void* allocate(SizeT size, Protection protection);
+	bool decommit(void* start, SizeT size);
 
 	/*
-	 *  Deallocates virtual memory allocated with allocate(). Returns true if the deallocation was successful, false otherwise.
+	 *  Deallocates virtual memory obtained by allocate() or reserve(). size must match the size passed upon allocation.
+	 *  Returns true if the deallocation was successful, false otherwise.
 	 */
-	bool deallocate(void* ptr);
+	bool deallocate(void* ptr, SizeT size);
 
 	/*
 	 *  Sets the page protection for all pages containing the addresses in the range [start; start + size]. Returns true if the page protection has been applied correctly.
@@ -475,10 +475,10 @@ namespace TT {
 
 
 	template<CC::Arithmetic T>
-	static constexpr bool HasBiggerType = CC::Exists<BiggerType<T>>;
+	static constexpr bool HasBiggerType = requires { typename Detail::BiggerType<T>::Type; };
 
 	template<CC::Arithmetic T>
-	static constexpr bool HasSmallerType = CC::Exists<SmallerType<T>>;
+	static constexpr bool HasSmallerType = requires { typename Detail::SmallerType<T>::Type; };
 
 
 	namespace Detail {
@@ -12,15 +12,20 @@
 #include "Common/Assert.hpp"
 #include "Meta/TypeTraits.hpp"
 
+#include <memory>
+#include <vector>
 #include <unordered_map>
 
 
 
-template<class Key, class Value, SizeT DomainSize = 512>
+template<class Key, class Value, SizeT DomainSize = 512, class Allocator = std::allocator<Value>>
 class ArrayMap {
 
 	constexpr static SizeT invalidStorage = -1;
 
+	template<class U>
+	using RebindAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+
 	struct Storage {
 
 		static_assert(std::is_nothrow_constructible_v<Value>, "Value must be nothrow-constructible");
@@ -428,8 +433,10 @@ private:
 	}
 
 
-	std::unordered_map<Key, SizeT> indexMap;
-	std::vector<std::vector<Storage>> storages;
+	using StorageBlock = std::vector<Storage, RebindAllocator<Storage>>;
+
+	std::unordered_map<Key, SizeT, std::hash<Key>, std::equal_to<Key>, RebindAllocator<std::pair<const Key, SizeT>>> indexMap;
+	std::vector<StorageBlock, RebindAllocator<StorageBlock>> storages;
 
 	SizeT firstActive;
 	SizeT firstFree;
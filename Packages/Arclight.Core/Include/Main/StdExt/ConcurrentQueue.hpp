@@ -27,18 +27,25 @@
 	Concurrent Queue for multiple consumers/producers with atomic operations.
 	This code has been optimized to relax atomic reordering.
 	All functions except constructor and destructor guarantee no-throw behaviour with the given constraints of T.
+
+	Size specifies the capacity at compile time. If Size is DynamicSize, the capacity is passed to the constructor instead.
+	If SingleConsumer is true, pop operations skip the head CAS. Only one thread may pop at a time then (see MPSCQueue).
+	Consumers may block on waitPop() without spinning; producers only pay a fence and a load while nobody waits.
 */
 
 #pragma once
 
+#include "Concurrent/AtomicWait.hpp"
+#include "Common/Assert.hpp"
 #include "Common/Types.hpp"
 
 #include <atomic>
 #include <cstddef>
 #include <new>
+#include <utility>
 
 
-template<class T, u32 Size>
+template<class T, u32 Size = 0, bool SingleConsumer = false>
 class ConcurrentQueue final {
 
 	constexpr static inline std::size_t hdiSize = std::hardware_destructive_interference_size;
@@ -89,9 +96,16 @@ public:
 	static_assert(std::is_nothrow_move_constructible_v<T>, "ConcurrentQueue requires T to be nothrow move-constructible");
 	static_assert(std::is_nothrow_destructible_v<T>, "ConcurrentQueue requires T to be nothrow destructible");
 
-	constexpr ConcurrentQueue() {
+	constexpr static inline u32 DynamicSize = 0;
+
+	constexpr ConcurrentQueue() requires (Size != DynamicSize) : ConcurrentQueue(Size) {}
+
+	constexpr explicit ConcurrentQueue(u32 capacity) : slots(capacity) {
+
+		arc_assert(capacity, "ConcurrentQueue capacity must not be 0");
+		arc_assert(Size == DynamicSize || capacity == Size, "Static ConcurrentQueue capacity mismatch");
 
-		storage = new Storage[Size];
+		storage = new Storage[slots];
 		head.store(0, std::memory_order_relaxed);
 		tail.store(0, std::memory_order_relaxed);
 		std::atomic_thread_fence(std::memory_order_release);
@@ -117,6 +131,7 @@ public:
 
 		std::atomic_thread_fence(std::memory_order_acquire);
 		this->storage = std::exchange(queue.storage, nullptr);
+		this->slots = queue.slots;
 		this->head.store(queue.head.load(std::memory_order_relaxed), std::memory_order_relaxed);
 		this->tail.store(queue.tail.load(std::memory_order_relaxed), std::memory_order_relaxed);
 		std::atomic_thread_fence(std::memory_order_release);
@@ -125,92 +140,89 @@ public:
 
 
 	constexpr ConcurrentQueue& operator=(ConcurrentQueue&& queue) noexcept {
-	
+
 		std::atomic_thread_fence(std::memory_order_acquire);
+		delete[] this->storage;
 		this->storage = std::exchange(queue.storage, nullptr);
+		this->slots = queue.slots;
 		this->head.store(queue.head.load(std::memory_order_relaxed), std::memory_order_relaxed);
 		this->tail.store(queue.tail.load(std::memory_order_relaxed), std::memory_order_relaxed);
 		std::atomic_thread_fence(std::memory_order_release);
 
+		return *this;
+
 	}
 
 
 
 	bool push(T&& element) noexcept {
 
-		u64 currentTail = tail.load(std::memory_order_acquire);
+		if (tryClaimPush(&element, 1) != 1) {
+			return false;
+		}
 
-		while (true) {
+		signal.notifyOne();
+		return true;
 
-			Storage& s = storage[currentTail % Size];
+	}
 
-			//When the index holds the correct state, attempt to push later
-			if ((currentTail / Size) << Storage::indexShift == s.getIndex()) {
-				
-				//Try incrementing the tail now. Fails if it has been modified by a different thread, retry in that case.
-				if (tail.compare_exchange_strong(currentTail, currentTail + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
 
-					s.acquire(std::move(element));
-					s.setIndex(((currentTail / Size) << Storage::indexShift) | (Storage::activeBit << Storage::activeShift));
-					return true;
 
-				}
+	/*
+		Pushes up to count elements from elements, claiming all slots with a single CAS.
+		Elements are moved from the front of the array. Returns the number of pushed elements.
+	*/
+	u32 pushBulk(T* elements, u32 count) noexcept {
 
-			} else {
-
-				//Wrong state, return if tail hasn't changed (meaning the queue is full)
-				u64 oldTail = currentTail;
-				currentTail = tail.load(std::memory_order_acquire);
-
-				if (oldTail == currentTail) {
-					break;
-				}
-
-			}
+		u32 pushed = tryClaimPush(elements, count);
 
+		if (pushed) {
+			signal.notifyAll();
 		}
 
-		return false;
+		return pushed;
 
 	}
 
 
 
 	bool pop(T& element) noexcept {
-	
-		u64 currentHead = head.load(std::memory_order_acquire);
+		return tryClaimPop(&element, 1) == 1;
+	}
 
-		while (true) {
 
-			Storage& s = storage[currentHead % Size];
 
-			//When the index holds the correct state, attempt to push later
-			if ((((currentHead / Size) << Storage::indexShift) | (Storage::activeBit << Storage::activeShift)) == s.getIndex()) {
+	/*
+		Pops up to count elements into elements, claiming all slots with a single CAS.
+		Returns the number of popped elements.
+	*/
+	u32 popBulk(T* elements, u32 count) noexcept {
+		return tryClaimPop(elements, count);
+	}
 
-				//Try incrementing the head now. Fails if it has been modified by a different thread, retry in that case.
-				if (head.compare_exchange_strong(currentHead, currentHead + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
 
-					s.release(element);
-					s.setIndex((currentHead / Size + 1) << Storage::indexShift);
-					return true;
 
-				}
+	//Pops an element, blocking until one is available
+	void waitPop(T& element) noexcept {
+		signal.wait([&]() { return pop(element); });
+	}
 
-			} else {
 
-				//Wrong state, return if head hasn't changed (meaning the queue is empty)
-				u64 oldHead = currentHead;
-				currentHead = head.load(std::memory_order_acquire);
 
-				if (oldHead == currentHead) {
-					break;
-				}
+	//Pops an element, blocking for at most us microseconds. Returns false if the queue stayed empty.
+	bool waitPop(T& element, u64 us) noexcept {
+		return signal.waitFor([&]() { return pop(element); }, us);
+	}
 
-			}
 
-		}
 
-		return false;
+	//Pops up to count elements, blocking for at most us microseconds until at least one is available. Returns the number of popped elements.
+	u32 waitPopBulk(T* elements, u32 count, u64 us) noexcept {
+
+		u32 popped = 0;
+		signal.waitFor([&]() { return (popped = popBulk(elements, count)) != 0; }, us);
+
+		return popped;
 
 	}
 
@@ -218,19 +230,20 @@ public:
 
 	//Returns the total capacity
 	u32 capacity() const noexcept {
-		return Size;
+		return Size != DynamicSize ? Size : slots;
 	}
 
 
 
 	//Returns the size of the queue. It's NOT a qualitative measurement since it might not represent the actual current state!
-	bool size() const noexcept {
+	SizeT size() const noexcept {
 
 		std::atomic_thread_fence(std::memory_order_acquire);
 		u64 headIndex = head.load(std::memory_order_relaxed);
 		u64 tailIndex = tail.load(std::memory_order_relaxed);
 
-		return tailIndex - headIndex;
+		//Pops may momentarily overtake the tail snapshot
+		return tailIndex > headIndex ? tailIndex - headIndex : 0;
 
 	}
 
@@ -243,14 +256,145 @@ public:
 		u64 headIndex = head.load(std::memory_order_relaxed);
 		u64 tailIndex = tail.load(std::memory_order_relaxed);
 
-		return headIndex == tailIndex;
+		return headIndex >= tailIndex;
 
 	}
 
 private:
 
+	u64 freeIndex(u64 ticket) const noexcept {
+		return (ticket / capacity()) << Storage::indexShift;
+	}
+
+	u64 activeIndex(u64 ticket) const noexcept {
+		return freeIndex(ticket) | (Storage::activeBit << Storage::activeShift);
+	}
+
+	Storage& slot(u64 ticket) const noexcept {
+		return storage[ticket % capacity()];
+	}
+
+
+	//Claims up to count consecutive free slots at the tail and moves elements into them
+	u32 tryClaimPush(T* elements, u32 count) noexcept {
+
+		u64 currentTail = tail.load(std::memory_order_acquire);
+
+		while (true) {
+
+			//Count the slots ready for this turn
+			u32 available = 0;
+
+			while (available < count && available < capacity() && slot(currentTail + available).getIndex() == freeIndex(currentTail + available)) {
+				available++;
+			}
+
+			if (available) {
+
+				//Try incrementing the tail now. Fails if it has been modified by a different thread, retry in that case.
+				if (tail.compare_exchange_strong(currentTail, currentTail + available, std::memory_order_acq_rel, std::memory_order_acquire)) {
+
+					for (u32 i = 0; i < available; i++) {
+
+						Storage& s = slot(currentTail + i);
+						s.acquire(std::move(elements[i]));
+						s.setIndex(activeIndex(currentTail + i));
+
+					}
+
+					return available;
+
+				}
+
+			} else {
+
+				//Wrong state, return if tail hasn't changed (meaning the queue is full)
+				u64 oldTail = currentTail;
+				currentTail = tail.load(std::memory_order_acquire);
+
+				if (oldTail == currentTail) {
+					return 0;
+				}
+
+			}
+
+		}
+
+	}
+
+
+	//Claims up to count consecutive active slots at the head and moves them into elements
+	u32 tryClaimPop(T* elements, u32 count) noexcept {
+
+		u64 currentHead = head.load(std::memory_order_acquire);
+
+		while (true) {
+
+			u32 available = 0;
+
+			while (available < count && available < capacity() && slot(currentHead + available).getIndex() == activeIndex(currentHead + available)) {
+				available++;
+			}
+
+			if (available) {
+
+				if constexpr (SingleConsumer) {
+
+					//No other consumer may advance the head
+					head.store(currentHead + available, std::memory_order_release);
+
+				} else if (!head.compare_exchange_strong(currentHead, currentHead + available, std::memory_order_acq_rel, std::memory_order_acquire)) {
+
+					//Head has been modified by a different thread, retry
+					continue;
+
+				}
+
+				for (u32 i = 0; i < available; i++) {
+
+					Storage& s = slot(currentHead + i);
+					s.release(elements[i]);
+					s.setIndex(freeIndex(currentHead + i + capacity()));
+
+				}
+
+				return available;
+
+			}
+
+			//Wrong state, return if head hasn't changed (meaning the queue is empty)
+			u64 oldHead = currentHead;
+			currentHead = head.load(std::memory_order_acquire);
+
+			if (oldHead == currentHead) {
+				return 0;
+			}
+
+		}
+
+	}
+
+
 	Storage* storage;
+	u32 slots;
 	alignas(hdiSize) std::atomic<u64> head;
 	alignas(hdiSize) std::atomic<u64> tail;
+	alignas(hdiSize) AtomicSignal signal;
+
+};
+
 
-};
\ No newline at end of file
+
+/*
+	Runtime-sized ConcurrentQueue
+*/
+template<class T>
+using DynamicConcurrentQueue = ConcurrentQueue<T, 0>;
+
+
+/*
+	Multi-producer single-consumer ConcurrentQueue.
+	Only one thread may pop at a time.
+*/
+template<class T, u32 Size = 0>
+using MPSCQueue = ConcurrentQueue<T, Size, true>;
\ No newline at end of file
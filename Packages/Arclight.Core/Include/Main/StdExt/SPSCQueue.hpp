@@ -0,0 +1,214 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 SPSCQueue.hpp
+ */
+
+#pragma once
+
+#include "Concurrent/AtomicWait.hpp"
+#include "Common/Assert.hpp"
+#include "Math/Math.hpp"
+#include "Common/Types.hpp"
+
+#include <new>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+
+
+/*
+	Bounded single-producer single-consumer queue.
+	Exactly one thread may push and one thread may pop at a time. Neither side performs a read-modify-write operation;
+	each keeps a cached copy of the other side's index and only reloads it when the queue appears full or empty.
+	Size specifies the capacity at compile time. If Size is DynamicSize, the capacity is passed to the constructor instead.
+*/
+template<class T, u32 Size = 0>
+class SPSCQueue final {
+
+	constexpr static inline std::size_t hdiSize = std::hardware_destructive_interference_size;
+
+	struct Storage {
+		alignas(T) u8 data[sizeof(T)];
+	};
+
+public:
+
+	static_assert(std::is_nothrow_move_constructible_v<T>, "SPSCQueue requires T to be nothrow move-constructible");
+	static_assert(std::is_nothrow_destructible_v<T>, "SPSCQueue requires T to be nothrow destructible");
+
+	constexpr static inline u32 DynamicSize = 0;
+
+	SPSCQueue() requires (Size != DynamicSize) : SPSCQueue(Size) {}
+
+	explicit SPSCQueue(u32 capacity) : storage(std::make_unique<Storage[]>(capacity)), slots(capacity), head(0), cachedTail(0), tail(0), cachedHead(0) {
+
+		arc_assert(capacity, "SPSCQueue capacity must not be 0");
+		arc_assert(Size == DynamicSize || capacity == Size, "Static SPSCQueue capacity mismatch");
+
+	}
+
+	~SPSCQueue() {
+
+		u64 last = tail.load(std::memory_order_acquire);
+
+		for (u64 i = head.load(std::memory_order_relaxed); i != last; i++) {
+			element(i).~T();
+		}
+
+	}
+
+	SPSCQueue(const SPSCQueue& queue) = delete;
+	SPSCQueue& operator=(const SPSCQueue& queue) = delete;
+
+
+
+	//Producer only
+	bool push(T&& object) noexcept {
+		return pushBulk(&object, 1);
+	}
+
+
+
+	//Producer only. Moves up to count elements into the queue and returns the number of pushed elements.
+	u32 pushBulk(T* objects, u32 count) noexcept {
+
+		u64 currentTail = tail.load(std::memory_order_relaxed);
+		u64 free = capacity() - (currentTail - cachedHead);
+
+		if (free < count) {
+
+			cachedHead = head.load(std::memory_order_acquire);
+			free = capacity() - (currentTail - cachedHead);
+
+		}
+
+		u32 pushed = Math::min<u64>(free, count);
+
+		if (!pushed) {
+			return 0;
+		}
+
+		for (u32 i = 0; i < pushed; i++) {
+			::new(storage[(currentTail + i) % capacity()].data) T(std::move(objects[i]));
+		}
+
+		tail.store(currentTail + pushed, std::memory_order_release);
+		signal.notifyOne();
+
+		return pushed;
+
+	}
+
+
+
+	//Consumer only
+	bool pop(T& object) noexcept {
+		return popBulk(&object, 1);
+	}
+
+
+
+	//Consumer only. Pops up to count elements and returns the number of popped elements.
+	u32 popBulk(T* objects, u32 count) noexcept {
+
+		u64 currentHead = head.load(std::memory_order_relaxed);
+
+		if (cachedTail - currentHead < count) {
+			cachedTail = tail.load(std::memory_order_acquire);
+		}
+
+		u32 popped = Math::min<u64>(cachedTail - currentHead, count);
+
+		for (u32 i = 0; i < popped; i++) {
+
+			T& old = element(currentHead + i);
+			objects[i] = std::move(old);
+			old.~T();
+
+		}
+
+		if (popped) {
+			head.store(currentHead + popped, std::memory_order_release);
+		}
+
+		return popped;
+
+	}
+
+
+
+	//Consumer only. Pops an element, blocking until one is available.
+	void waitPop(T& object) noexcept {
+		signal.wait([&]() { return pop(object); });
+	}
+
+
+
+	//Consumer only. Pops an element, blocking for at most us microseconds. Returns false if the queue stayed empty.
+	bool waitPop(T& object, u64 us) noexcept {
+		return signal.waitFor([&]() { return pop(object); }, us);
+	}
+
+
+
+	//Consumer only. Pops up to count elements, blocking for at most us microseconds until at least one is available.
+	u32 waitPopBulk(T* objects, u32 count, u64 us) noexcept {
+
+		u32 popped = 0;
+		signal.waitFor([&]() { return (popped = popBulk(objects, count)) != 0; }, us);
+
+		return popped;
+
+	}
+
+
+
+	//Returns the total capacity
+	u32 capacity() const noexcept {
+		return Size != DynamicSize ? Size : slots;
+	}
+
+
+
+	//Returns the size of the queue. It's NOT a qualitative measurement since it might not represent the actual current state!
+	SizeT size() const noexcept {
+
+		u64 headIndex = head.load(std::memory_order_acquire);
+		u64 tailIndex = tail.load(std::memory_order_acquire);
+
+		return tailIndex > headIndex ? tailIndex - headIndex : 0;
+
+	}
+
+
+
+	//Returns whether the queue is empty. It's NOT a qualitative measurement since it might not represent the actual current state!
+	bool empty() const noexcept {
+		return size() == 0;
+	}
+
+private:
+
+	T& element(u64 index) noexcept {
+		return *std::launder(reinterpret_cast<T*>(storage[index % capacity()].data));
+	}
+
+
+	std::unique_ptr<Storage[]> storage;
+	u32 slots;
+
+	//Consumer side
+	alignas(hdiSize) std::atomic<u64> head;
+	u64 cachedTail;
+
+	//Producer side
+	alignas(hdiSize) std::atomic<u64> tail;
+	u64 cachedHead;
+
+	alignas(hdiSize) AtomicSignal signal;
+
+};
\ No newline at end of file
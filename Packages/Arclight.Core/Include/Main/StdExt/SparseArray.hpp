@@ -15,6 +15,7 @@
 #include "Common/Types.hpp"
 
 #include <vector>
+#include <memory>
 #include <iterator>
 
 
@@ -24,12 +25,16 @@
 
 	Complexity for lookup, insertion, deletion is O(1). Traversal is O(n).
 	Memory overhead is proportional to the number of sparse entries.
+	Allocator is rebound for every internal array.
 */
-template<class T, class IndexType = u32>
+template<class T, class IndexType = u32, class Allocator = std::allocator<T>>
 class SparseArray {
 
 	static_assert(!std::is_reference_v<T>, "T cannot be a reference type");
 
+	template<class U>
+	using RebindAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+
 #ifdef ARC_CFG_SPARSE_PACK
 	struct Storage {
 		IndexType index;
@@ -714,12 +719,12 @@ private:
 	}
 
 #ifndef ARC_CFG_SPARSE_PACK
-	std::vector<T> elementArray;
-	std::vector<IndexType> denseArray;
+	std::vector<T, RebindAllocator<T>> elementArray;
+	std::vector<IndexType, RebindAllocator<IndexType>> denseArray;
 #else
-	std::vector<Storage> denseArray;
+	std::vector<Storage, RebindAllocator<Storage>> denseArray;
 #endif
 
-	std::vector<IndexType> indexArray;
+	std::vector<IndexType, RebindAllocator<IndexType>> indexArray;
 
 };
\ No newline at end of file
@@ -0,0 +1,304 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 Instrumentation.hpp
+ */
+
+#pragma once
+
+#include "Common/Types.hpp"
+#include "Common/Build.hpp"
+#include "Common/Config.hpp"
+#include "Util/Preprocessor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#if defined(ARC_PLATFORM_X86) && !defined(ARC_CFG_INSTRUMENTATION_STEADY_CLOCK)
+	#ifdef ARC_COMPILER_MSVC
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+	#endif
+	#define ARC_INSTRUMENTATION_TSC
+#endif
+
+
+
+/*
+	Instrumentation profiler.
+
+	arc_profile_zone("Update");					Times the enclosing scope
+	arc_profile_counter("Draw Calls", count);	Samples a counter
+	arc_profile_frame();						Marks a frame boundary
+
+	Events are written into per-thread buffers owned by the recording thread; recording a zone costs two timestamps and two buffer stores.
+	Zones nest naturally, per-thread nesting is reconstructed from the event order.
+	Recording only happens between Instrumentation::start() and Instrumentation::stop(). The returned capture can be aggregated
+	or exported as Chrome trace-event JSON (chrome://tracing, Perfetto).
+
+	Names passed to zones and counters must outlive the capture (string literals).
+	Timestamps are taken from the TSC on x86, which is assumed to be invariant. All durations reported by a capture are in microseconds.
+*/
+#ifdef ARC_CFG_INSTRUMENTATION
+
+	#define arc_profile_zone(name)																					\
+		static constexpr Instrumentation::ZoneSite ARC_PP_CAT(arcZoneSite, __LINE__) {(name), __FILE__, __LINE__};	\
+		Instrumentation::ScopedZone ARC_PP_CAT(arcZone, __LINE__)(ARC_PP_CAT(arcZoneSite, __LINE__))
+
+	#define arc_profile_counter(name, value)	Instrumentation::counter((name), (value))
+	#define arc_profile_frame()					Instrumentation::frame()
+
+#else
+
+	#define arc_profile_zone(name)				do {} while (false)
+	#define arc_profile_counter(name, value)	do {} while (false)
+	#define arc_profile_frame()					do {} while (false)
+
+#endif
+
+
+
+class Path;
+
+namespace Instrumentation {
+
+	struct ZoneSite {
+
+		const char* name;
+		const char* file;
+		u32 line;
+
+	};
+
+
+	enum class EventType : u32 {
+		ZoneBegin,
+		ZoneEnd,
+		Counter,
+		Frame
+	};
+
+
+	struct Event {
+
+		u64 timestamp;
+		const void* data;		//ZoneSite for zones, counter name for counters
+		double value;
+		EventType type;
+
+	};
+
+
+	//Returns the current timestamp in ticks
+	inline u64 now() noexcept {
+
+#ifdef ARC_INSTRUMENTATION_TSC
+		return __rdtsc();
+#else
+		return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+
+	}
+
+
+	namespace Detail {
+
+		constexpr u32 ChunkEvents = 4096;
+
+		struct Chunk {
+
+			std::atomic<u32> count;
+			std::atomic<Chunk*> next;
+			Event events[ChunkEvents];
+
+		};
+
+
+		struct ThreadCursor {
+
+			Chunk* chunk;
+			u32 state;
+
+		};
+
+
+		//Bit 0 toggles recording, the remaining bits count captures
+		extern std::atomic<u32> captureState;
+		extern constinit thread_local ThreadCursor threadCursor;
+
+		//Slow path: (re)initializes the calling thread's buffer or appends a new chunk. Returns false if no memory is available.
+		bool acquireChunk(u32 state) noexcept;
+
+
+		inline bool record(EventType type, const void* data, double value) noexcept {
+
+			u32 state = captureState.load(std::memory_order_relaxed);
+
+			if (!(state & 1)) {
+				return false;
+			}
+
+			ThreadCursor& cursor = threadCursor;
+
+			if (cursor.state != state || cursor.chunk->count.load(std::memory_order_relaxed) == ChunkEvents) [[unlikely]] {
+
+				if (!acquireChunk(state)) {
+					return false;
+				}
+
+			}
+
+			Chunk* chunk = cursor.chunk;
+			u32 index = chunk->count.load(std::memory_order_relaxed);
+
+			chunk->events[index] = {now(), data, value, type};
+			chunk->count.store(index + 1, std::memory_order_release);
+
+			return true;
+
+		}
+
+	}
+
+
+	class ScopedZone {
+
+	public:
+
+		explicit ScopedZone(const ZoneSite& site) noexcept : site(&site), active(Detail::record(EventType::ZoneBegin, &site, 0)) {}
+
+		~ScopedZone() noexcept {
+
+			if (active) {
+				Detail::record(EventType::ZoneEnd, site, 0);
+			}
+
+		}
+
+		ScopedZone(const ScopedZone& zone) = delete;
+		ScopedZone& operator=(const ScopedZone& zone) = delete;
+
+	private:
+
+		const ZoneSite* site;
+		bool active;
+
+	};
+
+
+	inline void counter(const char* name, double value) noexcept {
+		Detail::record(EventType::Counter, name, value);
+	}
+
+	inline void frame() noexcept {
+		Detail::record(EventType::Frame, nullptr, 0);
+	}
+
+
+	//Names the calling thread in exported traces
+	void setThreadName(const std::string& name);
+
+
+	struct Statistic {
+
+		double min = 0;
+		double avg = 0;
+		double max = 0;
+		double p50 = 0;
+		double p95 = 0;
+		double p99 = 0;
+
+	};
+
+
+	struct ZoneStatistics {
+
+		const ZoneSite* site;
+		u64 calls;
+		double totalTime;
+		double selfTime;		//Total time excluding nested zones
+		Statistic perCall;
+		Statistic perFrame;		//Accumulated time per frame, over all frames including those the zone did not run in
+
+	};
+
+
+	struct CounterStatistics {
+
+		const char* name;
+		u64 samples;
+		double min;
+		double avg;
+		double max;
+		double last;
+
+	};
+
+
+	struct ThreadCapture {
+
+		u32 id;
+		std::string name;
+		std::vector<Event> events;
+
+	};
+
+
+	class Capture {
+
+	public:
+
+		Capture() noexcept;
+
+		//Per zone site, sorted by descending total time
+		std::vector<ZoneStatistics> getZoneStatistics() const;
+		std::vector<CounterStatistics> getCounterStatistics() const;
+
+		//Durations between consecutive frame markers
+		Statistic getFrameStatistics() const;
+		u64 getFrameCount() const;
+
+		std::string exportChromeTrace() const;
+		bool exportChromeTrace(const Path& path) const;
+
+		const std::vector<ThreadCapture>& getThreads() const noexcept {
+			return threads;
+		}
+
+		//Converts a timestamp to microseconds since the start of the capture
+		double toMicroseconds(u64 timestamp) const noexcept;
+
+		//Converts a tick count to microseconds
+		double ticksToMicroseconds(u64 ticks) const noexcept;
+
+		double getDuration() const noexcept;
+
+	private:
+
+		friend Capture stop();
+
+		std::vector<ThreadCapture> threads;
+		u64 startTicks;
+		u64 endTicks;
+		double microsecondsPerTick;
+
+	};
+
+
+	/*
+		Starts a new capture, discarding events of the previous one.
+		start() and stop() must not be called concurrently.
+	*/
+	void start();
+
+	//Stops recording and collects all events recorded by any thread since start()
+	Capture stop();
+
+	bool isRecording() noexcept;
+
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 AsyncLog.hpp
+ */
+
+#pragma once
+
+#include "Common/Types.hpp"
+
+#include <span>
+#include <array>
+
+
+
+namespace Log::Detail {
+
+	enum class RecordKind : u32 {
+		Text,
+		Structured,
+		FormatDefinition
+	};
+
+	/*
+		Structured log files start with this magic, followed by records of the form
+		[u32 kind][u32 size][u64 timestamp][payload]
+		Format definitions are written before the first record referencing them.
+	*/
+	constexpr std::array<u8, 8> StructuredFileMagic = {'A', 'R', 'C', 'L', 'O', 'G', '0', '1'};
+
+	/*
+		Hands a record to the asynchronous backend.
+		Returns false if the backend is not running, in which case the caller has to write the record synchronously.
+	*/
+	bool submitRecord(RecordKind kind, std::span<const u8> payload) noexcept;
+
+}
\ No newline at end of file
@@ -293,6 +293,43 @@ namespace Log {
 	void closeLogFile() noexcept;
 
 
+	/*
+		Policy applied when a thread's log buffer is full
+		Drop:	The record is discarded
+		Block:	The thread waits until the writer made room
+		Sample:	Only every sampleRate-th record blocks, all others are discarded
+	*/
+	enum class Backpressure {
+		Drop,
+		Block,
+		Sample
+	};
+
+	struct AsyncConfig {
+
+		SizeT threadBufferSize = 256 * 1024;		//Ring buffer size per logging thread, rounded up to a power of two
+		Backpressure backpressure = Backpressure::Block;
+		u32 sampleRate = 8;
+		u64 flushInterval = 5000;					//Maximum time in us between writer wakeups
+		bool structuredFile = false;				//Write the log file in binary form, see Log::decodeStructuredLog()
+
+	};
+
+	/*
+		Starts the asynchronous backend. Records are copied into per-thread ring buffers and written by a background thread in batches.
+		The log file must be opened or closed while the backend is stopped.
+	*/
+	void startAsync(const AsyncConfig& config = AsyncConfig()) noexcept;
+
+	//Stops the asynchronous backend and writes all pending records
+	void stopAsync() noexcept;
+
+	bool isAsync() noexcept;
+
+	//Returns the number of records discarded due to backpressure
+	u64 getDroppedRecords() noexcept;
+
+
 	constexpr void setContainerLimits(SizeT elementsMax) noexcept {
 		RawLog::maxContainerElements = elementsMax;
 	};
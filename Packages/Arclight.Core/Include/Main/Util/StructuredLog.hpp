@@ -0,0 +1,239 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 StructuredLog.hpp
+ */
+
+#pragma once
+
+#include "Util/Log.hpp"
+#include "Meta/Concepts.hpp"
+#include "Common/Types.hpp"
+#include "Common/Assert.hpp"
+
+#include <span>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <string_view>
+
+
+
+/*
+	Structured logging with deferred formatting.
+
+	arc_log('I', "Renderer", "Frame %d took %.2f ms", frame, ms);
+
+	Every call site registers its printf-style format string once and receives a static ID.
+	The call itself only copies the ID and the raw argument bytes into a binary record; formatting happens in the asynchronous writer.
+	With AsyncConfig::structuredFile, records are stored as-is in the log file and can be formatted offline with Log::decodeStructuredLog().
+	If the asynchronous backend is not running, the message is formatted and written immediately.
+
+	Supported arguments are integers, floating point numbers, bool, pointers and strings (char pointers, std::string, std::string_view).
+	Strings are copied into the record. Variable width/precision (*) is not supported.
+*/
+#define arc_log(level, name, format, ...)															\
+	do {																							\
+		static const Log::StructuredFormat arcStructuredFormat((level), (name), (format));			\
+		Log::structured(arcStructuredFormat __VA_OPT__(,) __VA_ARGS__);								\
+	} while (false)
+
+
+
+namespace Log {
+
+	//Call site format registration. Trivially destructible so records may outlive static destruction.
+	class StructuredFormat {
+
+	public:
+
+		StructuredFormat(char level, const char* name, const char* format);
+
+		constexpr u32 getID() const noexcept {
+			return id;
+		}
+
+	private:
+
+		u32 id;
+
+	};
+
+
+	namespace Detail {
+
+		enum class ArgumentType : u8 {
+			Signed,
+			Unsigned,
+			Float,
+			String,
+			Pointer
+		};
+
+
+		//Serializes arguments into a stack buffer, spilling to the heap for large records
+		class ArgumentEncoder {
+
+		public:
+
+			constexpr static SizeT InlineSize = 256;
+
+			ArgumentEncoder(u32 formatID, u8 argumentCount) noexcept : size(0), truncated(false) {
+
+				write(&formatID, sizeof(formatID));
+				write(&argumentCount, sizeof(argumentCount));
+
+			}
+
+
+			template<class T>
+			void append(const T& value) noexcept {
+
+				using U = TT::RemoveCVRef<T>;
+
+				if constexpr (CC::Equal<U, bool>) {
+
+					appendScalar(ArgumentType::Unsigned, u64(value));
+
+				} else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+
+					appendScalar(ArgumentType::Signed, i64(value));
+
+				} else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>) {
+
+					appendScalar(ArgumentType::Unsigned, u64(value));
+
+				} else if constexpr (std::is_floating_point_v<U>) {
+
+					appendScalar(ArgumentType::Float, double(value));
+
+				} else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+
+					appendString(std::string_view(value));
+
+				} else if constexpr (CC::Pointer<TT::Decay<U>>) {
+
+					appendScalar(ArgumentType::Pointer, u64(reinterpret_cast<AddressT>(value)));
+
+				} else {
+
+					static_assert(!sizeof(U), "Unsupported structured log argument type");
+
+				}
+
+			}
+
+
+			std::span<const u8> data() const noexcept {
+				return heap.empty() ? std::span<const u8>(inlineBuffer, size) : std::span<const u8>(heap);
+			}
+
+			//True if spilling to the heap failed, the record is incomplete and must not be submitted
+			bool isTruncated() const noexcept {
+				return truncated;
+			}
+
+		private:
+
+			template<class T>
+			void appendScalar(ArgumentType type, T value) noexcept {
+
+				write(&type, sizeof(type));
+				write(&value, sizeof(value));
+
+			}
+
+			void appendString(std::string_view string) noexcept {
+
+				ArgumentType type = ArgumentType::String;
+				u32 length = string.size();
+
+				write(&type, sizeof(type));
+				write(&length, sizeof(length));
+				write(string.data(), length);
+
+			}
+
+			void write(const void* data, SizeT bytes) noexcept {
+
+				if (truncated) {
+					return;
+				}
+
+				if (heap.empty() && size + bytes <= InlineSize) {
+
+					std::memcpy(inlineBuffer + size, data, bytes);
+					size += bytes;
+					return;
+
+				}
+
+				try {
+
+					if (heap.empty()) {
+						heap.assign(inlineBuffer, inlineBuffer + size);
+					}
+
+					const u8* bytePtr = static_cast<const u8*>(data);
+					heap.insert(heap.end(), bytePtr, bytePtr + bytes);
+
+				} catch (const std::exception&) {
+
+					truncated = true;
+
+#if defined(ARC_CFG_LOG_EXCEPTION_ABORT) && !defined(ARC_CFG_FINAL_BUILD)
+					arc_abort();
+#endif
+
+				}
+
+			}
+
+
+			u8 inlineBuffer[InlineSize];
+			SizeT size;
+			std::vector<u8> heap;
+			bool truncated;
+
+		};
+
+
+		//Writes the encoded record to the asynchronous backend or formats it immediately
+		void submitStructured(std::span<const u8> record) noexcept;
+
+		//Formats an encoded record including its log prefix
+		std::string formatStructured(std::span<const u8> record);
+
+		//Appends the binary definition of the given format to out
+		void appendFormatDefinition(std::string& out, u32 id);
+
+		//Returns the number of registered formats
+		u32 getFormatCount() noexcept;
+
+	}
+
+
+	template<class... Args> requires (sizeof...(Args) < 256)
+	void structured(const StructuredFormat& format, const Args&... args) noexcept {
+
+		Detail::ArgumentEncoder encoder(format.getID(), sizeof...(Args));
+		(encoder.append(args), ...);
+
+		if (encoder.isTruncated()) {
+			return;
+		}
+
+		Detail::submitStructured(encoder.data());
+
+	}
+
+
+	/*
+		Formats a binary log file written with AsyncConfig::structuredFile into text.
+		Corrupted records terminate decoding with a marker line.
+	*/
+	std::string decodeStructuredLog(std::span<const u8> data);
+
+}
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 #include <array>
+#include <atomic>
 #include <unordered_map>
 
 
@@ -218,27 +219,82 @@ namespace CPU {
 	}
 
 
+#ifdef ARC_PLATFORM_X86
+
+	// Returns the stored register containing the feature or nullptr if its leaf was not reported
+	static u32* featureRegister(X86::Feature feature) noexcept {
+
+		const u32 reg = std::to_underlying(feature.reg());
+
+		if (feature.extended()) {
+			// Subleaf 0 stores EBX, ECX and EDX, every further subleaf all four registers
+			const u32 subLeaf = feature.subLeaf();
+			const SizeT index = subLeaf ? 3 + (subLeaf - 1) * 4 + reg : reg - 1;
+
+			if (index >= info.platform.extended.size()) {
+				return nullptr;
+			}
+
+			return &info.platform.extended[index];
+		}
+
+		return &info.platform.basic[reg - 2];
+
+	}
+
+#endif
+
+
 	bool supports(X86::Feature feature) noexcept {
 
 		arc_assert(info.initialized, "CPU information is not initialized");
 
 	#ifdef ARC_PLATFORM_X86
 
-		const u32 reg = std::to_underlying(feature.reg());
+		u32* value = featureRegister(feature);
 
-		u32 value;
+		// Feature words are accessed atomically since disable() and enable() may run concurrently with dispatch
+		return value && (std::atomic_ref<u32>(*value).load(std::memory_order_relaxed) & (1u << feature.bit()));
 
-		if (feature.extended()) {
-			value = info.platform.extended[feature.subLeaf() + reg - 1];
-		} else {
-			value = info.platform.basic[reg - 2];
+	#else
+
+		return false;
+
+	#endif
+
+	}
+
+	void disable(X86::Feature feature) noexcept {
+
+		arc_assert(info.initialized, "CPU information is not initialized");
+
+	#ifdef ARC_PLATFORM_X86
+
+		if (u32* value = featureRegister(feature)) {
+			std::atomic_ref<u32>(*value).fetch_and(~(1u << feature.bit()), std::memory_order_relaxed);
 		}
 
-		return value & (1 << feature.bit());
+	#endif
 
-	#else
+	}
 
-		return false;
+	void enable(X86::Feature feature) noexcept {
+
+		arc_assert(info.initialized, "CPU information is not initialized");
+
+	#ifdef ARC_PLATFORM_X86
+
+		u32* value = featureRegister(feature);
+
+		if (!value) {
+			return;
+		}
+
+		// Query the leaf again so that only features present in hardware are restored
+		u32 data[4];
+		__cpuidex(reinterpret_cast<i32*>(data), feature.extended() ? 7 : 1, feature.subLeaf());
+
+		std::atomic_ref<u32>(*value).fetch_or(data[std::to_underlying(feature.reg())] & (1u << feature.bit()), std::memory_order_relaxed);
 
 	#endif
 
@@ -0,0 +1,313 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 JobSystem.cpp
+ */
+
+#include "Concurrent/JobSystem.hpp"
+
+#include <thread>
+
+
+
+//Worker context of the calling thread
+struct WorkerContext {
+
+	const JobSystem* system;
+	SizeT index;
+
+};
+
+static constinit thread_local WorkerContext currentWorker {nullptr, 0};
+
+
+
+JobSystem::JobSystem(SizeT workerCount) : injectionCount(0), wakeEpoch(0), sleepers(0), stopping(false) {
+
+	workerCount = Math::max(workerCount, SizeT(1));
+	workers.reserve(workerCount);
+
+	for (SizeT i = 0; i < workerCount; i++) {
+		workers.emplace_back(std::make_unique<Worker>());
+	}
+
+	for (SizeT i = 0; i < workerCount; i++) {
+		workers[i]->thread.start([this, i]() { workerMain(i); });
+	}
+
+}
+
+
+
+JobSystem::~JobSystem() {
+
+	stopping.store(true, std::memory_order_seq_cst);
+	wakeEpoch.fetch_add(1, std::memory_order_seq_cst);
+	wakeEpoch.notify_all();
+
+	for (auto& worker : workers) {
+		worker->thread.finish();
+	}
+
+}
+
+
+
+void JobSystem::wait(const JobHandleBase& handle) {
+
+	Job* job = handle.job;
+
+	if (!job) {
+		return;
+	}
+
+	SizeT self = getCurrentWorker();
+
+	while (!job->finished()) {
+
+		if (Job* other = findJob(self)) {
+
+			run(other);
+			continue;
+
+		}
+
+		if (self != invalidWorker) {
+
+			//Workers must stay responsive to continuations scheduled onto their own deque
+			std::this_thread::yield();
+
+		} else {
+
+			job->done.wait(false, std::memory_order_acquire);
+
+		}
+
+	}
+
+}
+
+
+
+SizeT JobSystem::getWorkerCount() const noexcept {
+	return workers.size();
+}
+
+
+
+SizeT JobSystem::getDefaultWorkerCount() noexcept {
+
+	SizeT threads = Thread::getHardwareThreadCount();
+	return threads > 1 ? threads - 1 : 1;
+
+}
+
+
+
+JobSystem& JobSystem::getGlobal() {
+
+	static JobSystem system;
+	return system;
+
+}
+
+
+
+void JobSystem::addDependency(Job* job, Job* dependency) {
+
+	if (!dependency) {
+		return;
+	}
+
+	job->dependencies.fetch_add(1, std::memory_order_relaxed);
+
+	Job::Continuation* node = new Job::Continuation{job, nullptr};
+	Job::Continuation* head = dependency->continuations.load(std::memory_order_acquire);
+
+	do {
+
+		if (head == &Job::sealed) {
+
+			//Dependency already finished
+			delete node;
+			job->dependencies.fetch_sub(1, std::memory_order_relaxed);
+
+			return;
+
+		}
+
+		node->next = head;
+
+	} while (!dependency->continuations.compare_exchange_weak(head, node, std::memory_order_acq_rel, std::memory_order_acquire));
+
+}
+
+
+
+void JobSystem::submitJob(Job* job) {
+
+	if (job->dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		schedule(job);
+	}
+
+}
+
+
+
+void JobSystem::schedule(Job* job) {
+
+	SizeT self = getCurrentWorker();
+
+	if (self != invalidWorker) {
+
+		workers[self]->deque.push(job);
+
+	} else {
+
+		std::lock_guard lock(injectionMutex);
+
+		injectionQueue.push_back(job);
+		injectionCount.fetch_add(1, std::memory_order_release);
+
+	}
+
+	wakeEpoch.fetch_add(1, std::memory_order_seq_cst);
+
+	if (sleepers.load(std::memory_order_seq_cst)) {
+		wakeEpoch.notify_one();
+	}
+
+}
+
+
+
+void JobSystem::run(Job* job) noexcept {
+
+	job->execute();
+	finish(job);
+
+}
+
+
+
+void JobSystem::finish(Job* job) noexcept {
+
+	job->done.store(true, std::memory_order_release);
+	job->done.notify_all();
+
+	Job::Continuation* node = job->continuations.exchange(&Job::sealed, std::memory_order_acq_rel);
+
+	while (node) {
+
+		Job::Continuation* next = node->next;
+
+		if (node->job->dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			schedule(node->job);
+		}
+
+		delete node;
+		node = next;
+
+	}
+
+	job->release();
+
+}
+
+
+
+Job* JobSystem::findJob(SizeT self) noexcept {
+
+	Job* job = nullptr;
+
+	if (self != invalidWorker && workers[self]->deque.pop(job)) {
+		return job;
+	}
+
+	if (injectionCount.load(std::memory_order_acquire)) {
+
+		std::lock_guard lock(injectionMutex);
+
+		if (!injectionQueue.empty()) {
+
+			job = injectionQueue.front();
+			injectionQueue.pop_front();
+			injectionCount.fetch_sub(1, std::memory_order_relaxed);
+
+			return job;
+
+		}
+
+	}
+
+	//Start stealing at a pseudo-random victim to spread contention
+	static thread_local u32 seed = static_cast<u32>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1;
+
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+
+	SizeT count = workers.size();
+	SizeT offset = seed % count;
+
+	for (SizeT i = 0; i < count; i++) {
+
+		SizeT victim = (offset + i) % count;
+
+		if (victim != self && workers[victim]->deque.steal(job)) {
+			return job;
+		}
+
+	}
+
+	return nullptr;
+
+}
+
+
+
+SizeT JobSystem::getCurrentWorker() const noexcept {
+	return currentWorker.system == this ? currentWorker.index : invalidWorker;
+}
+
+
+
+void JobSystem::workerMain(SizeT index) {
+
+	currentWorker = {this, index};
+
+	while (true) {
+
+		u32 epoch = wakeEpoch.load(std::memory_order_seq_cst);
+
+		if (Job* job = findJob(index)) {
+
+			run(job);
+			continue;
+
+		}
+
+		if (stopping.load(std::memory_order_seq_cst)) {
+			break;
+		}
+
+		sleepers.fetch_add(1, std::memory_order_seq_cst);
+
+		if (Job* job = findJob(index)) {
+
+			sleepers.fetch_sub(1, std::memory_order_seq_cst);
+			run(job);
+			continue;
+
+		}
+
+		wakeEpoch.wait(epoch, std::memory_order_seq_cst);
+		sleepers.fetch_sub(1, std::memory_order_seq_cst);
+
+	}
+
+	currentWorker = {nullptr, 0};
+
+}
\ No newline at end of file
@@ -0,0 +1,716 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 AssetArchive.cpp
+ */
+
+#include "Filesystem/AssetArchive.hpp"
+#include "Filesystem/BinaryFile.hpp"
+#include "Filesystem/Directory.hpp"
+#include "Stream/BinaryReader.hpp"
+#include "Stream/BinaryWriter.hpp"
+#include "Memory/Memory.hpp"
+#include "Util/Log.hpp"
+#include "Math/Math.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+
+
+namespace {
+
+	/*
+		LZ77 block codec in the style of LZ4.
+		A sequence is a token (literal length << 4 | match length - 4), an extended literal length, the literals,
+		a 16-bit match offset and an extended match length. Lengths of 15 and above continue in bytes of 255.
+		The final sequence carries literals only.
+	*/
+	namespace LZ {
+
+		constexpr SizeT MinMatch = 4;
+		constexpr SizeT MaxOffset = 0xFFFF;
+		constexpr u32 HashBits = 14;
+
+
+		inline u32 read32(const u8* data) noexcept {
+
+			u32 value;
+			std::memcpy(&value, data, sizeof(value));
+
+			return value;
+
+		}
+
+		inline u32 hash(u32 sequence) noexcept {
+			return (sequence * 2654435761u) >> (32 - HashBits);
+		}
+
+
+		void writeLength(std::vector<u8>& out, SizeT length) {
+
+			while (length >= 255) {
+				out.push_back(255);
+				length -= 255;
+			}
+
+			out.push_back(length);
+
+		}
+
+		void writeSequence(std::vector<u8>& out, const u8* literals, SizeT literalLength, SizeT offset, SizeT matchLength) {
+
+			SizeT extraMatch = matchLength ? matchLength - MinMatch : 0;
+
+			out.push_back((Math::min(literalLength, SizeT(15)) << 4) | Math::min(extraMatch, SizeT(15)));
+
+			if (literalLength >= 15) {
+				writeLength(out, literalLength - 15);
+			}
+
+			out.insert(out.end(), literals, literals + literalLength);
+
+			if (!matchLength) {
+				return;
+			}
+
+			out.push_back(offset & 0xFF);
+			out.push_back(offset >> 8);
+
+			if (extraMatch >= 15) {
+				writeLength(out, extraMatch - 15);
+			}
+
+		}
+
+
+		std::vector<u8> compress(std::span<const u8> input) {
+
+			std::vector<u8> out;
+			out.reserve(input.size() / 2 + 16);
+
+			const u8* data = input.data();
+			const SizeT size = input.size();
+
+			constexpr u32 Empty = std::numeric_limits<u32>::max();
+			std::vector<u32> table(1 << HashBits, Empty);
+
+			SizeT anchor = 0;
+			SizeT i = 0;
+
+			while (i + MinMatch <= size) {
+
+				u32 sequence = read32(data + i);
+				u32& slot = table[hash(sequence)];
+
+				SizeT candidate = slot;
+				slot = i;
+
+				if (candidate == Empty || i - candidate > MaxOffset || read32(data + candidate) != sequence) {
+
+					// Skip faster through incompressible data
+					i += 1 + ((i - anchor) >> 6);
+					continue;
+
+				}
+
+				SizeT length = MinMatch;
+
+				while (i + length < size && data[candidate + length] == data[i + length]) {
+					length++;
+				}
+
+				while (i > anchor && candidate > 0 && data[i - 1] == data[candidate - 1]) {
+					i--;
+					candidate--;
+					length++;
+				}
+
+				writeSequence(out, data + anchor, i - anchor, i - candidate, length);
+
+				i += length;
+				anchor = i;
+
+				if (i >= 2 && i + MinMatch <= size) {
+					table[hash(read32(data + i - 2))] = i - 2;
+				}
+
+			}
+
+			writeSequence(out, data + anchor, size - anchor, 0, 0);
+
+			return out;
+
+		}
+
+
+		bool readLength(std::span<const u8> input, SizeT& cursor, SizeT& length) noexcept {
+
+			while (true) {
+
+				if (cursor >= input.size()) {
+					return false;
+				}
+
+				u8 byte = input[cursor++];
+				length += byte;
+
+				if (byte != 255) {
+					return true;
+				}
+
+			}
+
+		}
+
+		// Fails unless the input decodes to exactly output.size() bytes
+		bool decompress(std::span<const u8> input, std::span<u8> output) noexcept {
+
+			SizeT in = 0;
+			SizeT out = 0;
+
+			while (in < input.size()) {
+
+				u8 token = input[in++];
+				SizeT literalLength = token >> 4;
+
+				if (literalLength == 15 && !readLength(input, in, literalLength)) {
+					return false;
+				}
+
+				if (literalLength > input.size() - in || literalLength > output.size() - out) {
+					return false;
+				}
+
+				std::memcpy(output.data() + out, input.data() + in, literalLength);
+
+				in += literalLength;
+				out += literalLength;
+
+				if (in == input.size()) {
+					break;
+				}
+
+				if (input.size() - in < 2) {
+					return false;
+				}
+
+				SizeT offset = input[in] | (input[in + 1] << 8);
+				in += 2;
+
+				SizeT matchLength = token & 0xF;
+
+				if (matchLength == 15 && !readLength(input, in, matchLength)) {
+					return false;
+				}
+
+				matchLength += MinMatch;
+
+				if (!offset || offset > out || matchLength > output.size() - out) {
+					return false;
+				}
+
+				u8* destination = output.data() + out;
+				const u8* source = destination - offset;
+
+				if (offset >= matchLength) {
+
+					std::memcpy(destination, source, matchLength);
+
+				} else {
+
+					// Overlapping matches repeat the pattern
+					for (SizeT j = 0; j < matchLength; j++) {
+						destination[j] = source[j];
+					}
+
+				}
+
+				out += matchLength;
+
+			}
+
+			return out == output.size();
+
+		}
+
+	}
+
+}
+
+
+
+std::string AssetArchiveFormat::normalizePath(std::string_view path) {
+
+	std::string normalized(path);
+	std::replace(normalized.begin(), normalized.end(), '\\', '/');
+
+	SizeT start = 0;
+
+	while (start < normalized.size()) {
+
+		if (normalized[start] == '/') {
+			start++;
+		} else if (normalized.compare(start, 2, "./") == 0) {
+			start += 2;
+		} else {
+			break;
+		}
+
+	}
+
+	return normalized.substr(start);
+
+}
+
+
+
+u64 AssetArchiveFormat::hashPath(std::string_view path) noexcept {
+
+	// FNV-1a
+	u64 hash = 0xCBF29CE484222325;
+
+	for (char c : path) {
+		hash = (hash ^ static_cast<u8>(c)) * 0x100000001B3;
+	}
+
+	return hash;
+
+}
+
+
+
+AssetArchive::AssetArchive() = default;
+
+AssetArchive::AssetArchive(const Path& path) : archivePath(path) {}
+
+
+
+bool AssetArchive::open() {
+
+	using namespace AssetArchiveFormat;
+
+	close();
+
+	if (!file.open(archivePath, MappedFile::Access::Random)) {
+		LogE("AssetArchive") << "Failed to open archive '" << archivePath.toString() << "'";
+		return false;
+	}
+
+	std::span<const u8> data = file.data();
+
+	auto fail = [&](const char* reason) {
+
+		LogE("AssetArchive") << "Archive '" << archivePath.toString() << "' is invalid: " << reason;
+		close();
+
+		return false;
+
+	};
+
+	if (data.size() < HeaderSize || !std::equal(std::begin(Magic), std::end(Magic), data.begin())) {
+		return fail("Bad header");
+	}
+
+	BinaryReader header(data.subspan(sizeof(Magic), HeaderSize - sizeof(Magic)));
+
+	u32 version = header.read<u32>();
+	u32 entryCount = header.read<u32>();
+	u64 indexOffset = header.read<u64>();
+	u64 indexSize = header.read<u64>();
+
+	if (version != Version) {
+		return fail("Unsupported version");
+	}
+
+	if (indexOffset > data.size() || indexSize > data.size() - indexOffset || u64(entryCount) * EntrySize > indexSize) {
+		return fail("Index out of bounds");
+	}
+
+	std::span<const u8> index = data.subspan(indexOffset, indexSize);
+	std::span<const u8> strings = index.subspan(entryCount * EntrySize);
+
+	BinaryReader reader(index);
+
+	hashes.reserve(entryCount);
+	entries.reserve(entryCount);
+
+	for (u32 i = 0; i < entryCount; i++) {
+
+		u64 hash = reader.read<u64>();
+		u64 offset = reader.read<u64>();
+		u64 storedSize = reader.read<u64>();
+		u64 size = reader.read<u64>();
+		u32 nameOffset = reader.read<u32>();
+		u32 nameLength = reader.read<u32>();
+		u32 compression = reader.read<u32>();
+		reader.seek(sizeof(u32));
+
+		if (offset > indexOffset || storedSize > indexOffset - offset || nameOffset > strings.size() || nameLength > strings.size() - nameOffset) {
+			return fail("Entry out of bounds");
+		}
+
+		if (compression > u32(Compression::LZ) || (compression == u32(Compression::None) && storedSize != size)) {
+			return fail("Bad entry compression");
+		}
+
+		if (!hashes.empty() && hash < hashes.back()) {
+			return fail("Index not sorted");
+		}
+
+		std::string_view name(reinterpret_cast<const char*>(strings.data() + nameOffset), nameLength);
+
+		hashes.push_back(hash);
+		entries.push_back({name, offset, size, storedSize, static_cast<Compression>(compression)});
+
+	}
+
+	return true;
+
+}
+
+bool AssetArchive::open(const Path& path) {
+
+	archivePath = path;
+	return open();
+
+}
+
+
+
+void AssetArchive::close() {
+
+	file.close();
+	hashes.clear();
+	entries.clear();
+
+}
+
+
+
+bool AssetArchive::isOpen() const noexcept {
+	return file.isOpen();
+}
+
+
+
+bool AssetArchive::contains(std::string_view path) const {
+	return find(path);
+}
+
+
+
+const AssetEntry* AssetArchive::find(std::string_view path) const {
+	return findNormalized(AssetArchiveFormat::normalizePath(path));
+}
+
+
+
+std::span<const u8> AssetArchive::view(std::string_view path) const {
+
+	const AssetEntry* entry = find(path);
+
+	if (!entry || entry->compressed()) {
+		return {};
+	}
+
+	return file.data().subspan(entry->offset, entry->storedSize);
+
+}
+
+
+
+bool AssetArchive::read(std::string_view path, std::vector<u8>& data) const {
+
+	const AssetEntry* entry = find(path);
+
+	if (!entry) {
+		return false;
+	}
+
+	data.resize(entry->size);
+
+	return read(*entry, data);
+
+}
+
+bool AssetArchive::read(const AssetEntry& entry, std::span<u8> data) const {
+
+	if (data.size() != entry.size) {
+		return false;
+	}
+
+	std::span<const u8> stored = file.data().subspan(entry.offset, entry.storedSize);
+
+	switch (entry.compression) {
+
+		case AssetArchiveFormat::Compression::None:
+			std::copy(stored.begin(), stored.end(), data.begin());
+			return true;
+
+		case AssetArchiveFormat::Compression::LZ:
+
+			if (!LZ::decompress(stored, data)) {
+				LogE("AssetArchive") << "Entry '" << entry.path << "' in '" << archivePath.toString() << "' is corrupted";
+				return false;
+			}
+
+			return true;
+
+		default:
+			return false;
+
+	}
+
+}
+
+std::vector<u8> AssetArchive::read(std::string_view path) const {
+
+	std::vector<u8> data;
+
+	if (!read(path, data)) {
+		data.clear();
+	}
+
+	return data;
+
+}
+
+
+
+void AssetArchive::prefetch(std::string_view path) const {
+
+	if (const AssetEntry* entry = find(path)) {
+		file.prefetch(entry->offset, entry->storedSize);
+	}
+
+}
+
+
+
+const std::vector<AssetEntry>& AssetArchive::getEntries() const noexcept {
+	return entries;
+}
+
+
+
+SizeT AssetArchive::getEntryCount() const noexcept {
+	return entries.size();
+}
+
+
+
+Path AssetArchive::path() const {
+	return archivePath;
+}
+
+
+
+const AssetEntry* AssetArchive::findNormalized(std::string_view path) const {
+
+	u64 hash = AssetArchiveFormat::hashPath(path);
+
+	auto [first, last] = std::equal_range(hashes.begin(), hashes.end(), hash);
+
+	for (auto it = first; it != last; ++it) {
+
+		const AssetEntry& entry = entries[it - hashes.begin()];
+
+		if (entry.path == path) {
+			return &entry;
+		}
+
+	}
+
+	return nullptr;
+
+}
+
+
+
+AssetArchiveWriter::AssetArchiveWriter(u32 alignment) : alignment(std::bit_ceil(Math::max(alignment, 1u))) {}
+
+
+
+void AssetArchiveWriter::add(std::string_view path, std::span<const u8> data, Compression compression) {
+
+	PendingEntry entry {AssetArchiveFormat::normalizePath(path), {}, data.size(), Compression::None};
+
+	if (compression == Compression::LZ && data.size() <= std::numeric_limits<u32>::max()) {
+
+		std::vector<u8> compressed = LZ::compress(data);
+
+		if (compressed.size() < data.size()) {
+			entry.data = std::move(compressed);
+			entry.compression = Compression::LZ;
+		}
+
+	}
+
+	if (entry.compression == Compression::None) {
+		entry.data.assign(data.begin(), data.end());
+	}
+
+	auto it = std::find_if(entries.begin(), entries.end(), [&](const PendingEntry& e) { return e.path == entry.path; });
+
+	if (it != entries.end()) {
+		*it = std::move(entry);
+	} else {
+		entries.push_back(std::move(entry));
+	}
+
+}
+
+bool AssetArchiveWriter::addFile(std::string_view path, const Path& file, Compression compression) {
+
+	BinaryFile input(file);
+
+	if (!input.open()) {
+		LogE("AssetArchive") << "Failed to open '" << file.toString() << "'";
+		return false;
+	}
+
+	add(path, input.readAll(), compression);
+
+	return true;
+
+}
+
+SizeT AssetArchiveWriter::addDirectory(const Path& directory, Compression compression) {
+
+	SizeT count = 0;
+
+	for (const FSEntry& entry : Directory(directory).iterate(DirectoryIterator::Recursive, FSEntry::File)) {
+
+		Path file = entry.getPath();
+
+		if (addFile(file.relativeAgainst(directory), file, compression)) {
+			count++;
+		}
+
+	}
+
+	return count;
+
+}
+
+
+
+bool AssetArchiveWriter::write(const Path& path) const {
+
+	using namespace AssetArchiveFormat;
+
+	struct IndexEntry {
+
+		u64 hash;
+		const PendingEntry* entry;
+		u64 offset;
+
+	};
+
+	std::vector<IndexEntry> index;
+	index.reserve(entries.size());
+
+	for (const PendingEntry& entry : entries) {
+		index.push_back({hashPath(entry.path), &entry, 0});
+	}
+
+	std::sort(index.begin(), index.end(), [](const IndexEntry& a, const IndexEntry& b) {
+		return a.hash < b.hash || (a.hash == b.hash && a.entry->path < b.entry->path);
+	});
+
+
+	BinaryFile output(path, BinaryFile::Out | BinaryFile::Trunc, BinaryFile::Access::Sequential);
+
+	if (!output.open()) {
+		LogE("AssetArchive") << "Failed to create archive '" << path.toString() << "'";
+		return false;
+	}
+
+	// Entries are laid out in index order so that neighbouring lookups touch neighbouring pages
+
+	static const u8 padding[256] = {};
+
+	u64 offset = Memory::alignUp(HeaderSize, alignment);
+	bool success = true;
+
+	output.seekTo(offset);
+
+	for (IndexEntry& entry : index) {
+
+		u64 aligned = Memory::alignUp(offset, alignment);
+
+		while (offset < aligned) {
+
+			SizeT count = Math::min<u64>(aligned - offset, sizeof(padding));
+			success &= output.write({padding, count}) == count;
+			offset += count;
+
+		}
+
+		entry.offset = offset;
+
+		success &= output.write(entry.entry->data) == entry.entry->data.size();
+		offset += entry.entry->data.size();
+
+	}
+
+
+	std::vector<u8> indexData(index.size() * EntrySize);
+	std::string strings;
+
+	BinaryWriter writer(indexData);
+
+	for (const IndexEntry& entry : index) {
+
+		writer.write<u64>(entry.hash);
+		writer.write<u64>(entry.offset);
+		writer.write<u64>(entry.entry->data.size());
+		writer.write<u64>(entry.entry->size);
+		writer.write<u32>(strings.size());
+		writer.write<u32>(entry.entry->path.size());
+		writer.write<u32>(static_cast<u32>(entry.entry->compression));
+		writer.write<u32>(0);
+
+		strings += entry.entry->path;
+
+	}
+
+	indexData.insert(indexData.end(), strings.begin(), strings.end());
+
+	u64 indexOffset = offset;
+
+	success &= output.write(indexData) == indexData.size();
+
+
+	std::vector<u8> header(HeaderSize);
+	BinaryWriter headerWriter(header);
+
+	headerWriter.write(std::span<const u8>(Magic));
+	headerWriter.write<u32>(Version);
+	headerWriter.write<u32>(index.size());
+	headerWriter.write<u64>(indexOffset);
+	headerWriter.write<u64>(indexData.size());
+	headerWriter.write<u32>(alignment);
+	headerWriter.write<u32>(0);
+
+	success &= output.writeAt(0, header) == header.size();
+	success &= output.flush();
+
+	if (!success) {
+		LogE("AssetArchive") << "Failed to write archive '" << path.toString() << "'";
+	}
+
+	return success;
+
+}
+
+
+
+SizeT AssetArchiveWriter::getEntryCount() const noexcept {
+	return entries.size();
+}
\ No newline at end of file
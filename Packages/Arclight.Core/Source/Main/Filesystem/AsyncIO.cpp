@@ -0,0 +1,281 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 AsyncIO.cpp
+ */
+
+#include "Filesystem/AsyncIO.hpp"
+#include "Concurrent/AtomicWait.hpp"
+#include "Concurrent/Thread.hpp"
+#include "Common/Config.hpp"
+#include "Common/Assert.hpp"
+#include "Util/Log.hpp"
+#include "Math/Math.hpp"
+
+#include <mutex>
+#include <deque>
+#include <condition_variable>
+#include <cerrno>
+
+
+
+namespace {
+
+	// Fallback executing blocking positional transfers on dedicated threads
+	class ThreadPoolBackend final : public Detail::AsyncIOBackend {
+
+	public:
+
+		explicit ThreadPoolBackend(u32 threadCount) : stopping(false) {
+
+			threads.resize(Math::max(threadCount, 1u));
+
+			for (Thread& thread : threads) {
+				thread.start([this]() { workerMain(); });
+			}
+
+		}
+
+		~ThreadPoolBackend() noexcept override {
+
+			{
+				std::lock_guard lock(mutex);
+				stopping = true;
+			}
+
+			available.notify_all();
+
+			for (Thread& thread : threads) {
+				thread.finish();
+			}
+
+		}
+
+
+		void submit(std::span<Detail::IOOperation* const> operations) override {
+
+			{
+				std::lock_guard lock(mutex);
+				queue.insert(queue.end(), operations.begin(), operations.end());
+			}
+
+			if (operations.size() == 1) {
+				available.notify_one();
+			} else {
+				available.notify_all();
+			}
+
+		}
+
+	private:
+
+		void workerMain() {
+
+			while (true) {
+
+				Detail::IOOperation* operation;
+
+				{
+					std::unique_lock lock(mutex);
+					available.wait(lock, [this]() { return stopping || !queue.empty(); });
+
+					if (queue.empty()) {
+						return;
+					}
+
+					operation = queue.front();
+					queue.pop_front();
+				}
+
+				const IORequest& request = operation->request;
+				SizeT transferred = 0;
+
+				if (request.type == IORequest::Type::Read) {
+					transferred = request.file->readAt(request.offset, {request.data, request.size});
+				} else {
+					transferred = const_cast<BinaryFile*>(request.file)->writeAt(request.offset, {request.data, request.size});
+				}
+
+				// Positional transfers are only short at the end of file or on failure
+				i32 error = (request.type == IORequest::Type::Write && transferred != request.size) ? EIO : 0;
+
+				Detail::completeOperation(*operation, transferred, error);
+
+			}
+
+		}
+
+
+		std::vector<Thread> threads;
+
+		std::mutex mutex;
+		std::condition_variable available;
+		std::deque<Detail::IOOperation*> queue;
+		bool stopping;
+
+	};
+
+}
+
+
+
+void Detail::completeOperation(IOOperation& operation, SizeT transferred, i32 error) noexcept {
+
+	operation.result.transferred = transferred;
+	operation.result.error = error;
+
+	if (operation.request.callback) {
+
+		try {
+
+			operation.request.callback(operation.result);
+
+		} catch (const std::exception& e) {
+
+			LogE("AsyncIO") << "Uncaught exception in completion callback: " << e.what();
+
+#if defined(ARC_CFG_LOG_EXCEPTION_ABORT) && !defined(ARC_CFG_FINAL_BUILD)
+			arc_abort();
+#endif
+
+		}
+
+	}
+
+	// The service may be destroyed as soon as the pending count reaches zero
+	std::atomic<u32>& pending = *operation.pending;
+	std::shared_ptr<IOOperation> self = std::move(operation.self);
+
+	operation.done.store(1, std::memory_order_release);
+	AtomicWait::notifyAll(operation.done);
+
+	if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		AtomicWait::notifyAll(pending);
+	}
+
+}
+
+
+
+const IOResult& IOHandle::wait() const {
+
+	arc_assert(operation, "Waiting on an invalid IOHandle");
+
+	while (!operation->done.load(std::memory_order_acquire)) {
+		AtomicWait::wait(operation->done, 0);
+	}
+
+	return operation->result;
+
+}
+
+
+
+AsyncIO::AsyncIO(Backend type, u32 queueDepth, u32 threadCount) : backendType(Backend::ThreadPool), pending(0) {
+
+	if (type != Backend::ThreadPool) {
+
+		backend = Detail::createNativeAsyncIOBackend(Math::max(queueDepth, 1u));
+
+		if (backend) {
+			backendType = Backend::Native;
+		} else if (type == Backend::Native) {
+			LogW("AsyncIO") << "Native asynchronous I/O unavailable, falling back to I/O threads";
+		}
+
+	}
+
+	if (!backend) {
+		backend = std::make_unique<ThreadPoolBackend>(threadCount);
+	}
+
+}
+
+
+
+AsyncIO::~AsyncIO() {
+	waitIdle();
+}
+
+
+
+IOHandle AsyncIO::submit(IORequest request) {
+	return std::move(submit(std::span<IORequest>(&request, 1)).front());
+}
+
+
+
+std::vector<IOHandle> AsyncIO::submit(std::span<IORequest> requests) {
+
+	std::vector<IOHandle> handles;
+	std::vector<Detail::IOOperation*> operations;
+
+	handles.reserve(requests.size());
+	operations.reserve(requests.size());
+
+	for (IORequest& request : requests) {
+
+		auto operation = std::make_shared<Detail::IOOperation>();
+
+		operation->request = std::move(request);
+		operation->pending = &pending;
+		operation->self = operation;
+
+		operations.push_back(operation.get());
+		handles.push_back(IOHandle(std::move(operation)));
+
+	}
+
+	// Invalid requests complete immediately
+
+	std::erase_if(operations, [this](Detail::IOOperation* operation) {
+
+		const IORequest& request = operation->request;
+
+		if (request.file && request.file->isOpen() && (request.data || !request.size)) {
+			return false;
+		}
+
+		pending.fetch_add(1, std::memory_order_relaxed);
+		Detail::completeOperation(*operation, 0, EBADF);
+
+		return true;
+
+	});
+
+	if (!operations.empty()) {
+
+		pending.fetch_add(operations.size(), std::memory_order_relaxed);
+		backend->submit(operations);
+
+	}
+
+	return handles;
+
+}
+
+
+
+void AsyncIO::waitIdle() const {
+
+	u32 count;
+
+	while ((count = pending.load(std::memory_order_acquire))) {
+		AtomicWait::wait(pending, count);
+	}
+
+}
+
+
+
+SizeT AsyncIO::getPendingCount() const noexcept {
+	return pending.load(std::memory_order_relaxed);
+}
+
+
+
+AsyncIO::Backend AsyncIO::getBackend() const noexcept {
+	return backendType;
+}
\ No newline at end of file
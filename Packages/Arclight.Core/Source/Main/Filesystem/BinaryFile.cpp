@@ -0,0 +1,386 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 BinaryFile.cpp
+ */
+
+#include "Filesystem/BinaryFile.hpp"
+#include "Math/Math.hpp"
+
+#include <cstring>
+#include <utility>
+
+
+
+BinaryFile::BinaryFile() : openFlags(In), accessHint(Access::Default), flushPolicy(FlushPolicy::Buffered), handle(InvalidHandle), position(0),
+	bufferCapacity(DefaultBufferSize), bufferOffset(0), bufferSize(0), bufferDirty(false) {}
+
+BinaryFile::BinaryFile(const Path& path, u32 flags, Access access) : filePath(path), openFlags(flags), accessHint(access), flushPolicy(FlushPolicy::Buffered),
+	handle(InvalidHandle), position(0), bufferCapacity(DefaultBufferSize), bufferOffset(0), bufferSize(0), bufferDirty(false) {}
+
+BinaryFile::~BinaryFile() {
+	close();
+}
+
+BinaryFile::BinaryFile(BinaryFile&& file) noexcept :
+	filePath(std::move(file.filePath)), openFlags(file.openFlags), accessHint(file.accessHint), flushPolicy(file.flushPolicy),
+	handle(std::exchange(file.handle, InvalidHandle)), position(std::exchange(file.position, 0)),
+	buffer(std::move(file.buffer)), bufferCapacity(file.bufferCapacity), bufferOffset(std::exchange(file.bufferOffset, 0)),
+	bufferSize(std::exchange(file.bufferSize, 0)), bufferDirty(std::exchange(file.bufferDirty, false)) {}
+
+BinaryFile& BinaryFile::operator=(BinaryFile&& file) noexcept {
+
+	if (this != &file) {
+
+		close();
+
+		filePath = std::move(file.filePath);
+		openFlags = file.openFlags;
+		accessHint = file.accessHint;
+		flushPolicy = file.flushPolicy;
+		handle = std::exchange(file.handle, InvalidHandle);
+		position = std::exchange(file.position, 0);
+		buffer = std::move(file.buffer);
+		bufferCapacity = file.bufferCapacity;
+		bufferOffset = std::exchange(file.bufferOffset, 0);
+		bufferSize = std::exchange(file.bufferSize, 0);
+		bufferDirty = std::exchange(file.bufferDirty, false);
+
+	}
+
+	return *this;
+
+}
+
+
+
+bool BinaryFile::open() {
+
+	close();
+
+	if (!(openFlags & (In | Out)) || !openHandle()) {
+		return false;
+	}
+
+	position = (openFlags & Append) ? nativeSize() : 0;
+
+	if (accessHint != Access::Default) {
+		advise(0, 0, accessHint);
+	}
+
+	return true;
+
+}
+
+bool BinaryFile::open(const Path& path, u32 flags, Access access) {
+
+	filePath = path;
+	openFlags = flags;
+	accessHint = access;
+
+	return open();
+
+}
+
+
+
+void BinaryFile::close() {
+
+	if (!isOpen()) {
+		return;
+	}
+
+	flushBuffer();
+	discardBuffer();
+
+	closeHandle();
+
+	handle = InvalidHandle;
+	position = 0;
+
+}
+
+
+
+bool BinaryFile::isOpen() const noexcept {
+	return handle != InvalidHandle;
+}
+
+
+
+void BinaryFile::setBufferSize(SizeT size) {
+
+	flushBuffer();
+	discardBuffer();
+
+	buffer.reset();
+	bufferCapacity = size;
+
+}
+
+
+
+SizeT BinaryFile::getBufferSize() const noexcept {
+	return bufferCapacity;
+}
+
+
+
+void BinaryFile::setFlushPolicy(FlushPolicy policy) {
+
+	flushPolicy = policy;
+
+	if (policy == FlushPolicy::Immediate) {
+		flushBuffer();
+	}
+
+}
+
+
+
+BinaryFile::FlushPolicy BinaryFile::getFlushPolicy() const noexcept {
+	return flushPolicy;
+}
+
+
+
+SizeT BinaryFile::read(std::span<u8> data) {
+
+	if (!isOpen() || !flushBuffer()) {
+		return 0;
+	}
+
+	SizeT total = 0;
+
+	while (total < data.size()) {
+
+		// Serve from read-ahead data first
+
+		if (position >= bufferOffset && position < bufferOffset + bufferSize) {
+
+			SizeT start = position - bufferOffset;
+			SizeT count = Math::min(bufferSize - start, data.size() - total);
+
+			std::memcpy(data.data() + total, buffer.get() + start, count);
+
+			total += count;
+			position += count;
+
+			continue;
+
+		}
+
+		// Large requests are read directly into the destination
+
+		SizeT remaining = data.size() - total;
+
+		if (remaining >= bufferCapacity) {
+
+			SizeT count = readNative(position, data.data() + total, remaining);
+
+			total += count;
+			position += count;
+
+			break;
+
+		}
+
+		if (!buffer) {
+			buffer = std::make_unique<u8[]>(bufferCapacity);
+		}
+
+		bufferOffset = position;
+		bufferSize = readNative(position, buffer.get(), bufferCapacity);
+
+		if (!bufferSize) {
+			break;
+		}
+
+	}
+
+	return total;
+
+}
+
+
+
+SizeT BinaryFile::write(std::span<const u8> data) {
+
+	if (!isOpen() || data.empty()) {
+		return 0;
+	}
+
+	// Drop read-ahead data and pending writes that are not contiguous with this one
+
+	if (!bufferDirty) {
+		discardBuffer();
+	} else if (position != bufferOffset + bufferSize && !flushBuffer()) {
+		return 0;
+	}
+
+	if (bufferSize + data.size() > bufferCapacity) {
+
+		if (!flushBuffer()) {
+			return 0;
+		}
+
+		if (data.size() >= bufferCapacity) {
+
+			SizeT count = writeNative(position, data.data(), data.size());
+			position += count;
+
+			return count;
+
+		}
+
+	}
+
+	if (!buffer) {
+		buffer = std::make_unique<u8[]>(bufferCapacity);
+	}
+
+	if (!bufferSize) {
+		bufferOffset = position;
+	}
+
+	std::memcpy(buffer.get() + bufferSize, data.data(), data.size());
+
+	bufferSize += data.size();
+	bufferDirty = true;
+	position += data.size();
+
+	if (flushPolicy == FlushPolicy::Immediate && !flushBuffer()) {
+		return 0;
+	}
+
+	return data.size();
+
+}
+
+
+
+std::vector<u8> BinaryFile::readAll() {
+
+	if (!isOpen() || !flushBuffer()) {
+		return {};
+	}
+
+	std::vector<u8> data(nativeSize());
+	data.resize(readAt(0, data));
+
+	return data;
+
+}
+
+
+
+bool BinaryFile::flush() {
+	return flushBuffer();
+}
+
+
+
+bool BinaryFile::sync() {
+	return isOpen() && flushBuffer() && syncNative();
+}
+
+
+
+void BinaryFile::seek(i64 offset) {
+	position = offset < 0 && u64(-offset) > position ? 0 : position + offset;
+}
+
+
+
+void BinaryFile::seekTo(u64 offset) {
+	position = offset;
+}
+
+
+
+void BinaryFile::seekFromEnd(u64 offset) {
+
+	u64 end = size();
+	position = offset > end ? 0 : end - offset;
+
+}
+
+
+
+u64 BinaryFile::getPosition() const noexcept {
+	return position;
+}
+
+
+
+SizeT BinaryFile::readAt(u64 offset, std::span<u8> data) const {
+	return isOpen() ? readNative(offset, data.data(), data.size()) : 0;
+}
+
+
+
+SizeT BinaryFile::writeAt(u64 offset, std::span<const u8> data) {
+	return isOpen() ? writeNative(offset, data.data(), data.size()) : 0;
+}
+
+
+
+u64 BinaryFile::size() const {
+
+	if (!isOpen()) {
+		return 0;
+	}
+
+	u64 fileSize = nativeSize();
+
+	return bufferDirty ? Math::max(fileSize, bufferOffset + bufferSize) : fileSize;
+
+}
+
+
+
+Path BinaryFile::path() const {
+	return filePath;
+}
+
+
+
+BinaryFile::Handle BinaryFile::getNativeHandle() const noexcept {
+	return handle;
+}
+
+
+
+bool BinaryFile::flushBuffer() {
+
+	if (!bufferDirty) {
+		return true;
+	}
+
+	SizeT written = writeNative(bufferOffset, buffer.get(), bufferSize);
+	bool success = written == bufferSize;
+
+	// Keep unwritten data so a later flush can retry
+	if (success) {
+		discardBuffer();
+	} else {
+		std::memmove(buffer.get(), buffer.get() + written, bufferSize - written);
+		bufferOffset += written;
+		bufferSize -= written;
+	}
+
+	return success;
+
+}
+
+
+
+void BinaryFile::discardBuffer() noexcept {
+
+	bufferOffset = 0;
+	bufferSize = 0;
+	bufferDirty = false;
+
+}
\ No newline at end of file
@@ -161,7 +161,7 @@ void DirectoryIterator::reset() {
 
 
 
-constexpr static u32 getOrderRank(FSEntry::Type type) {
+u32 Directory::getSortRank(FSEntry::Type type) noexcept {
 
 	switch(type) {
 
@@ -190,6 +190,32 @@ constexpr static u32 getOrderRank(FSEntry::Type type) {
 
 
 
+bool Directory::compareKeys(const SortKey& a, const SortKey& b, Sorting sorting) noexcept {
+
+	const bool ascending = Bool::one(sorting, Sorting::NameAscending, Sorting::TypeAscending, Sorting::DateAscending, Sorting::SizeAscending);
+
+	auto compare = [ascending](const auto& x, const auto& y) {
+		return ascending ? x < y : x > y;
+	};
+
+	if(a.rank != b.rank) {
+		return compare(a.rank, b.rank);
+	}
+
+	if(a.value != b.value) {
+		return compare(a.value, b.value);
+	}
+
+	if(a.primary != b.primary) {
+		return compare(a.primary, b.primary);
+	}
+
+	return compare(a.secondary, b.secondary);
+
+}
+
+
+
 Directory::Directory() : Directory("") {}
 Directory::Directory(const Path& path) : Directory(FSEntry(path)) {}
 Directory::Directory(FSEntry entry) : entry(std::move(entry)) {}
@@ -333,112 +359,85 @@ std::vector<FSEntry> Directory::listEntries(bool recursive) const {
 
 std::vector<FSEntry> Directory::listEntries(Sorting sorting, bool recursive) const {
 
-	auto lessPredicate = []<Sorting S>(const FSEntry& a, const FSEntry& b) -> bool {
-
-		constexpr static bool isAsc = Bool::one(S, Sorting::NameAscending, Sorting::TypeAscending, Sorting::DateAscending, Sorting::SizeAscending);
-
-		constexpr static auto compare = [](const auto& a, const auto& b) -> bool {
-			return isAsc ? a < b : a > b;
-		};
-		
-		u32 rankA = getOrderRank(a.getType());
-		u32 rankB = getOrderRank(b.getType());
+	// Keys are computed once per entry instead of once per comparison
 
-		if(rankA != rankB) {
-
-			return compare(rankA, rankB);
+	struct KeyData {
+		std::string path;
+		std::string extension;
+		std::string stem;
+		SortKey key;
+	};
 
-		} else {
-			
-			if constexpr (Bool::one(S, Sorting::NameAscending, Sorting::NameDescending)) {
+	std::vector<FSEntry> entries = listEntries(recursive);
+	std::vector<KeyData> keys(entries.size());
 
-				return compare(a.getPath().toNativeString(), b.getPath().toNativeString());
+	for(SizeT i = 0; i < entries.size(); i++) {
 
-			} else if constexpr (Bool::one(S, Sorting::TypeAscending, Sorting::TypeDescending)) {
+		const FSEntry& entry = entries[i];
+		KeyData& data = keys[i];
 
-				if(a.getType() == FSEntry::Type::File) {
+		FSEntry::Type type = entry.getType();
+		Path path = entry.getPath();
 
-					std::string extA = a.getPath().getExtension();
-					std::string extB = b.getPath().getExtension();
+		data.path = path.toNativeString();
+		data.key = {getSortRank(type), 0, data.path, {}};
 
-					if(extA != extB) {
-						return compare(extA, extB);
-					} else {
-						return compare(a.getPath().getStem(), b.getPath().getStem());
-					}
+		std::error_code error;
 
-				} else {
+		switch(sorting) {
 
-					return compare(a.getPath().toNativeString(), b.getPath().toNativeString());
+			case Sorting::TypeAscending:
+			case Sorting::TypeDescending:
 
+				if(type == FSEntry::File) {
+					data.extension = path.getExtension();
+					data.stem = path.getStem();
+					data.key.primary = data.extension;
+					data.key.secondary = data.stem;
 				}
 
-			} else if constexpr (Bool::one(S, Sorting::DateAscending, Sorting::DateDescending)) {
-
-				return compare(a.getLastModifiedTime(), b.getLastModifiedTime());
-
-			} else if constexpr (Bool::one(S, Sorting::SizeAscending, Sorting::SizeDescending)) {
-
-				if(a.getType() == FSEntry::Type::File) {
-
-					return false;
+				break;
 
-				} else {
+			case Sorting::DateAscending:
+			case Sorting::DateDescending:
+				data.key.value = std::filesystem::last_write_time(path.getHandle(), error).time_since_epoch().count();
+				break;
 
-					return compare(a.getPath().toNativeString(), b.getPath().toNativeString());
+			case Sorting::SizeAscending:
+			case Sorting::SizeDescending:
 
+				if(type == FSEntry::File) {
+					u64 size = std::filesystem::file_size(path.getHandle(), error);
+					data.key.value = error ? 0 : size;
 				}
 
-			} else {
-
-				arc_force_assert("Illegal sorting mode");
+				break;
 
-			}
+			default:
+				break;
 
 		}
 
-	};
-
-	std::vector<FSEntry> entries = listEntries(recursive);
-
-	switch(sorting) {
-
-		default:
-		case Sorting::NameAscending:
-			std::sort(entries.begin(), entries.end(), [lessPredicate] (const FSEntry& a, const FSEntry& b) { return lessPredicate.template operator()<Sorting::NameAscending>(a, b); });
-			break;
-
-		case Sorting::NameDescending:
-			std::sort(entries.begin(), entries.end(), [lessPredicate] (const FSEntry& a, const FSEntry& b) { return lessPredicate.template operator()<Sorting::NameDescending>(a, b); });
-			break;
-
-		case Sorting::TypeAscending:
-			std::sort(entries.begin(), entries.end(), [lessPredicate] (const FSEntry& a, const FSEntry& b) { return lessPredicate.template operator()<Sorting::TypeAscending>(a, b); });
-			break;
-
-		case Sorting::TypeDescending:
-			std::sort(entries.begin(), entries.end(), [lessPredicate] (const FSEntry& a, const FSEntry& b) { return lessPredicate.template operator()<Sorting::TypeDescending>(a, b); });
-			break;
+	}
 
-		case Sorting::DateAscending:
-			std::sort(entries.begin(), entries.end(), [lessPredicate] (const FSEntry& a, const FSEntry& b) { return lessPredicate.template operator()<Sorting::DateAscending>(a, b); });
-			break;
+	std::vector<SizeT> order(entries.size());
 
-		case Sorting::DateDescending:
-			std::sort(entries.begin(), entries.end(), [lessPredicate] (const FSEntry& a, const FSEntry& b) { return lessPredicate.template operator()<Sorting::DateDescending>(a, b); });
-			break;
+	for(SizeT i = 0; i < order.size(); i++) {
+		order[i] = i;
+	}
 
-		case Sorting::SizeAscending:
-			std::sort(entries.begin(), entries.end(), [lessPredicate] (const FSEntry& a, const FSEntry& b) { return lessPredicate.template operator()<Sorting::SizeAscending>(a, b); });
-			break;
+	std::sort(order.begin(), order.end(), [&](SizeT a, SizeT b) {
+		return compareKeys(keys[a].key, keys[b].key, sorting);
+	});
 
-		case Sorting::SizeDescending:
-			std::sort(entries.begin(), entries.end(), [lessPredicate] (const FSEntry& a, const FSEntry& b) { return lessPredicate.template operator()<Sorting::SizeDescending>(a, b); });
-			break;
+	std::vector<FSEntry> sorted;
+	sorted.reserve(entries.size());
 
+	for(SizeT i : order) {
+		sorted.push_back(std::move(entries[i]));
 	}
 
-	return entries;
+	return sorted;
 
 }
 
@@ -0,0 +1,190 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 DirectoryScanner.cpp
+ */
+
+#include "Filesystem/DirectoryScanner.hpp"
+#include "Concurrent/Thread.hpp"
+#include "Math/Math.hpp"
+
+#include <mutex>
+#include <algorithm>
+#include <condition_variable>
+
+
+
+DirectoryScanner::DirectoryScanner(u32 threadCount) : threadCount(threadCount ? threadCount : Math::max<u32>(Thread::getHardwareThreadCount(), 1)) {}
+
+
+
+std::vector<ScannedEntry> DirectoryScanner::scan(const Path& root, Flags flags) const {
+
+	const bool recursive = (flags & Recursive) == Recursive;
+	const bool metadata = (flags & Metadata) == Metadata;
+
+	/*
+		Directories are shared through a LIFO stack so that workers stay close to the leaves,
+		which bounds the number of parent handles kept open. Scanning ends once no directory is pending or being read.
+	*/
+	std::mutex mutex;
+	std::condition_variable available;
+	std::vector<Detail::ScanTask> pending;
+	u32 active = 0;
+
+	pending.push_back({nullptr, ""});
+
+	auto worker = [&](std::vector<ScannedEntry>& entries) {
+
+		std::vector<Detail::ScanTask> subdirectories;
+
+		while (true) {
+
+			Detail::ScanTask task;
+
+			{
+				std::unique_lock lock(mutex);
+				available.wait(lock, [&]() { return !pending.empty() || !active; });
+
+				if (pending.empty()) {
+					return;
+				}
+
+				task = std::move(pending.back());
+				pending.pop_back();
+				active++;
+			}
+
+			Detail::scanDirectory(root, task, metadata, entries, subdirectories);
+
+			if (!recursive) {
+				subdirectories.clear();
+			}
+
+			// Release the parent handle before publishing new work
+			task = {};
+
+			bool finished;
+
+			{
+				std::lock_guard lock(mutex);
+
+				std::move(subdirectories.begin(), subdirectories.end(), std::back_inserter(pending));
+				active--;
+
+				finished = pending.empty() && !active;
+			}
+
+			if (finished || subdirectories.size() > 1) {
+				available.notify_all();
+			} else if (!subdirectories.empty()) {
+				available.notify_one();
+			}
+
+			subdirectories.clear();
+
+		}
+
+	};
+
+	// Single directories gain nothing from helper threads
+	u32 helpers = recursive ? threadCount - 1 : 0;
+
+	std::vector<std::vector<ScannedEntry>> results(helpers + 1);
+	std::vector<Thread> threads(helpers);
+
+	for (u32 i = 0; i < helpers; i++) {
+		threads[i].start([&, i]() { worker(results[i + 1]); });
+	}
+
+	worker(results[0]);
+
+	for (Thread& thread : threads) {
+		thread.finish();
+	}
+
+
+	std::vector<ScannedEntry> entries = std::move(results[0]);
+
+	SizeT total = entries.size();
+
+	for (u32 i = 1; i < results.size(); i++) {
+		total += results[i].size();
+	}
+
+	entries.reserve(total);
+
+	for (u32 i = 1; i < results.size(); i++) {
+		std::move(results[i].begin(), results[i].end(), std::back_inserter(entries));
+	}
+
+	return entries;
+
+}
+
+
+
+void DirectoryScanner::sort(std::vector<ScannedEntry>& entries, Directory::Sorting sorting) {
+
+	using Sorting = Directory::Sorting;
+
+	std::vector<Directory::SortKey> keys(entries.size());
+
+	for (SizeT i = 0; i < entries.size(); i++) {
+
+		const ScannedEntry& entry = entries[i];
+		Directory::SortKey& key = keys[i];
+
+		key = {Directory::getSortRank(entry.type), 0, entry.path, {}};
+
+		switch (sorting) {
+
+			case Sorting::TypeAscending:
+			case Sorting::TypeDescending:
+
+				if (entry.type == FSEntry::File) {
+					key.primary = entry.extension();
+					key.secondary = entry.stem();
+				}
+
+				break;
+
+			case Sorting::DateAscending:
+			case Sorting::DateDescending:
+				key.value = entry.modified;
+				break;
+
+			case Sorting::SizeAscending:
+			case Sorting::SizeDescending:
+				key.value = entry.size;
+				break;
+
+			default:
+				break;
+
+		}
+
+	}
+
+	std::vector<u32> order(entries.size());
+
+	for (u32 i = 0; i < order.size(); i++) {
+		order[i] = i;
+	}
+
+	std::sort(order.begin(), order.end(), [&](u32 a, u32 b) {
+		return Directory::compareKeys(keys[a], keys[b], sorting);
+	});
+
+	std::vector<ScannedEntry> sorted;
+	sorted.reserve(entries.size());
+
+	for (u32 i : order) {
+		sorted.push_back(std::move(entries[i]));
+	}
+
+	entries = std::move(sorted);
+
+}
\ No newline at end of file
@@ -126,7 +126,7 @@ void File::write(const std::string& text) {
 
 
 void File::writeLine(const std::string& line) {
-	stream << line << std::endl;
+	stream << line << '\n';
 }
 
 
@@ -156,6 +156,12 @@ std::vector<u8> File::readAll() {
 
 
 
+void File::flush() {
+	stream.flush();
+}
+
+
+
 void File::seek(i64 offset) {
 	stream.seekg(offset, std::ios::cur);
 }
@@ -0,0 +1,155 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 MappedFile.cpp
+ */
+
+#include "Filesystem/MappedFile.hpp"
+#include "Filesystem/File.hpp"
+
+#include <utility>
+
+
+
+MappedFile::MappedFile() : accessHint(Access::Default), view(nullptr), viewSize(0), mapped(false), opened(false) {}
+
+MappedFile::MappedFile(const Path& path, Access access) : filePath(path), accessHint(access), view(nullptr), viewSize(0), mapped(false), opened(false) {}
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+MappedFile::MappedFile(MappedFile&& file) noexcept :
+	filePath(std::move(file.filePath)), accessHint(file.accessHint),
+	view(std::exchange(file.view, nullptr)), viewSize(std::exchange(file.viewSize, 0)),
+	mapped(std::exchange(file.mapped, false)), opened(std::exchange(file.opened, false)),
+	buffer(std::move(file.buffer)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& file) noexcept {
+
+	if (this != &file) {
+
+		close();
+
+		filePath = std::move(file.filePath);
+		accessHint = file.accessHint;
+		view = std::exchange(file.view, nullptr);
+		viewSize = std::exchange(file.viewSize, 0);
+		mapped = std::exchange(file.mapped, false);
+		opened = std::exchange(file.opened, false);
+		buffer = std::move(file.buffer);
+
+	}
+
+	return *this;
+
+}
+
+
+
+bool MappedFile::open() {
+
+	close();
+
+	if (map()) {
+
+		mapped = true;
+		opened = true;
+
+		return true;
+
+	}
+
+	opened = readFallback();
+
+	return opened;
+
+}
+
+bool MappedFile::open(const Path& path, Access access) {
+
+	filePath = path;
+	accessHint = access;
+
+	return open();
+
+}
+
+
+
+void MappedFile::close() {
+
+	if (mapped) {
+		unmap();
+	}
+
+	view = nullptr;
+	viewSize = 0;
+	mapped = false;
+	opened = false;
+
+	buffer.clear();
+	buffer.shrink_to_fit();
+
+}
+
+
+
+bool MappedFile::isOpen() const noexcept {
+	return opened;
+}
+
+
+
+bool MappedFile::isMapped() const noexcept {
+	return mapped;
+}
+
+
+
+std::span<const u8> MappedFile::data() const noexcept {
+	return {view, viewSize};
+}
+
+
+
+SizeT MappedFile::size() const noexcept {
+	return viewSize;
+}
+
+
+
+Path MappedFile::path() const {
+	return filePath;
+}
+
+
+
+bool MappedFile::readFallback() {
+
+	try {
+
+		File file(filePath);
+
+		if (!file.open()) {
+			return false;
+		}
+
+		buffer = file.readAll();
+		file.close();
+
+	} catch (const std::exception&) {
+
+		buffer.clear();
+		return false;
+
+	}
+
+	view = buffer.data();
+	viewSize = buffer.size();
+
+	return true;
+
+}
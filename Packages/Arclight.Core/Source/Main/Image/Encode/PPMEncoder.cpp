@@ -45,10 +45,8 @@ void PPMEncoder::encode(const RawImage& image) {
 	// Write header
 	writer.write<const char>(stringWriter.view());
 
-	// Write raster data
-	RawImage copy(image);
-	RawImage rgb8 = Image<Pixel::RGB8>::fromRaw(copy, true).makeRaw();
-	writer.write<const u8>(rgb8.getRawBuffer());
+	// Convert raster data directly into the output buffer
+	PixelConversion::convert(image.getFormat(), Pixel::RGB8, image.getRawBuffer(), std::span{buffer}.subspan(headerSize));
 
 	validEncode = true;
 
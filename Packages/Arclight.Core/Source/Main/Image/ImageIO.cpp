@@ -28,6 +28,20 @@ std::vector<u8> ImageIO::Detail::loadFile(const Path& path) {
 
 
 
+MappedFile ImageIO::Detail::mapFile(const Path& path) {
+
+	MappedFile file(path, MappedFile::Access::Sequential);
+
+	if (!file.open()) {
+		throw ImageException("Failed to open file " + path.toString());
+	}
+
+	return file;
+
+}
+
+
+
 void ImageIO::Detail::saveFile(const Path& path, std::span<const u8> data) {
 
 	File file(path, File::Out);
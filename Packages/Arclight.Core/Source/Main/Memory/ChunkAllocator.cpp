@@ -88,7 +88,7 @@ void ChunkAllocator::clear() noexcept {
 		::operator delete(chunk, std::align_val_t(blockAlign));
 
 	#ifdef ARC_CFG_ALLOCATOR_DEBUG
-		LogD("Chunk Allocator").print("Chunk destroyed at %p.", heap);
+		LogD("Chunk Allocator").print("Chunk destroyed at %p.", chunk);
 	#endif
 
 		chunk = nextChunk;
@@ -110,6 +110,10 @@ void ChunkAllocator::clear() noexcept {
 
 	if (!head) {
 
+		if (!chunkBlocks) {
+			throw std::bad_alloc();
+		}
+
 		//If all chunks are full, allocate a new one
 		AddressT chunkSize = blockSize * chunkBlocks + sizeof(ChunkLink);
 		u8* chunk = static_cast<u8*>(::operator new(chunkSize, std::align_val_t(blockAlign)));
@@ -0,0 +1,422 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 SmallObjectAllocator.cpp
+ */
+
+#include "Memory/SmallObjectAllocator.hpp"
+#include "Memory/Memory.hpp"
+#include "Util/Log.hpp"
+#include "Common/Config.hpp"
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <utility>
+
+
+
+namespace {
+
+	struct ThreadCache;
+
+
+	//Free block, linked in place
+	struct Block {
+		Block* next;
+	};
+
+
+	/*
+		Span header, stored at the start of every SpanSize-aligned span.
+		Blocks are carved lazily from the bump range and recycled through freeList.
+	*/
+	struct alignas(SmallObjectHeap::MaxSmallAlign) Span {
+
+		ThreadCache* owner;
+		Span* prev;
+		Span* next;
+
+		Block* freeList;
+		u8* bump;
+		u8* end;
+
+		u32 sizeClass;
+		u32 blockSize;
+		u32 usedBlocks;
+		bool linked;
+
+	};
+
+	constexpr SizeT SpanHeaderSize = Memory::alignUp(sizeof(Span), SmallObjectHeap::MaxSmallAlign);
+
+
+	/*
+		Per-thread cache.
+		classSpans holds, for every size class, the spans with at least one free block.
+		remoteList receives blocks deallocated by foreign threads.
+	*/
+	struct ThreadCache {
+
+		Span* classSpans[SmallObjectHeap::SizeClassCount] {};
+		std::atomic<Block*> remoteList {nullptr};
+		ThreadCache* nextRetired = nullptr;
+
+	};
+
+
+	std::mutex retiredMutex;
+	ThreadCache* retiredCaches = nullptr;
+
+
+	ThreadCache* acquireCache() {
+
+		{
+			std::lock_guard lock(retiredMutex);
+
+			if (retiredCaches) {
+				return std::exchange(retiredCaches, retiredCaches->nextRetired);
+			}
+		}
+
+		return new ThreadCache;
+
+	}
+
+	void retireCache(ThreadCache* cache) noexcept {
+
+		std::lock_guard lock(retiredMutex);
+
+		cache->nextRetired = retiredCaches;
+		retiredCaches = cache;
+
+	}
+
+
+	//Retires the thread's cache on thread exit
+	struct CacheHandle {
+
+		~CacheHandle() noexcept;
+
+		ThreadCache* cache = nullptr;
+
+	};
+
+	thread_local CacheHandle cacheHandle;
+	constinit thread_local ThreadCache* threadCache = nullptr;
+	constinit thread_local bool threadExited = false;
+
+
+	CacheHandle::~CacheHandle() noexcept {
+
+		if (cache) {
+			retireCache(cache);
+		}
+
+		cache = nullptr;
+		threadCache = nullptr;
+		threadExited = true;
+
+	}
+
+
+	/*
+		Returns the calling thread's cache, creating one if necessary.
+		Returns nullptr if the thread is past its thread-local destruction.
+	*/
+	ThreadCache* getThreadCache() {
+
+		if (threadCache || threadExited) {
+			return threadCache;
+		}
+
+		ThreadCache* cache = acquireCache();
+
+		cacheHandle.cache = cache;
+		threadCache = cache;
+
+		return cache;
+
+	}
+
+
+	Span* getSpan(void* ptr) noexcept {
+		return reinterpret_cast<Span*>(Memory::alignDown(reinterpret_cast<AddressT>(ptr), SmallObjectHeap::SpanSize));
+	}
+
+
+	void linkSpan(ThreadCache* cache, Span* span) noexcept {
+
+		Span*& head = cache->classSpans[span->sizeClass];
+
+		span->prev = nullptr;
+		span->next = head;
+		span->linked = true;
+
+		if (head) {
+			head->prev = span;
+		}
+
+		head = span;
+
+	}
+
+	void unlinkSpan(ThreadCache* cache, Span* span) noexcept {
+
+		if (span->prev) {
+			span->prev->next = span->next;
+		} else {
+			cache->classSpans[span->sizeClass] = span->next;
+		}
+
+		if (span->next) {
+			span->next->prev = span->prev;
+		}
+
+		span->prev = nullptr;
+		span->next = nullptr;
+		span->linked = false;
+
+	}
+
+
+	Span* createSpan(ThreadCache* cache, SizeT sizeClass) {
+
+		u8* memory = static_cast<u8*>(::operator new(SmallObjectHeap::SpanSize, std::align_val_t(SmallObjectHeap::SpanSize)));
+		Span* span = ::new(memory) Span;
+
+		span->owner = cache;
+		span->prev = nullptr;
+		span->next = nullptr;
+		span->freeList = nullptr;
+		span->bump = memory + SpanHeaderSize;
+		span->end = memory + SmallObjectHeap::SpanSize;
+		span->sizeClass = sizeClass;
+		span->blockSize = SmallObjectHeap::getClassSize(sizeClass);
+		span->usedBlocks = 0;
+		span->linked = false;
+
+#ifdef ARC_CFG_ALLOCATOR_DEBUG
+		LogD("Small Object Heap").print("Span created at %p. Block size: %d", memory, span->blockSize);
+#endif
+
+		linkSpan(cache, span);
+
+		return span;
+
+	}
+
+	void destroySpan(ThreadCache* cache, Span* span) noexcept {
+
+		if (span->linked) {
+			unlinkSpan(cache, span);
+		}
+
+#ifdef ARC_CFG_ALLOCATOR_DEBUG
+		LogD("Small Object Heap").print("Span destroyed at %p.", span);
+#endif
+
+		span->~Span();
+		::operator delete(span, SmallObjectHeap::SpanSize, std::align_val_t(SmallObjectHeap::SpanSize));
+
+	}
+
+
+	bool isSpanFull(const Span* span) noexcept {
+		return !span->freeList && span->bump + span->blockSize > span->end;
+	}
+
+
+	//Returns a block to its span. Must be called by the owning thread.
+	void localFree(ThreadCache* cache, Span* span, void* ptr) noexcept {
+
+		span->freeList = ::new(ptr) Block{span->freeList};
+		span->usedBlocks--;
+
+		if (!span->linked) {
+
+			linkSpan(cache, span);
+
+		} else if (!span->usedBlocks && (span->prev || span->next)) {
+
+			//Keep one span per class around to avoid thrashing on alloc/free pairs
+			destroySpan(cache, span);
+
+		}
+
+	}
+
+
+	//Reclaims every block freed by foreign threads. Returns true if any block was reclaimed.
+	bool drainRemote(ThreadCache* cache) noexcept {
+
+		Block* block = cache->remoteList.exchange(nullptr, std::memory_order_acquire);
+
+		if (!block) {
+			return false;
+		}
+
+		while (block) {
+
+			Block* next = block->next;
+			localFree(cache, getSpan(block), block);
+			block = next;
+
+		}
+
+		return true;
+
+	}
+
+	void remoteFree(Span* span, void* ptr) noexcept {
+
+		std::atomic<Block*>& remoteList = span->owner->remoteList;
+		Block* block = ::new(ptr) Block{remoteList.load(std::memory_order_relaxed)};
+
+		while (!remoteList.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed));
+
+	}
+
+
+	void* cacheAllocate(ThreadCache* cache, SizeT sizeClass) {
+
+		Span* span = cache->classSpans[sizeClass];
+
+		if (!span) {
+
+			drainRemote(cache);
+			span = cache->classSpans[sizeClass];
+
+			if (!span) {
+				span = createSpan(cache, sizeClass);
+			}
+
+		}
+
+		void* ptr;
+
+		if (span->freeList) {
+
+			ptr = span->freeList;
+			span->freeList = span->freeList->next;
+
+		} else {
+
+			ptr = span->bump;
+			span->bump += span->blockSize;
+
+		}
+
+		span->usedBlocks++;
+
+		if (isSpanFull(span)) {
+			unlinkSpan(cache, span);
+		}
+
+		return ptr;
+
+	}
+
+}
+
+
+
+void* SmallObjectHeap::allocate(SizeT size, AlignT align) {
+
+	if (!isSmall(size, align)) {
+
+		if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+			return ::operator new(size, std::align_val_t(align));
+		}
+
+		return ::operator new(size);
+
+	}
+
+	SizeT sizeClass = getSizeClass(size);
+	ThreadCache* cache = getThreadCache();
+
+	if (cache) {
+		return cacheAllocate(cache, sizeClass);
+	}
+
+	//The thread has already torn down its cache, borrow a retired one
+	ThreadCache* borrowed = acquireCache();
+	void* ptr = nullptr;
+
+	try {
+		ptr = cacheAllocate(borrowed, sizeClass);
+	} catch (...) {
+		retireCache(borrowed);
+		throw;
+	}
+
+	retireCache(borrowed);
+
+	return ptr;
+
+}
+
+
+
+void SmallObjectHeap::deallocate(void* ptr, SizeT size, AlignT align) noexcept {
+
+	if (!ptr) {
+		return;
+	}
+
+	if (!isSmall(size, align)) {
+
+		if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+			::operator delete(ptr, size, std::align_val_t(align));
+		} else {
+			::operator delete(ptr, size);
+		}
+
+		return;
+
+	}
+
+	Span* span = getSpan(ptr);
+
+	if (span->owner == threadCache) {
+		localFree(threadCache, span, ptr);
+	} else {
+		remoteFree(span, ptr);
+	}
+
+}
+
+
+
+void SmallObjectHeap::trim() noexcept {
+
+	ThreadCache* cache = threadCache;
+
+	if (!cache) {
+		return;
+	}
+
+	drainRemote(cache);
+
+	for (Span*& head : cache->classSpans) {
+
+		Span* span = head;
+
+		while (span) {
+
+			Span* next = span->next;
+
+			if (!span->usedBlocks) {
+				destroySpan(cache, span);
+			}
+
+			span = next;
+
+		}
+
+	}
+
+}
@@ -0,0 +1,711 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 Instrumentation.cpp
+ */
+
+#include "Time/Instrumentation.hpp"
+#include "Filesystem/File.hpp"
+#include "Math/Math.hpp"
+
+#include <cmath>
+#include <mutex>
+#include <memory>
+#include <cstdio>
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+
+
+
+namespace {
+
+	using namespace Instrumentation;
+	using Detail::Chunk;
+
+
+	struct ThreadBuffer {
+
+		ThreadBuffer(u32 id) noexcept : id(id), state(0), head(nullptr), abandoned(false) {}
+
+		~ThreadBuffer() {
+
+			Chunk* chunk = head.load(std::memory_order_relaxed);
+
+			while (chunk) {
+
+				Chunk* next = chunk->next.load(std::memory_order_relaxed);
+				delete chunk;
+				chunk = next;
+
+			}
+
+		}
+
+		u32 id;
+		std::string name;						//Guarded by registryMutex
+		std::atomic<u32> state;					//Capture the chunk contents belong to
+		std::atomic<Chunk*> head;
+		std::atomic<bool> abandoned;
+
+	};
+
+
+	constinit thread_local bool threadExited = false;
+
+
+	//Marks the thread's buffer as abandoned on thread exit and stops further recording
+	struct BufferHandle {
+
+		~BufferHandle() noexcept {
+
+			Detail::threadCursor = {nullptr, 0};
+			threadExited = true;
+
+			if (buffer) {
+				buffer->abandoned.store(true, std::memory_order_release);
+			}
+
+		}
+
+		std::shared_ptr<ThreadBuffer> buffer;
+
+	};
+
+	thread_local BufferHandle bufferHandle;
+
+
+	std::mutex registryMutex;
+	std::vector<std::shared_ptr<ThreadBuffer>> registry;
+	u32 nextThreadID = 0;
+
+	u64 captureStartTicks = 0;
+	std::chrono::steady_clock::time_point captureStartTime;
+
+
+	ThreadBuffer* getThreadBuffer() {
+
+		if (threadExited) {
+			return nullptr;
+		}
+
+		if (!bufferHandle.buffer) {
+
+			std::lock_guard lock(registryMutex);
+
+			bufferHandle.buffer = std::make_shared<ThreadBuffer>(nextThreadID++);
+			registry.push_back(bufferHandle.buffer);
+
+		}
+
+		return bufferHandle.buffer.get();
+
+	}
+
+
+	Chunk* createChunk() {
+
+		Chunk* chunk = new Chunk;
+
+		chunk->count.store(0, std::memory_order_relaxed);
+		chunk->next.store(nullptr, std::memory_order_relaxed);
+
+		return chunk;
+
+	}
+
+
+	Statistic computeStatistic(std::vector<double>& values) {
+
+		Statistic statistic;
+
+		if (values.empty()) {
+			return statistic;
+		}
+
+		std::sort(values.begin(), values.end());
+
+		//Nearest-rank percentile
+		auto percentile = [&](double p) {
+
+			SizeT rank = static_cast<SizeT>(std::ceil(p * values.size()));
+			return values[Math::clamp(rank, SizeT(1), values.size()) - 1];
+
+		};
+
+		double sum = 0;
+
+		for (double value : values) {
+			sum += value;
+		}
+
+		statistic.min = values.front();
+		statistic.max = values.back();
+		statistic.avg = sum / values.size();
+		statistic.p50 = percentile(0.50);
+		statistic.p95 = percentile(0.95);
+		statistic.p99 = percentile(0.99);
+
+		return statistic;
+
+	}
+
+
+	/*
+		Reconstructs zone instances of a thread and invokes visitor(site, begin, end, childTicks, depth) in end order.
+		Zones that began before the capture are dropped, zones still open at its end are closed at the end timestamp.
+	*/
+	template<class Visitor>
+	void visitZones(const ThreadCapture& thread, u64 endTicks, Visitor&& visitor) {
+
+		struct OpenZone {
+
+			const ZoneSite* site;
+			u64 begin;
+			u64 childTicks;
+
+		};
+
+		std::vector<OpenZone> stack;
+
+		auto close = [&](u64 end) {
+
+			OpenZone zone = stack.back();
+			stack.pop_back();
+
+			u64 duration = end - zone.begin;
+
+			if (!stack.empty()) {
+				stack.back().childTicks += duration;
+			}
+
+			visitor(*zone.site, zone.begin, end, zone.childTicks, stack.size());
+
+		};
+
+		for (const Event& event : thread.events) {
+
+			switch (event.type) {
+
+				case EventType::ZoneBegin:
+					stack.push_back({static_cast<const ZoneSite*>(event.data), event.timestamp, 0});
+					break;
+
+				case EventType::ZoneEnd:
+
+					if (!stack.empty() && stack.back().site == event.data) {
+						close(event.timestamp);
+					}
+
+					break;
+
+				default:
+					break;
+
+			}
+
+		}
+
+		while (!stack.empty()) {
+			close(Math::max(endTicks, stack.back().begin));
+		}
+
+	}
+
+
+	std::vector<u64> collectFrames(const std::vector<ThreadCapture>& threads) {
+
+		std::vector<u64> frames;
+
+		for (const ThreadCapture& thread : threads) {
+
+			for (const Event& event : thread.events) {
+
+				if (event.type == EventType::Frame) {
+					frames.push_back(event.timestamp);
+				}
+
+			}
+
+		}
+
+		std::sort(frames.begin(), frames.end());
+
+		return frames;
+
+	}
+
+
+	void appendEscaped(std::string& out, std::string_view string) {
+
+		for (char c : string) {
+
+			switch (c) {
+
+				case '"':	out.append("\\\""); break;
+				case '\\':	out.append("\\\\"); break;
+				case '\n':	out.append("\\n"); break;
+				case '\t':	out.append("\\t"); break;
+
+				default:
+
+					if (static_cast<u8>(c) < 0x20) {
+
+						char buffer[8];
+						std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+						out.append(buffer);
+
+					} else {
+
+						out.push_back(c);
+
+					}
+
+					break;
+
+			}
+
+		}
+
+	}
+
+
+	void appendNumber(std::string& out, double value) {
+
+		char buffer[32];
+		int length = std::snprintf(buffer, sizeof(buffer), "%.3f", value);
+
+		out.append(buffer, length);
+
+	}
+
+}
+
+
+
+std::atomic<u32> Instrumentation::Detail::captureState = 0;
+constinit thread_local Instrumentation::Detail::ThreadCursor Instrumentation::Detail::threadCursor {nullptr, 0};
+
+
+
+bool Instrumentation::Detail::acquireChunk(u32 state) noexcept {
+
+	try {
+
+		ThreadBuffer* buffer = getThreadBuffer();
+
+		if (!buffer) {
+			return false;
+		}
+
+		ThreadCursor& cursor = threadCursor;
+
+		if (cursor.state != state) {
+
+			//New capture, reuse the chunks of the previous one
+			Chunk* head = buffer->head.load(std::memory_order_relaxed);
+
+			for (Chunk* chunk = head; chunk; chunk = chunk->next.load(std::memory_order_relaxed)) {
+				chunk->count.store(0, std::memory_order_relaxed);
+			}
+
+			if (!head) {
+
+				head = createChunk();
+				buffer->head.store(head, std::memory_order_release);
+
+			}
+
+			buffer->state.store(state, std::memory_order_release);
+			cursor = {head, state};
+
+			return true;
+
+		}
+
+		Chunk* next = cursor.chunk->next.load(std::memory_order_relaxed);
+
+		if (!next) {
+
+			next = createChunk();
+			cursor.chunk->next.store(next, std::memory_order_release);
+
+		}
+
+		cursor.chunk = next;
+
+		return true;
+
+	} catch (const std::exception&) {
+
+		return false;
+
+	}
+
+}
+
+
+
+void Instrumentation::setThreadName(const std::string& name) {
+
+	ThreadBuffer* buffer = getThreadBuffer();
+
+	if (buffer) {
+
+		std::lock_guard lock(registryMutex);
+		buffer->name = name;
+
+	}
+
+}
+
+
+
+void Instrumentation::start() {
+
+	captureStartTime = std::chrono::steady_clock::now();
+	captureStartTicks = now();
+
+	u32 state = Detail::captureState.load(std::memory_order_relaxed);
+	Detail::captureState.store(((state >> 1) + 1) << 1 | 1, std::memory_order_release);
+
+}
+
+
+
+Instrumentation::Capture Instrumentation::stop() {
+
+	using Clock = std::chrono::steady_clock;
+
+	u32 state = Detail::captureState.load(std::memory_order_relaxed);
+	Detail::captureState.store(state & ~1u, std::memory_order_release);
+
+	Capture capture;
+
+	if (!(state & 1)) {
+		return capture;
+	}
+
+	u64 endTicks = now();
+	Clock::time_point endTime = Clock::now();
+
+#ifdef ARC_INSTRUMENTATION_TSC
+
+	//Short captures do not allow for an accurate TSC frequency estimate, extend the calibration interval
+	while (endTime - captureStartTime < std::chrono::milliseconds(10)) {
+
+		endTicks = now();
+		endTime = Clock::now();
+
+	}
+
+	double elapsed = std::chrono::duration<double, std::micro>(endTime - captureStartTime).count();
+	capture.microsecondsPerTick = elapsed / Math::max(endTicks - captureStartTicks, u64(1));
+
+#else
+
+	capture.microsecondsPerTick = 1000000.0 * Clock::period::num / Clock::period::den;
+
+#endif
+
+	capture.startTicks = captureStartTicks;
+	capture.endTicks = endTicks;
+
+	std::lock_guard lock(registryMutex);
+
+	for (const auto& buffer : registry) {
+
+		if (buffer->state.load(std::memory_order_acquire) != state) {
+			continue;
+		}
+
+		ThreadCapture& thread = capture.threads.emplace_back();
+		thread.id = buffer->id;
+		thread.name = buffer->name;
+
+		for (Chunk* chunk = buffer->head.load(std::memory_order_acquire); chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+
+			u32 count = chunk->count.load(std::memory_order_acquire);
+			thread.events.insert(thread.events.end(), chunk->events, chunk->events + count);
+
+			if (count != Detail::ChunkEvents) {
+				break;
+			}
+
+		}
+
+	}
+
+	std::erase_if(registry, [](const std::shared_ptr<ThreadBuffer>& buffer) {
+		return buffer->abandoned.load(std::memory_order_acquire);
+	});
+
+	return capture;
+
+}
+
+
+
+bool Instrumentation::isRecording() noexcept {
+	return Detail::captureState.load(std::memory_order_relaxed) & 1;
+}
+
+
+
+Instrumentation::Capture::Capture() noexcept : startTicks(0), endTicks(0), microsecondsPerTick(0) {}
+
+
+
+std::vector<Instrumentation::ZoneStatistics> Instrumentation::Capture::getZoneStatistics() const {
+
+	struct Accumulator {
+
+		u64 calls = 0;
+		u64 totalTicks = 0;
+		u64 selfTicks = 0;
+		std::vector<double> durations;
+		std::vector<double> frameTimes;
+
+	};
+
+	std::vector<u64> frames = collectFrames(threads);
+	SizeT frameCount = frames.size() > 1 ? frames.size() - 1 : 0;
+
+	std::unordered_map<const ZoneSite*, Accumulator> zones;
+
+	for (const ThreadCapture& thread : threads) {
+
+		visitZones(thread, endTicks, [&](const ZoneSite& site, u64 begin, u64 end, u64 childTicks, SizeT) {
+
+			Accumulator& zone = zones[&site];
+			u64 duration = end - begin;
+
+			zone.calls++;
+			zone.totalTicks += duration;
+			zone.selfTicks += duration - Math::min(childTicks, duration);
+			zone.durations.push_back(ticksToMicroseconds(duration));
+
+			//Zones are attributed to the frame they started in
+			if (frameCount && begin >= frames.front() && begin < frames.back()) {
+
+				if (zone.frameTimes.empty()) {
+					zone.frameTimes.resize(frameCount);
+				}
+
+				SizeT frame = std::upper_bound(frames.begin(), frames.end(), begin) - frames.begin() - 1;
+				zone.frameTimes[frame] += ticksToMicroseconds(duration);
+
+			}
+
+		});
+
+	}
+
+	std::vector<ZoneStatistics> statistics;
+	statistics.reserve(zones.size());
+
+	for (auto& [site, zone] : zones) {
+
+		if (frameCount && zone.frameTimes.empty()) {
+			zone.frameTimes.resize(frameCount);
+		}
+
+		statistics.push_back({site, zone.calls, ticksToMicroseconds(zone.totalTicks), ticksToMicroseconds(zone.selfTicks), computeStatistic(zone.durations), computeStatistic(zone.frameTimes)});
+
+	}
+
+	std::sort(statistics.begin(), statistics.end(), [](const ZoneStatistics& a, const ZoneStatistics& b) {
+		return a.totalTime > b.totalTime;
+	});
+
+	return statistics;
+
+}
+
+
+
+std::vector<Instrumentation::CounterStatistics> Instrumentation::Capture::getCounterStatistics() const {
+
+	struct Sample {
+
+		u64 timestamp;
+		double value;
+
+	};
+
+	std::unordered_map<std::string_view, std::vector<Sample>> counters;
+
+	for (const ThreadCapture& thread : threads) {
+
+		for (const Event& event : thread.events) {
+
+			if (event.type == EventType::Counter) {
+				counters[static_cast<const char*>(event.data)].push_back({event.timestamp, event.value});
+			}
+
+		}
+
+	}
+
+	std::vector<CounterStatistics> statistics;
+
+	for (auto& [name, samples] : counters) {
+
+		std::sort(samples.begin(), samples.end(), [](const Sample& a, const Sample& b) {
+			return a.timestamp < b.timestamp;
+		});
+
+		CounterStatistics counter {name.data(), samples.size(), samples.front().value, 0, samples.front().value, samples.back().value};
+
+		for (const Sample& sample : samples) {
+
+			counter.min = Math::min(counter.min, sample.value);
+			counter.max = Math::max(counter.max, sample.value);
+			counter.avg += sample.value;
+
+		}
+
+		counter.avg /= samples.size();
+		statistics.push_back(counter);
+
+	}
+
+	std::sort(statistics.begin(), statistics.end(), [](const CounterStatistics& a, const CounterStatistics& b) {
+		return std::string_view(a.name) < std::string_view(b.name);
+	});
+
+	return statistics;
+
+}
+
+
+
+Instrumentation::Statistic Instrumentation::Capture::getFrameStatistics() const {
+
+	std::vector<u64> frames = collectFrames(threads);
+	std::vector<double> durations;
+
+	for (SizeT i = 1; i < frames.size(); i++) {
+		durations.push_back(ticksToMicroseconds(frames[i] - frames[i - 1]));
+	}
+
+	return computeStatistic(durations);
+
+}
+
+
+
+u64 Instrumentation::Capture::getFrameCount() const {
+
+	SizeT markers = collectFrames(threads).size();
+	return markers > 1 ? markers - 1 : 0;
+
+}
+
+
+
+std::string Instrumentation::Capture::exportChromeTrace() const {
+
+	std::string out;
+	out.reserve(256 + threads.size() * 64);
+
+	out.append("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+	bool first = true;
+
+	auto beginEvent = [&](std::string_view name, std::string_view phase, u32 thread, double timestamp) {
+
+		out.append(first ? "\n" : ",\n");
+		first = false;
+
+		out.append("{\"name\":\"");
+		appendEscaped(out, name);
+		out.append("\",\"ph\":\"").append(phase).append("\",\"pid\":0,\"tid\":").append(std::to_string(thread)).append(",\"ts\":");
+		appendNumber(out, timestamp);
+
+	};
+
+	for (const ThreadCapture& thread : threads) {
+
+		beginEvent("thread_name", "M", thread.id, 0);
+		out.append(",\"args\":{\"name\":\"");
+		appendEscaped(out, thread.name.empty() ? "Thread " + std::to_string(thread.id) : thread.name);
+		out.append("\"}}");
+
+		visitZones(thread, endTicks, [&](const ZoneSite& site, u64 begin, u64 end, u64, SizeT) {
+
+			beginEvent(site.name, "X", thread.id, toMicroseconds(begin));
+			out.append(",\"dur\":");
+			appendNumber(out, ticksToMicroseconds(end - begin));
+			out.append(",\"args\":{\"file\":\"");
+			appendEscaped(out, site.file);
+			out.append("\",\"line\":").append(std::to_string(site.line)).append("}}");
+
+		});
+
+		for (const Event& event : thread.events) {
+
+			switch (event.type) {
+
+				case EventType::Counter:
+					beginEvent(static_cast<const char*>(event.data), "C", thread.id, toMicroseconds(event.timestamp));
+					out.append(",\"args\":{\"value\":");
+					appendNumber(out, event.value);
+					out.append("}}");
+					break;
+
+				case EventType::Frame:
+					beginEvent("Frame", "i", thread.id, toMicroseconds(event.timestamp));
+					out.append(",\"s\":\"g\"}");
+					break;
+
+				default:
+					break;
+
+			}
+
+		}
+
+	}
+
+	out.append("\n]}\n");
+
+	return out;
+
+}
+
+
+
+bool Instrumentation::Capture::exportChromeTrace(const Path& path) const {
+
+	File file;
+
+	if (!file.open(path, File::Out | File::Trunc)) {
+		return false;
+	}
+
+	file.write(exportChromeTrace());
+
+	return true;
+
+}
+
+
+
+double Instrumentation::Capture::toMicroseconds(u64 timestamp) const noexcept {
+	return timestamp >= startTicks ? ticksToMicroseconds(timestamp - startTicks) : -ticksToMicroseconds(startTicks - timestamp);
+}
+
+
+
+double Instrumentation::Capture::ticksToMicroseconds(u64 ticks) const noexcept {
+	return ticks * microsecondsPerTick;
+}
+
+
+
+double Instrumentation::Capture::getDuration() const noexcept {
+	return ticksToMicroseconds(endTicks - startTicks);
+}
\ No newline at end of file
@@ -0,0 +1,653 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 AsyncLog.cpp
+ */
+
+#include "Util/AsyncLog.hpp"
+#include "Util/Log.hpp"
+#include "Util/StructuredLog.hpp"
+#include "Concurrent/AtomicWait.hpp"
+#include "Concurrent/Thread.hpp"
+#include "Filesystem/File.hpp"
+#include "Util/Bits.hpp"
+#include "Math/Math.hpp"
+#include "Common/Assert.hpp"
+#include "Common/Config.hpp"
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <thread>
+
+
+
+namespace Log {
+
+	extern File logFile;
+
+}
+
+
+
+namespace {
+
+	struct RecordHeader {
+
+		u32 size;
+		u32 kind;
+		u64 timestamp;
+
+	};
+
+	constexpr SizeT RecordAlignment = sizeof(RecordHeader);
+
+
+	/*
+		Single-producer single-consumer byte ring holding variable-sized records.
+		Records are aligned to the header size so headers never wrap around; payloads may.
+	*/
+	class LogRing {
+
+	public:
+
+		explicit LogRing(SizeT capacity) : abandoned(false), writing(false), data(std::make_unique<u8[]>(capacity)), mask(capacity - 1), head(0), tail(0), cachedHead(0) {}
+
+
+		SizeT capacity() const noexcept {
+			return mask + 1;
+		}
+
+		static SizeT recordSize(SizeT payload) noexcept {
+			return sizeof(RecordHeader) + Memory::alignUp(payload, RecordAlignment);
+		}
+
+
+		//Producer only. Returns false if the ring has no room for the record.
+		bool tryWrite(const RecordHeader& header, const u8* payload) noexcept {
+
+			SizeT size = recordSize(header.size);
+			u64 currentTail = tail.load(std::memory_order_relaxed);
+
+			if (capacity() - (currentTail - cachedHead) < size) {
+
+				cachedHead = head.load(std::memory_order_acquire);
+
+				if (capacity() - (currentTail - cachedHead) < size) {
+					return false;
+				}
+
+			}
+
+			std::memcpy(&data[currentTail & mask], &header, sizeof(RecordHeader));
+			copyIn(currentTail + sizeof(RecordHeader), payload, header.size);
+
+			tail.store(currentTail + size, std::memory_order_release);
+
+			return true;
+
+		}
+
+
+		//Producer only. Returns whether the ring is filled beyond half its capacity.
+		bool isHalfFull() const noexcept {
+			return (tail.load(std::memory_order_relaxed) - cachedHead) * 2 > capacity();
+		}
+
+
+		//Consumer only. Passes every available record to consumer(header, payload).
+		template<class Consumer>
+		void drain(Consumer&& consumer, std::vector<u8>& scratch) {
+
+			u64 currentHead = head.load(std::memory_order_relaxed);
+			u64 currentTail = tail.load(std::memory_order_acquire);
+
+			while (currentHead != currentTail) {
+
+				RecordHeader header;
+				std::memcpy(&header, &data[currentHead & mask], sizeof(RecordHeader));
+
+				u64 start = (currentHead + sizeof(RecordHeader)) & mask;
+				const u8* payload = &data[start];
+
+				if (start + header.size > capacity()) {
+
+					//Payload wraps around, stitch it together
+					scratch.resize(header.size);
+					copyOut(currentHead + sizeof(RecordHeader), scratch.data(), header.size);
+					payload = scratch.data();
+
+				}
+
+				consumer(header, std::span<const u8>(payload, header.size));
+				currentHead += recordSize(header.size);
+
+			}
+
+			head.store(currentHead, std::memory_order_release);
+
+		}
+
+
+		bool empty() const noexcept {
+			return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+		}
+
+
+		AtomicSignal space;
+		std::atomic<bool> abandoned;
+
+		//Set by the producer while it may still write into the ring, stopAsync() waits for it to clear before the final drain
+		std::atomic<bool> writing;
+
+	private:
+
+		void copyIn(u64 position, const u8* source, SizeT size) noexcept {
+
+			SizeT offset = position & mask;
+			SizeT first = Math::min(size, capacity() - offset);
+
+			std::memcpy(&data[offset], source, first);
+			std::memcpy(&data[0], source + first, size - first);
+
+		}
+
+		void copyOut(u64 position, u8* target, SizeT size) const noexcept {
+
+			SizeT offset = position & mask;
+			SizeT first = Math::min(size, capacity() - offset);
+
+			std::memcpy(target, &data[offset], first);
+			std::memcpy(target + first, &data[0], size - first);
+
+		}
+
+
+		std::unique_ptr<u8[]> data;
+		SizeT mask;
+
+		alignas(std::hardware_destructive_interference_size) std::atomic<u64> head;
+		alignas(std::hardware_destructive_interference_size) std::atomic<u64> tail;
+		u64 cachedHead;
+
+	};
+
+
+	//Marks the calling thread's ring as abandoned on thread exit
+	struct RingHandle {
+
+		~RingHandle() noexcept {
+
+			if (ring) {
+				ring->abandoned.store(true, std::memory_order_release);
+			}
+
+		}
+
+		std::shared_ptr<LogRing> ring;
+		u32 sampleCounter = 0;
+
+	};
+
+	thread_local RingHandle ringHandle;
+
+
+	std::atomic<bool> asyncEnabled = false;
+	std::atomic<u64> droppedRecords = 0;
+	Log::AsyncConfig asyncConfig;
+
+	std::mutex registryMutex;
+	std::vector<std::shared_ptr<LogRing>> registry;
+
+	//Serializes writes to the outputs between the writer and oversized records
+	std::mutex outputMutex;
+
+	//Formats whose definition has already been written to the structured log file, guarded by outputMutex
+	std::vector<bool> definedFormats;
+
+	Thread writerThread;
+	std::atomic<bool> writerStopping = false;
+	std::atomic<bool> writerPending = false;
+	AtomicSignal writerSignal;
+
+
+	LogRing& getThreadRing() {
+
+		if (!ringHandle.ring) {
+
+			SizeT capacity = Bits::ceilPowerOf2(Math::max(asyncConfig.threadBufferSize, SizeT(4096)));
+			ringHandle.ring = std::make_shared<LogRing>(capacity);
+
+			std::lock_guard lock(registryMutex);
+			registry.push_back(ringHandle.ring);
+
+		}
+
+		return *ringHandle.ring;
+
+	}
+
+
+	void wakeWriter() noexcept {
+
+		writerPending.store(true, std::memory_order_relaxed);
+		writerSignal.notifyOne();
+
+	}
+
+
+	u64 getTimestamp() noexcept {
+		return std::chrono::steady_clock::now().time_since_epoch().count();
+	}
+
+
+	void writeOutput(const std::string& console, const std::string& file) {
+
+		std::cout.write(console.data(), console.size());
+		std::cout.flush();
+
+		if (Log::logFile.isOpen()) {
+			Log::logFile.write(file);
+			Log::logFile.flush();
+		}
+
+	}
+
+
+	//Appends a text record to the console and file batches. Like the synchronous path, file lines are always newline-terminated.
+	void appendText(std::string& console, std::string& file, std::string_view text) {
+
+		console.append(text);
+		file.append(text);
+
+		if (text.empty() || text.back() != '\n') {
+			file.push_back('\n');
+		}
+
+	}
+
+
+	void appendBinary(std::string& file, Log::Detail::RecordKind kind, u64 timestamp, std::span<const u8> payload) {
+
+		u32 header[2] = {static_cast<u32>(kind), static_cast<u32>(payload.size())};
+
+		file.append(reinterpret_cast<const char*>(header), sizeof(header));
+		file.append(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp));
+		file.append(reinterpret_cast<const char*>(payload.data()), payload.size());
+
+	}
+
+
+	//Emits the format definition before the first structured record referencing it
+	void defineFormat(std::string& file, u64 timestamp, std::span<const u8> payload) {
+
+		u32 id;
+
+		if (payload.size() < sizeof(id)) {
+			return;
+		}
+
+		std::memcpy(&id, payload.data(), sizeof(id));
+
+		if (id < definedFormats.size() && definedFormats[id]) {
+			return;
+		}
+
+		if (id >= definedFormats.size()) {
+			definedFormats.resize(id + 1);
+		}
+
+		definedFormats[id] = true;
+
+		std::string definition;
+		Log::Detail::appendFormatDefinition(definition, id);
+
+		appendBinary(file, Log::Detail::RecordKind::FormatDefinition, timestamp, std::span(reinterpret_cast<const u8*>(definition.data()), definition.size()));
+
+	}
+
+
+	//Appends a record to the console and file batches. Structured records are formatted here, off the logging threads.
+	void appendRecord(std::string& console, std::string& file, Log::Detail::RecordKind kind, u64 timestamp, std::span<const u8> payload) {
+
+		using Log::Detail::RecordKind;
+
+		switch (kind) {
+
+			case RecordKind::Text:
+				{
+					std::string_view text(reinterpret_cast<const char*>(payload.data()), payload.size());
+
+					if (asyncConfig.structuredFile) {
+
+						console.append(text);
+						appendBinary(file, kind, timestamp, payload);
+
+					} else {
+
+						appendText(console, file, text);
+
+					}
+				}
+				break;
+
+			case RecordKind::Structured:
+				{
+					std::string text = Log::Detail::formatStructured(payload);
+
+					if (asyncConfig.structuredFile) {
+
+						console.append(text);
+						defineFormat(file, timestamp, payload);
+						appendBinary(file, kind, timestamp, payload);
+
+					} else {
+
+						appendText(console, file, text);
+
+					}
+				}
+				break;
+
+			default:
+				break;
+
+		}
+
+	}
+
+
+	//Collects all pending records, orders them by timestamp and writes them in one batch
+	void drainAll() {
+
+		struct Entry {
+
+			u64 timestamp;
+			u32 kind;
+			SizeT offset;
+			SizeT size;
+
+		};
+
+		static std::vector<Entry> entries;
+		static std::vector<u8> arena;
+		static std::vector<u8> scratch;
+		static std::string console;
+		static std::string file;
+
+		entries.clear();
+		arena.clear();
+
+		std::vector<std::shared_ptr<LogRing>> rings;
+
+		{
+			std::lock_guard lock(registryMutex);
+
+			//Drop rings of exited threads once they have been emptied
+			std::erase_if(registry, [](const std::shared_ptr<LogRing>& ring) {
+				return ring->abandoned.load(std::memory_order_acquire) && ring->empty();
+			});
+
+			rings = registry;
+		}
+
+		for (const auto& ring : rings) {
+
+			ring->drain([](const RecordHeader& header, std::span<const u8> payload) {
+
+				entries.push_back({header.timestamp, header.kind, arena.size(), payload.size()});
+				arena.insert(arena.end(), payload.begin(), payload.end());
+
+			}, scratch);
+
+			ring->space.notifyAll();
+
+		}
+
+		if (entries.empty()) {
+			return;
+		}
+
+		std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+			return a.timestamp < b.timestamp;
+		});
+
+		console.clear();
+		file.clear();
+
+		std::lock_guard lock(outputMutex);
+
+		for (const Entry& entry : entries) {
+			appendRecord(console, file, static_cast<Log::Detail::RecordKind>(entry.kind), entry.timestamp, std::span(arena.data() + entry.offset, entry.size));
+		}
+
+		writeOutput(console, file);
+
+	}
+
+
+	void writerMain() {
+
+		while (!writerStopping.load(std::memory_order_acquire)) {
+
+			writerSignal.waitFor([]() {
+				return writerPending.exchange(false, std::memory_order_relaxed) || writerStopping.load(std::memory_order_acquire);
+			}, asyncConfig.flushInterval);
+
+			try {
+				drainAll();
+			} catch (const std::exception&) {
+#if defined(ARC_CFG_LOG_EXCEPTION_ABORT) && !defined(ARC_CFG_FINAL_BUILD)
+				arc_abort();
+#endif
+			}
+
+		}
+
+		drainAll();
+
+	}
+
+
+	//Writes a record that does not fit into a ring directly
+	void writeOversized(Log::Detail::RecordKind kind, std::span<const u8> payload) {
+
+		std::string console;
+		std::string file;
+
+		std::lock_guard lock(outputMutex);
+
+		appendRecord(console, file, kind, getTimestamp(), payload);
+		writeOutput(console, file);
+
+	}
+
+}
+
+
+
+bool Log::Detail::submitRecord(RecordKind kind, std::span<const u8> payload) noexcept {
+
+	if (!asyncEnabled.load(std::memory_order_acquire)) {
+		return false;
+	}
+
+	try {
+
+		LogRing& ring = getThreadRing();
+
+		/*
+			Announce the write before checking again whether the backend is still running.
+			Both sides use sequentially consistent operations, so either this thread observes the shutdown
+			and logs synchronously, or stopAsync() observes the flag and waits until the record is in the ring.
+		*/
+		ring.writing.store(true, std::memory_order_seq_cst);
+
+		struct WritingGuard {
+
+			~WritingGuard() noexcept {
+				ring.writing.store(false, std::memory_order_release);
+			}
+
+			LogRing& ring;
+
+		} guard {ring};
+
+		if (!asyncEnabled.load(std::memory_order_seq_cst)) {
+			return false;
+		}
+
+		if (LogRing::recordSize(payload.size()) > ring.capacity()) {
+
+			writeOversized(kind, payload);
+			return true;
+
+		}
+
+		RecordHeader header {static_cast<u32>(payload.size()), static_cast<u32>(kind), getTimestamp()};
+
+		if (!ring.tryWrite(header, payload.data())) {
+
+			bool block = asyncConfig.backpressure == Backpressure::Block;
+
+			if (asyncConfig.backpressure == Backpressure::Sample) {
+				block = ++ringHandle.sampleCounter % Math::max(asyncConfig.sampleRate, 1u) == 0;
+			}
+
+			if (!block) {
+
+				droppedRecords.fetch_add(1, std::memory_order_relaxed);
+				return true;
+
+			}
+
+			wakeWriter();
+
+			bool written = false;
+
+			ring.space.wait([&]() {
+				return (written = ring.tryWrite(header, payload.data())) || !asyncEnabled.load(std::memory_order_acquire);
+			});
+
+			if (!written) {
+				return false;
+			}
+
+		}
+
+		if (ring.isHalfFull()) {
+			wakeWriter();
+		}
+
+	} catch (const std::exception&) {
+#if defined(ARC_CFG_LOG_EXCEPTION_ABORT) && !defined(ARC_CFG_FINAL_BUILD)
+		arc_abort();
+#endif
+	}
+
+	return true;
+
+}
+
+
+
+void Log::startAsync(const AsyncConfig& config) noexcept {
+
+	if (asyncEnabled.load(std::memory_order_acquire)) {
+		return;
+	}
+
+	try {
+
+		asyncConfig = config;
+		definedFormats.clear();
+
+		if (asyncConfig.structuredFile && logFile.isOpen()) {
+			logFile.write(std::span<const u8>(Detail::StructuredFileMagic));
+		}
+
+		writerStopping.store(false, std::memory_order_release);
+		writerThread.start(writerMain);
+
+		asyncEnabled.store(true, std::memory_order_release);
+
+		static bool exitHandlerRegistered = false;
+
+		if (!exitHandlerRegistered) {
+
+			std::atexit([]() { Log::stopAsync(); });
+			exitHandlerRegistered = true;
+
+		}
+
+	} catch (const std::exception&) {
+#if defined(ARC_CFG_LOG_EXCEPTION_ABORT) && !defined(ARC_CFG_FINAL_BUILD)
+		arc_abort();
+#endif
+	}
+
+}
+
+
+
+void Log::stopAsync() noexcept {
+
+	if (!asyncEnabled.exchange(false, std::memory_order_seq_cst)) {
+		return;
+	}
+
+	try {
+
+		std::vector<std::shared_ptr<LogRing>> rings;
+
+		//Release threads blocked on full rings, they fall back to synchronous logging
+		{
+			std::lock_guard lock(registryMutex);
+
+			for (const auto& ring : registry) {
+				ring->space.notifyAll();
+			}
+
+			rings = registry;
+		}
+
+		//Rings registered afterwards belong to producers that will observe the shutdown
+		for (const auto& ring : rings) {
+
+			while (ring->writing.load(std::memory_order_seq_cst)) {
+				std::this_thread::yield();
+			}
+
+		}
+
+		writerStopping.store(true, std::memory_order_release);
+		writerSignal.notifyAll();
+		writerThread.finish();
+
+	} catch (const std::exception&) {
+#if defined(ARC_CFG_LOG_EXCEPTION_ABORT) && !defined(ARC_CFG_FINAL_BUILD)
+		arc_abort();
+#endif
+	}
+
+}
+
+
+
+bool Log::isAsync() noexcept {
+	return asyncEnabled.load(std::memory_order_acquire);
+}
+
+
+
+u64 Log::getDroppedRecords() noexcept {
+	return droppedRecords.load(std::memory_order_relaxed);
+}
\ No newline at end of file
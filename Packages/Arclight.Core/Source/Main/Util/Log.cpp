@@ -7,6 +7,7 @@
  */
 
 #include "Util/Log.hpp"
+#include "Util/AsyncLog.hpp"
 #include "Common/Assert.hpp"
 #include "Filesystem/Directory.hpp"
 #include "Filesystem/File.hpp"
@@ -35,6 +36,10 @@ namespace Log {
 
 #endif
 
+#ifdef ARC_CFG_LOG_ASYNC
+		startAsync();
+#endif
+
 	}
 
 	void openLogFile(Path path) noexcept {
@@ -88,6 +93,15 @@ void RawLog::flush() noexcept {
 
 	try {
 
+		std::string_view view = buffer.view();
+
+		if (Log::Detail::submitRecord(Log::Detail::RecordKind::Text, std::span(reinterpret_cast<const u8*>(view.data()), view.size()))) {
+
+			buffer.str("");
+			return;
+
+		}
+
 		std::string str = buffer.str();
 		buffer.str("");
 
@@ -0,0 +1,598 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 StructuredLog.cpp
+ */
+
+#include "Util/StructuredLog.hpp"
+#include "Util/AsyncLog.hpp"
+#include "Common/Config.hpp"
+#include "Common/Assert.hpp"
+#include "Math/Math.hpp"
+
+#include <mutex>
+#include <memory>
+#include <cstdio>
+#include <algorithm>
+#include <unordered_map>
+
+
+
+namespace {
+
+	using Log::Detail::ArgumentType;
+
+
+	struct Segment {
+
+		std::string literal;		//Text preceding the conversion
+		std::string spec;			//Flags, width and precision without the length modifier
+		char conversion;			//Conversion character or 0 if the segment is plain text
+
+	};
+
+
+	struct FormatInfo {
+
+		char level;
+		std::string name;
+		std::string format;
+		std::vector<Segment> segments;
+
+	};
+
+
+	//Leaked intentionally: formats are looked up by the log writer until process exit
+	struct FormatRegistry {
+
+		std::mutex mutex;
+		std::vector<std::unique_ptr<FormatInfo>> formats;
+
+	};
+
+	FormatRegistry& getRegistry() {
+
+		static FormatRegistry* registry = new FormatRegistry;
+		return *registry;
+
+	}
+
+
+	const FormatInfo* findFormat(u32 id) {
+
+		FormatRegistry& registry = getRegistry();
+		std::lock_guard lock(registry.mutex);
+
+		return id < registry.formats.size() ? registry.formats[id].get() : nullptr;
+
+	}
+
+
+	std::vector<Segment> parseFormat(std::string_view format) {
+
+		std::vector<Segment> segments;
+		Segment segment {{}, {}, 0};
+
+		for (SizeT i = 0; i < format.size(); i++) {
+
+			if (format[i] != '%') {
+
+				segment.literal.push_back(format[i]);
+				continue;
+
+			}
+
+			if (i + 1 < format.size() && format[i + 1] == '%') {
+
+				segment.literal.push_back('%');
+				i++;
+				continue;
+
+			}
+
+			SizeT start = i++;
+
+			//Flags, width and precision are passed through to snprintf
+			while (i < format.size() && std::string_view("-+ #0123456789.").find(format[i]) != std::string_view::npos) {
+				i++;
+			}
+
+			std::string spec(format.substr(start, i - start));
+
+			//Arguments are always widened, so length modifiers are meaningless
+			while (i < format.size() && std::string_view("hlqjztL").find(format[i]) != std::string_view::npos) {
+				i++;
+			}
+
+			if (i >= format.size() || std::string_view("diuoxXcfFeEgGaAsp").find(format[i]) == std::string_view::npos) {
+
+				//Unsupported conversion, keep it verbatim
+				segment.literal.append(format.substr(start, Math::min(i + 1, format.size()) - start));
+				continue;
+
+			}
+
+			segment.spec = std::move(spec);
+			segment.conversion = format[i];
+			segments.push_back(std::move(segment));
+
+			segment = {{}, {}, 0};
+
+		}
+
+		if (!segment.literal.empty()) {
+			segments.push_back(std::move(segment));
+		}
+
+		return segments;
+
+	}
+
+
+	//Bounds-checked reader over record payloads
+	class RecordReader {
+
+	public:
+
+		explicit RecordReader(std::span<const u8> data) noexcept : data(data), offset(0) {}
+
+
+		template<class T>
+		bool read(T& value) noexcept {
+
+			if (remaining() < sizeof(T)) {
+				return false;
+			}
+
+			std::memcpy(&value, data.data() + offset, sizeof(T));
+			offset += sizeof(T);
+
+			return true;
+
+		}
+
+		bool readString(std::string_view& string) noexcept {
+
+			u32 length;
+
+			if (!read(length) || remaining() < length) {
+				return false;
+			}
+
+			string = std::string_view(reinterpret_cast<const char*>(data.data() + offset), length);
+			offset += length;
+
+			return true;
+
+		}
+
+		bool skip(SizeT bytes) noexcept {
+
+			if (remaining() < bytes) {
+				return false;
+			}
+
+			offset += bytes;
+			return true;
+
+		}
+
+		SizeT remaining() const noexcept {
+			return data.size() - offset;
+		}
+
+		SizeT position() const noexcept {
+			return offset;
+		}
+
+	private:
+
+		std::span<const u8> data;
+		SizeT offset;
+
+	};
+
+
+	struct Argument {
+
+		ArgumentType type;
+
+		union {
+			i64 i;
+			u64 u;
+			double f;
+		};
+
+		std::string_view string;
+
+	};
+
+
+	bool readArgument(RecordReader& reader, Argument& argument) noexcept {
+
+		if (!reader.read(argument.type)) {
+			return false;
+		}
+
+		switch (argument.type) {
+
+			case ArgumentType::Signed:
+				return reader.read(argument.i);
+
+			case ArgumentType::Unsigned:
+			case ArgumentType::Pointer:
+				return reader.read(argument.u);
+
+			case ArgumentType::Float:
+				return reader.read(argument.f);
+
+			case ArgumentType::String:
+				return reader.readString(argument.string);
+
+			default:
+				return false;
+
+		}
+
+	}
+
+
+	template<class T>
+	void appendFormatted(std::string& out, const std::string& spec, const char* modifier, char conversion, T value) {
+
+		std::string format = spec + modifier + conversion;
+
+		char buffer[64];
+		int length = std::snprintf(buffer, sizeof(buffer), format.c_str(), value);
+
+		if (length < 0) {
+			return;
+		}
+
+		if (SizeT(length) < sizeof(buffer)) {
+
+			out.append(buffer, length);
+
+		} else {
+
+			SizeT size = out.size();
+			out.resize(size + length + 1);
+			std::snprintf(out.data() + size, length + 1, format.c_str(), value);
+			out.resize(size + length);
+
+		}
+
+	}
+
+
+	//Formats a single argument according to the conversion, converting between argument types where needed
+	void appendArgument(std::string& out, const Segment& segment, const Argument& argument) {
+
+		char conversion = segment.conversion;
+
+		if (argument.type == ArgumentType::String) {
+
+			if (conversion == 's') {
+				appendFormatted(out, segment.spec, "", 's', std::string(argument.string).c_str());
+			} else {
+				out.append(argument.string);
+			}
+
+			return;
+
+		}
+
+		auto asSigned = [&]() -> i64 {
+			return argument.type == ArgumentType::Float ? i64(argument.f) : argument.i;
+		};
+
+		auto asUnsigned = [&]() -> u64 {
+			return argument.type == ArgumentType::Float ? u64(argument.f) : argument.u;
+		};
+
+		auto asFloat = [&]() -> double {
+
+			switch (argument.type) {
+				case ArgumentType::Float:	return argument.f;
+				case ArgumentType::Signed:	return double(argument.i);
+				default:					return double(argument.u);
+			}
+
+		};
+
+		switch (conversion) {
+
+			case 'd':
+			case 'i':
+				appendFormatted(out, segment.spec, "ll", conversion, static_cast<long long>(asSigned()));
+				break;
+
+			case 'u':
+			case 'o':
+			case 'x':
+			case 'X':
+				appendFormatted(out, segment.spec, "ll", conversion, static_cast<unsigned long long>(asUnsigned()));
+				break;
+
+			case 'c':
+				appendFormatted(out, segment.spec, "", 'c', static_cast<int>(asSigned()));
+				break;
+
+			case 'p':
+				appendFormatted(out, segment.spec, "", 'p', reinterpret_cast<void*>(static_cast<AddressT>(asUnsigned())));
+				break;
+
+			case 's':
+
+				switch (argument.type) {
+					case ArgumentType::Float:	appendFormatted(out, segment.spec, "", 'g', argument.f); break;
+					case ArgumentType::Signed:	appendFormatted(out, segment.spec, "ll", 'd', static_cast<long long>(argument.i)); break;
+					default:					appendFormatted(out, segment.spec, "ll", 'u', static_cast<unsigned long long>(argument.u)); break;
+				}
+
+				break;
+
+			default:
+				appendFormatted(out, segment.spec, "", conversion, asFloat());
+				break;
+
+		}
+
+	}
+
+
+	std::string formatRecord(const FormatInfo& info, RecordReader& reader) {
+
+		std::string out;
+		out.reserve(info.format.size() + 32);
+
+		out.push_back('[');
+		out.push_back(info.level);
+
+		if (info.name.empty()) {
+			out.append("] ");
+		} else {
+			out.append(": ").append(info.name).append("] ");
+		}
+
+		u8 argumentCount;
+
+		if (!reader.read(argumentCount)) {
+			return out.append("<corrupted record>\n");
+		}
+
+		u32 consumed = 0;
+
+		for (const Segment& segment : info.segments) {
+
+			out.append(segment.literal);
+
+			if (!segment.conversion) {
+				continue;
+			}
+
+			Argument argument;
+
+			if (consumed >= argumentCount) {
+
+				out.append("<missing>");
+				continue;
+
+			}
+
+			if (!readArgument(reader, argument)) {
+				return out.append("<corrupted record>\n");
+			}
+
+			consumed++;
+			appendArgument(out, segment, argument);
+
+		}
+
+		out.push_back('\n');
+		return out;
+
+	}
+
+
+	std::unique_ptr<FormatInfo> createFormat(char level, std::string_view name, std::string_view format) {
+
+		auto info = std::make_unique<FormatInfo>();
+
+		info->level = level;
+		info->name = name;
+		info->format = format;
+		info->segments = parseFormat(format);
+
+		return info;
+
+	}
+
+}
+
+
+
+Log::StructuredFormat::StructuredFormat(char level, const char* name, const char* format) : id(0) {
+
+	FormatRegistry& registry = getRegistry();
+	auto info = createFormat(level, name ? name : "", format);
+
+	std::lock_guard lock(registry.mutex);
+
+	id = registry.formats.size();
+	registry.formats.push_back(std::move(info));
+
+}
+
+
+
+void Log::Detail::submitStructured(std::span<const u8> record) noexcept {
+
+	if (submitRecord(RecordKind::Structured, record)) {
+		return;
+	}
+
+	try {
+
+		RawLog() << formatStructured(record);
+
+	} catch (const std::exception&) {
+#if defined(ARC_CFG_LOG_EXCEPTION_ABORT) && !defined(ARC_CFG_FINAL_BUILD)
+		arc_abort();
+#endif
+	}
+
+}
+
+
+
+std::string Log::Detail::formatStructured(std::span<const u8> record) {
+
+	RecordReader reader(record);
+	u32 id;
+
+	if (!reader.read(id)) {
+		return "<corrupted record>\n";
+	}
+
+	const FormatInfo* info = findFormat(id);
+
+	if (!info) {
+		return "<unknown format " + std::to_string(id) + ">\n";
+	}
+
+	return formatRecord(*info, reader);
+
+}
+
+
+
+void Log::Detail::appendFormatDefinition(std::string& out, u32 id) {
+
+	const FormatInfo* info = findFormat(id);
+
+	if (!info) {
+		return;
+	}
+
+	auto append = [&](const auto& value) {
+		out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+	};
+
+	u32 nameLength = info->name.size();
+	u32 formatLength = info->format.size();
+
+	append(id);
+	append(info->level);
+	append(nameLength);
+	out.append(info->name);
+	append(formatLength);
+	out.append(info->format);
+
+}
+
+
+
+u32 Log::Detail::getFormatCount() noexcept {
+
+	FormatRegistry& registry = getRegistry();
+	std::lock_guard lock(registry.mutex);
+
+	return registry.formats.size();
+
+}
+
+
+
+std::string Log::decodeStructuredLog(std::span<const u8> data) {
+
+	using Detail::RecordKind;
+
+	std::unordered_map<u32, std::unique_ptr<FormatInfo>> formats;
+	std::string out;
+
+	RecordReader reader(data);
+
+	while (reader.remaining()) {
+
+		//Every backend start emits the file magic again
+		if (reader.remaining() >= Detail::StructuredFileMagic.size() && std::equal(Detail::StructuredFileMagic.begin(), Detail::StructuredFileMagic.end(), data.data() + reader.position())) {
+
+			reader.skip(Detail::StructuredFileMagic.size());
+			continue;
+
+		}
+
+		u32 kind;
+		u32 size;
+		u64 timestamp;
+
+		if (!reader.read(kind) || !reader.read(size) || !reader.read(timestamp) || reader.remaining() < size) {
+			return out.append("<corrupted log>\n");
+		}
+
+		std::span<const u8> payload = data.subspan(reader.position(), size);
+		reader.skip(size);
+
+		switch (static_cast<RecordKind>(kind)) {
+
+			case RecordKind::Text:
+				{
+					out.append(reinterpret_cast<const char*>(payload.data()), payload.size());
+
+					if (!payload.empty() && payload.back() != '\n') {
+						out.push_back('\n');
+					}
+				}
+				break;
+
+			case RecordKind::Structured:
+				{
+					RecordReader recordReader(payload);
+					u32 id;
+
+					if (!recordReader.read(id)) {
+						out.append("<corrupted record>\n");
+						break;
+					}
+
+					auto it = formats.find(id);
+
+					if (it == formats.end()) {
+						out.append("<unknown format " + std::to_string(id) + ">\n");
+						break;
+					}
+
+					out.append(formatRecord(*it->second, recordReader));
+				}
+				break;
+
+			case RecordKind::FormatDefinition:
+				{
+					RecordReader definitionReader(payload);
+
+					u32 id;
+					char level;
+					std::string_view name;
+					std::string_view format;
+
+					if (!definitionReader.read(id) || !definitionReader.read(level) || !definitionReader.readString(name) || !definitionReader.readString(format)) {
+						return out.append("<corrupted log>\n");
+					}
+
+					formats[id] = createFormat(level, name, format);
+				}
+				break;
+
+			default:
+				return out.append("<corrupted log>\n");
+
+		}
+
+	}
+
+	return out;
+
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 AtomicWait.cpp
+ */
+
+#include "Concurrent/AtomicWait.hpp"
+
+#include <cerrno>
+#include <climits>
+#include <ctime>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+
+
+static long futex(std::atomic<u32>& value, int operation, u32 argument, const timespec* timeout) noexcept {
+
+	static_assert(sizeof(std::atomic<u32>) == sizeof(u32), "Atomic must be address-compatible with the futex word");
+	return syscall(SYS_futex, reinterpret_cast<u32*>(&value), operation, argument, timeout, nullptr, 0);
+
+}
+
+
+
+void AtomicWait::wait(std::atomic<u32>& value, u32 expected) noexcept {
+	futex(value, FUTEX_WAIT_PRIVATE, expected, nullptr);
+}
+
+
+
+bool AtomicWait::waitFor(std::atomic<u32>& value, u32 expected, u64 us) noexcept {
+
+	timespec timeout {
+		static_cast<time_t>(us / 1000000),
+		static_cast<long>(us % 1000000 * 1000)
+	};
+
+	return !(futex(value, FUTEX_WAIT_PRIVATE, expected, &timeout) == -1 && errno == ETIMEDOUT);
+
+}
+
+
+
+void AtomicWait::notifyOne(std::atomic<u32>& value) noexcept {
+	futex(value, FUTEX_WAKE_PRIVATE, 1, nullptr);
+}
+
+
+
+void AtomicWait::notifyAll(std::atomic<u32>& value) noexcept {
+	futex(value, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr);
+}
\ No newline at end of file
@@ -0,0 +1,515 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 AsyncIO.cpp
+ */
+
+#include "Filesystem/AsyncIO.hpp"
+#include "Concurrent/Thread.hpp"
+#include "Util/Log.hpp"
+#include "Math/Math.hpp"
+
+#include <mutex>
+#include <vector>
+#include <utility>
+#include <condition_variable>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+
+
+namespace {
+
+	int setupRing(u32 entries, io_uring_params& params) {
+		return static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+	}
+
+	int enterRing(int fd, u32 submit, u32 minComplete, u32 flags) {
+		return static_cast<int>(syscall(__NR_io_uring_enter, fd, submit, minComplete, flags, nullptr, 0));
+	}
+
+
+	class IOUringBackend;
+
+	// Backend whose completion thread is the calling thread
+	thread_local const IOUringBackend* completionBackend = nullptr;
+
+
+	/*
+		io_uring backend without liburing.
+		Submissions are serialized by a mutex and entered immediately in chunks of at most sqEntries, so the submission queue is empty whenever the mutex is free.
+		A dedicated thread reaps completions, resubmits short transfers and invokes the completion handlers.
+		The number of requests in flight is bounded by the completion queue size so completions can never be dropped.
+		Only the completion thread frees slots, so requests submitted by completion handlers are deferred instead of waiting for one.
+	*/
+	class IOUringBackend final : public Detail::AsyncIOBackend {
+
+	public:
+
+		IOUringBackend() : ringFd(-1), sqRing(nullptr), cqRing(nullptr), sqes(nullptr), sqRingSize(0), cqRingSize(0), sqesSize(0), inflight(0), capacity(0) {}
+
+		~IOUringBackend() noexcept override {
+
+			if (completionThread.running()) {
+
+				// The service waited for all requests, a NOP without user data stops the completion thread
+				std::lock_guard lock(submitMutex);
+
+				i32 error = 0;
+
+				pushEntry(IORING_OP_NOP, -1, nullptr, 0, 0, 0);
+				enter(1, error);
+
+			}
+
+			completionThread.finish();
+
+			if (sqes) {
+				munmap(sqes, sqesSize);
+			}
+
+			if (cqRing && cqRing != sqRing) {
+				munmap(cqRing, cqRingSize);
+			}
+
+			if (sqRing) {
+				munmap(sqRing, sqRingSize);
+			}
+
+			if (ringFd != -1) {
+				::close(ringFd);
+			}
+
+		}
+
+
+		bool create(u32 queueDepth) {
+
+			io_uring_params params;
+			std::memset(&params, 0, sizeof(params));
+
+			ringFd = setupRing(queueDepth, params);
+
+			if (ringFd == -1) {
+				return false;
+			}
+
+			// IORING_OP_READ/WRITE appeared together with RW_CUR_POS, NODROP guarantees completions are never lost
+			if (!(params.features & IORING_FEAT_RW_CUR_POS) || !(params.features & IORING_FEAT_NODROP)) {
+				return false;
+			}
+
+			sqRingSize = params.sq_off.array + params.sq_entries * sizeof(u32);
+			cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+			if (params.features & IORING_FEAT_SINGLE_MMAP) {
+				sqRingSize = cqRingSize = Math::max(sqRingSize, cqRingSize);
+			}
+
+			sqRing = mapRegion(sqRingSize, IORING_OFF_SQ_RING);
+
+			if (!sqRing) {
+				return false;
+			}
+
+			cqRing = (params.features & IORING_FEAT_SINGLE_MMAP) ? sqRing : mapRegion(cqRingSize, IORING_OFF_CQ_RING);
+
+			if (!cqRing) {
+				return false;
+			}
+
+			sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+			sqes = static_cast<io_uring_sqe*>(mapRegion(sqesSize, IORING_OFF_SQES));
+
+			if (!sqes) {
+				return false;
+			}
+
+			u8* sq = static_cast<u8*>(sqRing);
+			u8* cq = static_cast<u8*>(cqRing);
+
+			sqHead = reinterpret_cast<std::atomic<u32>*>(sq + params.sq_off.head);
+			sqTail = reinterpret_cast<std::atomic<u32>*>(sq + params.sq_off.tail);
+			sqMask = *reinterpret_cast<u32*>(sq + params.sq_off.ring_mask);
+			sqArray = reinterpret_cast<u32*>(sq + params.sq_off.array);
+			sqEntries = params.sq_entries;
+
+			cqHead = reinterpret_cast<std::atomic<u32>*>(cq + params.cq_off.head);
+			cqTail = reinterpret_cast<std::atomic<u32>*>(cq + params.cq_off.tail);
+			cqMask = *reinterpret_cast<u32*>(cq + params.cq_off.ring_mask);
+			cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+			// One slot stays reserved for the shutdown NOP
+			capacity = params.cq_entries - 1;
+
+			completionThread.start([this]() { completionMain(); });
+
+			return true;
+
+		}
+
+
+		void submit(std::span<Detail::IOOperation* const> operations) override {
+
+			if (completionBackend == this) {
+
+				deferred.insert(deferred.end(), operations.begin(), operations.end());
+				return;
+
+			}
+
+			std::vector<FailedOperation> failed;
+
+			while (!operations.empty()) {
+
+				u32 count = acquireSlots(Math::min<SizeT>(operations.size(), sqEntries));
+
+				{
+					std::lock_guard lock(submitMutex);
+					pushOperations(operations.first(count), failed);
+				}
+
+				failOperations(failed);
+
+				operations = operations.subspan(count);
+
+			}
+
+		}
+
+	private:
+
+		using FailedOperation = std::pair<Detail::IOOperation*, i32>;
+
+
+		void* mapRegion(SizeT size, u64 offset) {
+
+			void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, offset);
+			return address == MAP_FAILED ? nullptr : address;
+
+		}
+
+
+		// Blocks until at least one slot is free and reserves up to count slots
+		u32 acquireSlots(u32 count) {
+
+			std::unique_lock lock(slotMutex);
+			slotAvailable.wait(lock, [this]() { return inflight < capacity; });
+
+			count = Math::min(count, capacity - inflight);
+			inflight += count;
+
+			return count;
+
+		}
+
+		// Reserves up to count slots without blocking
+		u32 tryAcquireSlots(u32 count) {
+
+			std::lock_guard lock(slotMutex);
+
+			count = Math::min(count, capacity - inflight);
+			inflight += count;
+
+			return count;
+
+		}
+
+		void releaseSlots(u32 count) {
+
+			{
+				std::lock_guard lock(slotMutex);
+				inflight -= count;
+			}
+
+			slotAvailable.notify_all();
+
+		}
+
+
+		// Requires submitMutex
+		void pushEntry(u8 opcode, int fd, void* data, u32 size, u64 offset, u64 userData) {
+
+			u32 tail = sqTail->load(std::memory_order_relaxed);
+			u32 index = tail & sqMask;
+
+			io_uring_sqe& sqe = sqes[index];
+			std::memset(&sqe, 0, sizeof(sqe));
+
+			sqe.opcode = opcode;
+			sqe.fd = fd;
+			sqe.addr = reinterpret_cast<u64>(data);
+			sqe.len = size;
+			sqe.off = offset;
+			sqe.user_data = userData;
+
+			sqArray[index] = index;
+			sqTail->store(tail + 1, std::memory_order_release);
+
+		}
+
+		void pushOperation(Detail::IOOperation& operation) {
+
+			const IORequest& request = operation.request;
+
+			// Transfers are limited to 32 bits, the remainder is resubmitted on completion
+			u32 size = Math::min<SizeT>(request.size - operation.progress, 1u << 30);
+			u8 opcode = request.type == IORequest::Type::Read ? IORING_OP_READ : IORING_OP_WRITE;
+
+			pushEntry(opcode, static_cast<int>(request.file->getNativeHandle()), request.data + operation.progress, size, request.offset + operation.progress, reinterpret_cast<u64>(&operation));
+
+		}
+
+		/*
+			Requires submitMutex. Pushes the operations in chunks that fit the submission queue and enters each chunk.
+			Operations the kernel did not accept are appended to failed together with the error.
+		*/
+		void pushOperations(std::span<Detail::IOOperation* const> operations, std::vector<FailedOperation>& failed) {
+
+			while (!operations.empty()) {
+
+				u32 count = Math::min<SizeT>(operations.size(), sqEntries);
+
+				for (u32 i = 0; i < count; i++) {
+					pushOperation(*operations[i]);
+				}
+
+				i32 error = 0;
+				u32 submitted = enter(count, error);
+
+				for (u32 i = submitted; i < count; i++) {
+					failed.emplace_back(operations[i], error);
+				}
+
+				operations = operations.subspan(count);
+
+			}
+
+		}
+
+		// Must be called without submitMutex since completion handlers may submit again
+		void failOperations(std::vector<FailedOperation>& failed) {
+
+			if (failed.empty()) {
+				return;
+			}
+
+			for (auto [operation, error] : failed) {
+				Detail::completeOperation(*operation, operation->progress, error);
+			}
+
+			releaseSlots(failed.size());
+			failed.clear();
+
+		}
+
+		/*
+			Requires submitMutex. Returns the number of entries consumed by the kernel.
+			On failure the remaining entries are removed from the ring again so that later pushes cannot overwrite them.
+		*/
+		u32 enter(u32 count, i32& error) {
+
+			u32 submitted = 0;
+
+			while (submitted < count) {
+
+				int result = enterRing(ringFd, count - submitted, 0, 0);
+
+				if (result < 0) {
+
+					if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+						continue;
+					}
+
+					error = errno;
+					LogE("AsyncIO") << "io_uring submission failed: " << std::strerror(errno);
+
+					// Without SQPOLL the kernel only consumes entries inside io_uring_enter, so the tail can be rewound safely
+					sqTail->store(sqHead->load(std::memory_order_acquire), std::memory_order_release);
+
+					return submitted;
+
+				}
+
+				submitted += result;
+
+			}
+
+			return submitted;
+
+		}
+
+
+		/*
+			Completion thread only. Submits deferred requests while slots are free.
+			The remaining requests wait for the next completions, which are guaranteed since all slots are in use.
+		*/
+		void submitDeferred(std::vector<FailedOperation>& failed) {
+
+			while (!deferred.empty()) {
+
+				u32 count = tryAcquireSlots(Math::min<SizeT>(deferred.size(), sqEntries));
+
+				if (!count) {
+					return;
+				}
+
+				// Handlers of failed requests may defer further requests
+				std::vector<Detail::IOOperation*> operations(deferred.begin(), deferred.begin() + count);
+				deferred.erase(deferred.begin(), deferred.begin() + count);
+
+				{
+					std::lock_guard lock(submitMutex);
+					pushOperations(operations, failed);
+				}
+
+				failOperations(failed);
+
+			}
+
+		}
+
+
+		void completionMain() {
+
+			completionBackend = this;
+
+			std::vector<Detail::IOOperation*> resubmit;
+			std::vector<FailedOperation> failed;
+
+			while (true) {
+
+				if (enterRing(ringFd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+					LogE("AsyncIO") << "io_uring wait failed: " << std::strerror(errno);
+				}
+
+				u32 head = cqHead->load(std::memory_order_relaxed);
+				u32 tail = cqTail->load(std::memory_order_acquire);
+
+				u32 completed = 0;
+				bool stop = false;
+
+				for (; head != tail; head++) {
+
+					const io_uring_cqe& cqe = cqes[head & cqMask];
+
+					if (!cqe.user_data) {
+						stop = true;
+						continue;
+					}
+
+					Detail::IOOperation& operation = *reinterpret_cast<Detail::IOOperation*>(cqe.user_data);
+					const IORequest& request = operation.request;
+
+					if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+						resubmit.push_back(&operation);
+						continue;
+					}
+
+					if (cqe.res < 0) {
+						Detail::completeOperation(operation, operation.progress, -cqe.res);
+						completed++;
+						continue;
+					}
+
+					operation.progress += cqe.res;
+
+					// Zero-length results mark the end of file, writes never legitimately stop early
+					if (operation.progress < request.size && cqe.res > 0) {
+						resubmit.push_back(&operation);
+						continue;
+					}
+
+					i32 error = (request.type == IORequest::Type::Write && operation.progress != request.size) ? EIO : 0;
+
+					Detail::completeOperation(operation, operation.progress, error);
+					completed++;
+
+				}
+
+				cqHead->store(head, std::memory_order_release);
+
+				if (completed) {
+					releaseSlots(completed);
+				}
+
+				// A single pass may reap up to capacity resubmissions, which can exceed the submission queue
+				if (!resubmit.empty()) {
+
+					{
+						std::lock_guard lock(submitMutex);
+						pushOperations(resubmit, failed);
+					}
+
+					resubmit.clear();
+					failOperations(failed);
+
+				}
+
+				submitDeferred(failed);
+
+				if (stop) {
+					return;
+				}
+
+			}
+
+		}
+
+
+		int ringFd;
+
+		void* sqRing;
+		void* cqRing;
+		io_uring_sqe* sqes;
+
+		SizeT sqRingSize;
+		SizeT cqRingSize;
+		SizeT sqesSize;
+
+		std::atomic<u32>* sqHead;
+		std::atomic<u32>* sqTail;
+		u32* sqArray;
+		u32 sqMask;
+		u32 sqEntries;
+
+		std::atomic<u32>* cqHead;
+		std::atomic<u32>* cqTail;
+		io_uring_cqe* cqes;
+		u32 cqMask;
+
+		std::mutex submitMutex;
+
+		// Requests submitted by completion handlers, owned by the completion thread
+		std::vector<Detail::IOOperation*> deferred;
+
+		std::mutex slotMutex;
+		std::condition_variable slotAvailable;
+		u32 inflight;
+		u32 capacity;
+
+		Thread completionThread;
+
+	};
+
+}
+
+
+
+std::unique_ptr<Detail::AsyncIOBackend> Detail::createNativeAsyncIOBackend(u32 queueDepth) {
+
+	auto backend = std::make_unique<IOUringBackend>();
+
+	if (!backend->create(queueDepth)) {
+		return nullptr;
+	}
+
+	return backend;
+
+}
\ No newline at end of file
@@ -0,0 +1,162 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 BinaryFile.cpp
+ */
+
+#include "Filesystem/BinaryFile.hpp"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+
+
+constexpr static int accessToAdvice(BinaryFile::Access access) {
+
+	switch (access) {
+
+		case BinaryFile::Access::Sequential:	return POSIX_FADV_SEQUENTIAL;
+		case BinaryFile::Access::Random:		return POSIX_FADV_RANDOM;
+		default:								return POSIX_FADV_NORMAL;
+
+	}
+
+}
+
+
+
+bool BinaryFile::openHandle() {
+
+	int flags = O_CLOEXEC;
+
+	if ((openFlags & In) && (openFlags & Out)) {
+		flags |= O_RDWR;
+	} else if (openFlags & Out) {
+		flags |= O_WRONLY;
+	} else {
+		flags |= O_RDONLY;
+	}
+
+	if (openFlags & Out) {
+
+		flags |= O_CREAT;
+
+		if (openFlags & Trunc) {
+			flags |= O_TRUNC;
+		}
+
+	}
+
+	int fd = ::open(filePath.getHandle().c_str(), flags, 0644);
+
+	if (fd == -1) {
+		return false;
+	}
+
+	handle = fd;
+
+	return true;
+
+}
+
+
+
+void BinaryFile::closeHandle() noexcept {
+	::close(static_cast<int>(handle));
+}
+
+
+
+SizeT BinaryFile::readNative(u64 offset, u8* data, SizeT size) const {
+
+	SizeT total = 0;
+
+	while (total < size) {
+
+		ssize_t count = pread(static_cast<int>(handle), data + total, size - total, offset + total);
+
+		if (count == -1 && errno == EINTR) {
+			continue;
+		}
+
+		if (count <= 0) {
+			break;
+		}
+
+		total += count;
+
+	}
+
+	return total;
+
+}
+
+
+
+SizeT BinaryFile::writeNative(u64 offset, const u8* data, SizeT size) {
+
+	SizeT total = 0;
+
+	while (total < size) {
+
+		ssize_t count = pwrite(static_cast<int>(handle), data + total, size - total, offset + total);
+
+		if (count == -1 && errno == EINTR) {
+			continue;
+		}
+
+		if (count <= 0) {
+			break;
+		}
+
+		total += count;
+
+	}
+
+	return total;
+
+}
+
+
+
+u64 BinaryFile::nativeSize() const {
+
+	struct stat status;
+
+	if (fstat(static_cast<int>(handle), &status) == -1) {
+		return 0;
+	}
+
+	return status.st_size;
+
+}
+
+
+
+bool BinaryFile::syncNative() {
+	return fdatasync(static_cast<int>(handle)) == 0;
+}
+
+
+
+void BinaryFile::advise(u64 offset, u64 size, Access access) const noexcept {
+
+	if (isOpen()) {
+		posix_fadvise(static_cast<int>(handle), offset, size, accessToAdvice(access));
+	}
+
+}
+
+
+
+void BinaryFile::prefetch(u64 offset, u64 size) const noexcept {
+
+	if (isOpen()) {
+		posix_fadvise(static_cast<int>(handle), offset, size, POSIX_FADV_WILLNEED);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,207 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 DirectoryScanner.cpp
+ */
+
+#include "Filesystem/DirectoryScanner.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+
+
+struct Detail::ScanHandle {
+
+	explicit ScanHandle(int fd) noexcept : fd(fd) {}
+
+	~ScanHandle() noexcept {
+		::close(fd);
+	}
+
+	ScanHandle(const ScanHandle& handle) = delete;
+	ScanHandle& operator=(const ScanHandle& handle) = delete;
+
+	int fd;
+
+};
+
+
+
+namespace {
+
+	struct LinuxDirent64 {
+
+		u64 d_ino;
+		i64 d_off;
+		u16 d_reclen;
+		u8 d_type;
+		char d_name[];
+
+	};
+
+
+	FSEntry::Type convertDirentType(u8 type) {
+
+		switch (type) {
+
+			case DT_REG:	return FSEntry::File;
+			case DT_DIR:	return FSEntry::Directory;
+			case DT_LNK:	return FSEntry::Symlink;
+			case DT_BLK:	return FSEntry::BlockDevice;
+			case DT_CHR:	return FSEntry::CharacterDevice;
+			case DT_FIFO:	return FSEntry::Pipe;
+			case DT_SOCK:	return FSEntry::Socket;
+			default:		return FSEntry::Unknown;
+
+		}
+
+	}
+
+	FSEntry::Type convertModeType(mode_t mode) {
+
+		switch (mode & S_IFMT) {
+
+			case S_IFREG:	return FSEntry::File;
+			case S_IFDIR:	return FSEntry::Directory;
+			case S_IFLNK:	return FSEntry::Symlink;
+			case S_IFBLK:	return FSEntry::BlockDevice;
+			case S_IFCHR:	return FSEntry::CharacterDevice;
+			case S_IFIFO:	return FSEntry::Pipe;
+			case S_IFSOCK:	return FSEntry::Socket;
+			default:		return FSEntry::Unknown;
+
+		}
+
+	}
+
+
+	int openDirectory(const Path& root, const Detail::ScanTask& task) {
+
+		constexpr int Flags = O_RDONLY | O_DIRECTORY | O_CLOEXEC | O_NOFOLLOW;
+
+		if (task.parent) {
+
+			std::string_view name = task.path;
+			SizeT separator = name.rfind('/');
+
+			if (separator != std::string_view::npos) {
+				name = name.substr(separator + 1);
+			}
+
+			int fd = openat(task.parent->fd, std::string(name).c_str(), Flags);
+
+			// Fall back to the full path if descriptors run out
+			if (fd != -1 || errno != EMFILE) {
+				return fd;
+			}
+
+		}
+
+		std::string path = root.getHandle().string();
+
+		if (!task.path.empty()) {
+			path += '/' + task.path;
+		}
+
+		return open(path.c_str(), task.parent ? Flags : Flags & ~O_NOFOLLOW);
+
+	}
+
+}
+
+
+
+bool Detail::scanDirectory(const Path& root, const ScanTask& task, bool metadata, std::vector<ScannedEntry>& entries, std::vector<ScanTask>& subdirectories) {
+
+	int fd = openDirectory(root, task);
+
+	if (fd == -1) {
+		return false;
+	}
+
+	auto handle = std::make_shared<ScanHandle>(fd);
+
+	alignas(LinuxDirent64) u8 buffer[32 * 1024];
+
+	while (true) {
+
+		long size = syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+
+		if (size == -1 && errno == EINTR) {
+			continue;
+		}
+
+		if (size <= 0) {
+			break;
+		}
+
+		for (long offset = 0; offset < size;) {
+
+			const LinuxDirent64* dirent = reinterpret_cast<const LinuxDirent64*>(buffer + offset);
+			offset += dirent->d_reclen;
+
+			const char* name = dirent->d_name;
+
+			if (name[0] == '.' && (!name[1] || (name[1] == '.' && !name[2]))) {
+				continue;
+			}
+
+			ScannedEntry entry;
+			entry.type = convertDirentType(dirent->d_type);
+			entry.size = 0;
+			entry.modified = 0;
+
+			// Some filesystems do not report types in directory entries
+			if (metadata || entry.type == FSEntry::Unknown) {
+
+				struct stat status;
+
+				if (fstatat(fd, name, &status, AT_SYMLINK_NOFOLLOW) == 0) {
+
+					entry.type = convertModeType(status.st_mode);
+					entry.modified = u64(status.st_mtim.tv_sec) * 1000000000 + status.st_mtim.tv_nsec;
+
+					if (entry.type == FSEntry::File) {
+						entry.size = status.st_size;
+					}
+
+				}
+
+			}
+
+			SizeT nameLength = std::strlen(name);
+
+			entry.path.reserve(task.path.size() + nameLength + 1);
+			entry.path = task.path;
+
+			if (!entry.path.empty()) {
+				entry.path += '/';
+			}
+
+			entry.nameOffset = entry.path.size();
+			entry.path.append(name, nameLength);
+
+			const char* dot = std::strrchr(name, '.');
+			entry.extensionOffset = (dot && dot != name) ? entry.nameOffset + (dot - name) : entry.path.size();
+
+			if (entry.type == FSEntry::Directory) {
+				subdirectories.push_back({handle, entry.path});
+			}
+
+			entries.push_back(std::move(entry));
+
+		}
+
+	}
+
+	return true;
+
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 MappedFile.cpp
+ */
+
+#include "Filesystem/MappedFile.hpp"
+#include "Memory/Memory.hpp"
+#include "Math/Math.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+
+constexpr static int accessToAdvice(MappedFile::Access access) {
+
+	switch (access) {
+
+		case MappedFile::Access::Sequential:	return MADV_SEQUENTIAL;
+		case MappedFile::Access::Random:		return MADV_RANDOM;
+		default:								return MADV_NORMAL;
+
+	}
+
+}
+
+
+
+bool MappedFile::map() {
+
+	int fd = ::open(filePath.getHandle().c_str(), O_RDONLY | O_CLOEXEC);
+
+	if (fd == -1) {
+		return false;
+	}
+
+	struct stat status;
+
+	if (fstat(fd, &status) == -1 || !S_ISREG(status.st_mode)) {
+		::close(fd);
+		return false;
+	}
+
+	// Empty files cannot be mapped, fall back to an empty buffer
+	if (status.st_size == 0) {
+		::close(fd);
+		return false;
+	}
+
+	SizeT length = status.st_size;
+	void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping keeps the file referenced on its own
+	::close(fd);
+
+	if (address == MAP_FAILED) {
+		return false;
+	}
+
+	madvise(address, length, accessToAdvice(accessHint));
+
+	view = static_cast<const u8*>(address);
+	viewSize = length;
+
+	return true;
+
+}
+
+
+
+void MappedFile::unmap() noexcept {
+	munmap(const_cast<u8*>(view), viewSize);
+}
+
+
+
+void MappedFile::prefetch(SizeT offset, SizeT size) const noexcept {
+
+	if (!mapped || offset >= viewSize) {
+		return;
+	}
+
+	static const SizeT pageSize = sysconf(_SC_PAGESIZE);
+
+	SizeT start = Memory::alignDown(offset, pageSize);
+	SizeT end = Math::min(offset + size, viewSize);
+
+	madvise(const_cast<u8*>(view) + start, end - start, MADV_WILLNEED);
+
+}
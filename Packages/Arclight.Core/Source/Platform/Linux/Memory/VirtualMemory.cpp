@@ -0,0 +1,180 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 VirtualMemory.cpp
+ */
+
+#include "Memory/VirtualMemory.hpp"
+#include "Memory/Memory.hpp"
+#include "Common/Assert.hpp"
+
+#include <cstdio>
+#include <utility>
+#include <unistd.h>
+#include <sys/mman.h>
+
+
+
+constexpr static int protectionToProtectionFlags(VirtualMemory::Protection protection) {
+
+	switch (protection) {
+
+		case VirtualMemory::Protection::Execute:            return PROT_EXEC;
+		case VirtualMemory::Protection::ReadOnly:           return PROT_READ;
+		case VirtualMemory::Protection::ReadWrite:          return PROT_READ | PROT_WRITE;
+		case VirtualMemory::Protection::ExecuteRead:        return PROT_EXEC | PROT_READ;
+		case VirtualMemory::Protection::ExecuteReadWrite:   return PROT_EXEC | PROT_READ | PROT_WRITE;
+
+	}
+
+	arc_force_assert("Bad protection setting");
+	return PROT_READ;
+
+}
+
+
+
+//Expands [start; start + size] to the enclosing page range
+static std::pair<void*, SizeT> pageRange(void* start, SizeT size) {
+
+	SizeT pageSize = VirtualMemory::getPageSize();
+	AddressT first = Memory::alignDown(reinterpret_cast<AddressT>(start), pageSize);
+	AddressT last = Memory::alignUp(reinterpret_cast<AddressT>(start) + size, pageSize);
+
+	return {reinterpret_cast<void*>(first), last - first};
+
+}
+
+
+
+SizeT VirtualMemory::getPageSize() noexcept {
+
+	static const SizeT pageSize = sysconf(_SC_PAGESIZE);
+	return pageSize;
+
+}
+
+
+
+SizeT VirtualMemory::getHugePageSize() noexcept {
+
+	static const SizeT hugePageSize = []() -> SizeT {
+
+		std::FILE* file = std::fopen("/proc/meminfo", "r");
+
+		if (!file) {
+			return 0;
+		}
+
+		char line[128];
+		SizeT size = 0;
+
+		while (std::fgets(line, sizeof(line), file)) {
+
+			unsigned long kiB;
+
+			if (std::sscanf(line, "Hugepagesize: %lu kB", &kiB) == 1) {
+				size = kiB * 1024;
+				break;
+			}
+
+		}
+
+		std::fclose(file);
+		return size;
+
+	}();
+
+	return hugePageSize;
+
+}
+
+
+
+void* VirtualMemory::allocate(SizeT size, Protection protection, HugePages hugePages) {
+
+	int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+	if (hugePages == HugePages::Explicit) {
+
+		SizeT hugePageSize = getHugePageSize();
+
+		if (!hugePageSize || size % hugePageSize) {
+			return nullptr;
+		}
+
+		flags |= MAP_HUGETLB;
+
+	}
+
+	void* ptr = mmap(nullptr, size, protectionToProtectionFlags(protection), flags, -1, 0);
+
+	if (ptr == MAP_FAILED) {
+		return nullptr;
+	}
+
+	if (hugePages == HugePages::Transparent) {
+		madvise(ptr, size, MADV_HUGEPAGE);
+	}
+
+	return ptr;
+
+}
+
+
+
+void* VirtualMemory::reserve(SizeT size, HugePages hugePages) {
+
+	if (hugePages == HugePages::Explicit) {
+		return nullptr;
+	}
+
+	// Inaccessible private mappings are not charged against the commit limit until commit() makes them writable, so that commit() can fail
+	void* ptr = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if (ptr == MAP_FAILED) {
+		return nullptr;
+	}
+
+	if (hugePages == HugePages::Transparent) {
+		madvise(ptr, size, MADV_HUGEPAGE);
+	}
+
+	return ptr;
+
+}
+
+
+
+bool VirtualMemory::commit(void* start, SizeT size, Protection protection) {
+
+	auto [pageStart, pageSize] = pageRange(start, size);
+	return !mprotect(pageStart, pageSize, protectionToProtectionFlags(protection));
+
+}
+
+
+
+bool VirtualMemory::decommit(void* start, SizeT size) {
+
+	auto [pageStart, pageSize] = pageRange(start, size);
+	return !madvise(pageStart, pageSize, MADV_DONTNEED) && !mprotect(pageStart, pageSize, PROT_NONE);
+
+}
+
+
+
+bool VirtualMemory::deallocate(void* ptr, SizeT size) {
+	return !munmap(ptr, size);
+}
+
+
+
+bool VirtualMemory::protect(void* start, SizeT size, Protection protection) {
+
+	auto [pageStart, pageSize] = pageRange(start, size);
+	return !mprotect(pageStart, pageSize, protectionToProtectionFlags(protection));
+
+}
\ No newline at end of file
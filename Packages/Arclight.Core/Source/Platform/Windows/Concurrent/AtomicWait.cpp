@@ -0,0 +1,44 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 AtomicWait.cpp
+ */
+
+#include "Concurrent/AtomicWait.hpp"
+#include "Common/Win32.hpp"
+
+
+
+void AtomicWait::wait(std::atomic<u32>& value, u32 expected) noexcept {
+	WaitOnAddress(&value, &expected, sizeof(u32), INFINITE);
+}
+
+
+
+bool AtomicWait::waitFor(std::atomic<u32>& value, u32 expected, u64 us) noexcept {
+
+	//Round up to avoid busy-waiting on sub-millisecond timeouts
+	u64 ms = (us + 999) / 1000;
+
+	if (ms >= INFINITE) {
+		ms = INFINITE - 1;
+	}
+
+
+	return WaitOnAddress(&value, &expected, sizeof(u32), static_cast<DWORD>(ms)) || GetLastError() != ERROR_TIMEOUT;
+
+}
+
+
+
+void AtomicWait::notifyOne(std::atomic<u32>& value) noexcept {
+	WakeByAddressSingle(&value);
+}
+
+
+
+void AtomicWait::notifyAll(std::atomic<u32>& value) noexcept {
+	WakeByAddressAll(&value);
+}
\ No newline at end of file
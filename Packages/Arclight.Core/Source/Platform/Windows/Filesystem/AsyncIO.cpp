@@ -0,0 +1,18 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 AsyncIO.cpp
+ */
+
+#include "Filesystem/AsyncIO.hpp"
+
+
+
+std::unique_ptr<Detail::AsyncIOBackend> Detail::createNativeAsyncIOBackend(u32 queueDepth) {
+
+	// Overlapped I/O requires files opened with FILE_FLAG_OVERLAPPED, BinaryFile handles are synchronous
+	return nullptr;
+
+}
\ No newline at end of file
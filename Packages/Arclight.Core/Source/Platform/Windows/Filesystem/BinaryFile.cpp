@@ -0,0 +1,162 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 BinaryFile.cpp
+ */
+
+#include "Filesystem/BinaryFile.hpp"
+#include "Math/Math.hpp"
+#include "Common/Win32.hpp"
+
+
+
+constexpr static DWORD accessToFlags(BinaryFile::Access access) {
+
+	switch (access) {
+
+		case BinaryFile::Access::Sequential:	return FILE_FLAG_SEQUENTIAL_SCAN;
+		case BinaryFile::Access::Random:		return FILE_FLAG_RANDOM_ACCESS;
+		default:								return FILE_ATTRIBUTE_NORMAL;
+
+	}
+
+}
+
+
+// Transfers per call are limited to 32 bits
+constexpr static SizeT MaxTransferSize = 1u << 30;
+
+
+static OVERLAPPED offsetToOverlapped(u64 offset) {
+
+	OVERLAPPED overlapped {};
+	overlapped.Offset = static_cast<DWORD>(offset);
+	overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+	return overlapped;
+
+}
+
+
+
+bool BinaryFile::openHandle() {
+
+	DWORD access = 0;
+
+	if (openFlags & In) {
+		access |= GENERIC_READ;
+	}
+
+	if (openFlags & Out) {
+		access |= GENERIC_WRITE;
+	}
+
+	DWORD disposition = OPEN_EXISTING;
+
+	if (openFlags & Out) {
+		disposition = (openFlags & Trunc) ? CREATE_ALWAYS : OPEN_ALWAYS;
+	}
+
+	// Access hints are only honored when passed on creation
+	HANDLE file = CreateFileW(filePath.getHandle().c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, disposition, accessToFlags(accessHint), nullptr);
+
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	handle = reinterpret_cast<Handle>(file);
+
+	return true;
+
+}
+
+
+
+void BinaryFile::closeHandle() noexcept {
+	CloseHandle(reinterpret_cast<HANDLE>(handle));
+}
+
+
+
+SizeT BinaryFile::readNative(u64 offset, u8* data, SizeT size) const {
+
+	SizeT total = 0;
+
+	while (total < size) {
+
+		// The file pointer moved by ReadFile is never used, all transfers are positional
+		OVERLAPPED overlapped = offsetToOverlapped(offset + total);
+		DWORD count = 0;
+
+		if (!ReadFile(reinterpret_cast<HANDLE>(handle), data + total, static_cast<DWORD>(Math::min(size - total, MaxTransferSize)), &count, &overlapped) || !count) {
+			break;
+		}
+
+		total += count;
+
+	}
+
+	return total;
+
+}
+
+
+
+SizeT BinaryFile::writeNative(u64 offset, const u8* data, SizeT size) {
+
+	SizeT total = 0;
+
+	while (total < size) {
+
+		OVERLAPPED overlapped = offsetToOverlapped(offset + total);
+		DWORD count = 0;
+
+		if (!WriteFile(reinterpret_cast<HANDLE>(handle), data + total, static_cast<DWORD>(Math::min(size - total, MaxTransferSize)), &count, &overlapped) || !count) {
+			break;
+		}
+
+		total += count;
+
+	}
+
+	return total;
+
+}
+
+
+
+u64 BinaryFile::nativeSize() const {
+
+	LARGE_INTEGER fileSize;
+
+	if (!GetFileSizeEx(reinterpret_cast<HANDLE>(handle), &fileSize)) {
+		return 0;
+	}
+
+	return fileSize.QuadPart;
+
+}
+
+
+
+bool BinaryFile::syncNative() {
+	return FlushFileBuffers(reinterpret_cast<HANDLE>(handle));
+}
+
+
+
+void BinaryFile::advise(u64 offset, u64 size, Access access) const noexcept {
+
+	// Windows only accepts access hints on open
+
+}
+
+
+
+void BinaryFile::prefetch(u64 offset, u64 size) const noexcept {
+
+	// No per-range readahead for unmapped files, rely on the cache manager
+
+}
\ No newline at end of file
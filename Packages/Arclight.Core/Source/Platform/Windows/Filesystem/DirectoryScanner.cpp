@@ -0,0 +1,121 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 DirectoryScanner.cpp
+ */
+
+#include "Filesystem/DirectoryScanner.hpp"
+#include "Locale/Unicode.hpp"
+#include "Common/Win32.hpp"
+
+#include <algorithm>
+
+
+
+// Windows cannot open children relative to a directory handle, tasks always carry their full relative path
+struct Detail::ScanHandle {};
+
+
+
+namespace {
+
+	// Seconds between 1601-01-01 and 1970-01-01
+	constexpr u64 EpochDifference = 11644473600;
+
+
+	FSEntry::Type convertAttributes(const WIN32_FIND_DATAW& data) {
+
+		if (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) {
+			return FSEntry::Symlink;
+		}
+
+		if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+			return FSEntry::Directory;
+		}
+
+		if (data.dwFileAttributes & FILE_ATTRIBUTE_DEVICE) {
+			return FSEntry::CharacterDevice;
+		}
+
+		return FSEntry::File;
+
+	}
+
+}
+
+
+
+bool Detail::scanDirectory(const Path& root, const ScanTask& task, bool metadata, std::vector<ScannedEntry>& entries, std::vector<ScanTask>& subdirectories) {
+
+	std::filesystem::path directory = root.getHandle();
+
+	// Narrow strings would be interpreted in the ANSI code page, relative paths are UTF-8
+	if (!task.path.empty()) {
+		directory /= Unicode::convertString<Unicode::UTF8, Unicode::UTF16LE>(task.path);
+	}
+
+	std::wstring pattern = (directory / L"*").wstring();
+
+	// Basic info skips short names, large fetch batches the directory reads
+	WIN32_FIND_DATAW data;
+	HANDLE find = FindFirstFileExW(pattern.c_str(), FindExInfoBasic, &data, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+
+	if (find == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	do {
+
+		const wchar_t* wideName = data.cFileName;
+
+		if (wideName[0] == L'.' && (!wideName[1] || (wideName[1] == L'.' && !wideName[2]))) {
+			continue;
+		}
+
+		std::string name = Unicode::convertString<Unicode::UTF16LE, Unicode::UTF8>(wideName);
+		std::replace(name.begin(), name.end(), '\\', '/');
+
+		ScannedEntry entry;
+		entry.type = convertAttributes(data);
+		entry.size = 0;
+		entry.modified = 0;
+
+		// Find data carries all metadata, no additional queries are necessary
+		if (metadata) {
+
+			u64 time = (u64(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+			entry.modified = time >= EpochDifference * 10000000 ? (time - EpochDifference * 10000000) * 100 : 0;
+
+			if (entry.type == FSEntry::File) {
+				entry.size = (u64(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+			}
+
+		}
+
+		entry.path = task.path;
+
+		if (!entry.path.empty()) {
+			entry.path += '/';
+		}
+
+		entry.nameOffset = entry.path.size();
+		entry.path += name;
+
+		SizeT dot = name.rfind('.');
+		entry.extensionOffset = (dot != std::string::npos && dot != 0) ? entry.nameOffset + dot : entry.path.size();
+
+		if (entry.type == FSEntry::Directory) {
+			subdirectories.push_back({nullptr, entry.path});
+		}
+
+		entries.push_back(std::move(entry));
+
+	} while (FindNextFileW(find, &data));
+
+	FindClose(find);
+
+	return true;
+
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 MappedFile.cpp
+ */
+
+#include "Filesystem/MappedFile.hpp"
+#include "Math/Math.hpp"
+#include "Common/Win32.hpp"
+
+
+
+constexpr static DWORD accessToFlags(MappedFile::Access access) {
+
+	switch (access) {
+
+		case MappedFile::Access::Sequential:	return FILE_FLAG_SEQUENTIAL_SCAN;
+		case MappedFile::Access::Random:		return FILE_FLAG_RANDOM_ACCESS;
+		default:								return FILE_ATTRIBUTE_NORMAL;
+
+	}
+
+}
+
+
+
+bool MappedFile::map() {
+
+	HANDLE file = CreateFileW(filePath.getHandle().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, accessToFlags(accessHint), nullptr);
+
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+
+	// Empty files cannot be mapped, fall back to an empty buffer
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (!mapping) {
+		CloseHandle(file);
+		return false;
+	}
+
+	void* address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	// The view keeps the mapping and the file referenced on its own
+	CloseHandle(mapping);
+	CloseHandle(file);
+
+	if (!address) {
+		return false;
+	}
+
+	view = static_cast<const u8*>(address);
+	viewSize = fileSize.QuadPart;
+
+	return true;
+
+}
+
+
+
+void MappedFile::unmap() noexcept {
+	UnmapViewOfFile(view);
+}
+
+
+
+void MappedFile::prefetch(SizeT offset, SizeT size) const noexcept {
+
+	if (!mapped || offset >= viewSize) {
+		return;
+	}
+
+	WIN32_MEMORY_RANGE_ENTRY range;
+	range.VirtualAddress = const_cast<u8*>(view) + offset;
+	range.NumberOfBytes = Math::min(size, viewSize - offset);
+
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+
+}
@@ -30,13 +30,78 @@ constexpr static DWORD protectionToProtectionFlags(VirtualMemory::Protection pro
 }
 
 
-void* VirtualMemory::allocate(SizeT size, Protection protection) {
-	return VirtualAlloc(nullptr, size, MEM_COMMIT, protectionToProtectionFlags(protection));
+
+SizeT VirtualMemory::getPageSize() noexcept {
+
+	static const SizeT pageSize = []() {
+
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+
+		return info.dwPageSize;
+
+	}();
+
+	return pageSize;
+
+}
+
+
+
+SizeT VirtualMemory::getHugePageSize() noexcept {
+	return GetLargePageMinimum();
+}
+
+
+
+void* VirtualMemory::allocate(SizeT size, Protection protection, HugePages hugePages) {
+
+	DWORD type = MEM_RESERVE | MEM_COMMIT;
+
+	if (hugePages == HugePages::Explicit) {
+
+		SizeT hugePageSize = getHugePageSize();
+
+		if (!hugePageSize || size % hugePageSize) {
+			return nullptr;
+		}
+
+		//Requires SeLockMemoryPrivilege, fails otherwise
+		type |= MEM_LARGE_PAGES;
+
+	}
+
+	return VirtualAlloc(nullptr, size, type, protectionToProtectionFlags(protection));
+
+}
+
+
+
+void* VirtualMemory::reserve(SizeT size, HugePages hugePages) {
+
+	if (hugePages == HugePages::Explicit) {
+		return nullptr;
+	}
+
+	return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+
+}
+
+
+
+bool VirtualMemory::commit(void* start, SizeT size, Protection protection) {
+	return VirtualAlloc(start, size, MEM_COMMIT, protectionToProtectionFlags(protection));
+}
+
+
+
+bool VirtualMemory::decommit(void* start, SizeT size) {
+	return VirtualFree(start, size, MEM_DECOMMIT);
 }
 
 
 
-bool VirtualMemory::deallocate(void* ptr) {
+bool VirtualMemory::deallocate(void* ptr, [[maybe_unused]] SizeT size) {
 	return VirtualFree(ptr, 0, MEM_RELEASE);
 }
 
@@ -0,0 +1,1080 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 AES.hpp
+ */
+
+#pragma once
+
+#include "Key.hpp"
+#include "Util/Bits.hpp"
+#include "Common/Assert.hpp"
+#include "Common/Intrinsic.hpp"
+#include "Common/Vendor.hpp"
+
+#include <span>
+#include <array>
+#include <utility>
+#include <algorithm>
+
+#include ARC_INTRINSIC_H
+
+
+//ARMv8 AES instructions cannot be detected at runtime on every OS, they are only used if the target enables them
+#if defined(ARC_PLATFORM_AARCH64) && defined(ARC_INTRINSIC_AVAILABLE) && (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+	#define ARC_CRYPTO_AES_ARMV8
+#endif
+
+
+
+namespace AES {
+
+	namespace __Detail {
+
+		// Multiplication in GF(2^8) modulo x^8 + x^4 + x^3 + x + 1
+		constexpr u8 gfMultiply(u8 a, u8 b) {
+
+			u8 p = 0;
+
+			while (b) {
+
+				if (b & 1) {
+					p ^= a;
+				}
+
+				a = u8((a << 1) ^ ((a & 0x80) ? 0x1B : 0));
+				b >>= 1;
+
+			}
+
+			return p;
+
+		}
+
+		constexpr auto sbox = []() {
+
+			std::array<u8, 256> box{};
+
+			for (u32 i = 0; i < 256; i++) {
+
+				// Multiplicative inverse as x^254
+				u8 inverse = 0;
+
+				if (i) {
+
+					u8 base = i;
+					inverse = 1;
+
+					for (u32 e = 254; e; e >>= 1) {
+
+						if (e & 1) {
+							inverse = gfMultiply(inverse, base);
+						}
+
+						base = gfMultiply(base, base);
+
+					}
+
+				}
+
+				box[i] = inverse ^ Bits::rol(inverse, 1) ^ Bits::rol(inverse, 2) ^ Bits::rol(inverse, 3) ^ Bits::rol(inverse, 4) ^ 0x63;
+
+			}
+
+			return box;
+
+		}();
+
+		constexpr auto inverseSbox = []() {
+
+			std::array<u8, 256> box{};
+
+			for (u32 i = 0; i < 256; i++) {
+				box[sbox[i]] = i;
+			}
+
+			return box;
+
+		}();
+
+		// Combined SubBytes, ShiftRows and MixColumns, one table per input row
+		constexpr auto encryptTable = []() {
+
+			std::array<std::array<u32, 256>, 4> table{};
+
+			for (u32 i = 0; i < 256; i++) {
+
+				u8 s = sbox[i];
+				u32 w = u32(gfMultiply(s, 2)) << 24 | u32(s) << 16 | u32(s) << 8 | gfMultiply(s, 3);
+
+				for (u32 j = 0; j < 4; j++) {
+					table[j][i] = Bits::ror(w, j * 8);
+				}
+
+			}
+
+			return table;
+
+		}();
+
+		constexpr auto decryptTable = []() {
+
+			std::array<std::array<u32, 256>, 4> table{};
+
+			for (u32 i = 0; i < 256; i++) {
+
+				u8 s = inverseSbox[i];
+				u32 w = u32(gfMultiply(s, 14)) << 24 | u32(gfMultiply(s, 9)) << 16 | u32(gfMultiply(s, 13)) << 8 | gfMultiply(s, 11);
+
+				for (u32 j = 0; j < 4; j++) {
+					table[j][i] = Bits::ror(w, j * 8);
+				}
+
+			}
+
+			return table;
+
+		}();
+
+
+		constexpr u32 loadWord(const u8* data) {
+			return Bits::big(Bits::assemble<u32>(data));
+		}
+
+		constexpr void storeWord(u32 word, u8* data) {
+			Bits::disassemble(Bits::big(word), data);
+		}
+
+		constexpr u32 subWord(u32 w) {
+			return u32(sbox[w >> 24]) << 24 | u32(sbox[(w >> 16) & 0xFF]) << 16 | u32(sbox[(w >> 8) & 0xFF]) << 8 | sbox[w & 0xFF];
+		}
+
+
+		/*
+			Round keys are stored as big-endian column words.
+			The decryption schedule is the one of the equivalent inverse cipher: Reversed, with InvMixColumns applied to all inner round keys.
+		*/
+		template<u32 Rounds>
+		constexpr void expandKey(std::span<const u8> key, u32 (&encryptKeys)[(Rounds + 1) * 4], u32 (&decryptKeys)[(Rounds + 1) * 4]) {
+
+			constexpr u32 KeyWords = Rounds - 6;
+			constexpr u32 Words = (Rounds + 1) * 4;
+
+			for (u32 i = 0; i < KeyWords; i++) {
+				encryptKeys[i] = loadWord(key.data() + i * 4);
+			}
+
+			u8 rcon = 1;
+
+			for (u32 i = KeyWords; i < Words; i++) {
+
+				u32 t = encryptKeys[i - 1];
+
+				if (i % KeyWords == 0) {
+
+					t = subWord(Bits::rol(t, 8)) ^ (u32(rcon) << 24);
+					rcon = gfMultiply(rcon, 2);
+
+				} else if (KeyWords > 6 && i % KeyWords == 4) {
+
+					t = subWord(t);
+
+				}
+
+				encryptKeys[i] = encryptKeys[i - KeyWords] ^ t;
+
+			}
+
+			for (u32 r = 0; r <= Rounds; r++) {
+
+				for (u32 c = 0; c < 4; c++) {
+
+					u32 w = encryptKeys[(Rounds - r) * 4 + c];
+
+					if (r > 0 && r < Rounds) {
+						w = decryptTable[0][sbox[w >> 24]] ^ decryptTable[1][sbox[(w >> 16) & 0xFF]] ^ decryptTable[2][sbox[(w >> 8) & 0xFF]] ^ decryptTable[3][sbox[w & 0xFF]];
+					}
+
+					decryptKeys[r * 4 + c] = w;
+
+				}
+
+			}
+
+		}
+
+
+		template<u32 Rounds>
+		inline void encryptBlock(const u32* keys, const u8* input, u8* output) {
+
+			const auto& t = encryptTable;
+
+			u32 s0 = loadWord(input) ^ keys[0];
+			u32 s1 = loadWord(input + 4) ^ keys[1];
+			u32 s2 = loadWord(input + 8) ^ keys[2];
+			u32 s3 = loadWord(input + 12) ^ keys[3];
+
+			for (u32 r = 1; r < Rounds; r++) {
+
+				const u32* k = keys + r * 4;
+
+				u32 t0 = t[0][s0 >> 24] ^ t[1][(s1 >> 16) & 0xFF] ^ t[2][(s2 >> 8) & 0xFF] ^ t[3][s3 & 0xFF] ^ k[0];
+				u32 t1 = t[0][s1 >> 24] ^ t[1][(s2 >> 16) & 0xFF] ^ t[2][(s3 >> 8) & 0xFF] ^ t[3][s0 & 0xFF] ^ k[1];
+				u32 t2 = t[0][s2 >> 24] ^ t[1][(s3 >> 16) & 0xFF] ^ t[2][(s0 >> 8) & 0xFF] ^ t[3][s1 & 0xFF] ^ k[2];
+				u32 t3 = t[0][s3 >> 24] ^ t[1][(s0 >> 16) & 0xFF] ^ t[2][(s1 >> 8) & 0xFF] ^ t[3][s2 & 0xFF] ^ k[3];
+
+				s0 = t0;
+				s1 = t1;
+				s2 = t2;
+				s3 = t3;
+
+			}
+
+			const u32* k = keys + Rounds * 4;
+
+			storeWord((u32(sbox[s0 >> 24]) << 24 | u32(sbox[(s1 >> 16) & 0xFF]) << 16 | u32(sbox[(s2 >> 8) & 0xFF]) << 8 | sbox[s3 & 0xFF]) ^ k[0], output);
+			storeWord((u32(sbox[s1 >> 24]) << 24 | u32(sbox[(s2 >> 16) & 0xFF]) << 16 | u32(sbox[(s3 >> 8) & 0xFF]) << 8 | sbox[s0 & 0xFF]) ^ k[1], output + 4);
+			storeWord((u32(sbox[s2 >> 24]) << 24 | u32(sbox[(s3 >> 16) & 0xFF]) << 16 | u32(sbox[(s0 >> 8) & 0xFF]) << 8 | sbox[s1 & 0xFF]) ^ k[2], output + 8);
+			storeWord((u32(sbox[s3 >> 24]) << 24 | u32(sbox[(s0 >> 16) & 0xFF]) << 16 | u32(sbox[(s1 >> 8) & 0xFF]) << 8 | sbox[s2 & 0xFF]) ^ k[3], output + 12);
+
+		}
+
+		template<u32 Rounds>
+		inline void decryptBlock(const u32* keys, const u8* input, u8* output) {
+
+			const auto& t = decryptTable;
+			const auto& s = inverseSbox;
+
+			u32 s0 = loadWord(input) ^ keys[0];
+			u32 s1 = loadWord(input + 4) ^ keys[1];
+			u32 s2 = loadWord(input + 8) ^ keys[2];
+			u32 s3 = loadWord(input + 12) ^ keys[3];
+
+			for (u32 r = 1; r < Rounds; r++) {
+
+				const u32* k = keys + r * 4;
+
+				u32 t0 = t[0][s0 >> 24] ^ t[1][(s3 >> 16) & 0xFF] ^ t[2][(s2 >> 8) & 0xFF] ^ t[3][s1 & 0xFF] ^ k[0];
+				u32 t1 = t[0][s1 >> 24] ^ t[1][(s0 >> 16) & 0xFF] ^ t[2][(s3 >> 8) & 0xFF] ^ t[3][s2 & 0xFF] ^ k[1];
+				u32 t2 = t[0][s2 >> 24] ^ t[1][(s1 >> 16) & 0xFF] ^ t[2][(s0 >> 8) & 0xFF] ^ t[3][s3 & 0xFF] ^ k[2];
+				u32 t3 = t[0][s3 >> 24] ^ t[1][(s2 >> 16) & 0xFF] ^ t[2][(s1 >> 8) & 0xFF] ^ t[3][s0 & 0xFF] ^ k[3];
+
+				s0 = t0;
+				s1 = t1;
+				s2 = t2;
+				s3 = t3;
+
+			}
+
+			const u32* k = keys + Rounds * 4;
+
+			storeWord((u32(s[s0 >> 24]) << 24 | u32(s[(s3 >> 16) & 0xFF]) << 16 | u32(s[(s2 >> 8) & 0xFF]) << 8 | s[s1 & 0xFF]) ^ k[0], output);
+			storeWord((u32(s[s1 >> 24]) << 24 | u32(s[(s0 >> 16) & 0xFF]) << 16 | u32(s[(s3 >> 8) & 0xFF]) << 8 | s[s2 & 0xFF]) ^ k[1], output + 4);
+			storeWord((u32(s[s2 >> 24]) << 24 | u32(s[(s1 >> 16) & 0xFF]) << 16 | u32(s[(s0 >> 8) & 0xFF]) << 8 | s[s3 & 0xFF]) ^ k[2], output + 8);
+			storeWord((u32(s[s3 >> 24]) << 24 | u32(s[(s2 >> 16) & 0xFF]) << 16 | u32(s[(s1 >> 8) & 0xFF]) << 8 | s[s0 & 0xFF]) ^ k[3], output + 12);
+
+		}
+
+
+		// Increments the big-endian counter block, GCM only increments the lower 32 bits
+		inline void incrementCounter(u8 (&counter)[16], bool wrap32) {
+
+			SizeT last = wrap32 ? 12 : 0;
+
+			for (SizeT i = 16; i-- > last;) {
+
+				if (++counter[i]) {
+					break;
+				}
+
+			}
+
+		}
+
+		inline void xorBlock(const u8* input, const u8* stream, u8* output, SizeT size) {
+
+			for (SizeT i = 0; i < size; i++) {
+				output[i] = input[i] ^ stream[i];
+			}
+
+		}
+
+
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
+
+		template<u32 Rounds>
+		ARC_TARGET("aes,sse4.1") ARC_FORCE_INLINE void loadKeysAESNI(const u32* keys, __m128i (&rk)[Rounds + 1]) {
+
+			const __m128i swap = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+			for (u32 i = 0; i <= Rounds; i++) {
+				rk[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i * 4)), swap);
+			}
+
+		}
+
+		template<u32 Rounds, bool Decrypt>
+		ARC_TARGET("aes,sse4.1") ARC_FORCE_INLINE __m128i cryptAESNI(__m128i block, const __m128i (&rk)[Rounds + 1]) {
+
+			block = _mm_xor_si128(block, rk[0]);
+
+			for (u32 r = 1; r < Rounds; r++) {
+				block = Decrypt ? _mm_aesdec_si128(block, rk[r]) : _mm_aesenc_si128(block, rk[r]);
+			}
+
+			return Decrypt ? _mm_aesdeclast_si128(block, rk[Rounds]) : _mm_aesenclast_si128(block, rk[Rounds]);
+
+		}
+
+		//Eight independent blocks keep the AES unit's pipeline busy, the packs unroll the lanes into registers
+		constexpr auto LanesAESNI = std::make_index_sequence<8>();
+
+		template<u32 Rounds, bool Decrypt, SizeT... J>
+		ARC_TARGET("aes,sse4.1") ARC_FORCE_INLINE void cryptAESNIx8(__m128i (&b)[8], const __m128i (&rk)[Rounds + 1], std::index_sequence<J...>) {
+
+			((b[J] = _mm_xor_si128(b[J], rk[0])), ...);
+
+			for (u32 r = 1; r < Rounds; r++) {
+				((b[J] = Decrypt ? _mm_aesdec_si128(b[J], rk[r]) : _mm_aesenc_si128(b[J], rk[r])), ...);
+			}
+
+			((b[J] = Decrypt ? _mm_aesdeclast_si128(b[J], rk[Rounds]) : _mm_aesenclast_si128(b[J], rk[Rounds])), ...);
+
+		}
+
+		template<SizeT... J>
+		ARC_TARGET("aes,sse4.1") ARC_FORCE_INLINE void loadAESNIx8(__m128i (&b)[8], const u8* input, std::index_sequence<J...>) {
+			((b[J] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + J * 16))), ...);
+		}
+
+		template<SizeT... J>
+		ARC_TARGET("aes,sse4.1") ARC_FORCE_INLINE void storeAESNIx8(const __m128i (&b)[8], u8* output, std::index_sequence<J...>) {
+			(_mm_storeu_si128(reinterpret_cast<__m128i*>(output + J * 16), b[J]), ...);
+		}
+
+		template<u32 Rounds, bool Decrypt>
+		ARC_TARGET("aes,sse4.1") inline void ecbAESNI(const u32* keys, const u8* input, u8* output, SizeT blocks) {
+
+			__m128i rk[Rounds + 1];
+			loadKeysAESNI<Rounds>(keys, rk);
+
+			SizeT i = 0;
+
+			for (; i + 8 <= blocks; i += 8) {
+
+				__m128i b[8];
+
+				loadAESNIx8(b, input + i * 16, LanesAESNI);
+				cryptAESNIx8<Rounds, Decrypt>(b, rk, LanesAESNI);
+				storeAESNIx8(b, output + i * 16, LanesAESNI);
+
+			}
+
+			for (; i < blocks; i++) {
+
+				__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 16));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 16), cryptAESNI<Rounds, Decrypt>(b, rk));
+
+			}
+
+		}
+
+		//The counter is kept byte-reversed, so that it can be incremented as a little-endian integer
+		template<bool Wrap32>
+		ARC_TARGET("aes,sse4.1") ARC_FORCE_INLINE __m128i nextCounterAESNI(__m128i& counter, __m128i reverse) {
+
+			__m128i block = _mm_shuffle_epi8(counter, reverse);
+
+			if constexpr (Wrap32) {
+
+				counter = _mm_add_epi32(counter, _mm_set_epi32(0, 0, 0, 1));
+
+			} else {
+
+				counter = _mm_add_epi64(counter, _mm_set_epi64x(0, 1));
+
+				if (_mm_testz_si128(counter, _mm_set_epi64x(0, -1))) {
+					counter = _mm_add_epi64(counter, _mm_set_epi64x(1, 0));
+				}
+
+			}
+
+			return block;
+
+		}
+
+		template<bool Wrap32, SizeT... J>
+		ARC_TARGET("aes,sse4.1") ARC_FORCE_INLINE void countersAESNIx8(__m128i (&b)[8], __m128i& counter, __m128i reverse, std::index_sequence<J...>) {
+			((b[J] = nextCounterAESNI<Wrap32>(counter, reverse)), ...);
+		}
+
+		template<SizeT... J>
+		ARC_TARGET("aes,sse4.1") ARC_FORCE_INLINE void xorAESNIx8(__m128i (&b)[8], const u8* input, std::index_sequence<J...>) {
+			((b[J] = _mm_xor_si128(b[J], _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + J * 16)))), ...);
+		}
+
+		template<u32 Rounds, bool Wrap32>
+		ARC_TARGET("aes,sse4.1") inline void ctrAESNI(const u32* keys, u8 (&counter)[16], const u8* input, u8* output, SizeT size) {
+
+			const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+			__m128i rk[Rounds + 1];
+			loadKeysAESNI<Rounds>(keys, rk);
+
+			__m128i ctr = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(counter)), reverse);
+
+			SizeT blocks = size / 16;
+			SizeT i = 0;
+
+			for (; i + 8 <= blocks; i += 8) {
+
+				__m128i b[8];
+
+				countersAESNIx8<Wrap32>(b, ctr, reverse, LanesAESNI);
+				cryptAESNIx8<Rounds, false>(b, rk, LanesAESNI);
+				xorAESNIx8(b, input + i * 16, LanesAESNI);
+				storeAESNIx8(b, output + i * 16, LanesAESNI);
+
+			}
+
+			for (; i < blocks; i++) {
+
+				__m128i b = cryptAESNI<Rounds, false>(nextCounterAESNI<Wrap32>(ctr, reverse), rk);
+				__m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 16));
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 16), _mm_xor_si128(data, b));
+
+			}
+
+			if (size % 16) {
+
+				alignas(16) u8 stream[16];
+				_mm_store_si128(reinterpret_cast<__m128i*>(stream), cryptAESNI<Rounds, false>(nextCounterAESNI<Wrap32>(ctr, reverse), rk));
+
+				xorBlock(input + blocks * 16, stream, output + blocks * 16, size % 16);
+
+			}
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(counter), _mm_shuffle_epi8(ctr, reverse));
+
+		}
+
+
+		/*
+			Carry-less multiplication in GF(2^128) on byte-reversed operands with reduction modulo x^128 + x^7 + x^2 + x + 1.
+			GCM's bit reflection is absorbed by shifting the 256-bit product left by one.
+			Reduction is linear, so products can be accumulated before reducing once.
+		*/
+		ARC_TARGET("pclmul,sse4.1") ARC_FORCE_INLINE void accumulateCLMUL(__m128i a, __m128i b, __m128i& lo, __m128i& mid, __m128i& hi) {
+
+			lo = _mm_xor_si128(lo, _mm_clmulepi64_si128(a, b, 0x00));
+			hi = _mm_xor_si128(hi, _mm_clmulepi64_si128(a, b, 0x11));
+			mid = _mm_xor_si128(mid, _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01)));
+
+		}
+
+		ARC_TARGET("pclmul,sse4.1") ARC_FORCE_INLINE __m128i reduceCLMUL(__m128i lo, __m128i mid, __m128i hi) {
+
+			lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+			hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+			// Shift the product left by one bit
+			__m128i loCarry = _mm_srli_epi32(lo, 31);
+			__m128i hiCarry = _mm_srli_epi32(hi, 31);
+
+			lo = _mm_slli_epi32(lo, 1);
+			hi = _mm_slli_epi32(hi, 1);
+
+			hi = _mm_or_si128(hi, _mm_or_si128(_mm_slli_si128(hiCarry, 4), _mm_srli_si128(loCarry, 12)));
+			lo = _mm_or_si128(lo, _mm_slli_si128(loCarry, 4));
+
+			// Reduction
+			__m128i t = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)), _mm_slli_epi32(lo, 25));
+			lo = _mm_xor_si128(lo, _mm_slli_si128(t, 12));
+
+			__m128i u = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)), _mm_srli_epi32(lo, 7));
+			u = _mm_xor_si128(u, _mm_srli_si128(t, 4));
+
+			return _mm_xor_si128(hi, _mm_xor_si128(lo, u));
+
+		}
+
+		ARC_TARGET("pclmul,sse4.1") ARC_FORCE_INLINE __m128i gfMultiplyCLMUL(__m128i a, __m128i b) {
+
+			__m128i lo = _mm_setzero_si128();
+			__m128i mid = _mm_setzero_si128();
+			__m128i hi = _mm_setzero_si128();
+
+			accumulateCLMUL(a, b, lo, mid, hi);
+
+			return reduceCLMUL(lo, mid, hi);
+
+		}
+
+		//Four blocks are multiplied by H^4 to H^1 and reduced together, which shortens the dependency chain
+		ARC_TARGET("pclmul,sse4.1") inline void ghashCLMUL(u8 (&state)[16], const u8 (&key)[16], const u8* data, SizeT blocks) {
+
+			const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+			__m128i h = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(key)), reverse);
+			__m128i x = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), reverse);
+
+			SizeT i = 0;
+
+			if (blocks >= 4) {
+
+				__m128i h2 = gfMultiplyCLMUL(h, h);
+				__m128i h3 = gfMultiplyCLMUL(h2, h);
+				__m128i h4 = gfMultiplyCLMUL(h3, h);
+
+				for (; i + 4 <= blocks; i += 4) {
+
+					const __m128i* p = reinterpret_cast<const __m128i*>(data + i * 16);
+
+					__m128i lo = _mm_setzero_si128();
+					__m128i mid = _mm_setzero_si128();
+					__m128i hi = _mm_setzero_si128();
+
+					accumulateCLMUL(_mm_xor_si128(x, _mm_shuffle_epi8(_mm_loadu_si128(p), reverse)), h4, lo, mid, hi);
+					accumulateCLMUL(_mm_shuffle_epi8(_mm_loadu_si128(p + 1), reverse), h3, lo, mid, hi);
+					accumulateCLMUL(_mm_shuffle_epi8(_mm_loadu_si128(p + 2), reverse), h2, lo, mid, hi);
+					accumulateCLMUL(_mm_shuffle_epi8(_mm_loadu_si128(p + 3), reverse), h, lo, mid, hi);
+
+					x = reduceCLMUL(lo, mid, hi);
+
+				}
+
+			}
+
+			for (; i < blocks; i++) {
+
+				__m128i b = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16)), reverse);
+				x = gfMultiplyCLMUL(_mm_xor_si128(x, b), h);
+
+			}
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi8(x, reverse));
+
+		}
+
+#elif defined(ARC_CRYPTO_AES_ARMV8)
+
+		template<u32 Rounds>
+		ARC_FORCE_INLINE void loadKeysARMv8(const u32* keys, uint8x16_t (&rk)[Rounds + 1]) {
+
+			for (u32 i = 0; i <= Rounds; i++) {
+				rk[i] = vrev32q_u8(vreinterpretq_u8_u32(vld1q_u32(keys + i * 4)));
+			}
+
+		}
+
+		//AESE/AESD include the round key addition, the last key is applied separately
+		template<u32 Rounds, bool Decrypt>
+		ARC_FORCE_INLINE uint8x16_t cryptARMv8(uint8x16_t block, const uint8x16_t (&rk)[Rounds + 1]) {
+
+			for (u32 r = 0; r < Rounds - 1; r++) {
+				block = Decrypt ? vaesimcq_u8(vaesdq_u8(block, rk[r])) : vaesmcq_u8(vaeseq_u8(block, rk[r]));
+			}
+
+			block = Decrypt ? vaesdq_u8(block, rk[Rounds - 1]) : vaeseq_u8(block, rk[Rounds - 1]);
+
+			return veorq_u8(block, rk[Rounds]);
+
+		}
+
+		template<u32 Rounds, bool Decrypt>
+		inline void ecbARMv8(const u32* keys, const u8* input, u8* output, SizeT blocks) {
+
+			uint8x16_t rk[Rounds + 1];
+			loadKeysARMv8<Rounds>(keys, rk);
+
+			for (SizeT i = 0; i < blocks; i++) {
+				vst1q_u8(output + i * 16, cryptARMv8<Rounds, Decrypt>(vld1q_u8(input + i * 16), rk));
+			}
+
+		}
+
+		template<u32 Rounds>
+		inline void ctrARMv8(const u32* keys, u8 (&counter)[16], bool wrap32, const u8* input, u8* output, SizeT size) {
+
+			uint8x16_t rk[Rounds + 1];
+			loadKeysARMv8<Rounds>(keys, rk);
+
+			SizeT blocks = size / 16;
+
+			for (SizeT i = 0; i < blocks; i++) {
+
+				uint8x16_t b = cryptARMv8<Rounds, false>(vld1q_u8(counter), rk);
+				incrementCounter(counter, wrap32);
+
+				vst1q_u8(output + i * 16, veorq_u8(vld1q_u8(input + i * 16), b));
+
+			}
+
+			if (size % 16) {
+
+				u8 stream[16];
+				vst1q_u8(stream, cryptARMv8<Rounds, false>(vld1q_u8(counter), rk));
+				incrementCounter(counter, wrap32);
+
+				xorBlock(input + blocks * 16, stream, output + blocks * 16, size % 16);
+
+			}
+
+		}
+
+#endif
+
+
+		template<u32 Rounds, bool Decrypt>
+		inline void ecb(const u32* keys, const u8* input, u8* output, SizeT blocks) {
+
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
+
+			arc_intrinsic_aesni (
+				ecbAESNI<Rounds, Decrypt>(keys, input, output, blocks);
+				return;
+			)
+
+#elif defined(ARC_CRYPTO_AES_ARMV8)
+
+			ecbARMv8<Rounds, Decrypt>(keys, input, output, blocks);
+			return;
+
+#endif
+
+			for (SizeT i = 0; i < blocks; i++) {
+
+				if constexpr (Decrypt) {
+					decryptBlock<Rounds>(keys, input + i * 16, output + i * 16);
+				} else {
+					encryptBlock<Rounds>(keys, input + i * 16, output + i * 16);
+				}
+
+			}
+
+		}
+
+		//Processes size bytes and advances counter past every block started
+		template<u32 Rounds>
+		inline void ctr(const u32* keys, u8 (&counter)[16], bool wrap32, const u8* input, u8* output, SizeT size) {
+
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
+
+			arc_intrinsic_aesni (
+
+				if (wrap32) {
+					ctrAESNI<Rounds, true>(keys, counter, input, output, size);
+				} else {
+					ctrAESNI<Rounds, false>(keys, counter, input, output, size);
+				}
+
+				return;
+
+			)
+
+#elif defined(ARC_CRYPTO_AES_ARMV8)
+
+			ctrARMv8<Rounds>(keys, counter, wrap32, input, output, size);
+			return;
+
+#endif
+
+			u8 stream[16];
+
+			for (SizeT i = 0; i < size; i += 16) {
+
+				encryptBlock<Rounds>(keys, counter, stream);
+				incrementCounter(counter, wrap32);
+
+				xorBlock(input + i, stream, output + i, std::min<SizeT>(16, size - i));
+
+			}
+
+		}
+
+
+		/*
+			GHASH key with Shoup's 4-bit multiplication tables for the portable path.
+			Table entry i holds H multiplied by the reflected nibble i.
+		*/
+		struct GHashKey {
+
+			GHashKey() = default;
+
+			explicit GHashKey(const u8 (&key)[16]) {
+
+				std::copy_n(key, 16, h);
+
+				u64 vh = Bits::big(Bits::assemble<u64>(key));
+				u64 vl = Bits::big(Bits::assemble<u64>(key + 8));
+
+				high[8] = vh;
+				low[8] = vl;
+				high[0] = 0;
+				low[0] = 0;
+
+				for (u32 i = 4; i > 0; i >>= 1) {
+
+					u64 t = (vl & 1) * 0xE100000000000000;
+
+					vl = (vh << 63) | (vl >> 1);
+					vh = (vh >> 1) ^ t;
+
+					high[i] = vh;
+					low[i] = vl;
+
+				}
+
+				for (u32 i = 2; i <= 8; i *= 2) {
+
+					for (u32 j = 1; j < i; j++) {
+
+						high[i + j] = high[i] ^ high[j];
+						low[i + j] = low[i] ^ low[j];
+
+					}
+
+				}
+
+			}
+
+			u8 h[16];
+			u64 high[16];
+			u64 low[16];
+
+		};
+
+		inline void ghashMultiply(const GHashKey& key, u8 (&x)[16]) {
+
+			constexpr u16 reduction[16] = {
+				0x0000, 0x1C20, 0x3840, 0x2460, 0x7080, 0x6CA0, 0x48C0, 0x54E0,
+				0xE100, 0xFD20, 0xD940, 0xC560, 0x9180, 0x8DA0, 0xA9C0, 0xB5E0
+			};
+
+			u8 n = x[15] & 0xF;
+			u64 zh = key.high[n];
+			u64 zl = key.low[n];
+
+			for (u32 i = 16; i-- > 0;) {
+
+				u8 lo = x[i] & 0xF;
+				u8 hi = x[i] >> 4;
+
+				if (i != 15) {
+
+					u8 rem = zl & 0xF;
+
+					zl = (zh << 60) | (zl >> 4);
+					zh = (zh >> 4) ^ (u64(reduction[rem]) << 48);
+					zh ^= key.high[lo];
+					zl ^= key.low[lo];
+
+				}
+
+				u8 rem = zl & 0xF;
+
+				zl = (zh << 60) | (zl >> 4);
+				zh = (zh >> 4) ^ (u64(reduction[rem]) << 48);
+				zh ^= key.high[hi];
+				zl ^= key.low[hi];
+
+			}
+
+			Bits::disassemble(Bits::big(zh), x);
+			Bits::disassemble(Bits::big(zl), x + 8);
+
+		}
+
+		//Absorbs data into state, a partial last block is padded with zeros
+		inline void ghash(u8 (&state)[16], const GHashKey& key, const u8* data, SizeT size) {
+
+			SizeT blocks = size / 16;
+			u8 last[16] = {};
+
+			std::copy_n(data + blocks * 16, size % 16, last);
+
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
+
+			arc_intrinsic_pclmulqdq (
+
+				ghashCLMUL(state, key.h, data, blocks);
+
+				if (size % 16) {
+					ghashCLMUL(state, key.h, last, 1);
+				}
+
+				return;
+
+			)
+
+#endif
+
+			for (SizeT i = 0; i < blocks; i++) {
+
+				xorBlock(state, data + i * 16, state, 16);
+				ghashMultiply(key, state);
+
+			}
+
+			if (size % 16) {
+
+				xorBlock(state, last, state, 16);
+				ghashMultiply(key, state);
+
+			}
+
+		}
+
+	}
+
+
+	/*
+		AES block cipher for 128, 192 and 256-bit keys.
+		Uses AES-NI on x86 and the ARMv8 crypto extension where available, and 32-bit T-tables otherwise.
+		The table path is not constant-time and should be avoided where cache timing is observable.
+	*/
+	template<SizeT KeySize> requires (KeySize == 128 || KeySize == 192 || KeySize == 256)
+	class Cipher {
+
+	public:
+
+		constexpr static u32 Rounds = KeySize / 32 + 6;
+		constexpr static SizeT BlockSize = 16;
+		constexpr static SizeT CounterSize = 16;
+
+		using Counter = std::array<u8, CounterSize>;
+
+
+		explicit Cipher(const CryptoKey<KeySize>& key) {
+
+			auto bytes = key.toArray();
+			__Detail::expandKey<Rounds>(bytes, encryptKeys, decryptKeys);
+
+		}
+
+
+		// Encrypts each block independently (ECB), input and output may alias
+		void encryptBlocks(std::span<const u8> input, std::span<u8> output) const {
+
+			arc_assert(input.size() % BlockSize == 0, "Input size must be a multiple of the block size");
+			arc_assert(output.size() >= input.size(), "Output buffer too small");
+
+			__Detail::ecb<Rounds, false>(encryptKeys, input.data(), output.data(), input.size() / BlockSize);
+
+		}
+
+		void decryptBlocks(std::span<const u8> input, std::span<u8> output) const {
+
+			arc_assert(input.size() % BlockSize == 0, "Input size must be a multiple of the block size");
+			arc_assert(output.size() >= input.size(), "Output buffer too small");
+
+			__Detail::ecb<Rounds, true>(decryptKeys, input.data(), output.data(), input.size() / BlockSize);
+
+		}
+
+
+		/*
+			Counter mode: XORs input with the encrypted counter sequence, encryption and decryption are identical.
+			The counter is incremented as a 128-bit big-endian integer. Input and output may alias.
+			Returns the counter following the last block used, so that a multiple of the block size can be continued.
+		*/
+		Counter ctr(std::span<const u8, CounterSize> counter, std::span<const u8> input, std::span<u8> output) const {
+
+			arc_assert(output.size() >= input.size(), "Output buffer too small");
+
+			u8 next[CounterSize];
+			std::copy(counter.begin(), counter.end(), next);
+
+			__Detail::ctr<Rounds>(encryptKeys, next, false, input.data(), output.data(), input.size());
+
+			Counter result;
+			std::copy_n(next, CounterSize, result.begin());
+
+			return result;
+
+		}
+
+	private:
+
+		template<SizeT>
+		friend class GCM;
+
+		u32 encryptKeys[(Rounds + 1) * 4];
+		u32 decryptKeys[(Rounds + 1) * 4];
+
+	};
+
+
+	/*
+		Galois/Counter Mode authenticated encryption (NIST SP 800-38D) with 128-bit tags.
+		Data is processed in chunks so that every chunk is hashed while still in cache.
+		GHASH uses PCLMULQDQ on x86 where available.
+	*/
+	template<SizeT KeySize>
+	class GCM {
+
+	public:
+
+		constexpr static SizeT TagSize = 16;
+
+		using Tag = std::array<u8, TagSize>;
+
+
+		explicit GCM(const CryptoKey<KeySize>& key) : cipher(key) {
+
+			u8 h[16] = {};
+			cipher.encryptBlocks(h, h);
+
+			hashKey = __Detail::GHashKey(h);
+
+		}
+
+
+		/*
+			Encrypts plaintext into ciphertext and returns the authentication tag over aad and ciphertext.
+			Plaintext and ciphertext may alias. An IV must never be reused with the same key, 12 bytes are recommended.
+		*/
+		Tag encrypt(std::span<const u8> iv, std::span<const u8> aad, std::span<const u8> plaintext, std::span<u8> ciphertext) const {
+
+			arc_assert(ciphertext.size() >= plaintext.size(), "Output buffer too small");
+
+			u8 j0[16];
+			initialCounter(iv, j0);
+
+			u8 counter[16];
+			std::copy_n(j0, 16, counter);
+			__Detail::incrementCounter(counter, true);
+
+			u8 state[16] = {};
+			__Detail::ghash(state, hashKey, aad.data(), aad.size());
+
+			for (SizeT i = 0; i < plaintext.size(); i += ChunkSize) {
+
+				SizeT size = std::min(ChunkSize, plaintext.size() - i);
+
+				__Detail::ctr<Cipher<KeySize>::Rounds>(cipher.encryptKeys, counter, true, plaintext.data() + i, ciphertext.data() + i, size);
+				__Detail::ghash(state, hashKey, ciphertext.data() + i, size);
+
+			}
+
+			return finalize(j0, state, aad.size(), plaintext.size());
+
+		}
+
+		/*
+			Decrypts ciphertext into plaintext if tag authenticates aad and ciphertext.
+			Returns false and zeroes plaintext otherwise. Ciphertext and plaintext may alias.
+		*/
+		bool decrypt(std::span<const u8> iv, std::span<const u8> aad, std::span<const u8> ciphertext, std::span<const u8, TagSize> tag, std::span<u8> plaintext) const {
+
+			arc_assert(plaintext.size() >= ciphertext.size(), "Output buffer too small");
+
+			u8 j0[16];
+			initialCounter(iv, j0);
+
+			u8 counter[16];
+			std::copy_n(j0, 16, counter);
+			__Detail::incrementCounter(counter, true);
+
+			u8 state[16] = {};
+			__Detail::ghash(state, hashKey, aad.data(), aad.size());
+
+			for (SizeT i = 0; i < ciphertext.size(); i += ChunkSize) {
+
+				SizeT size = std::min(ChunkSize, ciphertext.size() - i);
+
+				__Detail::ghash(state, hashKey, ciphertext.data() + i, size);
+				__Detail::ctr<Cipher<KeySize>::Rounds>(cipher.encryptKeys, counter, true, ciphertext.data() + i, plaintext.data() + i, size);
+
+			}
+
+			Tag expected = finalize(j0, state, aad.size(), ciphertext.size());
+
+			//Constant-time comparison
+			u8 difference = 0;
+
+			for (SizeT i = 0; i < TagSize; i++) {
+				difference |= expected[i] ^ tag[i];
+			}
+
+			if (difference) {
+
+				std::fill_n(plaintext.begin(), ciphertext.size(), 0);
+				return false;
+
+			}
+
+			return true;
+
+		}
+
+	private:
+
+		constexpr static SizeT ChunkSize = 4096;
+
+
+		void initialCounter(std::span<const u8> iv, u8 (&j0)[16]) const {
+
+			if (iv.size() == 12) {
+
+				std::copy(iv.begin(), iv.end(), j0);
+
+				j0[12] = 0;
+				j0[13] = 0;
+				j0[14] = 0;
+				j0[15] = 1;
+
+				return;
+
+			}
+
+			u8 lengths[16] = {};
+			Bits::disassemble(Bits::big(u64(iv.size()) * 8), lengths + 8);
+
+			std::fill_n(j0, 16, 0);
+
+			__Detail::ghash(j0, hashKey, iv.data(), iv.size());
+			__Detail::ghash(j0, hashKey, lengths, 16);
+
+		}
+
+		Tag finalize(const u8 (&j0)[16], u8 (&state)[16], SizeT aadSize, SizeT size) const {
+
+			u8 lengths[16];
+			Bits::disassemble(Bits::big(u64(aadSize) * 8), lengths);
+			Bits::disassemble(Bits::big(u64(size) * 8), lengths + 8);
+
+			__Detail::ghash(state, hashKey, lengths, 16);
+
+			u8 mask[16];
+			cipher.encryptBlocks(j0, mask);
+
+			Tag tag;
+
+			for (SizeT i = 0; i < TagSize; i++) {
+				tag[i] = state[i] ^ mask[i];
+			}
+
+			return tag;
+
+		}
+
+
+		Cipher<KeySize> cipher;
+		__Detail::GHashKey hashKey;
+
+	};
+
+
+	using Cipher128 = Cipher<128>;
+	using Cipher192 = Cipher<192>;
+	using Cipher256 = Cipher<256>;
+
+	using GCM128 = GCM<128>;
+	using GCM192 = GCM<192>;
+	using GCM256 = GCM<256>;
+
+}
\ No newline at end of file
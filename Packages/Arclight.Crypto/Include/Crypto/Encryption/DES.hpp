@@ -16,6 +16,8 @@
 
 #include <span>
 #include <array>
+#include <vector>
+#include <algorithm>
 
 
 
@@ -139,173 +141,150 @@ namespace DES {
 		};
 
 		
-		constexpr u64 readBlock(const std::span<const u8>& bytes, u64 position) {
+		// Reads a big-endian block, a trailing partial block is padded with zeros
+		constexpr u64 readBlock(const std::span<const u8>& bytes, SizeT position) {
 
-			SizeT remaining = bytes.size() - position;
+			u8 block[8]{};
+			std::copy_n(bytes.data() + position, Math::min<SizeT>(bytes.size() - position, 8), block);
 
-			return Bits::assemble<u64>(bytes.data(), Math::min(remaining, 8));
+			return Bits::big(Bits::assemble<u64>(block));
 
 		}
 
-		constexpr CryptoKey<56> permuteKey(const CryptoKey<64>& key) {
+		// Applies a permutation table, bits are numbered from 1 starting at the most significant bit as in FIPS 46-3
+		template<u32 InBits, u32 OutBits>
+		constexpr u64 permuteBits(u64 in, const u8 (&table)[OutBits]) {
 
-			CryptoKey<56> out;
+			u64 out = 0;
 
-			// Permute and shrink key to 56 bits
-			for (u32 i = 0; i < 56; i++) {
-				out[55 - i] = key[64 - pc1[i]];
+			for (u32 i = 0; i < OutBits; i++) {
+				out |= ((in >> (InBits - table[i])) & 1) << (OutBits - 1 - i);
 			}
 
 			return out;
 
 		}
 
-		template<bool Upper>
-		constexpr u32 splitKey(const CryptoKey<56>& key) {
-			return key.subKey<Upper ? 28 : 0, 28>().bits().template read<u32>(28);
-		}
 
-		constexpr CryptoKey<48> concatKeys(u32 keyL, u32 keyR) {
+		/*
+			IP and FP are bit permutations and therefore linear over XOR.
+			They are tabulated per input byte, turning each permutation into eight lookups.
+		*/
+		template<class F>
+		constexpr auto byteTable(F&& function) {
 
-			// Concatenate two 28-bit key into a 56-bit key
-			CryptoKey<64> key(keyL | u64(keyR) << 28);
-			CryptoKey<48> out;
+			std::array<std::array<u64, 256>, 8> table{};
 
-			// Permute and shrink key to 48 bits
-			for (u32 i = 0; i < 48; i++) {
-				out[47 - i] = key[56 - pc2[i]];
-			}
+			for (u32 i = 0; i < 8; i++) {
 
-			return out;
+				for (u32 v = 0; v < 256; v++) {
+					table[i][v] = function(u64(v) << (i * 8));
+				}
 
-		}
+			}
 
-		constexpr u32 shiftKey(u32 v, u32 n) {
+			return table;
 
-			n = n % 28;
+		}
 
-			u32 r = (1u << 28) - 1;
-			r &= v << n;
-			r |= v >> (28 - n);
+		constexpr auto ipTable = byteTable([](u64 x) { return permuteBits<64, 64>(x, ip); });
+		constexpr auto fpTable = byteTable([](u64 x) { return permuteBits<64, 64>(x, p1); });
 
-			return r;
+		// S box g followed by the P permutation, indexed by the raw 6-bit input
+		constexpr auto spTable = []() {
 
-		}
+			std::array<std::array<u32, 64>, 8> table{};
 
-		template<bool Final>
-		constexpr u64 permuteBlock(u64 block) {
+			for (u32 g = 0; g < 8; g++) {
 
-			// Input block data
-			u8 bData[8];
-			Bits::disassemble(block, bData);
-			auto bBits = BitSpan<64>(bData);
+				for (u32 v = 0; v < 64; v++) {
 
-			// Data calculated from the permutation
-			u8 pData[8]{};
-			auto pBits = BitSpan<64, false>(pData);
+					u32 row = ((v >> 4) & 0x2) | (v & 0x1);
+					u32 col = (v >> 1) & 0xF;
 
-			for (u32 i = 0; i < 64; i++) {
+					table[g][v] = permuteBits<32, 32>(u64(s[g][row * 16 + col]) << (28 - g * 4), p);
 
-				if constexpr (Final) {
-					pBits[63 - i] = bBits[64 - p1[i]];
-				} else {
-					pBits[63 - i] = bBits[64 - ip[i]];
 				}
 
 			}
 
-			return Bits::assemble<u64>(pData);
+			return table;
+
+		}();
 
-		}
 
-		constexpr u8 sBoxIndex(u8 bits) {
+		constexpr u64 permuteBlock(u64 block, const std::array<std::array<u64, 256>, 8>& table) {
 
-			u8 row = (bits >> 1) & 0xF;
-			u8 col = (bits & 0x20) | ((bits << 4) & 0x10);
+			u64 out = 0;
+
+			for (u32 i = 0; i < 8; i++) {
+				out ^= table[i][(block >> (i * 8)) & 0xFF];
+			}
 
-			return row | col;
+			return out;
 
 		}
 
-		constexpr u32 feistel(u32 block, const CryptoKey<48>& key) {
+		constexpr u32 rotateKey(u32 v, u32 n) {
+			return ((v << n) | (v >> (28 - n))) & 0xFFFFFFF;
+		}
 
-			// Input block data
-			u8 bData[4]{};
-			Bits::disassemble(block, bData);
-			auto bBits = BitSpan<32>(bData);
-			
-			// Data calculated from E ^ key
-			u8 eData[6]{};
-			auto eBits = BitSpan<48, false>(eData);
+		/*
+			Generates the 16 round keys, each split into its eight 6-bit S box groups.
+			The expansion of group g consists of the six bits around nibble g of the block, so groups 0, 2, 4, 6 are aligned by
+			a rotation of the block by 5 and groups 1, 3, 5, 7 by a rotation by 9. The key groups are stored at the matching
+			byte offsets, the even groups in the lower and the odd groups in the upper 32 bits.
+		*/
+		constexpr void expandKey(const CryptoKey<64>& key, u64 (&keys)[16]) {
 
-			// Expand the data using the E table and XOR with the key
-			for (u32 i = 0; i < 48; i++) {
-				eBits[i] = bBits[e[i] - 1] ^ key[i];
-			}
+			auto bytes = key.toArray();
 
-			// Data calculated from the S boxes
-			u8 sData[4]{};
-			auto sBits = BitSpan<32, false>(sData);
-			
-			// Calculate a 32-bit value using the S boxes
-			for (u32 i = 0; i < 8; i++) {
-				
-				// Read 6 bits to use as the S box index
-				u8 sIndex = eBits.subspan(i * 6, 6).read<u8>(6);
+			// Permute and shrink key to 56 bits, then split it into two 28-bit halves
+			u64 cd = permuteBits<64, 56>(Bits::big(Bits::assemble<u64>(bytes.data())), pc1);
 
-				// Read 4 bits from the S box
-				u8 s4Bits = s[7 - i][sBoxIndex(sIndex)];
+			u32 c = cd >> 28;
+			u32 d = cd & 0xFFFFFFF;
 
-				// Write the 4 bits to the output block
-				sBits.subspan(i * 4, 4).write(4, s4Bits);
-				
-			}
+			for (u32 r = 0; r < 16; r++) {
 
-			// Data calculated from the P permutation
-			u8 pData[4]{};
-			auto pBits = BitSpan<32, false>(pData);
+				u32 shift = Bool::any(r, 0, 1, 8, 15) ? 1 : 2;
 
-			// Permute the data using the P table
-			for (u32 i = 0; i < 32; i++) {
-				pBits[31 - i] = sBits[32 - p[i]];
-			}
+				c = rotateKey(c, shift);
+				d = rotateKey(d, shift);
 
-			return Bits::assemble<u32>(pData);
+				// Permute the concatenated halves into the final 48-bit key
+				u64 subKey = permuteBits<56, 48>(u64(c) << 28 | d, pc2);
+				u64 groups = 0;
 
-		}
+				for (u32 g = 0; g < 8; g++) {
+					groups |= ((subKey >> (42 - g * 6)) & 0x3F) << ((g & 1) * 32 + (4 - g / 2) % 4 * 8);
+				}
 
-		constexpr void process(bool decrypt, const std::span<const u8>& input, const std::span<u8>& output, const CryptoKey<64>& key) {
+				keys[r] = groups;
 
-			// Permute input key
-			CryptoKey<56> permutedKey = permuteKey(key);
+			}
 
-			// Split 56-bit key into two 28-bit keys
-			u32 keyL = splitKey<0>(permutedKey);
-			u32 keyR = splitKey<1>(permutedKey);
+		}
 
-			// Generate 16 keys
-			CryptoKey<48> keys[16];
+		constexpr u32 feistel(u32 block, u64 key) {
 
-			for (u32 s = 0; s < 16; s++) {
+			u32 a = Bits::rol(block, 5) ^ u32(key);
+			u32 b = Bits::rol(block, 9) ^ u32(key >> 32);
 
-				u8 shift = Bool::any(s, 0, 1, 8, 15) ? 1 : 2;
+			return	spTable[0][a & 0x3F] ^ spTable[2][(a >> 24) & 0x3F] ^ spTable[4][(a >> 16) & 0x3F] ^ spTable[6][(a >> 8) & 0x3F] ^
+					spTable[1][b & 0x3F] ^ spTable[3][(b >> 24) & 0x3F] ^ spTable[5][(b >> 16) & 0x3F] ^ spTable[7][(b >> 8) & 0x3F];
 
-				// Shift the two keys to the left
-				keyL = shiftKey(keyL, shift);
-				keyR = shiftKey(keyR, shift);
+		}
 
-				// Concatenate the two keys and permute the final 48-bit key
-				keys[s] = concatKeys(keyL, keyR);
+		constexpr void process(bool decrypt, const std::span<const u8>& input, const std::span<u8>& output, const CryptoKey<64>& key) {
 
-			}
+			u64 keys[16];
+			expandKey(key, keys);
 
 			for (SizeT p = 0; p < input.size(); p += 8) {
 
-				// Read block from input storage
-				u64 block = readBlock(input, p);
-
-				// Permute block using the IP table
-				block = permuteBlock<0>(block);
+				// Read block from input storage and permute it using the IP table
+				u64 block = permuteBlock(readBlock(input, p), ipTable);
 
 				// Split 64-bit block into two 32-bit blocks
 				u32 blockL = block >> 32;
@@ -314,21 +293,17 @@ namespace DES {
 				for (u32 s = 0; s < 16; s++) {
 
 					u32 prevL = blockL;
-					u32 prevR = blockR;
 
-					blockL = prevR;
-					blockR = prevL ^ feistel(prevR, keys[decrypt ? (15 - s) : s]);
+					blockL = blockR;
+					blockR = prevL ^ feistel(blockR, keys[decrypt ? (15 - s) : s]);
 
 				}
 
-				// Concatenate the two 32-bit blocks into a 64-bit block
-				block = blockL | u64(blockR) << 32;
-
-				// Permute block using the P-1 table
-				block = permuteBlock<1>(block);
+				// Swap the halves and permute the block using the FP table
+				block = permuteBlock(u64(blockR) << 32 | blockL, fpTable);
 
 				// Write block to output storage
-				Bits::disassemble(block, output.data() + p);
+				Bits::disassemble(Bits::big(block), output.data() + p);
 
 			}
 
@@ -585,13 +560,13 @@ namespace TripleDES {
 		std::array<u8, Bits::ceilPowerOf2(Extent, 8)> result{};
 
 		// Decrypt - first stage
-		__Detail::process(1, data, result, key1);
+		__Detail::process(1, data, result, key3);
 
 		// Encrypt - second stage
 		__Detail::process(0, result, result, key2);
 
 		// Decrypt - third stage
-		__Detail::process(1, result, result, key3);
+		__Detail::process(1, result, result, key1);
 
 		return result;
 
@@ -606,13 +581,13 @@ namespace TripleDES {
 		std::vector<u8> result(alignedSize);
 
 		// Decrypt - first stage
-		__Detail::process(1, data, result, key1);
+		__Detail::process(1, data, result, key3);
 
 		// Encrypt - second stage
 		__Detail::process(0, result, result, key2);
 
 		// Decrypt - third stage
-		__Detail::process(1, result, result, key3);
+		__Detail::process(1, result, result, key1);
 
 		return result;
 
@@ -10,11 +10,17 @@
 
 #include "Util/Bits.hpp"
 #include "Common/Types.hpp"
+#include "Common/Intrinsic.hpp"
 
 #include <span>
 #include <algorithm>
 
 
+//ARMv8 SHA instructions cannot be detected at runtime on every OS, they are only used if the target enables them
+#if defined(ARC_PLATFORM_AARCH64) && defined(ARC_INTRINSIC_AVAILABLE) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+	#define ARC_CRYPTO_SHA_ARMV8
+#endif
+
 
 namespace Crypto {
 
@@ -91,4 +97,130 @@ namespace Crypto {
 
 	}
 
+
+	/*
+		Incremental Merkle-Damgard padding for hashes with 64 or 128 byte blocks.
+		Partial blocks are buffered, complete blocks are passed to the compression function in runs,
+		so the span it receives may contain any non-zero multiple of Size bytes.
+		The message length is tracked in bytes, limiting messages to 2^64 - 1 bytes.
+	*/
+	template<SizeT Size> requires (Size == 64 || Size == 128)
+	class MDStream {
+
+	public:
+
+		constexpr static SizeT BlockSize = Size;
+
+
+		constexpr MDStream() noexcept : buffer{}, buffered(0), length(0) {}
+
+		constexpr void reset() noexcept {
+
+			buffered = 0;
+			length = 0;
+
+		}
+
+		template<class Compress>
+		constexpr void update(std::span<const u8> data, Compress&& compress) {
+
+			length += data.size();
+
+			SizeT i = 0;
+
+			//Complete a previously buffered block first
+			if (buffered) {
+
+				i = std::min(Size - buffered, data.size());
+
+				std::copy_n(data.data(), i, buffer + buffered);
+				buffered += i;
+
+				if (buffered < Size) {
+					return;
+				}
+
+				compress(std::span<const u8>(buffer, Size));
+				buffered = 0;
+
+			}
+
+			//Full blocks are compressed in place
+			SizeT run = (data.size() - i) / Size * Size;
+
+			if (run) {
+
+				compress(data.subspan(i, run));
+				i += run;
+
+			}
+
+			buffered = data.size() - i;
+			std::copy_n(data.data() + i, buffered, buffer);
+
+		}
+
+		template<class Compress>
+		constexpr void finalize(ByteOrder order, Compress&& compress) {
+
+			constexpr SizeT LengthSize = Size / 8;
+			constexpr SizeT PadOffset = Size - LengthSize;
+
+			buffer[buffered++] = 0x80;
+
+			//The length field does not fit anymore, pad an additional block
+			if (buffered > PadOffset) {
+
+				std::fill(buffer + buffered, buffer + Size, u8(0));
+				compress(std::span<const u8>(buffer, Size));
+				buffered = 0;
+
+			}
+
+			std::fill(buffer + buffered, buffer + PadOffset, u8(0));
+
+			//Length in bits, the upper 64 bits are only present for 128 byte blocks
+			u64 low = length << 3;
+			u64 high = length >> 61;
+
+			for (SizeT i = 0; i < 8; i++) {
+
+				if (order == ByteOrder::Big) {
+
+					buffer[Size - 1 - i] = u8(low >> (i * 8));
+
+					if constexpr (LengthSize == 16) {
+						buffer[Size - 9 - i] = u8(high >> (i * 8));
+					}
+
+				} else {
+
+					buffer[PadOffset + i] = u8(low >> (i * 8));
+
+					if constexpr (LengthSize == 16) {
+						buffer[PadOffset + 8 + i] = u8(high >> (i * 8));
+					}
+
+				}
+
+			}
+
+			compress(std::span<const u8>(buffer, Size));
+
+			reset();
+
+		}
+
+		constexpr u64 getLength() const noexcept {
+			return length;
+		}
+
+	private:
+
+		u8 buffer[Size];
+		SizeT buffered;
+		u64 length;
+
+	};
+
 }
\ No newline at end of file
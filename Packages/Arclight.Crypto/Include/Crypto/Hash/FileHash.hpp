@@ -0,0 +1,137 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 FileHash.hpp
+ */
+
+#pragma once
+
+#include "Filesystem/BinaryFile.hpp"
+#include "Filesystem/AsyncIO.hpp"
+#include "Math/Math.hpp"
+#include "Common/Types.hpp"
+
+#include <span>
+#include <vector>
+#include <optional>
+
+
+
+namespace CC {
+
+	template<class H>
+	concept StreamHasher = requires (H h, std::span<const u8> data) {
+		typename H::HashType;
+		h.update(data);
+		{ h.finalize() } -> CC::Equal<typename H::HashType>;
+	};
+
+}
+
+
+namespace Crypto {
+
+	constexpr SizeT DefaultFileHashChunkSize = 4 * 1024 * 1024;
+
+
+	/*
+		Hashes the entire file in chunks of chunkSize bytes, memory usage does not depend on the file size.
+		The system is asked to prefetch the following chunk before the current one is hashed.
+		Returns std::nullopt if the file could not be read completely.
+	*/
+	template<CC::StreamHasher H>
+	std::optional<typename H::HashType> hashFile(const BinaryFile& file, SizeT chunkSize = DefaultFileHashChunkSize) {
+
+		arc_assert(chunkSize > 0, "Chunk size cannot be 0");
+
+		u64 size = file.size();
+
+		std::vector<u8> chunk(Math::min<u64>(chunkSize, size));
+		H hasher;
+
+		for (u64 offset = 0; offset < size;) {
+
+			SizeT count = Math::min<u64>(chunkSize, size - offset);
+
+			if (offset + count < size) {
+				file.prefetch(offset + count, Math::min<u64>(chunkSize, size - offset - count));
+			}
+
+			if (file.readAt(offset, {chunk.data(), count}) != count) {
+				return std::nullopt;
+			}
+
+			hasher.update({chunk.data(), count});
+			offset += count;
+
+		}
+
+		return hasher.finalize();
+
+	}
+
+	/*
+		Double-buffered variant, the next chunk is read by the I/O service while the current one is hashed.
+		Returns std::nullopt if the file could not be read completely.
+	*/
+	template<CC::StreamHasher H>
+	std::optional<typename H::HashType> hashFile(const BinaryFile& file, AsyncIO& io, SizeT chunkSize = DefaultFileHashChunkSize) {
+
+		arc_assert(chunkSize > 0, "Chunk size cannot be 0");
+
+		u64 size = file.size();
+		SizeT bufferSize = Math::min<u64>(chunkSize, size);
+
+		std::vector<u8> buffers[2] = { std::vector<u8>(bufferSize), std::vector<u8>(bufferSize) };
+		H hasher;
+
+		auto submit = [&](u64 offset, u32 buffer) {
+			return io.submit(IORequest::read(file, offset, {buffers[buffer].data(), SizeT(Math::min<u64>(chunkSize, size - offset))}));
+		};
+
+		IOHandle pending;
+
+		if (size) {
+			pending = submit(0, 0);
+		}
+
+		for (u64 offset = 0, current = 0; offset < size; current ^= 1) {
+
+			SizeT count = Math::min<u64>(chunkSize, size - offset);
+			IOResult result = pending.wait();
+
+			if (!result.success() || result.transferred != count) {
+				return std::nullopt;
+			}
+
+			offset += count;
+
+			if (offset < size) {
+				pending = submit(offset, current ^ 1);
+			}
+
+			hasher.update({buffers[current].data(), count});
+
+		}
+
+		return hasher.finalize();
+
+	}
+
+	// Returns std::nullopt if the file cannot be opened or read completely
+	template<CC::StreamHasher H>
+	std::optional<typename H::HashType> hashFile(const Path& path, SizeT chunkSize = DefaultFileHashChunkSize) {
+
+		BinaryFile file;
+
+		if (!file.open(path, BinaryFile::In, BinaryFile::Access::Sequential)) {
+			return std::nullopt;
+		}
+
+		return hashFile<H>(file, chunkSize);
+
+	}
+
+}
\ No newline at end of file
@@ -49,7 +49,7 @@ public:
 
 	}
 
-	constexpr bool operator==(const Hash<Size>& other) noexcept {
+	constexpr bool operator==(const Hash<Size>& other) const noexcept {
 
 		bool equal = true;
 
@@ -91,9 +91,12 @@ public:
 	std::string toString(bool upper = false) const noexcept {
 
 		std::string s;
+		s.reserve(Segments * 2);
+
+		String::HexFlags flags = upper ? String::HexFlags::Upper | String::HexFlags::Fill : String::HexFlags::Fill;
 
 		for(SizeT i = 0; i < Segments; i++) {
-			s += String::toHexString(Bits::swap(segments[i]), upper, false);
+			s += String::toHexString(segments[i], flags);
 		}
 
 		return s;
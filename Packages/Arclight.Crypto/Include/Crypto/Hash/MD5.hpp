@@ -146,4 +146,70 @@ namespace MD5 {
 
 	}
 
+
+
+	/*
+		Streaming MD5 hasher, equivalent to hash() over the concatenation of all updates.
+		Only a single block is buffered regardless of the message size.
+	*/
+	class Hasher {
+
+	public:
+
+		using HashType = Hash<128>;
+
+		constexpr static SizeT BlockSize = 64;
+
+
+		constexpr Hasher() noexcept {
+			reset();
+		}
+
+		constexpr void reset() noexcept {
+
+			stream.reset();
+
+			a = 0x67452301;
+			b = 0xEFCDAB89;
+			c = 0x98BADCFE;
+			d = 0x10325476;
+
+		}
+
+		constexpr Hasher& update(std::span<const u8> data) {
+
+			stream.update(data, [this](const std::span<const u8>& blocks) {
+
+				for (SizeT i = 0; i < blocks.size(); i += 64) {
+					__Detail::dispatchBlock(blocks.subspan(i, 64), a, b, c, d);
+				}
+
+			});
+
+			return *this;
+
+		}
+
+		//Returns the hash of all data passed so far and resets the hasher
+		constexpr HashType finalize() {
+
+			stream.finalize(ByteOrder::Little, [this](const std::span<const u8>& block) {
+				__Detail::dispatchBlock(block, a, b, c, d);
+			});
+
+			HashType h(Bits::little32(a), Bits::little32(b), Bits::little32(c), Bits::little32(d));
+			reset();
+
+			return h;
+
+		}
+
+	private:
+
+		Crypto::MDStream<64> stream;
+
+		u32 a, b, c, d;
+
+	};
+
 }
\ No newline at end of file
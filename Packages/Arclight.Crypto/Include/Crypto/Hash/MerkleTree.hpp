@@ -0,0 +1,427 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 MerkleTree.hpp
+ */
+
+#pragma once
+
+#include "SHA2.hpp"
+#include "Filesystem/BinaryFile.hpp"
+#include "Concurrent/JobSystem.hpp"
+#include "Math/Math.hpp"
+#include "Common/Types.hpp"
+
+#include <span>
+#include <atomic>
+#include <vector>
+#include <optional>
+#include <algorithm>
+
+
+
+namespace Crypto {
+
+	constexpr SizeT DefaultMerkleLeafSize = 1024 * 1024;
+
+
+	/*
+		SHA-256 tree hash over fixed-size leaves.
+		Leaves are hashed in parallel on a JobSystem and combined pairwise up to a single root, an unpaired node moves up unchanged.
+		Leaf and node hashes are prefixed with 0x00 and 0x01 respectively, so a leaf can never be mistaken for an inner node.
+		Leaf i covers the bytes [i * leafSize; (i + 1) * leafSize), empty input consists of a single empty leaf.
+
+		All levels are kept: Modified leaves can be rehashed without touching the rest of the input,
+		and two trees are compared without descending into equal subtrees.
+	*/
+	class MerkleTree {
+
+	public:
+
+		using HashType = Hash<256>;
+
+
+		explicit MerkleTree(SizeT leafSize = DefaultMerkleLeafSize) : leafSize(leafSize), size(0), levels{{hashLeaf({})}} {}
+
+		// Restores a tree from a previously stored leaf list
+		MerkleTree(u64 size, SizeT leafSize, std::vector<HashType> leaves, JobSystem& jobSystem = JobSystem::getGlobal()) : leafSize(leafSize), size(size) {
+
+			arc_assert(leafSize > 0, "Leaf size cannot be 0");
+			arc_assert(leaves.size() == leafCount(size, leafSize), "Leaf count does not match the data size");
+
+			levels.emplace_back(std::move(leaves));
+			buildLevels(jobSystem);
+
+		}
+
+
+		static MerkleTree build(std::span<const u8> data, SizeT leafSize = DefaultMerkleLeafSize, JobSystem& jobSystem = JobSystem::getGlobal()) {
+			return *buildFrom(MemorySource{data}, leafSize, jobSystem);
+		}
+
+		// Returns std::nullopt if the file could not be read completely
+		static std::optional<MerkleTree> build(const BinaryFile& file, SizeT leafSize = DefaultMerkleLeafSize, JobSystem& jobSystem = JobSystem::getGlobal()) {
+			return buildFrom(FileSource{file, file.size()}, leafSize, jobSystem);
+		}
+
+
+		/*
+			Rehashes the given leaves from the new contents and updates their paths to the root.
+			If the size changed, the previous last leaf and all leaves past it are rehashed as well.
+		*/
+		void update(std::span<const u8> data, std::span<const SizeT> leaves, JobSystem& jobSystem = JobSystem::getGlobal()) {
+			updateFrom(MemorySource{data}, leaves, jobSystem);
+		}
+
+		// Returns false and leaves the tree unchanged if the file could not be read
+		bool update(const BinaryFile& file, std::span<const SizeT> leaves, JobSystem& jobSystem = JobSystem::getGlobal()) {
+			return updateFrom(FileSource{file, file.size()}, leaves, jobSystem);
+		}
+
+
+		// Rehashes all of data and returns the indices of the leaves that do not match this tree
+		std::vector<SizeT> verify(std::span<const u8> data, JobSystem& jobSystem = JobSystem::getGlobal()) const {
+			return diff(build(data, leafSize, jobSystem));
+		}
+
+		// Returns std::nullopt if the file could not be read completely
+		std::optional<std::vector<SizeT>> verify(const BinaryFile& file, JobSystem& jobSystem = JobSystem::getGlobal()) const {
+
+			std::optional<MerkleTree> tree = build(file, leafSize, jobSystem);
+
+			if (!tree) {
+				return std::nullopt;
+			}
+
+			return diff(*tree);
+
+		}
+
+		// Returns the sorted indices of all leaves that differ, including leaves present in only one of the trees
+		std::vector<SizeT> diff(const MerkleTree& other) const {
+
+			arc_assert(leafSize == other.leafSize, "Cannot compare trees with different leaf sizes");
+
+			std::vector<SizeT> leaves;
+
+			const std::vector<HashType>& a = levels[0];
+			const std::vector<HashType>& b = other.levels[0];
+
+			//Trees of different shape can only be compared leaf by leaf
+			if (a.size() != b.size()) {
+
+				for (SizeT i = 0; i < Math::max(a.size(), b.size()); i++) {
+
+					if (i >= a.size() || i >= b.size() || !(a[i] == b[i])) {
+						leaves.push_back(i);
+					}
+
+				}
+
+				return leaves;
+
+			}
+
+			std::vector<std::pair<SizeT, SizeT>> stack = {{levels.size() - 1, 0}};
+
+			while (!stack.empty()) {
+
+				auto [level, index] = stack.back();
+				stack.pop_back();
+
+				if (levels[level][index] == other.levels[level][index]) {
+					continue;
+				}
+
+				if (level == 0) {
+
+					leaves.push_back(index);
+					continue;
+
+				}
+
+				//Right child first so that leaves are found in ascending order
+				if (index * 2 + 1 < levels[level - 1].size()) {
+					stack.emplace_back(level - 1, index * 2 + 1);
+				}
+
+				stack.emplace_back(level - 1, index * 2);
+
+			}
+
+			return leaves;
+
+		}
+
+
+		HashType getRoot() const noexcept {
+			return levels.back()[0];
+		}
+
+		std::span<const HashType> getLeaves() const noexcept {
+			return levels[0];
+		}
+
+		SizeT getLeafCount() const noexcept {
+			return levels[0].size();
+		}
+
+		SizeT getLeafSize() const noexcept {
+			return leafSize;
+		}
+
+		u64 getSize() const noexcept {
+			return size;
+		}
+
+	private:
+
+		struct MemorySource {
+
+			u64 size() const noexcept {
+				return data.size();
+			}
+
+			std::optional<std::span<const u8>> read(u64 offset, SizeT count, std::vector<u8>&) const noexcept {
+				return data.subspan(offset, count);
+			}
+
+			std::span<const u8> data;
+
+		};
+
+		struct FileSource {
+
+			u64 size() const noexcept {
+				return fileSize;
+			}
+
+			std::optional<std::span<const u8>> read(u64 offset, SizeT count, std::vector<u8>& buffer) const {
+
+				buffer.resize(count);
+
+				if (file.readAt(offset, buffer) != count) {
+					return std::nullopt;
+				}
+
+				return std::span<const u8>(buffer);
+
+			}
+
+			const BinaryFile& file;
+			u64 fileSize;
+
+		};
+
+		//Node levels smaller than this are combined on the calling thread
+		constexpr static SizeT NodeGrainSize = 1024;
+
+
+		MerkleTree(u64 size, SizeT leafSize) : leafSize(leafSize), size(size) {}
+
+
+		constexpr static SizeT leafCount(u64 size, SizeT leafSize) noexcept {
+			return Math::max<u64>((size + leafSize - 1) / leafSize, 1);
+		}
+
+		static HashType hashLeaf(std::span<const u8> data) {
+
+			constexpr u8 prefix[1] = {0x00};
+			return SHA2::Hasher256().update(prefix).update(data).finalize();
+
+		}
+
+		static HashType hashNode(const HashType& left, const HashType& right) {
+
+			u8 data[65];
+
+			auto l = left.toArray();
+			auto r = right.toArray();
+
+			data[0] = 0x01;
+			std::copy(l.begin(), l.end(), data + 1);
+			std::copy(r.begin(), r.end(), data + 33);
+
+			return SHA2::hash256(data);
+
+		}
+
+
+		//Hashes the leaves indices[i] of source in parallel and stores them in hashes[i]
+		template<class Source>
+		static bool hashLeaves(const Source& source, SizeT leafSize, std::span<const SizeT> indices, std::span<HashType> hashes, JobSystem& jobSystem) {
+
+			std::atomic<bool> failed = false;
+
+			jobSystem.parallelFor(SizeT(0), indices.size(), [&](SizeT first, SizeT last) {
+
+				std::vector<u8> buffer;
+
+				for (SizeT i = first; i < last && !failed.load(std::memory_order_relaxed); i++) {
+
+					u64 offset = u64(indices[i]) * leafSize;
+					SizeT count = Math::min<u64>(leafSize, source.size() - offset);
+
+					std::optional<std::span<const u8>> data = source.read(offset, count, buffer);
+
+					if (!data) {
+
+						failed.store(true, std::memory_order_relaxed);
+						return;
+
+					}
+
+					hashes[i] = hashLeaf(*data);
+
+				}
+
+			});
+
+			return !failed.load(std::memory_order_relaxed);
+
+		}
+
+		template<class Source>
+		static std::optional<MerkleTree> buildFrom(const Source& source, SizeT leafSize, JobSystem& jobSystem) {
+
+			arc_assert(leafSize > 0, "Leaf size cannot be 0");
+
+			MerkleTree tree(source.size(), leafSize);
+
+			std::vector<SizeT> indices(leafCount(source.size(), leafSize));
+			std::vector<HashType> leaves(indices.size());
+
+			for (SizeT i = 0; i < indices.size(); i++) {
+				indices[i] = i;
+			}
+
+			if (!hashLeaves(source, leafSize, indices, leaves, jobSystem)) {
+				return std::nullopt;
+			}
+
+			tree.levels.emplace_back(std::move(leaves));
+			tree.buildLevels(jobSystem);
+
+			return tree;
+
+		}
+
+		template<class Source>
+		bool updateFrom(const Source& source, std::span<const SizeT> leaves, JobSystem& jobSystem) {
+
+			const u64 newSize = source.size();
+			const SizeT oldCount = levels[0].size();
+			const SizeT newCount = leafCount(newSize, leafSize);
+
+			std::vector<SizeT> dirty;
+			dirty.reserve(leaves.size());
+
+			for (SizeT leaf : leaves) {
+
+				if (leaf < newCount) {
+					dirty.push_back(leaf);
+				}
+
+			}
+
+			//The previous last leaf may have been partial, everything past it is new
+			if (newSize != size) {
+
+				for (SizeT i = Math::min(oldCount, newCount) - 1; i < newCount; i++) {
+					dirty.push_back(i);
+				}
+
+			}
+
+			std::sort(dirty.begin(), dirty.end());
+			dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+			std::vector<HashType> hashes(dirty.size());
+
+			if (!hashLeaves(source, leafSize, dirty, hashes, jobSystem)) {
+				return false;
+			}
+
+			size = newSize;
+			levels[0].resize(newCount);
+
+			for (SizeT i = 0; i < dirty.size(); i++) {
+				levels[0][dirty[i]] = hashes[i];
+			}
+
+			if (oldCount != newCount) {
+
+				levels.resize(1);
+				buildLevels(jobSystem);
+
+			} else {
+
+				rehashPaths(dirty);
+
+			}
+
+			return true;
+
+		}
+
+
+		HashType combine(SizeT level, SizeT index) const {
+
+			const std::vector<HashType>& below = levels[level - 1];
+
+			if (index * 2 + 1 < below.size()) {
+				return hashNode(below[index * 2], below[index * 2 + 1]);
+			}
+
+			return below[index * 2];
+
+		}
+
+		//Builds all levels above the leaves
+		void buildLevels(JobSystem& jobSystem) {
+
+			while (levels.back().size() > 1) {
+
+				levels.emplace_back((levels.back().size() + 1) / 2);
+
+				SizeT level = levels.size() - 1;
+				std::vector<HashType>& nodes = levels[level];
+
+				jobSystem.parallelFor(SizeT(0), nodes.size(), [&](SizeT i) {
+					nodes[i] = combine(level, i);
+				}, NodeGrainSize);
+
+			}
+
+		}
+
+		//Recomputes the ancestors of the given sorted leaves
+		void rehashPaths(std::vector<SizeT> nodes) {
+
+			for (SizeT level = 1; level < levels.size(); level++) {
+
+				for (SizeT& node : nodes) {
+					node /= 2;
+				}
+
+				nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+				for (SizeT node : nodes) {
+					levels[level][node] = combine(level, node);
+				}
+
+			}
+
+		}
+
+
+		SizeT leafSize;
+		u64 size;
+
+		std::vector<std::vector<HashType>> levels;
+
+	};
+
+}
\ No newline at end of file
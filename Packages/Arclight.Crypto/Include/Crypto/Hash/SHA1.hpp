@@ -11,9 +11,13 @@
 #include "Hash.hpp"
 #include "Common.hpp"
 #include "Util/Bits.hpp"
+#include "Common/Intrinsic.hpp"
+#include "Common/Vendor.hpp"
 
 #include <span>
 
+#include ARC_INTRINSIC_H
+
 
 
 namespace __SHA01Detail {
@@ -104,6 +108,169 @@ namespace __SHA01Detail {
 	}
 
 
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
+
+	//Four rounds of SHA-1 using the SHA extensions, e[G % 2] carries the E term into the next group
+	template<u32 G>
+	ARC_TARGET("sha,sse4.1") ARC_FORCE_INLINE void roundsSHA1SHANI(__m128i& abcd, __m128i (&e)[2], __m128i (&m)[4], const u8* data, __m128i mask) {
+
+		if constexpr (G < 4) {
+			m[G] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + G * 16)), mask);
+		}
+
+		if constexpr (G == 0) {
+			e[0] = _mm_add_epi32(e[0], m[0]);
+		} else {
+			e[G % 2] = _mm_sha1nexte_epu32(e[G % 2], m[G % 4]);
+		}
+
+		e[(G + 1) % 2] = abcd;
+
+		if constexpr (G >= 3 && G <= 18) {
+			m[(G + 1) % 4] = _mm_sha1msg2_epu32(m[(G + 1) % 4], m[G % 4]);
+		}
+
+		abcd = _mm_sha1rnds4_epu32(abcd, e[G % 2], G / 5);
+
+		if constexpr (G >= 1 && G <= 16) {
+			m[(G + 3) % 4] = _mm_sha1msg1_epu32(m[(G + 3) % 4], m[G % 4]);
+		}
+
+		if constexpr (G >= 2 && G <= 17) {
+			m[(G + 2) % 4] = _mm_xor_si128(m[(G + 2) % 4], m[G % 4]);
+		}
+
+		if constexpr (G < 19) {
+			roundsSHA1SHANI<G + 1>(abcd, e, m, data, mask);
+		}
+
+	}
+
+	ARC_TARGET("sha,sse4.1") inline void compressSHA1SHANI(const u8* data, SizeT blocks, u32& a, u32& b, u32& c, u32& d, u32& e) {
+
+		const __m128i mask = _mm_set_epi64x(0x0001020304050607, 0x08090A0B0C0D0E0F);
+
+		__m128i abcd = _mm_set_epi32(a, b, c, d);
+		__m128i e0 = _mm_set_epi32(e, 0, 0, 0);
+
+		for (SizeT i = 0; i < blocks; i++, data += 64) {
+
+			__m128i abcdSave = abcd;
+			__m128i eSave = e0;
+			__m128i es[2] = {e0, e0};
+			__m128i m[4];
+
+			roundsSHA1SHANI<0>(abcd, es, m, data, mask);
+
+			e0 = _mm_sha1nexte_epu32(es[0], eSave);
+			abcd = _mm_add_epi32(abcd, abcdSave);
+
+		}
+
+		a = _mm_extract_epi32(abcd, 3);
+		b = _mm_extract_epi32(abcd, 2);
+		c = _mm_extract_epi32(abcd, 1);
+		d = _mm_extract_epi32(abcd, 0);
+		e = _mm_extract_epi32(e0, 3);
+
+	}
+
+#elif defined(ARC_CRYPTO_SHA_ARMV8)
+
+	template<u32 G>
+	ARC_FORCE_INLINE void roundsSHA1ARMv8(uint32x4_t& abcd, u32& e, uint32x4_t (&m)[4]) {
+
+		constexpr u32 K[4] = {0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6};
+
+		uint32x4_t msg = vaddq_u32(m[G % 4], vdupq_n_u32(K[G / 5]));
+		u32 next = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+
+		if constexpr (G < 5) {
+			abcd = vsha1cq_u32(abcd, e, msg);
+		} else if constexpr (G >= 10 && G < 15) {
+			abcd = vsha1mq_u32(abcd, e, msg);
+		} else {
+			abcd = vsha1pq_u32(abcd, e, msg);
+		}
+
+		e = next;
+
+		if constexpr (G < 16) {
+			m[G % 4] = vsha1su1q_u32(vsha1su0q_u32(m[G % 4], m[(G + 1) % 4], m[(G + 2) % 4]), m[(G + 3) % 4]);
+		}
+
+		if constexpr (G < 19) {
+			roundsSHA1ARMv8<G + 1>(abcd, e, m);
+		}
+
+	}
+
+	inline void compressSHA1ARMv8(const u8* data, SizeT blocks, u32& a, u32& b, u32& c, u32& d, u32& e) {
+
+		const u32 state[4] = {a, b, c, d};
+		uint32x4_t abcd = vld1q_u32(state);
+
+		for (SizeT i = 0; i < blocks; i++, data += 64) {
+
+			uint32x4_t abcdSave = abcd;
+			u32 eSave = e;
+			uint32x4_t m[4];
+
+			for (u32 j = 0; j < 4; j++) {
+				m[j] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + j * 16)));
+			}
+
+			roundsSHA1ARMv8<0>(abcd, e, m);
+
+			abcd = vaddq_u32(abcd, abcdSave);
+			e += eSave;
+
+		}
+
+		a = vgetq_lane_u32(abcd, 0);
+		b = vgetq_lane_u32(abcd, 1);
+		c = vgetq_lane_u32(abcd, 2);
+		d = vgetq_lane_u32(abcd, 3);
+
+	}
+
+#endif
+
+
+	//Compresses a run of complete blocks, SHA-1 uses hardware SHA instructions where available
+	template<bool SHA1>
+	constexpr void compressSHA01(const std::span<const u8>& blocks, u32& a, u32& b, u32& c, u32& d, u32& e) noexcept {
+
+		if constexpr (SHA1) {
+
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
+
+			arc_intrinsic_sha (
+				compressSHA1SHANI(blocks.data(), blocks.size() / 64, a, b, c, d, e);
+				return;
+			)
+
+#elif defined(ARC_CRYPTO_SHA_ARMV8)
+
+			if (!std::is_constant_evaluated()) {
+
+				compressSHA1ARMv8(blocks.data(), blocks.size() / 64, a, b, c, d, e);
+				return;
+
+			}
+
+#endif
+
+		}
+
+		for (SizeT i = 0; i < blocks.size(); i += 64) {
+			dispatchBlockSHA01<SHA1>(blocks.subspan(i, 64), a, b, c, d, e);
+		}
+
+	}
+
+
+
 	template<bool SHA1>
 	constexpr Hash<160> hashSHA01(const std::span<const u8>& data) {
 
@@ -120,24 +287,80 @@ namespace __SHA01Detail {
 		u32 specialBlocks = construct.prevBlockUsed + 1;
 
 		//Hash blocks
-		if (blocks >= specialBlocks) {
-
-			for(SizeT i = 0; i < blocks - specialBlocks; i++) {
-				dispatchBlockSHA01<SHA1>(data.subspan(i * 64, 64), a, b, c, d, e);
-			}
-
+		if (blocks > specialBlocks) {
+			compressSHA01<SHA1>(data.subspan(0, (blocks - specialBlocks) * 64), a, b, c, d, e);
 		}
 
 		if (construct.prevBlockUsed) {
-			dispatchBlockSHA01<SHA1>({construct.prevLastBlock, 64}, a, b, c, d, e);
+			compressSHA01<SHA1>({construct.prevLastBlock, 64}, a, b, c, d, e);
 		}
 
-		dispatchBlockSHA01<SHA1>({construct.lastBlock, 64}, a, b, c, d, e);
+		compressSHA01<SHA1>({construct.lastBlock, 64}, a, b, c, d, e);
 
 		return Hash<160>(Bits::big32(a), Bits::big32(b), Bits::big32(c), Bits::big32(d), Bits::big32(e));
 
 	}
 
+
+
+	template<bool SHA1>
+	class Hasher01 {
+
+	public:
+
+		using HashType = Hash<160>;
+
+		constexpr static SizeT BlockSize = 64;
+
+
+		constexpr Hasher01() noexcept {
+			reset();
+		}
+
+		constexpr void reset() noexcept {
+
+			stream.reset();
+
+			a = 0x67452301;
+			b = 0xEFCDAB89;
+			c = 0x98BADCFE;
+			d = 0x10325476;
+			e = 0xC3D2E1F0;
+
+		}
+
+		constexpr Hasher01& update(std::span<const u8> data) {
+
+			stream.update(data, [this](const std::span<const u8>& blocks) {
+				compressSHA01<SHA1>(blocks, a, b, c, d, e);
+			});
+
+			return *this;
+
+		}
+
+		//Returns the hash of all data passed so far and resets the hasher
+		constexpr HashType finalize() {
+
+			stream.finalize(ByteOrder::Big, [this](const std::span<const u8>& block) {
+				compressSHA01<SHA1>(block, a, b, c, d, e);
+			});
+
+			HashType h(Bits::big32(a), Bits::big32(b), Bits::big32(c), Bits::big32(d), Bits::big32(e));
+			reset();
+
+			return h;
+
+		}
+
+	private:
+
+		Crypto::MDStream<64> stream;
+
+		u32 a, b, c, d, e;
+
+	};
+
 }
 
 
@@ -148,6 +371,9 @@ namespace SHA0 {
 		return __SHA01Detail::hashSHA01<false>(data);
 	}
 
+	//Streaming variant of hash()
+	using Hasher = __SHA01Detail::Hasher01<false>;
+
 }
 
 namespace SHA1 {
@@ -156,4 +382,7 @@ namespace SHA1 {
 		return __SHA01Detail::hashSHA01<true>(data);
 	}
 
+	//Streaming variant of hash()
+	using Hasher = __SHA01Detail::Hasher01<true>;
+
 }
\ No newline at end of file
@@ -13,10 +13,16 @@
 #include "Util/Bits.hpp"
 #include "Util/Bool.hpp"
 #include "Meta/TypeTraits.hpp"
+#include "Common/Intrinsic.hpp"
+#include "Common/Vendor.hpp"
 
 #include <span>
+#include <array>
+#include <vector>
 #include <algorithm>
 
+#include ARC_INTRINSIC_H
+
 
 
 namespace SHA2 {
@@ -142,18 +148,267 @@ namespace SHA2 {
 		}
 
 
-		template<SHA2Variant Variant>
-		constexpr static auto hashSHA2(const std::span<const u8>& data) {
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
 
-			constexpr bool bits64 = is64BitSHA2Variant(Variant);
-			constexpr u32 bytes = bits64 ? 128 : 64;
+		//Four rounds of SHA-256 using the SHA extensions, message groups 4 to 15 are derived in place
+		template<u32 G>
+		ARC_TARGET("sha,sse4.1") ARC_FORCE_INLINE void roundsSHA256SHANI(__m128i& state0, __m128i& state1, __m128i (&m)[4], const u8* data, __m128i mask) {
 
-			using ValueT = TT::Conditional<bits64, u64, u32>;
+			if constexpr (G < 4) {
+				m[G] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + G * 16)), mask);
+			}
 
-			Crypto::MDConstruction<bytes> construct {};
-			Crypto::mdConstruct(construct, data, ByteOrder::Big);
+			__m128i msg = _mm_add_epi32(m[G % 4], _mm_loadu_si128(reinterpret_cast<const __m128i*>(sha2Constants32 + G * 4)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
 
-			ValueT h[8];
+			if constexpr (G >= 3 && G <= 14) {
+
+				__m128i tmp = _mm_alignr_epi8(m[G % 4], m[(G + 3) % 4], 4);
+				m[(G + 1) % 4] = _mm_sha256msg2_epu32(_mm_add_epi32(m[(G + 1) % 4], tmp), m[G % 4]);
+
+			}
+
+			msg = _mm_shuffle_epi32(msg, 0x0E);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+			if constexpr (G >= 1 && G <= 12) {
+				m[(G + 3) % 4] = _mm_sha256msg1_epu32(m[(G + 3) % 4], m[G % 4]);
+			}
+
+			if constexpr (G < 15) {
+				roundsSHA256SHANI<G + 1>(state0, state1, m, data, mask);
+			}
+
+		}
+
+		ARC_TARGET("sha,sse4.1") inline void compressSHA256SHANI(const u8* data, SizeT blocks, u32 h[8]) {
+
+			const __m128i mask = _mm_set_epi64x(0x0C0D0E0F08090A0B, 0x0405060700010203);
+
+			//The rounds operate on ABEF and CDGH
+			__m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h)), 0xB1);
+			__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h + 4)), 0x1B);
+			__m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+
+			state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+			for (SizeT i = 0; i < blocks; i++, data += 64) {
+
+				__m128i save0 = state0;
+				__m128i save1 = state1;
+				__m128i m[4];
+
+				roundsSHA256SHANI<0>(state0, state1, m, data, mask);
+
+				state0 = _mm_add_epi32(state0, save0);
+				state1 = _mm_add_epi32(state1, save1);
+
+			}
+
+			tmp = _mm_shuffle_epi32(state0, 0x1B);
+			state1 = _mm_shuffle_epi32(state1, 0xB1);
+			state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+			state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(h), state0);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(h + 4), state1);
+
+		}
+
+
+		template<u32 N>
+		ARC_TARGET("avx2") ARC_FORCE_INLINE __m256i rorAVX2(__m256i x) {
+			return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N));
+		}
+
+		/*
+			Compresses one block of eight independent SHA-256 streams.
+			state holds the transposed hash states, state[i][j] being word i of stream j.
+		*/
+		ARC_TARGET("avx2") inline void compressSHA256x8AVX2(const u8* const (&blocks)[8], u32 (&state)[8][8]) {
+
+			const __m256i swap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+			__m256i w[16];
+
+			//Transpose the 8x8 word matrices so that each vector holds one word of all streams
+			for (u32 half = 0; half < 2; half++) {
+
+				__m256i r[8], t[8];
+
+				for (u32 i = 0; i < 8; i++) {
+					r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[i] + half * 32));
+				}
+
+				for (u32 i = 0; i < 8; i += 2) {
+
+					t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+					t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+
+				}
+
+				for (u32 i = 0; i < 8; i += 4) {
+
+					r[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+					r[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+					r[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+					r[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+
+				}
+
+				for (u32 i = 0; i < 4; i++) {
+
+					w[half * 8 + i] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r[i], r[i + 4], 0x20), swap);
+					w[half * 8 + i + 4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r[i], r[i + 4], 0x31), swap);
+
+				}
+
+			}
+
+			__m256i h[8];
+
+			for (u32 i = 0; i < 8; i++) {
+				h[i] = _mm256_load_si256(reinterpret_cast<const __m256i*>(state[i]));
+			}
+
+			__m256i a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], k = h[7];
+
+			for (u32 i = 0; i < 64; i++) {
+
+				//Rolling message schedule
+				if (i >= 16) {
+
+					__m256i w15 = w[(i + 1) % 16];
+					__m256i w2 = w[(i + 14) % 16];
+
+					__m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rorAVX2<7>(w15), rorAVX2<18>(w15)), _mm256_srli_epi32(w15, 3));
+					__m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rorAVX2<17>(w2), rorAVX2<19>(w2)), _mm256_srli_epi32(w2, 10));
+
+					w[i % 16] = _mm256_add_epi32(_mm256_add_epi32(w[i % 16], s0), _mm256_add_epi32(w[(i + 9) % 16], s1));
+
+				}
+
+				__m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rorAVX2<6>(e), rorAVX2<11>(e)), rorAVX2<25>(e));
+				__m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+				__m256i t1 = _mm256_add_epi32(_mm256_add_epi32(k, s1), _mm256_add_epi32(ch, _mm256_add_epi32(w[i % 16], _mm256_set1_epi32(sha2Constants32[i]))));
+
+				__m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rorAVX2<2>(a), rorAVX2<13>(a)), rorAVX2<22>(a));
+				__m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+				__m256i t2 = _mm256_add_epi32(s0, maj);
+
+				k = g;
+				g = f;
+				f = e;
+				e = _mm256_add_epi32(d, t1);
+				d = c;
+				c = b;
+				b = a;
+				a = _mm256_add_epi32(t1, t2);
+
+			}
+
+			const __m256i x[8] = {a, b, c, d, e, f, g, k};
+
+			for (u32 i = 0; i < 8; i++) {
+				_mm256_store_si256(reinterpret_cast<__m256i*>(state[i]), _mm256_add_epi32(h[i], x[i]));
+			}
+
+		}
+
+#elif defined(ARC_CRYPTO_SHA_ARMV8)
+
+		template<u32 G>
+		ARC_FORCE_INLINE void roundsSHA256ARMv8(uint32x4_t& state0, uint32x4_t& state1, uint32x4_t (&m)[4]) {
+
+			uint32x4_t msg = vaddq_u32(m[G % 4], vld1q_u32(sha2Constants32 + G * 4));
+
+			if constexpr (G < 12) {
+				m[G % 4] = vsha256su0q_u32(m[G % 4], m[(G + 1) % 4]);
+			}
+
+			uint32x4_t prev = state0;
+
+			state0 = vsha256hq_u32(state0, state1, msg);
+			state1 = vsha256h2q_u32(state1, prev, msg);
+
+			if constexpr (G < 12) {
+				m[G % 4] = vsha256su1q_u32(m[G % 4], m[(G + 2) % 4], m[(G + 3) % 4]);
+			}
+
+			if constexpr (G < 15) {
+				roundsSHA256ARMv8<G + 1>(state0, state1, m);
+			}
+
+		}
+
+		inline void compressSHA256ARMv8(const u8* data, SizeT blocks, u32 h[8]) {
+
+			uint32x4_t state0 = vld1q_u32(h);
+			uint32x4_t state1 = vld1q_u32(h + 4);
+
+			for (SizeT i = 0; i < blocks; i++, data += 64) {
+
+				uint32x4_t save0 = state0;
+				uint32x4_t save1 = state1;
+				uint32x4_t m[4];
+
+				for (u32 j = 0; j < 4; j++) {
+					m[j] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + j * 16)));
+				}
+
+				roundsSHA256ARMv8<0>(state0, state1, m);
+
+				state0 = vaddq_u32(state0, save0);
+				state1 = vaddq_u32(state1, save1);
+
+			}
+
+			vst1q_u32(h, state0);
+			vst1q_u32(h + 4, state1);
+
+		}
+
+#endif
+
+
+		//Compresses a run of complete blocks, SHA-224 and SHA-256 use hardware SHA instructions where available
+		template<SHA2Variant Variant, class ValueT = TT::Conditional<is64BitSHA2Variant(Variant), u64, u32>>
+		constexpr static void compressSHA2(const std::span<const u8>& blocks, ValueT h[8]) {
+
+			constexpr SizeT BlockSize = is64BitSHA2Variant(Variant) ? 128 : 64;
+
+			if constexpr (!is64BitSHA2Variant(Variant)) {
+
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
+
+				arc_intrinsic_sha (
+					compressSHA256SHANI(blocks.data(), blocks.size() / BlockSize, h);
+					return;
+				)
+
+#elif defined(ARC_CRYPTO_SHA_ARMV8)
+
+				if (!std::is_constant_evaluated()) {
+
+					compressSHA256ARMv8(blocks.data(), blocks.size() / BlockSize, h);
+					return;
+
+				}
+
+#endif
+
+			}
+
+			for (SizeT i = 0; i < blocks.size(); i += BlockSize) {
+				dispatchBlockSHA2<Variant>(blocks.subspan(i, BlockSize), h);
+			}
+
+		}
+
+
+
+		template<SHA2Variant Variant, class ValueT = TT::Conditional<is64BitSHA2Variant(Variant), u64, u32>>
+		constexpr static void initializeSHA2(ValueT h[8]) {
 
 			if constexpr (Variant == SHA2Variant::SHA224) {
 
@@ -187,22 +442,10 @@ namespace SHA2 {
 
 			}
 
-			SizeT blocks = construct.blocks;
-			SizeT specialBlocks = construct.prevBlockUsed + 1;
-
-			if (blocks >= specialBlocks) {
-
-				for(SizeT i = 0; i < blocks - specialBlocks; i++) {
-					dispatchBlockSHA2<Variant>(data.subspan(i * bytes, bytes), h);
-				}
-
-			}
-
-			if (construct.prevBlockUsed) {
-				dispatchBlockSHA2<Variant>({construct.prevLastBlock, bytes}, h);
-			}
+		}
 
-			dispatchBlockSHA2<Variant>({construct.lastBlock, bytes}, h);
+		template<SHA2Variant Variant, class ValueT = TT::Conditional<is64BitSHA2Variant(Variant), u64, u32>>
+		constexpr static auto outputSHA2(ValueT h[8]) {
 
 			std::for_each_n(h, 8, [](ValueT& x) {
 				x = Bits::big(x);
@@ -224,6 +467,271 @@ namespace SHA2 {
 
 		}
 
+
+		template<SHA2Variant Variant>
+		constexpr static auto hashSHA2(const std::span<const u8>& data) {
+
+			constexpr bool bits64 = is64BitSHA2Variant(Variant);
+			constexpr u32 bytes = bits64 ? 128 : 64;
+
+			using ValueT = TT::Conditional<bits64, u64, u32>;
+
+			Crypto::MDConstruction<bytes> construct {};
+			Crypto::mdConstruct(construct, data, ByteOrder::Big);
+
+			ValueT h[8];
+			initializeSHA2<Variant>(h);
+
+			SizeT blocks = construct.blocks;
+			SizeT specialBlocks = construct.prevBlockUsed + 1;
+
+			if (blocks > specialBlocks) {
+				compressSHA2<Variant>(data.subspan(0, (blocks - specialBlocks) * bytes), h);
+			}
+
+			if (construct.prevBlockUsed) {
+				compressSHA2<Variant>({construct.prevLastBlock, bytes}, h);
+			}
+
+			compressSHA2<Variant>({construct.lastBlock, bytes}, h);
+
+			return outputSHA2<Variant>(h);
+
+		}
+
+
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
+
+		/*
+			Multi-buffer SHA-256: Up to eight messages are hashed in lockstep, one per AVX2 lane.
+			Lanes that finish pick up the next pending message while idle lanes compress a dummy block.
+			Once no messages are pending and only a few lanes are left, those are finished one by one.
+		*/
+		inline void hashBatchSHA256AVX2(std::span<const std::span<const u8>> messages, std::span<Hash<256>> hashes) {
+
+			constexpr SizeT Lanes = 8;
+			constexpr SizeT DrainLanes = 2;
+
+			struct Lane {
+
+				const u8* data;
+				SizeT blocks;
+				SizeT message;
+				u32 tailBlocks;
+				u32 tailIndex;
+				bool active;
+				u8 tail[128];
+
+			};
+
+			alignas(64) static constexpr u8 Dummy[64] {};
+
+			alignas(32) u32 state[8][Lanes];
+			Lane lanes[Lanes] {};
+
+			SizeT next = 0;
+			SizeT active = 0;
+
+			auto assign = [&](SizeT l, SizeT index) {
+
+				Lane& lane = lanes[l];
+				const std::span<const u8>& message = messages[index];
+
+				SizeT size = message.size();
+				SizeT rem = size % 64;
+
+				lane.data = message.data();
+				lane.blocks = size / 64;
+				lane.message = index;
+				lane.tailBlocks = rem < 56 ? 1 : 2;
+				lane.tailIndex = 0;
+				lane.active = true;
+
+				//Pad the last partial block
+				const SizeT tailSize = lane.tailBlocks * 64;
+				const u64 bits = u64(size) << 3;
+
+				std::copy_n(message.data() + lane.blocks * 64, rem, lane.tail);
+				lane.tail[rem] = 0x80;
+				std::fill(lane.tail + rem + 1, lane.tail + tailSize - 8, u8(0));
+
+				for (u32 i = 0; i < 8; i++) {
+					lane.tail[tailSize - 1 - i] = u8(bits >> (i * 8));
+				}
+
+				u32 h[8];
+				initializeSHA2<SHA2Variant::SHA256>(h);
+
+				for (u32 i = 0; i < 8; i++) {
+					state[i][l] = h[i];
+				}
+
+				active++;
+
+			};
+
+			auto finish = [&](SizeT l) {
+
+				u32 h[8];
+
+				for (u32 i = 0; i < 8; i++) {
+					h[i] = state[i][l];
+				}
+
+				hashes[lanes[l].message] = outputSHA2<SHA2Variant::SHA256>(h);
+				lanes[l].active = false;
+
+				active--;
+
+			};
+
+			while (true) {
+
+				for (SizeT l = 0; l < Lanes && next < messages.size(); l++) {
+
+					if (!lanes[l].active) {
+						assign(l, next++);
+					}
+
+				}
+
+				if (!active) {
+					break;
+				}
+
+				//Running mostly empty lanes is slower than finishing the remaining streams sequentially
+				if (next == messages.size() && active <= DrainLanes) {
+
+					for (SizeT l = 0; l < Lanes; l++) {
+
+						Lane& lane = lanes[l];
+
+						if (!lane.active) {
+							continue;
+						}
+
+						u32 h[8];
+
+						for (u32 i = 0; i < 8; i++) {
+							h[i] = state[i][l];
+						}
+
+						if (lane.blocks) {
+							compressSHA2<SHA2Variant::SHA256>({lane.data, lane.blocks * 64}, h);
+						}
+
+						compressSHA2<SHA2Variant::SHA256>({lane.tail + lane.tailIndex * 64, (lane.tailBlocks - lane.tailIndex) * 64}, h);
+
+						for (u32 i = 0; i < 8; i++) {
+							state[i][l] = h[i];
+						}
+
+						finish(l);
+
+					}
+
+					break;
+
+				}
+
+				const u8* blocks[Lanes];
+
+				for (SizeT l = 0; l < Lanes; l++) {
+
+					Lane& lane = lanes[l];
+
+					if (!lane.active) {
+
+						blocks[l] = Dummy;
+
+					} else if (lane.blocks) {
+
+						blocks[l] = lane.data;
+						lane.data += 64;
+						lane.blocks--;
+
+					} else {
+
+						blocks[l] = lane.tail + lane.tailIndex++ * 64;
+
+					}
+
+				}
+
+				compressSHA256x8AVX2(blocks, state);
+
+				for (SizeT l = 0; l < Lanes; l++) {
+
+					const Lane& lane = lanes[l];
+
+					if (lane.active && !lane.blocks && lane.tailIndex == lane.tailBlocks) {
+						finish(l);
+					}
+
+				}
+
+			}
+
+		}
+
+#endif
+
+
+
+		template<SHA2Variant Variant>
+		class HasherSHA2 {
+
+		public:
+
+			using ValueT = TT::Conditional<is64BitSHA2Variant(Variant), u64, u32>;
+			using HashType = decltype(outputSHA2<Variant>(static_cast<ValueT*>(nullptr)));
+
+			constexpr static SizeT BlockSize = is64BitSHA2Variant(Variant) ? 128 : 64;
+
+
+			constexpr HasherSHA2() noexcept {
+				reset();
+			}
+
+			constexpr void reset() noexcept {
+
+				stream.reset();
+				initializeSHA2<Variant>(h);
+
+			}
+
+			constexpr HasherSHA2& update(std::span<const u8> data) {
+
+				stream.update(data, [this](const std::span<const u8>& blocks) {
+					compressSHA2<Variant>(blocks, h);
+				});
+
+				return *this;
+
+			}
+
+			//Returns the hash of all data passed so far and resets the hasher
+			constexpr HashType finalize() {
+
+				stream.finalize(ByteOrder::Big, [this](const std::span<const u8>& block) {
+					compressSHA2<Variant>(block, h);
+				});
+
+				HashType hash = outputSHA2<Variant>(h);
+				reset();
+
+				return hash;
+
+			}
+
+		private:
+
+			Crypto::MDStream<BlockSize> stream;
+
+			ValueT h[8];
+
+		};
+
 	}
 
 
@@ -236,6 +744,51 @@ namespace SHA2 {
 		return __Detail::hashSHA2<__Detail::SHA2Variant::SHA256>(data);
 	}
 
+
+	/*
+		Hashes every message with SHA-256, storing the hash of messages[i] in hashes[i].
+		Meant for large amounts of small messages: Without SHA extensions, eight messages are hashed at once using AVX2.
+	*/
+	inline void hashBatch256(std::span<const std::span<const u8>> messages, std::span<Hash<256>> hashes) {
+
+		arc_assert(messages.size() == hashes.size(), "Hash count does not match message count");
+
+#if defined(ARC_PLATFORM_X86) && defined(ARC_INTRINSIC_AVAILABLE)
+
+		arc_intrinsic_sha (
+
+			for (SizeT i = 0; i < messages.size(); i++) {
+				hashes[i] = hash256(messages[i]);
+			}
+
+			return;
+
+		)
+
+		arc_intrinsic_avx2 (
+			__Detail::hashBatchSHA256AVX2(messages, hashes);
+			return;
+		)
+
+#endif
+
+		for (SizeT i = 0; i < messages.size(); i++) {
+			hashes[i] = hash256(messages[i]);
+		}
+
+	}
+
+	inline std::vector<Hash<256>> hashBatch256(std::span<const std::span<const u8>> messages) {
+
+		std::vector<Hash<256>> hashes(messages.size());
+		hashBatch256(messages, hashes);
+
+		return hashes;
+
+	}
+
+
+
 	constexpr Hash<384> hash384(const std::span<const u8>& data) {
 		return __Detail::hashSHA2<__Detail::SHA2Variant::SHA384>(data);
 	}
@@ -252,4 +805,13 @@ namespace SHA2 {
 		return __Detail::hashSHA2<__Detail::SHA2Variant::SHA512t256>(data);
 	}
 
+
+	//Streaming variants of the hash functions above
+	using Hasher224 = __Detail::HasherSHA2<__Detail::SHA2Variant::SHA224>;
+	using Hasher256 = __Detail::HasherSHA2<__Detail::SHA2Variant::SHA256>;
+	using Hasher384 = __Detail::HasherSHA2<__Detail::SHA2Variant::SHA384>;
+	using Hasher512 = __Detail::HasherSHA2<__Detail::SHA2Variant::SHA512>;
+	using Hasher512t224 = __Detail::HasherSHA2<__Detail::SHA2Variant::SHA512t224>;
+	using Hasher512t256 = __Detail::HasherSHA2<__Detail::SHA2Variant::SHA512t256>;
+
 }
\ No newline at end of file
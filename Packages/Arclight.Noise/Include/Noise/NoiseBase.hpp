@@ -8,12 +8,16 @@
 
 #pragma once
 
+#include "NoiseLanes.hpp"
 #include "Math/Math.hpp"
 #include "Math/Vector.hpp"
 #include "Meta/Concepts.hpp"
 #include <numeric>
 #include <random>
 #include <array>
+#include <span>
+#include <vector>
+#include <algorithm>
 
 
 enum class NoiseFractal {
@@ -27,7 +31,28 @@ class NoiseBase {
 
 public:
 
-	constexpr NoiseBase() : p(defaultP) {};
+	// Points evaluated per lane group by batch sampling, matching the widest vector unit of the target
+#if defined(__AVX512F__)
+	static constexpr u32 DefaultLanes = 16;
+#elif defined(__AVX__)
+	static constexpr u32 DefaultLanes = 8;
+#else
+	static constexpr u32 DefaultLanes = 4;
+#endif
+
+	template<CC::FloatParam T>
+	static consteval u32 dimension() {
+
+		if constexpr (CC::Float<T>) {
+			return 1;
+		} else {
+			return T::Size;
+		}
+
+	}
+
+
+	NoiseBase() : p(defaultP) {};
 
 
 	inline void permutate(u32 seed) {
@@ -95,19 +120,211 @@ protected:
 
 	}
 
-	template<NoiseFractal Fractal, CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L, CC::Arithmetic P, CC::Invocable<T, A> Func, CC::Float F = TT::ExtractType<T>>
-	static constexpr std::vector<F> fractalSample(Func&& func, std::span<const T> points, std::span<const A> frequencies, u32 octaves, L lacunarity, P persistence) {
+	template<NoiseFractal Fractal, CC::Float F, u32 N>
+	static constexpr NoiseLanes<F, N> applyFractal(NoiseLanes<F, N> sample) {
+
+		if constexpr (Fractal != NoiseFractal::Standard) {
+
+			sample = 1 - abs(sample);
+
+			if constexpr (Fractal == NoiseFractal::RidgedSq) {
+				sample *= sample;
+			}
+
+			sample = sample * 2 - 1;
+		}
+
+		return sample;
+
+	}
+
+	template<NoiseFractal Fractal, CC::Float F, SizeT D, u32 N, CC::Arithmetic A, CC::Arithmetic L, CC::Arithmetic P, class Func>
+	static constexpr NoiseLanes<F, N> fractalSample(Func&& func, const NoiseLanePoint<F, D, N>& point, NoiseLanes<A, N> frequency, u32 octaves, L lacunarity, P persistence) {
+
+		using Lanes = NoiseLanes<F, N>;
+
+		if (octaves == 1) {
+			return func(point, frequency);
+		}
+
+		Lanes scale = 1;
+		Lanes noise = 0;
+		Lanes range = 0;
+
+		for (u32 i = 0; i < octaves; i++) {
+
+			Lanes sample = func(point, frequency);
+
+			noise += sample * scale;
+
+			range += scale;
+
+			frequency = NoiseLanes<A, N>::generate([&](u32 j) constexpr {
+				A f = frequency[j];
+				return f *= lacunarity;
+			});
+
+			if constexpr (Fractal == NoiseFractal::Standard) {
+				scale *= F(persistence);
+			} else {
+				scale *= 1 - abs(sample);
+				scale *= F(0.5);
+			}
+		}
+
+		return noise / range;
+
+	}
+
+	/*
+		Evaluates all samples in groups of N lanes.
+		load(point, frequency, lane, index) fills a single lane and is invoked for ascending indices only,
+		the last group is padded by repeating its final point.
+	*/
+	template<NoiseFractal Fractal, u32 N, SizeT D, CC::Float F, CC::Arithmetic A, CC::Arithmetic L, CC::Arithmetic P, class Func, class Load>
+	static constexpr void batchSample(Func&& func, Load&& load, std::span<F> samples, u32 octaves, L lacunarity, P persistence) {
 
 		arc_assert(octaves >= 1, "Octaves count cannot be 0");
+
+		NoiseLanePoint<F, D, N> point;
+		NoiseLanes<A, N> frequency;
+
+		const SizeT count = samples.size();
+
+		for (SizeT start = 0; start < count; start += N) {
+
+			const u32 lanes = Math::min(count - start, SizeT(N));
+
+			for (u32 i = 0; i < lanes; i++) {
+				load(point, frequency, i, start + i);
+			}
+
+			for (u32 i = lanes; i < N; i++) {
+
+				for (u32 d = 0; d < D; d++) {
+					point[d][i] = point[d][lanes - 1];
+				}
+
+				frequency[i] = frequency[lanes - 1];
+
+			}
+
+			NoiseLanes<F, N> result = fractalSample<Fractal>(func, point, frequency, octaves, lacunarity, persistence);
+
+			std::copy_n(result.v, lanes, samples.data() + start);
+
+		}
+
+	}
+
+	template<NoiseFractal Fractal, u32 N, CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L, CC::Arithmetic P, class Func, CC::Float F = TT::ExtractType<T>>
+	static constexpr void fractalSample(Func&& func, std::span<const T> points, std::span<const A> frequencies, std::span<F> samples, u32 octaves, L lacunarity, P persistence) {
+
 		arc_assert(points.size() == frequencies.size(), "The amount of points need to match the amount of frequencies");
+		arc_assert(points.size() == samples.size(), "The amount of points need to match the amount of samples");
 
-		if (octaves == 1) {
-			return func(points, frequencies);
+		auto load = [&](auto& point, auto& frequency, u32 lane, SizeT index) constexpr {
+
+			storeLane(point, lane, points[index]);
+			frequency[lane] = frequencies[index];
+
+		};
+
+		batchSample<Fractal, N, dimension<T>(), F, A>(func, load, samples, octaves, lacunarity, persistence);
+
+	}
+
+	template<NoiseFractal Fractal, u32 N, CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L, CC::Arithmetic P, class Func, CC::Float F = TT::ExtractType<T>>
+	static constexpr void fractalSample(Func&& func, std::span<const T> points, A frequency, std::span<F> samples, u32 octaves, L lacunarity, P persistence) {
+
+		arc_assert(points.size() == samples.size(), "The amount of points need to match the amount of samples");
+
+		auto load = [&](auto& point, auto& frequencies, u32 lane, SizeT index) constexpr {
+
+			storeLane(point, lane, points[index]);
+			frequencies[lane] = frequency;
+
+		};
+
+		batchSample<Fractal, N, dimension<T>(), F, A>(func, load, samples, octaves, lacunarity, persistence);
+
+	}
+
+	// Samples origin + step * index for every grid index, the first axis varies fastest
+	template<NoiseFractal Fractal, u32 N, CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L, CC::Arithmetic P, class Func, CC::Float F = TT::ExtractType<T>>
+	static constexpr void fractalSampleGrid(Func&& func, const T& origin, const T& step, const std::array<u32, dimension<T>()>& counts, A frequency, std::span<F> samples, u32 octaves, L lacunarity, P persistence) {
+
+		constexpr u32 D = dimension<T>();
+
+		SizeT total = 1;
+
+		for (u32 count : counts) {
+			total *= count;
+		}
+
+		arc_assert(samples.size() == total, "The amount of samples needs to match the grid size");
+
+		std::array<u32, D> index {};
+
+		auto load = [&](auto& point, auto& frequencies, u32 lane, SizeT) constexpr {
+
+			for (u32 d = 0; d < D; d++) {
+				point[d][lane] = coordinate(origin, d) + coordinate(step, d) * index[d];
+			}
+
+			frequencies[lane] = frequency;
+
+			for (u32 d = 0; d < D; d++) {
+
+				if (++index[d] < counts[d]) {
+					break;
+				}
+
+				index[d] = 0;
+
+			}
+
+		};
+
+		batchSample<Fractal, N, D, F, A>(func, load, samples, octaves, lacunarity, persistence);
+
+	}
+
+	template<NoiseFractal Fractal, CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L, CC::Arithmetic P, class Func, CC::Float F = TT::ExtractType<T>>
+	static constexpr std::vector<F> fractalSample(Func&& func, std::span<const T> points, std::span<const A> frequencies, u32 octaves, L lacunarity, P persistence) {
+
+		std::vector<F> samples(points.size());
+
+		fractalSample<Fractal, DefaultLanes>(func, points, frequencies, std::span<F>(samples), octaves, lacunarity, persistence);
+
+		return samples;
+
+	}
+
+
+	// Multiplies in the common type before narrowing, matching the scalar overloads
+	template<CC::Float F, CC::Arithmetic A, u32 N>
+	static constexpr NoiseLanes<F, N> applyFrequency(const NoiseLanes<F, N>& x, const NoiseLanes<A, N>& frequency) {
+		return NoiseLanes<F, N>::generate([&](u32 i) constexpr { return F(x[i] * frequency[i]); });
+	}
+
+	template<CC::FloatParam T>
+	static constexpr TT::ExtractType<T> coordinate(const T& point, u32 d) {
+
+		if constexpr (CC::Float<T>) {
+			return point;
+		} else {
+			return point[d];
 		}
 
-		arc_force_assert("Fractal span sampling not yet supported");
+	}
+
+	template<CC::Float F, SizeT D, u32 N, CC::FloatParam T>
+	static constexpr void storeLane(NoiseLanePoint<F, D, N>& lanes, u32 lane, const T& point) {
 
-		return {};
+		for (u32 d = 0; d < D; d++) {
+			lanes[d][lane] = coordinate(point, d);
+		}
 
 	}
 
@@ -186,6 +403,89 @@ protected:
 		return p[hash(x, y, z) + w];
 	}
 
+
+	template<CC::Integer I, u32 N>
+	static constexpr NoiseLanes<u32, N> hashIndex(const NoiseLanes<I, N>& ip) {
+		return NoiseLanes<u32, N>::from(ip & I(hashMask));
+	}
+
+	template<u32 N>
+	constexpr NoiseLanes<u32, N> hash(const NoiseLanes<u32, N>& x) const {
+		return gatherLanes(p.data(), x);
+	}
+
+	// Hashes each lane's coordinates in order, equivalent to the scalar hash() overloads
+	template<SizeT D, u32 N>
+	constexpr NoiseLanes<u32, N> hash(const std::array<NoiseLanes<u32, N>, D>& h) const {
+
+		NoiseLanes<u32, N> x = hash(h[0]);
+
+		for (u32 d = 1; d < D; d++) {
+			x = hash(x + h[d]);
+		}
+
+		return x;
+
+	}
+
+
+	// Gradient tables split into one array per component for gathering
+	template<CC::Float F, SizeT D>
+	static constexpr auto gradientTable = []() constexpr {
+
+		constexpr u32 Count = D == 1 ? grad1DMask + 1 : D == 2 ? grad2DMask + 1 : D == 3 ? grad3DMask + 1 : grad4DMask + 1;
+
+		std::array<std::array<F, Count>, D> table {};
+
+		for (u32 i = 0; i < Count; i++) {
+
+			if constexpr (D == 1) {
+
+				table[0][i] = gradient1D<F>[i];
+
+			} else {
+
+				const auto& g = [&]() constexpr -> const auto& {
+
+					if constexpr (D == 2) {
+						return gradient2D<Vec2<F>>[i];
+					} else if constexpr (D == 3) {
+						return gradient3D<Vec3<F>>[i];
+					} else {
+						return gradient4D<Vec4<F>>[i];
+					}
+
+				}();
+
+				for (u32 d = 0; d < D; d++) {
+					table[d][i] = g[d];
+				}
+
+			}
+
+		}
+
+		return table;
+
+	}();
+
+	// Gathers the gradient components selected by the hashed lanes
+	template<CC::Float F, SizeT D, u32 N>
+	static constexpr NoiseLanePoint<F, D, N> gradient(const NoiseLanes<u32, N>& h) {
+
+		constexpr u32 Count = gradientTable<F, D>[0].size();
+
+		NoiseLanes<u32, N> index = h & (Count - 1);
+		NoiseLanePoint<F, D, N> g;
+
+		for (u32 d = 0; d < D; d++) {
+			g[d] = lookupLanes<Count>(gradientTable<F, D>[d].data(), index);
+		}
+
+		return g;
+
+	}
+
 private:
 
 	using PermutationT = std::array<u32, 512>;
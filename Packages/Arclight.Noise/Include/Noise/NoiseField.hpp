@@ -0,0 +1,372 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 NoiseField.hpp
+ */
+
+#pragma once
+
+#include "NoiseMix.hpp"
+#include "Concurrent/JobSystem.hpp"
+
+#include <list>
+#include <mutex>
+#include <memory>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+
+
+/*
+ *	Fills 2D and 3D sample arrays from a NoiseMix.
+ *	The lattice is split into cubic tiles which are generated in parallel on a JobSystem and kept in an LRU cache,
+ *	so overlapping requests and revisited regions only copy already generated samples.
+ *	Tiles are keyed by seed, tile coordinate and parameters. Sample i along an axis lies at (origin + i) * spacing.
+ *
+ *	fill() may be called from multiple threads concurrently, setSeed() must not overlap with any fill() call.
+ */
+template<CC::Float F, u32 D, CC::NoiseType... Types> requires (D == 2 || D == 3)
+class NoiseField {
+
+public:
+
+	using Mix = NoiseMix<Types...>;
+	using Point = std::conditional_t<D == 2, Vec2<F>, Vec3<F>>;
+	using Coordinate = std::array<i64, D>;
+	using Extent = std::array<u32, D>;
+
+	static constexpr u32 TypesCount = Mix::TypesCount;
+	static constexpr u32 DefaultTileSize = D == 2 ? 64 : 16;
+	static constexpr SizeT DefaultCapacity = 256;
+
+
+	struct Parameters {
+
+		constexpr bool operator==(const Parameters& other) const = default;
+
+		F frequency = 1;
+		F spacing = 1;
+		u32 octaves = 1;
+		F lacunarity = 2;
+		F persistence = 0.5;
+
+		// If set, generators are combined with contribution weighting instead of averaged
+		bool weighted = false;
+		F contribution[TypesCount - 1] {};
+
+	};
+
+
+	explicit NoiseField(u32 seed, u32 tileSize = DefaultTileSize, SizeT capacity = DefaultCapacity, JobSystem& jobSystem = JobSystem::getGlobal()) :
+		tileSize(tileSize), capacity(capacity), jobSystem(jobSystem) {
+
+		arc_assert(tileSize > 0, "Tile size cannot be 0");
+
+		setSeed(seed);
+
+	}
+
+
+	void setSeed(u32 seed) {
+
+		this->seed = seed;
+
+		[&]<SizeT... I>(std::index_sequence<I...>) {
+			(mix.template permutate<I>(seed + u32(I) * 0x9E3779B9), ...);
+		}(std::make_index_sequence<TypesCount>{});
+
+	}
+
+	u32 getSeed() const noexcept {
+		return seed;
+	}
+
+
+	// Fills samples with the region [origin; origin + extent), the first axis varies fastest
+	void fill(std::span<F> samples, const Coordinate& origin, const Extent& extent, const Parameters& parameters) {
+
+		SizeT total = 1;
+
+		for (u32 count : extent) {
+			total *= count;
+		}
+
+		arc_assert(samples.size() == total, "The amount of samples needs to match the region size");
+
+		if (!total) {
+			return;
+		}
+
+		Coordinate first, last;
+
+		for (u32 d = 0; d < D; d++) {
+			first[d] = floorDiv(origin[d]);
+			last[d] = floorDiv(origin[d] + extent[d] - 1);
+		}
+
+		std::vector<TileKey> keys;
+		Coordinate tile = first;
+
+		while (true) {
+
+			keys.push_back({seed, tile, parameters});
+
+			u32 d = 0;
+
+			for (; d < D; d++) {
+
+				if (++tile[d] <= last[d]) {
+					break;
+				}
+
+				tile[d] = first[d];
+
+			}
+
+			if (d == D) {
+				break;
+			}
+
+		}
+
+		std::vector<TileData> tiles(keys.size());
+		std::vector<u32> missing;
+
+		{
+			std::lock_guard lock(mutex);
+
+			for (u32 i = 0; i < keys.size(); i++) {
+
+				auto it = index.find(keys[i]);
+
+				if (it != index.end()) {
+
+					entries.splice(entries.begin(), entries, it->second);
+					tiles[i] = it->second->second;
+
+				} else {
+
+					missing.push_back(i);
+
+				}
+
+			}
+		}
+
+		jobSystem.parallelFor(SizeT(0), missing.size(), [&](SizeT i) {
+			tiles[missing[i]] = generate(keys[missing[i]]);
+		}, 1);
+
+		if (!missing.empty()) {
+
+			std::lock_guard lock(mutex);
+
+			for (u32 i : missing) {
+				insert(keys[i], tiles[i]);
+			}
+
+		}
+
+		for (u32 i = 0; i < keys.size(); i++) {
+			copyTile(samples, origin, extent, keys[i].tile, *tiles[i]);
+		}
+
+	}
+
+	std::vector<F> fill(const Coordinate& origin, const Extent& extent, const Parameters& parameters) {
+
+		SizeT total = 1;
+
+		for (u32 count : extent) {
+			total *= count;
+		}
+
+		std::vector<F> samples(total);
+		fill(samples, origin, extent, parameters);
+
+		return samples;
+
+	}
+
+
+	void clearCache() {
+
+		std::lock_guard lock(mutex);
+
+		index.clear();
+		entries.clear();
+
+	}
+
+	SizeT getCachedTileCount() const {
+
+		std::lock_guard lock(mutex);
+		return entries.size();
+
+	}
+
+	constexpr u32 getTileSize() const noexcept {
+		return tileSize;
+	}
+
+private:
+
+	using TileData = std::shared_ptr<const std::vector<F>>;
+
+	struct TileKey {
+
+		constexpr bool operator==(const TileKey& other) const = default;
+
+		u32 seed;
+		Coordinate tile;
+		Parameters parameters;
+
+	};
+
+	struct TileKeyHash {
+
+		SizeT operator()(const TileKey& key) const noexcept {
+
+			SizeT hash = std::hash<u32>{}(key.seed);
+
+			auto combine = [&](const auto& value) {
+				hash ^= std::hash<TT::RemoveCVRef<decltype(value)>>{}(value) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+			};
+
+			for (i64 c : key.tile) {
+				combine(c);
+			}
+
+			const Parameters& p = key.parameters;
+
+			combine(p.frequency);
+			combine(p.spacing);
+			combine(p.octaves);
+			combine(p.lacunarity);
+			combine(p.persistence);
+			combine(p.weighted);
+
+			for (F c : p.contribution) {
+				combine(c);
+			}
+
+			return hash;
+
+		}
+
+	};
+
+	using Entry = std::pair<TileKey, TileData>;
+
+
+	constexpr i64 floorDiv(i64 x) const noexcept {
+		return (x >= 0 ? x : x - i64(tileSize) + 1) / i64(tileSize);
+	}
+
+	TileData generate(const TileKey& key) const {
+
+		const Parameters& p = key.parameters;
+
+		Point origin, step;
+		Extent counts;
+
+		for (u32 d = 0; d < D; d++) {
+			origin[d] = F(key.tile[d] * i64(tileSize) * p.spacing);
+			step[d] = p.spacing;
+			counts[d] = tileSize;
+		}
+
+		SizeT total = 1;
+
+		for (u32 d = 0; d < D; d++) {
+			total *= tileSize;
+		}
+
+		auto tile = std::make_shared<std::vector<F>>(total);
+
+		if (p.weighted) {
+			mix.sampleGrid(p.contribution, origin, step, counts, p.frequency, std::span<F>(*tile), p.octaves, p.lacunarity, p.persistence);
+		} else {
+			mix.sampleGrid(origin, step, counts, p.frequency, std::span<F>(*tile), p.octaves, p.lacunarity, p.persistence);
+		}
+
+		return tile;
+
+	}
+
+	void insert(const TileKey& key, const TileData& tile) {
+
+		// Another fill may have generated the same tile in the meantime
+		if (index.contains(key)) {
+			return;
+		}
+
+		entries.emplace_front(key, tile);
+		index.emplace(key, entries.begin());
+
+		while (entries.size() > capacity) {
+
+			index.erase(entries.back().first);
+			entries.pop_back();
+
+		}
+
+	}
+
+	// Copies the intersection of a tile with the requested region row by row
+	void copyTile(std::span<F> samples, const Coordinate& origin, const Extent& extent, const Coordinate& tile, const std::vector<F>& data) const {
+
+		Coordinate begin, end;
+
+		for (u32 d = 0; d < D; d++) {
+
+			i64 tileBegin = tile[d] * i64(tileSize);
+
+			begin[d] = Math::max(origin[d], tileBegin);
+			end[d] = Math::min(origin[d] + i64(extent[d]), tileBegin + i64(tileSize));
+
+		}
+
+		const SizeT rowLength = end[0] - begin[0];
+		const u32 layers = D == 3 ? u32(end[2] - begin[2]) : 1;
+
+		for (u32 z = 0; z < layers; z++) {
+
+			for (i64 y = begin[1]; y < end[1]; y++) {
+
+				SizeT source = (y - tile[1] * tileSize) * tileSize + (begin[0] - tile[0] * tileSize);
+				SizeT target = (y - origin[1]) * extent[0] + (begin[0] - origin[0]);
+
+				if constexpr (D == 3) {
+
+					i64 zi = begin[2] + z;
+
+					source += SizeT(zi - tile[2] * tileSize) * tileSize * tileSize;
+					target += SizeT(zi - origin[2]) * extent[0] * extent[1];
+
+				}
+
+				std::memcpy(samples.data() + target, data.data() + source, rowLength * sizeof(F));
+
+			}
+
+		}
+
+	}
+
+
+	Mix mix;
+	u32 seed;
+
+	const u32 tileSize;
+	const SizeT capacity;
+	JobSystem& jobSystem;
+
+	mutable std::mutex mutex;
+	std::list<Entry> entries;
+	std::unordered_map<TileKey, typename std::list<Entry>::iterator, TileKeyHash> index;
+
+};
\ No newline at end of file
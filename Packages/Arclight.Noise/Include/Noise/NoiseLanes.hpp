@@ -0,0 +1,216 @@
+/*
+ *	 Copyright (c) 2024 - Arclight Team
+ *
+ *	 This file is part of Arclight. All rights reserved.
+ *
+ *	 NoiseLanes.hpp
+ */
+
+#pragma once
+
+#include "Math/Math.hpp"
+#include "Meta/Concepts.hpp"
+#include "Common/Intrinsic.hpp"
+
+#include <array>
+#include <type_traits>
+
+#include ARC_INTRINSIC_H
+
+
+/*
+ *	Lane group used by batch noise evaluation.
+ *	Every operation is a branch-free loop over all lanes so that the compiler maps it onto vector registers,
+ *	selecting vector instructions of the target without explicit intrinsics.
+ */
+template<CC::Arithmetic T, u32 N> requires (N == 4 || N == 8 || N == 16)
+struct NoiseLanes {
+
+	using Type = T;
+
+	static constexpr u32 Size = N;
+
+
+	constexpr NoiseLanes() noexcept = default;
+
+	constexpr NoiseLanes(T value) noexcept {
+
+		for (u32 i = 0; i < N; i++) {
+			v[i] = value;
+		}
+
+	}
+
+
+	template<class Func>
+	static constexpr NoiseLanes generate(Func&& func) {
+
+		NoiseLanes lanes;
+
+		for (u32 i = 0; i < N; i++) {
+			lanes.v[i] = func(i);
+		}
+
+		return lanes;
+
+	}
+
+	template<CC::Arithmetic U>
+	static constexpr NoiseLanes from(const NoiseLanes<U, N>& lanes) noexcept {
+		return generate([&](u32 i) constexpr { return T(lanes[i]); });
+	}
+
+
+	constexpr T& operator[](u32 i) noexcept {
+		return v[i];
+	}
+
+	constexpr const T& operator[](u32 i) const noexcept {
+		return v[i];
+	}
+
+
+	constexpr NoiseLanes operator-() const noexcept {
+		return generate([&](u32 i) constexpr { return -v[i]; });
+	}
+
+	constexpr NoiseLanes& operator+=(const NoiseLanes& other) noexcept {
+		return *this = *this + other;
+	}
+
+	constexpr NoiseLanes& operator-=(const NoiseLanes& other) noexcept {
+		return *this = *this - other;
+	}
+
+	constexpr NoiseLanes& operator*=(const NoiseLanes& other) noexcept {
+		return *this = *this * other;
+	}
+
+
+	friend constexpr NoiseLanes operator+(const NoiseLanes& a, const NoiseLanes& b) noexcept {
+		return generate([&](u32 i) constexpr { return T(a.v[i] + b.v[i]); });
+	}
+
+	friend constexpr NoiseLanes operator-(const NoiseLanes& a, const NoiseLanes& b) noexcept {
+		return generate([&](u32 i) constexpr { return T(a.v[i] - b.v[i]); });
+	}
+
+	friend constexpr NoiseLanes operator*(const NoiseLanes& a, const NoiseLanes& b) noexcept {
+		return generate([&](u32 i) constexpr { return T(a.v[i] * b.v[i]); });
+	}
+
+	friend constexpr NoiseLanes operator/(const NoiseLanes& a, const NoiseLanes& b) noexcept {
+		return generate([&](u32 i) constexpr { return T(a.v[i] / b.v[i]); });
+	}
+
+	friend constexpr NoiseLanes operator&(const NoiseLanes& a, const NoiseLanes& b) noexcept requires CC::Integral<T> {
+		return generate([&](u32 i) constexpr { return T(a.v[i] & b.v[i]); });
+	}
+
+
+	friend constexpr NoiseLanes min(const NoiseLanes& a, const NoiseLanes& b) noexcept {
+		return generate([&](u32 i) constexpr { return a.v[i] < b.v[i] ? a.v[i] : b.v[i]; });
+	}
+
+	friend constexpr NoiseLanes max(const NoiseLanes& a, const NoiseLanes& b) noexcept {
+		return generate([&](u32 i) constexpr { return a.v[i] > b.v[i] ? a.v[i] : b.v[i]; });
+	}
+
+	friend constexpr NoiseLanes abs(const NoiseLanes& a) noexcept {
+		return generate([&](u32 i) constexpr { return a.v[i] < 0 ? T(-a.v[i]) : a.v[i]; });
+	}
+
+	friend constexpr NoiseLanes sqrt(const NoiseLanes& a) noexcept requires CC::Float<T> {
+		return generate([&](u32 i) constexpr { return Math::sqrt(a.v[i]); });
+	}
+
+	friend constexpr NoiseLanes lerp(const NoiseLanes& a, const NoiseLanes& b, const NoiseLanes& t) noexcept {
+		return a + t * (b - a);
+	}
+
+	// Selects x where a >= b holds per lane, otherwise y
+	friend constexpr NoiseLanes selectGreaterEqual(const NoiseLanes& a, const NoiseLanes& b, const NoiseLanes& x, const NoiseLanes& y) noexcept {
+		return generate([&](u32 i) constexpr { return a.v[i] >= b.v[i] ? x.v[i] : y.v[i]; });
+	}
+
+
+	alignas(N * sizeof(T) < 64 ? N * sizeof(T) : 64) T v[N];
+
+};
+
+
+// Rounds towards negative infinity, exact for all values representable by the integer type
+template<CC::Integer I, CC::Float F, u32 N>
+constexpr NoiseLanes<I, N> floorLanes(const NoiseLanes<F, N>& lanes) noexcept {
+
+	return NoiseLanes<I, N>::generate([&](u32 i) constexpr {
+		I t = I(lanes[i]);
+		return I(t - (F(t) > lanes[i]));
+	});
+
+}
+
+
+// Yields 1 for every lane where a >= b holds, otherwise 0
+template<CC::Integral I, CC::Arithmetic T, u32 N>
+constexpr NoiseLanes<I, N> greaterEqualLanes(const NoiseLanes<T, N>& a, const NoiseLanes<T, N>& b) noexcept {
+	return NoiseLanes<I, N>::generate([&](u32 i) constexpr { return I(a[i] >= b[i]); });
+}
+
+
+// Loads table[index] for every lane
+template<CC::Arithmetic T, u32 N>
+constexpr NoiseLanes<T, N> gatherLanes(const T* table, const NoiseLanes<u32, N>& index) noexcept {
+	return NoiseLanes<T, N>::generate([&](u32 i) constexpr { return table[index[i]]; });
+}
+
+/*
+	Loads table[index] for every lane from a table of Count entries, index must be below Count.
+	Small float tables are held in registers and selected with permutes on AVX2 targets,
+	avoiding hardware gathers which are slow on many processors.
+*/
+template<u32 Count, CC::Arithmetic T, u32 N>
+constexpr NoiseLanes<T, N> lookupLanes(const T* table, const NoiseLanes<u32, N>& index) noexcept {
+
+#if defined(ARC_INTRINSIC_AVAILABLE) && defined(__AVX2__)
+
+	if constexpr (CC::Equal<T, float> && N % 8 == 0 && Count % 8 == 0 && Count <= 32) {
+
+		if (!std::is_constant_evaluated()) {
+
+			NoiseLanes<T, N> lanes;
+
+			for (u32 i = 0; i < N; i += 8) {
+
+				__m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index.v + i));
+				__m256i block = _mm256_srli_epi32(idx, 3);
+				__m256 result = _mm256_permutevar8x32_ps(_mm256_loadu_ps(table), idx);
+
+				for (u32 j = 1; j < Count / 8; j++) {
+
+					__m256 part = _mm256_permutevar8x32_ps(_mm256_loadu_ps(table + j * 8), idx);
+					__m256i select = _mm256_cmpeq_epi32(block, _mm256_set1_epi32(j));
+
+					result = _mm256_blendv_ps(result, part, _mm256_castsi256_ps(select));
+
+				}
+
+				_mm256_storeu_ps(lanes.v + i, result);
+
+			}
+
+			return lanes;
+
+		}
+
+	}
+
+#endif
+
+	return gatherLanes(table, index);
+
+}
+
+
+template<CC::Float F, SizeT D, u32 N>
+using NoiseLanePoint = std::array<NoiseLanes<F, N>, D>;
\ No newline at end of file
@@ -193,6 +193,62 @@ public:
 
 	}
 
+	template<CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L = u32, CC::Arithmetic P = u32, CC::Float F = TT::ExtractType<T>>
+	void sampleGrid(const T& origin, const T& step, const std::array<u32, NoiseBase::dimension<T>()>& counts, A frequency, std::span<F> samples, u32 octaves = 1, L lacunarity = 1, P persistence = 1) const {
+
+		std::vector<F> buffer(samples.size());
+		std::fill(samples.begin(), samples.end(), F(0));
+
+		auto calculate = [&](const auto& type) {
+
+			type.sampleGrid(origin, step, counts, frequency, std::span<F>(buffer), octaves, lacunarity, persistence);
+
+			for (SizeT i = 0; i < samples.size(); i++) {
+				samples[i] += buffer[i];
+			}
+
+		};
+
+		std::apply([&](const auto&... args) {
+			(calculate(args), ...);
+		}, types);
+
+		for (F& sample : samples) {
+			sample /= TypesCount;
+		}
+
+	}
+
+	template<CC::Arithmetic C, SizeT N, CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L = u32, CC::Arithmetic P = u32, CC::Float F = TT::ExtractType<T>>
+	void sampleGrid(ContributionT<C, N> contribution, const T& origin, const T& step, const std::array<u32, NoiseBase::dimension<T>()>& counts, A frequency, std::span<F> samples, u32 octaves = 1, L lacunarity = 1, P persistence = 1) const {
+
+		std::vector<F> buffer(samples.size());
+		std::fill(samples.begin(), samples.end(), F(0));
+
+		auto calculate = [&](const auto& type, u32 idx) {
+
+			F scale = (idx == 0) ? 1 : contribution[idx - 1];
+
+			type.sampleGrid(origin, step, counts, frequency, std::span<F>(buffer), octaves, lacunarity, persistence);
+
+			for (SizeT i = 0; i < samples.size(); i++) {
+
+				samples[i] += buffer[i] * scale;
+
+				if (idx != TypesCount - 1) {
+					samples[i] *= 1 - contribution[idx];
+				}
+			}
+
+		};
+
+		std::apply([&](const auto&... args) {
+			u32 idx = 0;
+			(calculate(args, idx++), ...);
+		}, types);
+
+	}
+
 private:
 
 	std::tuple<Types...> types;
@@ -23,7 +23,22 @@ public:
 
 	template<CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L = u32, CC::Arithmetic P = u32, CC::Float F = TT::ExtractType<T>>
 	constexpr std::vector<F> sample(std::span<const T> points, std::span<const A> frequencies, u32 octaves = 1, L lacunarity = 1, P persistence = 1) const {
-		return fractalSample<Fractal>([this](auto p, auto f) constexpr { return raw(p, f); }, points, frequencies, octaves, lacunarity, persistence);
+		return fractalSample<Fractal>([this](const auto& p, const auto& f) constexpr { return raw(p, f); }, points, frequencies, octaves, lacunarity, persistence);
+	}
+
+	template<u32 Lanes = DefaultLanes, CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L = u32, CC::Arithmetic P = u32>
+	constexpr void sample(std::span<const T> points, std::span<const A> frequencies, std::span<TT::ExtractType<T>> samples, u32 octaves = 1, L lacunarity = 1, P persistence = 1) const {
+		fractalSample<Fractal, Lanes>([this](const auto& p, const auto& f) constexpr { return raw(p, f); }, points, frequencies, samples, octaves, lacunarity, persistence);
+	}
+
+	template<u32 Lanes = DefaultLanes, CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L = u32, CC::Arithmetic P = u32>
+	constexpr void sample(std::span<const T> points, A frequency, std::span<TT::ExtractType<T>> samples, u32 octaves = 1, L lacunarity = 1, P persistence = 1) const {
+		fractalSample<Fractal, Lanes>([this](const auto& p, const auto& f) constexpr { return raw(p, f); }, points, frequency, samples, octaves, lacunarity, persistence);
+	}
+
+	template<u32 Lanes = DefaultLanes, CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L = u32, CC::Arithmetic P = u32>
+	constexpr void sampleGrid(const T& origin, const T& step, const std::array<u32, dimension<T>()>& counts, A frequency, std::span<TT::ExtractType<T>> samples, u32 octaves = 1, L lacunarity = 1, P persistence = 1) const {
+		fractalSampleGrid<Fractal, Lanes>([this](const auto& p, const auto& f) constexpr { return raw(p, f); }, origin, step, counts, frequency, samples, octaves, lacunarity, persistence);
 	}
 
 private:
@@ -229,16 +244,65 @@ private:
 	}
 
 
-	template<CC::FloatParam T, CC::Arithmetic A, CC::Float F = TT::ExtractType<T>>
-	constexpr std::vector<F> raw(std::span<const T> points, std::span<const A> frequencies) const {
+	template<CC::Float F, SizeT D, u32 N, CC::Arithmetic A>
+	constexpr NoiseLanes<F, N> raw(const NoiseLanePoint<F, D, N>& point, const NoiseLanes<A, N>& frequency) const {
+
+		using I = TT::ToInteger<F>;
+		using Lanes = NoiseLanes<F, N>;
+		using Index = NoiseLanes<u32, N>;
 
-		std::vector<F> samples;
+		constexpr u32 Corners = 1 << D;
+
+		std::array<Lanes, D> p0, p1, step;
+		std::array<Index, D> h0, h1;
+
+		for (u32 d = 0; d < D; d++) {
+
+			Lanes x = applyFrequency(point[d], frequency);
+			NoiseLanes<I, N> ip0 = floorLanes<I>(x);
+
+			p0[d] = x - Lanes::from(ip0);
+			p1[d] = p0[d] - 1;
+			h0[d] = hashIndex(ip0);
+			h1[d] = h0[d] + 1;
+			step[d] = interpolate(p0[d]);
 
-		for (u32 i = 0; i < points.size(); i++) {
-			samples.push_back(raw(points[i], frequencies[i]));
 		}
 
-		return samples;
+		// Bit d of a corner selects the upper cell boundary along axis d
+		std::array<Lanes, Corners> samples;
+
+		for (u32 c = 0; c < Corners; c++) {
+
+			std::array<Index, D> h;
+
+			for (u32 d = 0; d < D; d++) {
+				h[d] = (c >> d) & 1 ? h1[d] : h0[d];
+			}
+
+			NoiseLanePoint<F, D, N> g = gradient<F, D>(hash(h));
+
+			Lanes dot = 0;
+
+			for (u32 d = 0; d < D; d++) {
+				dot += ((c >> d) & 1 ? p1[d] : p0[d]) * g[d];
+			}
+
+			samples[c] = dot;
+
+		}
+
+		// Collapse one axis at a time, pairs differ in their lowest remaining bit
+		for (u32 d = 0, count = Corners; d < D; d++, count /= 2) {
+			for (u32 c = 0; c < count / 2; c++) {
+				samples[c] = lerp(samples[c * 2], samples[c * 2 + 1], step[d]);
+			}
+		}
+
+		constexpr F scale = D == 1 ? 2 : D == 2 ? 1.41421356237 : D == 3 ? 1.15470053838 : 1;
+
+		return applyFractal<Fractal>(samples[0] * scale);
+
 	}
 
 
@@ -247,6 +311,11 @@ private:
 		return t * t * t * (t * (t * 6 - 15) + 10);
 	}
 
+	template<CC::Float F, u32 N>
+	static constexpr NoiseLanes<F, N> interpolate(const NoiseLanes<F, N>& t) {
+		return t * t * t * (t * (t * 6 - 15) + 10);
+	}
+
 };
 
 
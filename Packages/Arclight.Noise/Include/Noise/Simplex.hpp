@@ -23,7 +23,22 @@ public:
 
 	template<CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L = u32, CC::Arithmetic P = u32, CC::Float F = TT::ExtractType<T>>
 	constexpr std::vector<F> sample(std::span<const T> points, std::span<const A> frequencies, u32 octaves = 1, L lacunarity = 1, P persistence = 1) const {
-		return fractalSample<Fractal>([this](auto p, auto f) constexpr { return raw(p, f); }, points, frequencies, octaves, lacunarity, persistence);
+		return fractalSample<Fractal>([this](const auto& p, const auto& f) constexpr { return raw(p, f); }, points, frequencies, octaves, lacunarity, persistence);
+	}
+
+	template<u32 Lanes = DefaultLanes, CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L = u32, CC::Arithmetic P = u32>
+	constexpr void sample(std::span<const T> points, std::span<const A> frequencies, std::span<TT::ExtractType<T>> samples, u32 octaves = 1, L lacunarity = 1, P persistence = 1) const {
+		fractalSample<Fractal, Lanes>([this](const auto& p, const auto& f) constexpr { return raw(p, f); }, points, frequencies, samples, octaves, lacunarity, persistence);
+	}
+
+	template<u32 Lanes = DefaultLanes, CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L = u32, CC::Arithmetic P = u32>
+	constexpr void sample(std::span<const T> points, A frequency, std::span<TT::ExtractType<T>> samples, u32 octaves = 1, L lacunarity = 1, P persistence = 1) const {
+		fractalSample<Fractal, Lanes>([this](const auto& p, const auto& f) constexpr { return raw(p, f); }, points, frequency, samples, octaves, lacunarity, persistence);
+	}
+
+	template<u32 Lanes = DefaultLanes, CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L = u32, CC::Arithmetic P = u32>
+	constexpr void sampleGrid(const T& origin, const T& step, const std::array<u32, dimension<T>()>& counts, A frequency, std::span<TT::ExtractType<T>> samples, u32 octaves = 1, L lacunarity = 1, P persistence = 1) const {
+		fractalSampleGrid<Fractal, Lanes>([this](const auto& p, const auto& f) constexpr { return raw(p, f); }, origin, step, counts, frequency, samples, octaves, lacunarity, persistence);
 	}
 
 private:
@@ -424,16 +439,148 @@ private:
 	}
 
 
-	template<CC::FloatParam T, CC::Arithmetic A, CC::Float F = TT::ExtractType<T>>
-	constexpr std::vector<F> raw(std::span<const T> points, std::span<const A> frequencies) const {
+	template<CC::Float F, u32 N, CC::Arithmetic A>
+	NoiseLanes<F, N> raw(const NoiseLanePoint<F, 1, N>& point, const NoiseLanes<A, N>& frequency) const {
+
+		using I = TT::ToInteger<F>;
+		using Lanes = NoiseLanes<F, N>;
+		using Index = NoiseLanes<u32, N>;
+
+		Lanes x = applyFrequency(point[0], frequency);
+
+		NoiseLanes<I, N> ip0 = floorLanes<I>(x);
+
+		Lanes p0 = x - Lanes::from(ip0);
+		Lanes p1 = p0 - 1;
+
+		Index h0 = hashIndex(ip0);
+		Index h1 = h0 + 1;
+
+		auto part = [&](const Lanes& p, const Index& h) constexpr {
+
+			Lanes dot = p * gradient<F, 1>(hash(h))[0];
+
+			return dot * falloff(Lanes(1), p);
+
+		};
+
+		Lanes sample = part(p0, h0) + part(p1, h1);
+
+		constexpr F scale = 64.0 / 27;
+
+		return applyFractal<Fractal>(sample * scale);
+
+	}
+
+	/*
+		Simplex vertices are selected by ranking the skewed cell offsets instead of branching,
+		vertex k lies on the upper boundary of every axis ranked D - k or higher.
+	*/
+	template<CC::Float F, SizeT D, u32 N, CC::Arithmetic A> requires(D >= 2)
+	NoiseLanes<F, N> raw(const NoiseLanePoint<F, D, N>& point, const NoiseLanes<A, N>& frequency) const {
+
+		using I = TT::ToInteger<F>;
+		using Lanes = NoiseLanes<F, N>;
+		using Index = NoiseLanes<u32, N>;
+		using Offset = NoiseLanes<I, N>;
+
+		constexpr F toSimplex = D == 2 ? 0.2113248654 : D == 3 ? 1.0 / 6 : 0.13819660112;
+		constexpr F toCube = D == 2 ? 0.36602540378 : D == 3 ? 1.0 / 3 : 0.30901699437;
+
+		std::array<Lanes, D> x, p0, diff;
+		std::array<Offset, D> ip0;
+		std::array<Index, D> h0;
+
+		Lanes sum = 0;
+
+		for (u32 d = 0; d < D; d++) {
+			x[d] = applyFrequency(point[d], frequency);
+			sum += x[d];
+		}
+
+		Lanes skew = sum * toCube;
+
+		for (u32 d = 0; d < D; d++) {
+
+			Lanes skewed = x[d] + skew;
+
+			ip0[d] = floorLanes<I>(skewed);
+
+			p0[d] = x[d] - Lanes::from(ip0[d]);
+			diff[d] = skewed - Lanes::from(ip0[d]);
+			h0[d] = hashIndex(ip0[d]);
+
+		}
+
+		std::array<Offset, D> rank {};
+
+		for (u32 a = 0; a < D; a++) {
+			for (u32 b = a + 1; b < D; b++) {
+
+				Offset greater = greaterEqualLanes<I>(diff[a], diff[b]);
 
-		std::vector<F> samples;
+				rank[a] += greater;
+				rank[b] += 1 - greater;
 
-		for (u32 i = 0; i < points.size(); i++) {
-			samples.push_back(raw(points[i], frequencies[i]));
+			}
 		}
 
-		return samples;
+		auto part = [&](const std::array<Offset, D>& offset) constexpr {
+
+			Offset ipSum = 0;
+			std::array<Lanes, D> p;
+			std::array<Index, D> h;
+
+			for (u32 d = 0; d < D; d++) {
+				ipSum += ip0[d] + offset[d];
+				p[d] = p0[d] - Lanes::from(offset[d]);
+				h[d] = h0[d] + Index::from(offset[d]);
+			}
+
+			Lanes unskew = Lanes::from(ipSum) * toSimplex;
+
+			NoiseLanePoint<F, D, N> g = gradient<F, D>(hash(h));
+
+			Lanes dot = 0;
+			Lanes a = 0.5;
+
+			for (u32 d = 0; d < D; d++) {
+
+				Lanes unskewed = p[d] + unskew;
+
+				dot += unskewed * g[d];
+				a -= unskewed * unskewed;
+
+			}
+
+			a = max(a, Lanes(0));
+
+			return dot * (a * a * a);
+
+		};
+
+		std::array<Offset, D> offset;
+
+		offset.fill(0);
+		Lanes sample = part(offset);
+
+		offset.fill(1);
+		sample += part(offset);
+
+		for (u32 k = 1; k < D; k++) {
+
+			for (u32 d = 0; d < D; d++) {
+				offset[d] = greaterEqualLanes<I>(rank[d], Offset(D - k));
+			}
+
+			sample += part(offset);
+
+		}
+
+		constexpr F scale = D == 2 ? F(32.990773983) : D == 3 ? F(30.6822935365f) : F(27);
+
+		return applyFractal<Fractal>(sample * scale);
+
 	}
 
 
@@ -449,6 +596,16 @@ private:
 		return a * a * a;
 	}
 
+	template<CC::Float F, u32 N, class... Args>
+	static constexpr NoiseLanes<F, N> falloff(NoiseLanes<F, N> a, const Args&... v) {
+
+		((a -= v * v), ...);
+
+		a = max(a, NoiseLanes<F, N>(0));
+
+		return a * a * a;
+	}
+
 };
 
 
@@ -33,7 +33,22 @@ public:
 
 	template<CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L = u32, CC::Arithmetic P = u32, CC::Float F = TT::ExtractType<T>>
 	constexpr std::vector<F> sample(std::span<const T> points, std::span<const A> frequencies, u32 octaves = 1, L lacunarity = 1, P persistence = 1) const {
-		return fractalSample<Fractal>([this](auto p, auto f) constexpr { return raw(p, f); }, points, frequencies, octaves, lacunarity, persistence);
+		return fractalSample<Fractal>([this](const auto& p, const auto& f) constexpr { return raw(p, f); }, points, frequencies, octaves, lacunarity, persistence);
+	}
+
+	template<u32 Lanes = DefaultLanes, CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L = u32, CC::Arithmetic P = u32>
+	constexpr void sample(std::span<const T> points, std::span<const A> frequencies, std::span<TT::ExtractType<T>> samples, u32 octaves = 1, L lacunarity = 1, P persistence = 1) const {
+		fractalSample<Fractal, Lanes>([this](const auto& p, const auto& f) constexpr { return raw(p, f); }, points, frequencies, samples, octaves, lacunarity, persistence);
+	}
+
+	template<u32 Lanes = DefaultLanes, CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L = u32, CC::Arithmetic P = u32>
+	constexpr void sample(std::span<const T> points, A frequency, std::span<TT::ExtractType<T>> samples, u32 octaves = 1, L lacunarity = 1, P persistence = 1) const {
+		fractalSample<Fractal, Lanes>([this](const auto& p, const auto& f) constexpr { return raw(p, f); }, points, frequency, samples, octaves, lacunarity, persistence);
+	}
+
+	template<u32 Lanes = DefaultLanes, CC::FloatParam T, CC::Arithmetic A, CC::Arithmetic L = u32, CC::Arithmetic P = u32>
+	constexpr void sampleGrid(const T& origin, const T& step, const std::array<u32, dimension<T>()>& counts, A frequency, std::span<TT::ExtractType<T>> samples, u32 octaves = 1, L lacunarity = 1, P persistence = 1) const {
+		fractalSampleGrid<Fractal, Lanes>([this](const auto& p, const auto& f) constexpr { return raw(p, f); }, origin, step, counts, frequency, samples, octaves, lacunarity, persistence);
 	}
 
 private:
@@ -230,16 +245,63 @@ private:
 	}
 
 
-	template<CC::FloatParam T, CC::Arithmetic A, CC::Float F = TT::ExtractType<T>>
-	constexpr std::vector<F> raw(std::span<const T> points, std::span<const A> frequencies) const {
+	template<CC::Float F, SizeT D, u32 N, CC::Arithmetic A>
+	constexpr NoiseLanes<F, N> raw(const NoiseLanePoint<F, D, N>& point, const NoiseLanes<A, N>& frequency) const {
 
-		std::vector<F> samples;
+		using I = TT::ToInteger<F>;
+		using Lanes = NoiseLanes<F, N>;
+		using Index = NoiseLanes<u32, N>;
+		using Offset = NoiseLanes<I, N>;
+
+		constexpr F max = D == 1 ? 2 : D == 2 ? 1.41421356237 : D == 3 ? 1.73205080756 : 2;
+		constexpr u32 Neighbors = D == 1 ? 3 : D == 2 ? 9 : D == 3 ? 27 : 81;
+
+		std::array<Lanes, D> p;
+		std::array<Offset, D> ip;
+
+		for (u32 d = 0; d < D; d++) {
+
+			Lanes x = applyFrequency(point[d], frequency);
+
+			ip[d] = floorLanes<I>(x);
+			p[d] = x - Lanes::from(ip[d]);
 
-		for (u32 i = 0; i < points.size(); i++) {
-			samples.push_back(raw(points[i], frequencies[i]));
 		}
 
-		return samples;
+		// Distances are compared squared, roots are only taken of the results
+		Lanes first = max * max;
+		Lanes second = max * max;
+
+		for (u32 n = 0; n < Neighbors; n++) {
+
+			std::array<I, D> offset;
+			std::array<Index, D> h;
+
+			for (u32 d = 0, rest = n; d < D; d++, rest /= 3) {
+				offset[d] = I(rest % 3) - 1;
+				h[d] = hashIndex(abs(ip[d] + Offset(offset[d])));
+			}
+
+			NoiseLanePoint<F, D, N> g = gradient<F, D>(hash(h));
+
+			Lanes dist = 0;
+
+			for (u32 d = 0; d < D; d++) {
+
+				Lanes delta = p[d] - (g[d] / 2 + F(0.5) + F(offset[d]));
+
+				dist += delta * delta;
+
+			}
+
+			updateDistances(first, second, dist);
+
+		}
+
+		Lanes sample = applyFlag(sqrt(first), sqrt(second)) / max * 2 - 1;
+
+		return applyFractal<Fractal>(sample);
+
 	}
 
 
@@ -261,6 +323,20 @@ private:
 		}
 	}
 
+	template<CC::Float F, u32 N>
+	static constexpr void updateDistances(NoiseLanes<F, N>& first, NoiseLanes<F, N>& second, const NoiseLanes<F, N>& dist) {
+		if constexpr (Flag == FlagT::None) {
+
+			first = min(first, dist);
+
+		} else {
+
+			second = selectGreaterEqual(dist, first, min(second, dist), first);
+			first = min(first, dist);
+
+		}
+	}
+
 	template<CC::Float F>
 	static constexpr F applyFlag(F first, F second) {
 		if constexpr (Flag == FlagT::Second) {
@@ -272,6 +348,17 @@ private:
 		}
 	}
 
+	template<CC::Float F, u32 N>
+	static constexpr NoiseLanes<F, N> applyFlag(const NoiseLanes<F, N>& first, const NoiseLanes<F, N>& second) {
+		if constexpr (Flag == FlagT::Second) {
+			return second;
+		} else if constexpr (Flag == FlagT::Diff) {
+			return second - first;
+		} else {
+			return first;
+		}
+	}
+
 };
 
 
@@ -64,7 +64,10 @@ public:
 	bool hasTexture(u32 texID) const;
 	const TextureData& getTextureData(u32 texID) const;
 
-	static CompositeTexture loadAndComposite(const TextureSet& set, Type type);
+	// Upper bound for encoded texture bytes held in memory while loading
+	static constexpr SizeT DefaultLoadBudget = 256 * 1024 * 1024;
+
+	static CompositeTexture loadAndComposite(const TextureSet& set, Type type, SizeT memoryBudget = DefaultLoadBudget);
 
 private:
 
@@ -9,9 +9,16 @@
 #include "Spring/CompositeTexture.hpp"
 #include "Spring/TextureSet.hpp"
 #include "Filesystem/File.hpp"
+#include "Filesystem/MappedFile.hpp"
 #include "Filesystem/Path.hpp"
 #include "Render/GLE/GLE.hpp"
 #include "Image/ImageIO.hpp"
+#include "Concurrent/Thread.hpp"
+
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <deque>
 
 
 
@@ -96,24 +103,286 @@ const CompositeTexture::TextureData& CompositeTexture::getTextureData(u32 texID)
 
 
 
-CompositeTexture CompositeTexture::loadAndComposite(const TextureSet& set, Type type) {
+/*
+ *	Three stage texture loading pipeline:
+ *	A reader thread maps encoded files and prefetches their pages, a pool of decoder threads decodes and converts them to RGBA8
+ *	and the calling thread collects the results into the composite as they arrive.
+ *	Encoded bytes in flight are bounded by the memory budget; a single file exceeding it is still admitted alone.
+ */
+class TextureLoadPipeline {
+
+public:
+
+	struct Result {
+
+		u32 id;
+		bool hasAlpha;
+		Image<Pixel::RGBA8> image;
+
+	};
+
+
+	TextureLoadPipeline(const std::unordered_map<u32, TextureLoadData>& loadData, SizeT memoryBudget) : budget(memoryBudget), inFlight(0), pending(loadData.size()), readerDone(false), failed(false) {
+
+		entries.reserve(loadData.size());
+
+		for (const auto& [id, data] : loadData) {
+			entries.emplace_back(&data);
+		}
+
+		SizeT decoderCount = Math::clamp(Thread::getHardwareThreadCount(), 1, Math::max(entries.size(), 1));
+
+		reader.start([this]() { read(); });
+
+		decoders.resize(decoderCount);
+
+		for (Thread& decoder : decoders) {
+			decoder.start([this]() { decode(); });
+		}
+
+	}
+
+	~TextureLoadPipeline() {
+
+		abort();
+
+		reader.finish();
+
+		for (Thread& decoder : decoders) {
+			decoder.finish();
+		}
+
+	}
+
+
+	// Blocks until the next texture is ready, returns false once all textures have been collected
+	bool next(Result& result) {
+
+		std::unique_lock lock(mutex);
+
+		resultCondition.wait(lock, [this]() { return !results.empty() || !pending || failed; });
+
+		if (failed) {
+			std::rethrow_exception(exception);
+		}
+
+		if (results.empty()) {
+			return false;
+		}
+
+		result = std::move(results.front());
+		results.pop_front();
+		pending--;
+
+		return true;
+
+	}
+
+private:
+
+	struct Encoded {
+
+		const TextureLoadData* data;
+		MappedFile file;
+
+	};
+
+
+	void read() {
+
+		try {
+
+			for (const TextureLoadData* data : entries) {
+
+				SizeT fileSize = File(data->path).size();
+
+				{
+
+					std::unique_lock lock(mutex);
+
+					budgetCondition.wait(lock, [&]() { return inFlight == 0 || inFlight + fileSize <= budget || failed; });
+
+					if (failed) {
+						return;
+					}
+
+					inFlight += fileSize;
+
+				}
+
+				MappedFile file = ImageIO::Detail::mapFile(data->path);
+
+				// Pull the mapped pages in before a decoder touches them
+				file.prefetch(0, file.size());
+
+				{
+
+					std::lock_guard lock(mutex);
+
+					// Account for files that changed size between stat and open
+					inFlight = inFlight - fileSize + file.size();
+					encoded.emplace_back(data, std::move(file));
+
+				}
+
+				encodedCondition.notify_one();
+
+			}
+
+		} catch (...) {
+
+			fail(std::current_exception());
+
+		}
+
+		{
+
+			std::lock_guard lock(mutex);
+			readerDone = true;
+
+		}
+
+		encodedCondition.notify_all();
+
+	}
+
+	void decode() {
+
+		try {
+
+			while (true) {
+
+				Encoded work;
+
+				{
+
+					std::unique_lock lock(mutex);
+
+					encodedCondition.wait(lock, [this]() { return !encoded.empty() || readerDone || failed; });
+
+					if (failed || encoded.empty()) {
+						return;
+					}
+
+					work = std::move(encoded.front());
+					encoded.pop_front();
+
+				}
+
+				Image<Pixel::RGBA8> image = ImageIO::load<Pixel::RGBA8>(work.file.data(), work.data->path.getExtension());
+				SizeT fileSize = work.file.size();
+
+				work.file.close();
+
+				{
+
+					std::lock_guard lock(mutex);
+
+					inFlight -= fileSize;
+					results.emplace_back(work.data->id, work.data->hasAlpha, std::move(image));
+
+				}
+
+				budgetCondition.notify_one();
+				resultCondition.notify_one();
+
+			}
+
+		} catch (...) {
+
+			fail(std::current_exception());
+
+		}
+
+	}
+
+	void fail(std::exception_ptr ex) {
+
+		{
+
+			std::lock_guard lock(mutex);
+
+			if (!failed) {
+				exception = ex;
+				failed = true;
+			}
+
+		}
+
+		notifyAll();
+
+	}
+
+	void abort() {
+
+		{
+
+			std::lock_guard lock(mutex);
+
+			if (!failed && pending) {
+				exception = std::make_exception_ptr(BadTextureCompositeException());
+				failed = true;
+			}
+
+		}
+
+		notifyAll();
+
+	}
+
+	void notifyAll() {
+
+		budgetCondition.notify_all();
+		encodedCondition.notify_all();
+		resultCondition.notify_all();
+
+	}
+
+
+	std::vector<const TextureLoadData*> entries;
+
+	std::mutex mutex;
+	std::condition_variable budgetCondition;
+	std::condition_variable encodedCondition;
+	std::condition_variable resultCondition;
+
+	std::deque<Encoded> encoded;
+	std::deque<Result> results;
+
+	SizeT budget;
+	SizeT inFlight;
+	SizeT pending;
+	bool readerDone;
+	bool failed;
+	std::exception_ptr exception;
+
+	Thread reader;
+	std::vector<Thread> decoders;
+
+};
+
+
+
+CompositeTexture CompositeTexture::loadAndComposite(const TextureSet& set, Type type, SizeT memoryBudget) {
 
 	try {
 
-		const std::unordered_map<u32, TextureLoadData>& loadData = set.getTexturePaths();
 		std::unordered_map<u32, TextureData> textures;
 
 		u32 maxWidth = 0;
 		u32 maxHeight = 0;
 
-		for(const auto& [id, data] : loadData) {
+		TextureLoadPipeline pipeline(set.getTexturePaths(), memoryBudget);
+		TextureLoadPipeline::Result result;
+
+		while (pipeline.next(result)) {
 
-			Image image = ImageIO::load<Pixel::RGBA8>(data.path);
+			Image<Pixel::RGBA8>& image = result.image;
 
 			maxWidth = Math::max(image.getWidth(), maxWidth);
 			maxHeight = Math::max(image.getHeight(), maxHeight);
 
-			textures.emplace(id, TextureData(0, 0, image.getWidth(), image.getHeight(), data.hasAlpha, std::move(image)));
+			textures.emplace(result.id, TextureData(0, 0, image.getWidth(), image.getHeight(), result.hasAlpha, std::move(image)));
 
 		}
 